@@ -0,0 +1,278 @@
+// Include Files
+//==============
+
+#include "CallingBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <algorithm>
+#include <Engine/Results/Results.h>
+#include <Examples/CFunctionsFromLua/LuaBinding.h>
+#include <Examples/LuaFunctionsFromC/LuaBatchCall.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// C++ to Lua
+	//-----------
+
+	bool SetUp_luaFunction( lua_State& io_luaState );
+
+	// Also leaves the function at index 1
+	bool SetUp_luaFunctionOnStack( lua_State& io_luaState );
+
+	bool Benchmark_luaCall( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_luaPcall( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_luaPcall_functionOnStack( lua_State& io_luaState, const uint64_t i_operationCount );
+	// Each operation is one row of a batch
+	bool Benchmark_batchCall( lua_State& io_luaState, const uint64_t i_operationCount );
+
+	// The arguments of a row of a batch call
+	struct sAddends
+	{
+		lua_Number value1;
+		lua_Number value2;
+	};
+	constexpr size_t s_batchRowCount = 1024;
+
+	// Lua to C++
+	//-----------
+
+	// This is the same as ExampleAdd() in CFunctionsFromLua
+	int ExampleAdd( lua_State* io_luaState );
+	// This is the ordinary C++ function that the binding calls
+	double Add( const double i_value1, const double i_value2 );
+
+	bool SetUp_cFunction( lua_State& io_luaState );
+	bool SetUp_binding( lua_State& io_luaState );
+	// Leaves a function that calls ExampleAdd() a given number of times at index 1
+	bool LoadCallingLoop( lua_State& io_luaState );
+
+	bool Benchmark_callFromLua( lua_State& io_luaState, const uint64_t i_operationCount );
+
+	void WriteAndPopError( lua_State& io_luaState );
+}
+
+// Interface
+//==========
+
+void AddCallingBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "call/lua_call", SetUp_luaFunction, Benchmark_luaCall );
+	io_runner.Add( "call/lua_pcall", SetUp_luaFunction, Benchmark_luaPcall );
+	io_runner.Add( "call/lua_pcall (function pushed from the stack)", SetUp_luaFunctionOnStack, Benchmark_luaPcall_functionOnStack );
+	io_runner.Add( "call/LuaBatchCall (1024 rows)", SetUp_luaFunctionOnStack, Benchmark_batchCall );
+	io_runner.Add( "cfunction/lua_register", SetUp_cFunction, Benchmark_callFromLua );
+	io_runner.Add( "cfunction/lua_register (binding)", SetUp_binding, Benchmark_callFromLua );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// C++ to Lua
+	//-----------
+
+	bool SetUp_luaFunction( lua_State& io_luaState )
+	{
+		// This is the same as ExampleAdd() in luaFunctionsFromC.lua
+		// (that file isn't loaded because it prints when it is run)
+		constexpr auto* const script =
+			"function ExampleAdd( i_value1, i_value2 )\n"
+			"	return i_value1 + i_value2\n"
+			"end\n";
+		if ( luaL_dostring( &io_luaState, script ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return true;
+	}
+
+	bool SetUp_luaFunctionOnStack( lua_State& io_luaState )
+	{
+		if ( !SetUp_luaFunction( io_luaState ) )
+		{
+			return false;
+		}
+		lua_getglobal( &io_luaState, "ExampleAdd" );
+		return true;
+	}
+
+	bool Benchmark_luaCall( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		lua_Number sum = 0.0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_getglobal( &io_luaState, "ExampleAdd" );
+			lua_pushnumber( &io_luaState, static_cast<lua_Number>( i ) );
+			lua_pushnumber( &io_luaState, 1.0 );
+			constexpr int argumentCount = 2;
+			constexpr int returnValueCount = 1;
+			lua_call( &io_luaState, argumentCount, returnValueCount );
+			sum += lua_tonumber( &io_luaState, -1 );
+			lua_pop( &io_luaState, returnValueCount );
+		}
+		// The sum is checked so that the results are used
+		return sum > 0.0;
+	}
+
+	bool Benchmark_luaPcall( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		lua_Number sum = 0.0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_getglobal( &io_luaState, "ExampleAdd" );
+			lua_pushnumber( &io_luaState, static_cast<lua_Number>( i ) );
+			lua_pushnumber( &io_luaState, 1.0 );
+			constexpr int argumentCount = 2;
+			constexpr int returnValueCount = 1;
+			constexpr int noErrorHandler = 0;
+			if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+			{
+				WriteAndPopError( io_luaState );
+				return false;
+			}
+			sum += lua_tonumber( &io_luaState, -1 );
+			lua_pop( &io_luaState, returnValueCount );
+		}
+		return sum > 0.0;
+	}
+
+	bool Benchmark_luaPcall_functionOnStack( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		lua_Number sum = 0.0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_pushvalue( &io_luaState, 1 );
+			lua_pushnumber( &io_luaState, static_cast<lua_Number>( i ) );
+			lua_pushnumber( &io_luaState, 1.0 );
+			constexpr int argumentCount = 2;
+			constexpr int returnValueCount = 1;
+			constexpr int noErrorHandler = 0;
+			if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+			{
+				WriteAndPopError( io_luaState );
+				return false;
+			}
+			sum += lua_tonumber( &io_luaState, -1 );
+			lua_pop( &io_luaState, returnValueCount );
+		}
+		return sum > 0.0;
+	}
+
+	bool Benchmark_batchCall( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		std::vector<sAddends> rows( s_batchRowCount );
+		for ( size_t i = 0; i < s_batchRowCount; ++i )
+		{
+			rows[i] = sAddends{ static_cast<lua_Number>( i ), 1.0 };
+		}
+		std::vector<lua_Number> sums( s_batchRowCount );
+		std::vector<eae6320::LuaBatchCall::sRowError> errors;
+		lua_Number sum = 0.0;
+		for ( uint64_t i = 0; i < i_operationCount; i += s_batchRowCount )
+		{
+			const auto rowCount = static_cast<size_t>( std::min<uint64_t>( i_operationCount - i, s_batchRowCount ) );
+			constexpr int argumentCount = 2;
+			constexpr int returnValueCount = 1;
+			const auto result = eae6320::LuaBatchCall::Call( io_luaState, 1, rows.data(), rowCount,
+				argumentCount, []( lua_State& io_luaState, const sAddends& i_addends )
+				{
+					lua_pushnumber( &io_luaState, i_addends.value1 );
+					lua_pushnumber( &io_luaState, i_addends.value2 );
+				},
+				sums.data(), returnValueCount, []( lua_State& io_luaState, lua_Number& o_sum )
+				{
+					o_sum = lua_tonumber( &io_luaState, -1 );
+				},
+				errors );
+			if ( !result || !errors.empty() )
+			{
+				for ( const auto& error : errors )
+				{
+					std::cerr << error.message << std::endl;
+				}
+				return false;
+			}
+			sum += sums[rowCount - 1];
+		}
+		return sum > 0.0;
+	}
+
+	// Lua to C++
+	//-----------
+
+	int ExampleAdd( lua_State* io_luaState )
+	{
+		const auto i_value1 = lua_tonumber( io_luaState, 1 );
+		const auto i_value2 = lua_tonumber( io_luaState, 2 );
+
+		const auto o_value = i_value1 + i_value2;
+		lua_pushnumber( io_luaState, o_value );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	double Add( const double i_value1, const double i_value2 )
+	{
+		return i_value1 + i_value2;
+	}
+
+	bool SetUp_cFunction( lua_State& io_luaState )
+	{
+		lua_register( &io_luaState, "ExampleAdd", ExampleAdd );
+		return LoadCallingLoop( io_luaState );
+	}
+
+	bool SetUp_binding( lua_State& io_luaState )
+	{
+		// Unlike ExampleAdd() the binding checks the types of its arguments
+		lua_register( &io_luaState, "ExampleAdd", EAE6320_LUABINDING_FUNCTION( Add ) );
+		return LoadCallingLoop( io_luaState );
+	}
+
+	bool LoadCallingLoop( lua_State& io_luaState )
+	{
+		// Like the script in CFunctionsFromLua this uses the global variable for every call
+		// (and ignores the results)
+		constexpr auto* const script =
+			"local operationCount = ...\n"
+			"for i = 1, operationCount do\n"
+			"	ExampleAdd( i, 1 )\n"
+			"end\n";
+		if ( luaL_loadstring( &io_luaState, script ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_callFromLua( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		lua_pushvalue( &io_luaState, 1 );
+		lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_operationCount ) );
+		constexpr int argumentCount = 1;
+		constexpr int returnValueCount = 0;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return true;
+	}
+
+	void WriteAndPopError( lua_State& io_luaState )
+	{
+		std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+		lua_pop( &io_luaState, 1 );
+	}
+}
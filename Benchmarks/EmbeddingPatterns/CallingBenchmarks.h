@@ -0,0 +1,23 @@
+/*
+	These benchmarks time calling functions in both directions:
+		* Calling a Lua function from C++ with lua_call() and with lua_pcall()
+			(LuaFunctionsFromC looks the function up with lua_getglobal() before every call, and so these do too)
+		* Calling it with lua_pcall() after pushing it from a stack slot instead of looking it up,
+			and for every row of an array with a single LuaBatchCall (LuaFunctionsFromC)
+		* Calling a C++ function from Lua after it has been registered with lua_register()
+			(CFunctionsFromLua), both a hand-written lua_CFunction and one generated by a binding
+	Each operation is one call of an ExampleAdd() function that adds two numbers.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddCallingBenchmarks( eae6320::cBenchmarkRunner& io_runner );
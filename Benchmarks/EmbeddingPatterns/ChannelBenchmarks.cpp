@@ -0,0 +1,233 @@
+// Include Files
+//==============
+
+#include "ChannelBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <atomic>
+#include <External/Lua/Includes.h>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The most pairs of threads that a benchmark uses
+	constexpr unsigned int s_maxPairCount = 16;
+
+	// Every script is called with the names of two channels and how many operations to do
+	constexpr auto* const s_sendSource =
+		"local name, _, count = ...\n"
+		"local channel = require( 'channel' ).open( name )\n"
+		"for i = 1, count do\n"
+		"	channel:send{ id = i, path = 'texture.png' }\n"
+		"end";
+	constexpr auto* const s_receiveSource =
+		"local name, _, count = ...\n"
+		"local channel = require( 'channel' ).open( name )\n"
+		"for i = 1, count do\n"
+		"	channel:receive()\n"
+		"end";
+	constexpr auto* const s_pingSource =
+		"local pingName, pongName, count = ...\n"
+		"local ping, pong = require( 'channel' ).open( pingName ), require( 'channel' ).open( pongName )\n"
+		"for i = 1, count do\n"
+		"	ping:send( i )\n"
+		"	assert( pong:receive() == i )\n"
+		"end";
+	constexpr auto* const s_pongSource =
+		"local pingName, pongName, count = ...\n"
+		"local ping, pong = require( 'channel' ).open( pingName ), require( 'channel' ).open( pongName )\n"
+		"for i = 1, count do\n"
+		"	pong:send( ping:receive() )\n"
+		"end";
+
+	std::string GetPingName( const unsigned int i_pairIndex );
+	std::string GetPongName( const unsigned int i_pairIndex );
+
+	// Runs a script in a new state (on the calling thread)
+	void RunScript( const char* const i_source, const std::string i_firstChannelName, const std::string i_secondChannelName,
+		const uint64_t i_operationCount, std::atomic<bool>& io_didFail );
+
+	// A channel is freed when no state has it open
+	// (which could happen between the sends and the receives if the threads ran one after another),
+	// and so the set up opens every channel that the benchmarks use and leaves them in a table at index 1
+	bool SetUp_openChannels( lua_State& io_luaState );
+
+	bool Throughput( const unsigned int i_threadCount, const uint64_t i_operationCount );
+	bool Latency( const unsigned int i_threadCount, const uint64_t i_operationCount );
+
+	template <unsigned int threadCount>
+	bool Benchmark_throughput( lua_State& io_luaState, const uint64_t i_operationCount );
+	template <unsigned int threadCount>
+	bool Benchmark_latency( lua_State& io_luaState, const uint64_t i_operationCount );
+}
+
+// Interface
+//==========
+
+void AddChannelBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "channel/throughput (2 threads)", SetUp_openChannels, Benchmark_throughput<2> );
+	io_runner.Add( "channel/throughput (4 threads)", SetUp_openChannels, Benchmark_throughput<4> );
+	io_runner.Add( "channel/throughput (8 threads)", SetUp_openChannels, Benchmark_throughput<8> );
+	io_runner.Add( "channel/throughput (16 threads)", SetUp_openChannels, Benchmark_throughput<16> );
+	io_runner.Add( "channel/throughput (32 threads)", SetUp_openChannels, Benchmark_throughput<32> );
+	io_runner.Add( "channel/round trip (2 threads)", SetUp_openChannels, Benchmark_latency<2> );
+	io_runner.Add( "channel/round trip (4 threads)", SetUp_openChannels, Benchmark_latency<4> );
+	io_runner.Add( "channel/round trip (8 threads)", SetUp_openChannels, Benchmark_latency<8> );
+	io_runner.Add( "channel/round trip (16 threads)", SetUp_openChannels, Benchmark_latency<16> );
+	io_runner.Add( "channel/round trip (32 threads)", SetUp_openChannels, Benchmark_latency<32> );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::string GetPingName( const unsigned int i_pairIndex )
+	{
+		return "ping" + std::to_string( i_pairIndex );
+	}
+
+	std::string GetPongName( const unsigned int i_pairIndex )
+	{
+		return "pong" + std::to_string( i_pairIndex );
+	}
+
+	void RunScript( const char* const i_source, const std::string i_firstChannelName, const std::string i_secondChannelName,
+		const uint64_t i_operationCount, std::atomic<bool>& io_didFail )
+	{
+		auto* const luaState = eae6320::cBenchmarkRunner::NewState();
+		if ( !luaState )
+		{
+			io_didFail = true;
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return;
+		}
+		if ( luaL_loadstring( luaState, i_source ) == LUA_OK )
+		{
+			lua_pushlstring( luaState, i_firstChannelName.data(), i_firstChannelName.size() );
+			lua_pushlstring( luaState, i_secondChannelName.data(), i_secondChannelName.size() );
+			lua_pushinteger( luaState, static_cast<lua_Integer>( i_operationCount ) );
+			constexpr int argumentCount = 3;
+			constexpr int returnValueCount = 0;
+			constexpr int noMessageHandler = 0;
+			if ( lua_pcall( luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK )
+			{
+				io_didFail = true;
+				std::cerr << lua_tostring( luaState, -1 ) << std::endl;
+			}
+		}
+		else
+		{
+			io_didFail = true;
+			std::cerr << lua_tostring( luaState, -1 ) << std::endl;
+		}
+		lua_close( luaState );
+	}
+
+	bool SetUp_openChannels( lua_State& io_luaState )
+	{
+		constexpr auto* const source =
+			"local pingNames, pongNames = ...\n"
+			"local channel = require( 'channel' )\n"
+			"local channels = { channel.open( 'throughput' ) }\n"
+			"for i, name in ipairs( pingNames ) do\n"
+			"	channels[#channels + 1] = channel.open( name )\n"
+			"	channels[#channels + 1] = channel.open( pongNames[i] )\n"
+			"end\n"
+			"return channels";
+		if ( luaL_loadstring( &io_luaState, source ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			return false;
+		}
+		lua_createtable( &io_luaState, static_cast<int>( s_maxPairCount ), 0 );
+		lua_createtable( &io_luaState, static_cast<int>( s_maxPairCount ), 0 );
+		for ( unsigned int i = 0; i < s_maxPairCount; ++i )
+		{
+			const auto pingName = GetPingName( i );
+			const auto pongName = GetPongName( i );
+			lua_pushlstring( &io_luaState, pingName.data(), pingName.size() );
+			lua_rawseti( &io_luaState, -3, static_cast<lua_Integer>( i + 1 ) );
+			lua_pushlstring( &io_luaState, pongName.data(), pongName.size() );
+			lua_rawseti( &io_luaState, -2, static_cast<lua_Integer>( i + 1 ) );
+		}
+		constexpr int argumentCount = 2;
+		constexpr int returnValueCount = 1;
+		constexpr int noMessageHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool Throughput( const unsigned int i_threadCount, const uint64_t i_operationCount )
+	{
+		std::atomic<bool> didFail( false );
+		std::vector<std::thread> threads;
+		threads.reserve( i_threadCount );
+		{
+			// Every message is sent by one sender and received by one receiver
+			// (the first of each also does the remainder)
+			const auto pairCount = i_threadCount / 2;
+			for ( unsigned int i = 0; i < pairCount; ++i )
+			{
+				const auto messageCount = ( i_operationCount / pairCount ) + ( ( i == 0 ) ? ( i_operationCount % pairCount ) : 0 );
+				threads.emplace_back( RunScript, s_sendSource, "throughput", "", messageCount, std::ref( didFail ) );
+				threads.emplace_back( RunScript, s_receiveSource, "throughput", "", messageCount, std::ref( didFail ) );
+			}
+		}
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+		return !didFail;
+	}
+
+	bool Latency( const unsigned int i_threadCount, const uint64_t i_operationCount )
+	{
+		std::atomic<bool> didFail( false );
+		std::vector<std::thread> threads;
+		threads.reserve( i_threadCount );
+		{
+			const auto pairCount = i_threadCount / 2;
+			for ( unsigned int i = 0; i < pairCount; ++i )
+			{
+				const auto pingName = GetPingName( i );
+				const auto pongName = GetPongName( i );
+				threads.emplace_back( RunScript, s_pingSource, pingName, pongName, i_operationCount, std::ref( didFail ) );
+				threads.emplace_back( RunScript, s_pongSource, pingName, pongName, i_operationCount, std::ref( didFail ) );
+			}
+		}
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+		return !didFail;
+	}
+
+	template <unsigned int threadCount>
+	bool Benchmark_throughput( lua_State&, const uint64_t i_operationCount )
+	{
+		static_assert( ( threadCount >= 2 ) && ( ( threadCount % 2 ) == 0 ), "The threads must be in pairs" );
+		return Throughput( threadCount, i_operationCount );
+	}
+
+	template <unsigned int threadCount>
+	bool Benchmark_latency( lua_State&, const uint64_t i_operationCount )
+	{
+		static_assert( ( threadCount >= 2 ) && ( ( threadCount % 2 ) == 0 ) && ( ( threadCount / 2 ) <= s_maxPairCount ),
+			"The threads must be in pairs" );
+		return Latency( threadCount, i_operationCount );
+	}
+}
@@ -0,0 +1,25 @@
+/*
+	These benchmarks time the channel library (see lchannel.c) with every thread running its own state:
+		* Throughput: half of the threads send small tables to one channel and the other half receive them
+			(an operation is one message)
+		* Latency: the threads are in pairs, and each pair sends an integer back and forth through two channels of its own
+			(an operation is one round trip, which every pair does at the same time)
+	with 2, 4, 8, 16, and 32 threads.
+	The times include starting the threads and creating their states,
+	which the number of operations makes small.
+	When there are more threads than processors a thread that is waiting gives up its time slice,
+	and so the times show how the channels behave when the program has more threads than it should.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddChannelBenchmarks( eae6320::cBenchmarkRunner& io_runner );
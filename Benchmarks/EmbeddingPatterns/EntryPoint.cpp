@@ -0,0 +1,100 @@
+/*
+	The main() function is where the program starts execution
+
+	This program times the patterns that the examples show for embedding Lua:
+		EmbeddingPatterns [-json] [-filter text] [-time seconds] [-runs count]
+	-json writes the results as JSON instead of as a table
+		(so that they can be saved and compared with the results of a different build)
+	-filter only runs the benchmarks whose names contain the text (e.g. "load/" or "hash/")
+	-time is the minimum number of seconds that each timed run takes (the default is 0.2)
+	-runs is how many times each benchmark is timed (the default is 3, and the fastest is reported)
+
+	The asset files that the examples load must be in the working directory
+	(the build copies them to the output directory).
+*/
+
+// Include Files
+//==============
+
+#include "CallingBenchmarks.h"
+#include "cBenchmarkRunner.h"
+#include "ChannelBenchmarks.h"
+#include "HashLookupBenchmarks.h"
+#include "InterningBenchmarks.h"
+#include "LoadingBenchmarks.h"
+#include "SchedulerBenchmarks.h"
+#include "StringPoolBenchmarks.h"
+#include "TableBuildingBenchmarks.h"
+#include "TableReadingBenchmarks.h"
+#include "TableSnapshotBenchmarks.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Results/Results.h>
+#include <iostream>
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	bool shouldWriteJson = false;
+	const char* filter = nullptr;
+	double minimumSecondsPerRun = 0.2;
+	unsigned int runCount = 3;
+
+	// Parse the command line
+	for ( int i = 1; i < i_argumentCount; ++i )
+	{
+		const auto* const argument = i_arguments[i];
+		const auto hasValue = ( i + 1 ) < i_argumentCount;
+		if ( std::strcmp( argument, "-json" ) == 0 )
+		{
+			shouldWriteJson = true;
+		}
+		else if ( ( std::strcmp( argument, "-filter" ) == 0 ) && hasValue )
+		{
+			filter = i_arguments[++i];
+		}
+		else if ( ( std::strcmp( argument, "-time" ) == 0 ) && hasValue && ( std::atof( i_arguments[i + 1] ) > 0.0 ) )
+		{
+			minimumSecondsPerRun = std::atof( i_arguments[++i] );
+		}
+		else if ( ( std::strcmp( argument, "-runs" ) == 0 ) && hasValue && ( std::atoi( i_arguments[i + 1] ) > 0 ) )
+		{
+			runCount = static_cast<unsigned int>( std::atoi( i_arguments[++i] ) );
+		}
+		else
+		{
+			std::cerr << "Usage: EmbeddingPatterns [-json] [-filter text] [-time seconds] [-runs count]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	eae6320::cBenchmarkRunner runner( minimumSecondsPerRun, runCount );
+	AddLoadingBenchmarks( runner );
+	AddCallingBenchmarks( runner );
+	AddTableReadingBenchmarks( runner );
+	AddHashLookupBenchmarks( runner );
+	AddTableBuildingBenchmarks( runner );
+	AddInterningBenchmarks( runner );
+	AddStringPoolBenchmarks( runner );
+	AddTableSnapshotBenchmarks( runner );
+	AddChannelBenchmarks( runner );
+	AddSchedulerBenchmarks( runner );
+
+	if ( !runner.Run( filter ) )
+	{
+		return EXIT_FAILURE;
+	}
+	if ( shouldWriteJson )
+	{
+		runner.WriteJson( std::cout );
+	}
+	else
+	{
+		runner.WriteTable( std::cout );
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+// Include Files
+//==============
+
+#include "HashLookupBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The set up leaves these on the stack:
+	//	1: A table with string keys ("property1", "property2", ...) whose values are their numbers
+	//	2: An array of those keys
+	//	3: An array of as many keys that aren't in the table ("optional1", "optional2", ...)
+	//	4: A table with integer keys (i * 7919) and float keys (i + 0.5) for the same numbers
+	constexpr int s_stringTableIndex = 1;
+	constexpr int s_keysIndex = 2;
+	constexpr int s_missingKeysIndex = 3;
+	constexpr int s_numberTableIndex = 4;
+	constexpr auto* const s_setUpChunk =
+		"local keyCount = ...\n"
+		"local strings, keys, missingKeys, numbers = {}, {}, {}, {}\n"
+		"for i = 1, keyCount do\n"
+		"	keys[i] = 'property' .. i\n"
+		"	missingKeys[i] = 'optional' .. i\n"
+		"	strings[keys[i]] = i\n"
+		"	numbers[i * 7919] = i\n"
+		"	numbers[i + 0.5] = i\n"
+		"end\n"
+		"return strings, keys, missingKeys, numbers\n";
+	constexpr lua_Integer s_integerKeyScale = 7919;
+
+	bool SetUp_16keys( lua_State& io_luaState );
+	bool SetUp_512keys( lua_State& io_luaState );
+	bool SetUp( lua_State& io_luaState, const lua_Integer i_keyCount );
+
+	bool Benchmark_stringKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_missingStringKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_integerKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_floatKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newTable( lua_State& io_luaState, const uint64_t i_operationCount );
+
+	// Checks and pops the value that was looked up
+	bool PopValue( lua_State& io_luaState, const lua_Integer i_expectedValue );
+	bool PopNil( lua_State& io_luaState );
+}
+
+// Interface
+//==========
+
+void AddHashLookupBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "hash/string key (16 keys)", SetUp_16keys, Benchmark_stringKey );
+	io_runner.Add( "hash/string key (512 keys)", SetUp_512keys, Benchmark_stringKey );
+	io_runner.Add( "hash/missing string key (512 keys)", SetUp_512keys, Benchmark_missingStringKey );
+	io_runner.Add( "hash/integer key (512 keys)", SetUp_512keys, Benchmark_integerKey );
+	io_runner.Add( "hash/float key (512 keys)", SetUp_512keys, Benchmark_floatKey );
+	io_runner.Add( "hash/new table (512 string keys)", SetUp_512keys, Benchmark_newTable );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool SetUp_16keys( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, 16 );
+	}
+
+	bool SetUp_512keys( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, 512 );
+	}
+
+	bool SetUp( lua_State& io_luaState, const lua_Integer i_keyCount )
+	{
+		if ( luaL_loadstring( &io_luaState, s_setUpChunk ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		lua_pushinteger( &io_luaState, i_keyCount );
+		constexpr int argumentCount = 1;
+		constexpr int returnValueCount = 4;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_stringKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto keyCount = static_cast<lua_Integer>( lua_rawlen( &io_luaState, s_keysIndex ) );
+		lua_Integer key = 0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			key = ( key < keyCount ) ? ( key + 1 ) : 1;
+			lua_rawgeti( &io_luaState, s_keysIndex, key );
+			lua_rawget( &io_luaState, s_stringTableIndex );
+			if ( !PopValue( io_luaState, key ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_missingStringKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto keyCount = static_cast<lua_Integer>( lua_rawlen( &io_luaState, s_missingKeysIndex ) );
+		lua_Integer key = 0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			key = ( key < keyCount ) ? ( key + 1 ) : 1;
+			lua_rawgeti( &io_luaState, s_missingKeysIndex, key );
+			lua_rawget( &io_luaState, s_stringTableIndex );
+			if ( !PopNil( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_integerKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto keyCount = static_cast<lua_Integer>( lua_rawlen( &io_luaState, s_keysIndex ) );
+		lua_Integer key = 0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			key = ( key < keyCount ) ? ( key + 1 ) : 1;
+			lua_rawgeti( &io_luaState, s_numberTableIndex, key * s_integerKeyScale );
+			if ( !PopValue( io_luaState, key ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_floatKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto keyCount = static_cast<lua_Integer>( lua_rawlen( &io_luaState, s_keysIndex ) );
+		lua_Integer key = 0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			key = ( key < keyCount ) ? ( key + 1 ) : 1;
+			lua_pushnumber( &io_luaState, static_cast<lua_Number>( key ) + 0.5 );
+			lua_rawget( &io_luaState, s_numberTableIndex );
+			if ( !PopValue( io_luaState, key ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_newTable( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto keyCount = static_cast<lua_Integer>( lua_rawlen( &io_luaState, s_keysIndex ) );
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			// The table isn't presized, and so it is rehashed every time that it runs out of room
+			lua_newtable( &io_luaState );
+			for ( lua_Integer key = 1; key <= keyCount; ++key )
+			{
+				lua_rawgeti( &io_luaState, s_keysIndex, key );
+				lua_pushinteger( &io_luaState, key );
+				lua_rawset( &io_luaState, -3 );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+
+	bool PopValue( lua_State& io_luaState, const lua_Integer i_expectedValue )
+	{
+		int isInteger;
+		const auto value = lua_tointegerx( &io_luaState, -1, &isInteger );
+		lua_pop( &io_luaState, 1 );
+		if ( !isInteger || ( value != i_expectedValue ) )
+		{
+			std::cerr << "The table doesn't have the expected value for key #" << i_expectedValue << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool PopNil( lua_State& io_luaState )
+	{
+		const auto isNil = lua_isnil( &io_luaState, -1 );
+		lua_pop( &io_luaState, 1 );
+		if ( !isNil )
+		{
+			std::cerr << "The table has a value for a key that was never added" << std::endl;
+			return false;
+		}
+		return true;
+	}
+}
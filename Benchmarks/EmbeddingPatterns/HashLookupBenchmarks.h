@@ -0,0 +1,27 @@
+/*
+	These benchmarks time single lookups in the hash part of a table
+	so that different builds of ltable.c can be compared (e.g. one built with LUA_USE_HASHGROUPS):
+		* A string key that is in a table with 16 or 512 string keys (lua_rawget(), which calls luaH_getshortstr())
+		* A string key that isn't in a table with 512 string keys
+		* An integer key that is too sparse for the array part (lua_rawgeti(), which calls luaH_getint())
+		* A float key (lua_rawget(), which calls luaH_get())
+	Each operation is one lookup of a different key than the previous one.
+	The keys are read from arrays (which are the same for every build)
+	so that the strings don't have to be interned again for every lookup.
+
+	There is also a benchmark that builds a new table with 512 string keys,
+	which includes every rehash as the table grows.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddHashLookupBenchmarks( eae6320::cBenchmarkRunner& io_runner );
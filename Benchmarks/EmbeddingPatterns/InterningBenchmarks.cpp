@@ -0,0 +1,238 @@
+// Include Files
+//==============
+
+#include "InterningBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// These are the Lua files from the Tables example
+	// (the build copies them to the output directory, which is where the benchmarks must be run from)
+	constexpr const char* s_sourcePaths[] =
+	{
+		"loadTableFromFile.lua", "readNestedTableValues.lua", "readTopLevelTableValues.lua", "tableExamples.lua"
+	};
+	// Longer strings aren't interned (this is LUAI_MAXSHORTLEN in llimits.h)
+	constexpr size_t s_maxShortStringLength = 40;
+	// How many hexadecimal digits are appended to make a new string
+	constexpr size_t s_suffixLength = 8;
+
+	// The contents of the files, and their names and short string literals.
+	// These are read once by the first set up.
+	struct sWorkload
+	{
+		std::vector<std::string> sources;
+		std::vector<std::string> strings;
+	};
+	sWorkload s_workload;
+	bool LoadWorkload();
+	// Adds the names and the short string literals of Lua source code in the order that they appear
+	// (this only handles what the files use; e.g. long strings and comments with levels like "--[==[" aren't handled)
+	void AddStrings( const std::string& i_source, std::vector<std::string>& io_strings );
+
+	// The set up leaves a table at index 1 that has every string as a key
+	// so that the strings stay interned while the benchmark runs
+	bool SetUp_existingStrings( lua_State& io_luaState );
+	bool SetUp_workload( lua_State& io_luaState );
+
+	bool Benchmark_existingStrings( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newStrings( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_compile( lua_State& io_luaState, const uint64_t i_operationCount );
+}
+
+// Interface
+//==========
+
+void AddInterningBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "intern/lua_pushlstring (strings that are already interned)", SetUp_existingStrings, Benchmark_existingStrings );
+	io_runner.Add( "intern/lua_pushlstring (new strings)", SetUp_workload, Benchmark_newStrings );
+	io_runner.Add( "intern/luaL_loadbuffer (the Tables example's Lua files)", SetUp_workload, Benchmark_compile );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool LoadWorkload()
+	{
+		if ( !s_workload.sources.empty() )
+		{
+			return true;
+		}
+		sWorkload workload;
+		for ( const auto* const path : s_sourcePaths )
+		{
+			std::ifstream file( path, std::ios::binary );
+			if ( !file )
+			{
+				std::cerr << "Couldn't open " << path << std::endl;
+				return false;
+			}
+			workload.sources.emplace_back( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+			AddStrings( workload.sources.back(), workload.strings );
+		}
+		s_workload = std::move( workload );
+		return true;
+	}
+
+	void AddStrings( const std::string& i_source, std::vector<std::string>& io_strings )
+	{
+		const auto length = i_source.size();
+		size_t i = 0;
+		while ( i < length )
+		{
+			const auto character = static_cast<unsigned char>( i_source[i] );
+			if ( ( character == '-' ) && ( i_source.compare( i, 2, "--" ) == 0 ) )
+			{
+				// A long comment ends with "]]" and any other comment ends with the line
+				const auto isLongComment = i_source.compare( i + 2, 2, "[[" ) == 0;
+				const auto end = i_source.find( isLongComment ? "]]" : "\n", i + 2 );
+				i = ( end != std::string::npos ) ? ( end + ( isLongComment ? 2 : 1 ) ) : length;
+			}
+			else if ( ( character == '"' ) || ( character == '\'' ) )
+			{
+				// The raw text is used (escape sequences are skipped but not replaced)
+				const auto start = ++i;
+				while ( ( i < length ) && ( static_cast<unsigned char>( i_source[i] ) != character ) )
+				{
+					i += ( i_source[i] == '\\' ) ? 2 : 1;
+				}
+				i = std::min( i, length );
+				if ( ( i - start ) <= s_maxShortStringLength )
+				{
+					io_strings.push_back( i_source.substr( start, i - start ) );
+				}
+				++i;
+			}
+			else if ( std::isalpha( character ) || ( character == '_' ) )
+			{
+				const auto start = i;
+				while ( ( i < length )
+					&& ( std::isalnum( static_cast<unsigned char>( i_source[i] ) ) || ( i_source[i] == '_' ) ) )
+				{
+					++i;
+				}
+				io_strings.push_back( i_source.substr( start, i - start ) );
+			}
+			else if ( std::isdigit( character ) )
+			{
+				// A number (e.g. "789.123" or "0x1F") isn't a string
+				while ( ( i < length )
+					&& ( std::isalnum( static_cast<unsigned char>( i_source[i] ) ) || ( i_source[i] == '.' ) ) )
+				{
+					++i;
+				}
+			}
+			else
+			{
+				++i;
+			}
+		}
+	}
+
+	bool SetUp_existingStrings( lua_State& io_luaState )
+	{
+		if ( !SetUp_workload( io_luaState ) )
+		{
+			return false;
+		}
+		lua_createtable( &io_luaState, 0, static_cast<int>( s_workload.strings.size() ) );
+		for ( const auto& string : s_workload.strings )
+		{
+			lua_pushlstring( &io_luaState, string.data(), string.size() );
+			lua_pushboolean( &io_luaState, 1 );
+			lua_rawset( &io_luaState, -3 );
+		}
+		return true;
+	}
+
+	bool SetUp_workload( lua_State& )
+	{
+		if ( !LoadWorkload() )
+		{
+			return false;
+		}
+		if ( s_workload.strings.empty() )
+		{
+			std::cerr << "The Lua files don't have any strings" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_existingStrings( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& strings = s_workload.strings;
+		const auto stringCount = strings.size();
+		size_t stringIndex = 0;
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			const auto& string = strings[stringIndex];
+			lua_pushlstring( &io_luaState, string.data(), string.size() );
+			lua_pop( &io_luaState, 1 );
+			stringIndex = ( ( stringIndex + 1 ) < stringCount ) ? ( stringIndex + 1 ) : 0;
+		}
+		return true;
+	}
+
+	bool Benchmark_newStrings( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& strings = s_workload.strings;
+		const auto stringCount = strings.size();
+		size_t stringIndex = 0;
+		// Every string gets a hexadecimal suffix with a count that keeps increasing between runs
+		// (so that a string is never still interned from before)
+		static uint32_t s_count = 0;
+		char buffer[s_maxShortStringLength];
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			const auto& string = strings[stringIndex];
+			const auto prefixLength = std::min( string.size(), s_maxShortStringLength - s_suffixLength );
+			std::copy( string.data(), string.data() + prefixLength, buffer );
+			auto count = s_count++;
+			for ( size_t j = 0; j < s_suffixLength; ++j, count >>= 4 )
+			{
+				buffer[prefixLength + j] = "0123456789abcdef"[count & 0xf];
+			}
+			lua_pushlstring( &io_luaState, buffer, prefixLength + s_suffixLength );
+			lua_pop( &io_luaState, 1 );
+			stringIndex = ( ( stringIndex + 1 ) < stringCount ) ? ( stringIndex + 1 ) : 0;
+		}
+		return true;
+	}
+
+	bool Benchmark_compile( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto sourceCount = s_workload.sources.size();
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			for ( size_t j = 0; j < sourceCount; ++j )
+			{
+				const auto& source = s_workload.sources[j];
+				if ( luaL_loadbuffer( &io_luaState, source.data(), source.size(), s_sourcePaths[j] ) != LUA_OK )
+				{
+					std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+					lua_pop( &io_luaState, 1 );
+					return false;
+				}
+				lua_pop( &io_luaState, 1 );
+			}
+		}
+		return true;
+	}
+}
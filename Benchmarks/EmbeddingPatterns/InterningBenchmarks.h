@@ -0,0 +1,30 @@
+/*
+	These benchmarks time interning short strings
+	so that different builds of lstring.c can be compared (e.g. one built with LUA_USE_FASTINTERN).
+	Every short string that Lua creates is interned:
+	the lexer interns every name and string literal that it reads,
+	and lua_pushstring()/lua_pushlstring()/lua_getfield()/lua_setfield() intern the strings that C++ gives them.
+
+	The workload is the names and string literals of the Lua files in the Tables example
+	(its three asset files and tableExamples.lua, which has most of the names),
+	read from the files with a simple scanner in the order that the lexer would read them:
+		* Pushing strings that are already interned (what reading an asset's keys from C++ does)
+		* Pushing strings that are new every time
+			(which also includes creating them and the garbage collector removing them again)
+		* Compiling the files with luaL_loadbuffer() (without running them)
+	Each push operation is one string;
+	each compile operation is every file once.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddInterningBenchmarks( eae6320::cBenchmarkRunner& io_runner );
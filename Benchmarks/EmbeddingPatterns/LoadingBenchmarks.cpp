@@ -0,0 +1,184 @@
+// Include Files
+//==============
+
+#include "LoadingBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This is the asset file from the Tables example
+	// (the build copies it to the output directory, which is where the benchmarks must be run from)
+	constexpr auto* const s_assetPath = "loadTableFromFile.lua";
+
+	// Each of these loads the asset once the way that LoadTableFromFile.cpp does
+	// and leaves the stack the way that it was
+	bool LoadAsset_method1( lua_State& io_luaState );
+	bool LoadAsset_method2( lua_State& io_luaState );
+	bool LoadAsset_hybridMethod( lua_State& io_luaState );
+
+	bool Benchmark_method1( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_method2( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_hybridMethod( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_method2WithNewState( lua_State& io_luaState, const uint64_t i_operationCount );
+
+	bool CheckReturnedValues( lua_State& io_luaState, const int i_returnedValueCount );
+	void WriteAndPopError( lua_State& io_luaState );
+}
+
+// Interface
+//==========
+
+void AddLoadingBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "load/luaL_dofile", nullptr, Benchmark_method1 );
+	io_runner.Add( "load/luaL_loadfile+lua_pcall", nullptr, Benchmark_method2 );
+	io_runner.Add( "load/hybrid", nullptr, Benchmark_hybridMethod );
+	io_runner.Add( "load/luaL_loadfile+lua_pcall (new state)", nullptr, Benchmark_method2WithNewState );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool LoadAsset_method1( lua_State& io_luaState )
+	{
+		const auto stackTopBeforeLoading = lua_gettop( &io_luaState );
+		if ( luaL_dofile( &io_luaState, s_assetPath ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return CheckReturnedValues( io_luaState, lua_gettop( &io_luaState ) - stackTopBeforeLoading );
+	}
+
+	bool LoadAsset_method2( lua_State& io_luaState )
+	{
+		if ( luaL_loadfile( &io_luaState, s_assetPath ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return CheckReturnedValues( io_luaState, returnValueCount );
+	}
+
+	bool LoadAsset_hybridMethod( lua_State& io_luaState )
+	{
+		const auto stackTopBeforeLoad = lua_gettop( &io_luaState );
+		if ( luaL_loadfile( &io_luaState, s_assetPath ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = LUA_MULTRET;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			WriteAndPopError( io_luaState );
+			return false;
+		}
+		return CheckReturnedValues( io_luaState, lua_gettop( &io_luaState ) - stackTopBeforeLoad );
+	}
+
+	bool Benchmark_method1( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			if ( !LoadAsset_method1( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_method2( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			if ( !LoadAsset_method2( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_hybridMethod( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			if ( !LoadAsset_hybridMethod( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_method2WithNewState( lua_State&, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			// The state that the runner provides isn't used;
+			// like the examples, every asset gets its own state
+			// (without the standard libraries, which an asset file doesn't need)
+			constexpr bool shouldOpenStandardLibraries = false;
+			auto* luaState = eae6320::cBenchmarkRunner::NewState( shouldOpenStandardLibraries );
+			if ( !luaState )
+			{
+				std::cerr << "Failed to create a new Lua state" << std::endl;
+				return false;
+			}
+			const auto didSucceed = LoadAsset_method2( *luaState );
+			lua_close( luaState );
+			if ( !didSucceed )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool CheckReturnedValues( lua_State& io_luaState, const int i_returnedValueCount )
+	{
+		// A well-behaved asset file will only return a single table
+		auto didSucceed = true;
+		if ( i_returnedValueCount != 1 )
+		{
+			std::cerr << "Asset files must return a single table (instead of "
+				<< i_returnedValueCount << " values)" << std::endl;
+			didSucceed = false;
+		}
+		else if ( !lua_istable( &io_luaState, -1 ) )
+		{
+			std::cerr << "Asset files must return a table (instead of a "
+				<< luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+			didSucceed = false;
+		}
+		lua_pop( &io_luaState, i_returnedValueCount );
+		return didSucceed;
+	}
+
+	void WriteAndPopError( lua_State& io_luaState )
+	{
+		std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+		lua_pop( &io_luaState, 1 );
+	}
+}
@@ -0,0 +1,23 @@
+/*
+	These benchmarks time the ways of loading an asset file that LoadTableFromFile.cpp shows:
+		* luaL_dofile()
+		* luaL_loadfile() and then lua_pcall() with a single return value
+		* luaL_loadfile() and then lua_pcall() with LUA_MULTRET (the "hybrid" method)
+	Each operation loads the file, runs it, checks the table that it returns, and pops it,
+	with the same error checking that the example does.
+	The examples create a new state for every asset,
+	and so there is also a benchmark that includes creating and closing the state.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddLoadingBenchmarks( eae6320::cBenchmarkRunner& io_runner );
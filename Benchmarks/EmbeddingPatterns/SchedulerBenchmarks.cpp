@@ -0,0 +1,230 @@
+// Include Files
+//==============
+
+#include "SchedulerBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <Engine/Results/Results.h>
+#include <Examples/LuaFunctionsFromC/cTaskScheduler.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <new>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	constexpr unsigned int s_taskCount = 100000;
+	// When some tasks are busy this is how many of every 100 wake every frame
+	constexpr unsigned int s_busyTasksPer100 = 1;
+	constexpr double s_secondsPerFrame = 1.0 / 60.0;
+	// A dormant task waits for much longer than a benchmark runs
+	constexpr double s_dormantPeriod = 1.0e9;
+
+	// Each task is called with how many seconds to wait every time it wakes
+	constexpr auto* const s_resumeLoopTaskSource =
+		"return function( period )\n"
+		"	local wakeTime = g_time + period\n"
+		"	while true do\n"
+		"		coroutine.yield()\n"
+		"		if g_time >= wakeTime then\n"
+		"			wakeTime = g_time + period\n"
+		"		end\n"
+		"	end\n"
+		"end";
+	constexpr auto* const s_schedulerTaskSource =
+		"return function( period )\n"
+		"	while true do\n"
+		"		scheduler.wait( period )\n"
+		"	end\n"
+		"end";
+
+	// The resume loop's coroutines are kept in a table at index 1 (so that they aren't collected),
+	// and in this list so that the loop doesn't have to read them from the table
+	std::vector<lua_State*> s_coroutines;
+	double s_time = 0.0;
+
+	double GetPeriod( const unsigned int i_taskIndex, const bool i_areSomeTasksBusy );
+	bool LoadTaskFunction( lua_State& io_luaState, const char* const i_source );
+
+	bool SetUp_resumeLoop( lua_State& io_luaState, const bool i_areSomeTasksBusy );
+	bool SetUp_resumeLoop_dormant( lua_State& io_luaState );
+	bool SetUp_resumeLoop_busy( lua_State& io_luaState );
+	// The scheduler is in a userdata at index 1 whose finalizer cleans it up
+	// (since the runner closes the state after the benchmark)
+	bool SetUp_scheduler( lua_State& io_luaState, const bool i_areSomeTasksBusy );
+	bool SetUp_scheduler_dormant( lua_State& io_luaState );
+	bool SetUp_scheduler_busy( lua_State& io_luaState );
+	int DestroyScheduler( lua_State* io_luaState );
+
+	bool Benchmark_resumeLoop( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_scheduler( lua_State& io_luaState, const uint64_t i_operationCount );
+}
+
+// Interface
+//==========
+
+void AddSchedulerBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "scheduler/frame of 100000 dormant tasks (resume loop)", SetUp_resumeLoop_dormant, Benchmark_resumeLoop );
+	io_runner.Add( "scheduler/frame of 100000 dormant tasks (scheduler)", SetUp_scheduler_dormant, Benchmark_scheduler );
+	io_runner.Add( "scheduler/frame of 100000 tasks with 1% waking (resume loop)", SetUp_resumeLoop_busy, Benchmark_resumeLoop );
+	io_runner.Add( "scheduler/frame of 100000 tasks with 1% waking (scheduler)", SetUp_scheduler_busy, Benchmark_scheduler );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	double GetPeriod( const unsigned int i_taskIndex, const bool i_areSomeTasksBusy )
+	{
+		// A busy task waits for a single frame
+		return ( i_areSomeTasksBusy && ( ( i_taskIndex % 100 ) < s_busyTasksPer100 ) ) ? 0.0 : s_dormantPeriod;
+	}
+
+	bool LoadTaskFunction( lua_State& io_luaState, const char* const i_source )
+	{
+		if ( luaL_dostring( &io_luaState, i_source ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		return true;
+	}
+
+	bool SetUp_resumeLoop( lua_State& io_luaState, const bool i_areSomeTasksBusy )
+	{
+		s_time = 0.0;
+		lua_pushnumber( &io_luaState, s_time );
+		lua_setglobal( &io_luaState, "g_time" );
+		s_coroutines.clear();
+		s_coroutines.reserve( s_taskCount );
+
+		lua_createtable( &io_luaState, static_cast<int>( s_taskCount ), 0 );
+		if ( !LoadTaskFunction( io_luaState, s_resumeLoopTaskSource ) )
+		{
+			return false;
+		}
+		for ( unsigned int i = 0; i < s_taskCount; ++i )
+		{
+			auto* const coroutine = lua_newthread( &io_luaState );
+			lua_rawseti( &io_luaState, 1, static_cast<lua_Integer>( i + 1 ) );
+			lua_pushvalue( &io_luaState, 2 );
+			lua_xmove( &io_luaState, coroutine, 1 );
+			lua_pushnumber( coroutine, GetPeriod( i, i_areSomeTasksBusy ) );
+			// Start the coroutine so that it is waiting
+			constexpr int argumentCount = 1;
+			if ( lua_resume( coroutine, &io_luaState, argumentCount ) != LUA_YIELD )
+			{
+				std::cerr << lua_tostring( coroutine, -1 ) << std::endl;
+				return false;
+			}
+			s_coroutines.push_back( coroutine );
+		}
+		lua_pop( &io_luaState, 1 );
+		return true;
+	}
+
+	bool SetUp_resumeLoop_dormant( lua_State& io_luaState )
+	{
+		constexpr bool areSomeTasksBusy = false;
+		return SetUp_resumeLoop( io_luaState, areSomeTasksBusy );
+	}
+
+	bool SetUp_resumeLoop_busy( lua_State& io_luaState )
+	{
+		constexpr bool areSomeTasksBusy = true;
+		return SetUp_resumeLoop( io_luaState, areSomeTasksBusy );
+	}
+
+	bool SetUp_scheduler( lua_State& io_luaState, const bool i_areSomeTasksBusy )
+	{
+		auto* const scheduler = new ( lua_newuserdata( &io_luaState, sizeof( eae6320::cTaskScheduler ) ) ) eae6320::cTaskScheduler;
+		lua_createtable( &io_luaState, 0, 1 );
+		lua_pushcfunction( &io_luaState, DestroyScheduler );
+		lua_setfield( &io_luaState, -2, "__gc" );
+		lua_setmetatable( &io_luaState, -2 );
+		if ( !scheduler->Initialize( io_luaState ) )
+		{
+			return false;
+		}
+
+		if ( !LoadTaskFunction( io_luaState, s_schedulerTaskSource ) )
+		{
+			return false;
+		}
+		for ( unsigned int i = 0; i < s_taskCount; ++i )
+		{
+			lua_pushvalue( &io_luaState, 2 );
+			lua_pushnumber( &io_luaState, GetPeriod( i, i_areSomeTasksBusy ) );
+			constexpr int argumentCount = 1;
+			if ( !scheduler->Spawn( argumentCount ) )
+			{
+				return false;
+			}
+		}
+		lua_pop( &io_luaState, 1 );
+		// Start the tasks so that they are waiting
+		scheduler->Tick( 0.0 );
+		if ( scheduler->GetSleepingTaskCount() != s_taskCount )
+		{
+			std::cerr << "Only " << scheduler->GetSleepingTaskCount() << " of the tasks are waiting" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool SetUp_scheduler_dormant( lua_State& io_luaState )
+	{
+		constexpr bool areSomeTasksBusy = false;
+		return SetUp_scheduler( io_luaState, areSomeTasksBusy );
+	}
+
+	bool SetUp_scheduler_busy( lua_State& io_luaState )
+	{
+		constexpr bool areSomeTasksBusy = true;
+		return SetUp_scheduler( io_luaState, areSomeTasksBusy );
+	}
+
+	int DestroyScheduler( lua_State* io_luaState )
+	{
+		auto* const scheduler = static_cast<eae6320::cTaskScheduler*>( lua_touserdata( io_luaState, 1 ) );
+		scheduler->~cTaskScheduler();
+		return 0;
+	}
+
+	bool Benchmark_resumeLoop( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			s_time += s_secondsPerFrame;
+			lua_pushnumber( &io_luaState, s_time );
+			lua_setglobal( &io_luaState, "g_time" );
+			for ( auto* const coroutine : s_coroutines )
+			{
+				constexpr int argumentCount = 0;
+				if ( lua_resume( coroutine, &io_luaState, argumentCount ) != LUA_YIELD )
+				{
+					std::cerr << lua_tostring( coroutine, -1 ) << std::endl;
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_scheduler( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		auto& scheduler = *static_cast<eae6320::cTaskScheduler*>( lua_touserdata( &io_luaState, 1 ) );
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			scheduler.Tick( s_secondsPerFrame );
+		}
+		return scheduler.GetTaskCount() == s_taskCount;
+	}
+}
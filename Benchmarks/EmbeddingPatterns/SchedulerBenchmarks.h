@@ -0,0 +1,21 @@
+/*
+	These benchmarks time a frame of 100,000 script tasks that are waiting for time to pass:
+		* Resume loop: the host resumes every coroutine every frame, and each one checks if it is time to wake
+		* Scheduler: a cTaskScheduler tick, which only resumes the tasks that are due
+	both when every task is dormant (waiting much longer than the benchmark runs)
+	and when 1% of them wake every frame.
+	An operation is one frame (of 1/60th of a second).
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddSchedulerBenchmarks( eae6320::cBenchmarkRunner& io_runner );
@@ -0,0 +1,194 @@
+// Include Files
+//==============
+
+#include "StringPoolBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// These are the asset files from the Tables example
+	// (the build copies them to the output directory, which is where the benchmarks must be run from)
+	constexpr const char* s_assetPaths[] =
+	{
+		"loadTableFromFile.lua", "readNestedTableValues.lua", "readTopLevelTableValues.lua"
+	};
+
+	// Loads every asset and pops it
+	bool LoadAssets( lua_State& io_luaState );
+	// Closes the state (if it isn't NULL) after doing a benchmark's operation with it
+	bool CloseState( lua_State* io_luaState, const bool i_shouldLoadAssets );
+
+	bool Benchmark_newState( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newStateAndLoadAssets( lua_State& io_luaState, const uint64_t i_operationCount );
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+	// The string pool is made by the first set up and is kept until the program exits
+	struct sStringPool
+	{
+		lua_StringPool* pool = nullptr;
+
+		~sStringPool()
+		{
+			if ( pool )
+			{
+				lua_closestringpool( pool );
+			}
+		}
+	};
+	sStringPool s_stringPool;
+
+	bool SetUp_stringPool( lua_State& io_luaState );
+
+	bool Benchmark_newStateWithPool( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newStateWithPoolAndLoadAssets( lua_State& io_luaState, const uint64_t i_operationCount );
+#endif
+}
+
+// Interface
+//==========
+
+void AddStringPoolBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "stringpool/new state with the standard libraries (own strings)", nullptr, Benchmark_newState );
+#if defined( LUA_USE_SHAREDSTRINGS )
+	io_runner.Add( "stringpool/new state with the standard libraries (shared strings)", SetUp_stringPool, Benchmark_newStateWithPool );
+#endif
+	io_runner.Add( "stringpool/new state and load the Tables assets (own strings)", nullptr, Benchmark_newStateAndLoadAssets );
+#if defined( LUA_USE_SHAREDSTRINGS )
+	io_runner.Add( "stringpool/new state and load the Tables assets (shared strings)", SetUp_stringPool, Benchmark_newStateWithPoolAndLoadAssets );
+#endif
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool LoadAssets( lua_State& io_luaState )
+	{
+		for ( const auto* const path : s_assetPaths )
+		{
+			constexpr int argumentCount = 0;
+			constexpr int returnValueCount = 1;
+			constexpr int noMessageHandler = 0;
+			if ( ( luaL_loadfile( &io_luaState, path ) != LUA_OK )
+				|| ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK ) )
+			{
+				std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+				lua_pop( &io_luaState, 1 );
+				return false;
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+
+	bool CloseState( lua_State* io_luaState, const bool i_shouldLoadAssets )
+	{
+		if ( !io_luaState )
+		{
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return false;
+		}
+		const auto didSucceed = !i_shouldLoadAssets || LoadAssets( *io_luaState );
+		lua_close( io_luaState );
+		return didSucceed;
+	}
+
+	bool Benchmark_newState( lua_State&, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			constexpr bool shouldLoadAssets = false;
+			if ( !CloseState( eae6320::cBenchmarkRunner::NewState(), shouldLoadAssets ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_newStateAndLoadAssets( lua_State&, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			// Like cLuaStatePool, the state doesn't have the standard libraries
+			// (which an asset file doesn't need)
+			constexpr bool shouldOpenStandardLibraries = false;
+			constexpr bool shouldLoadAssets = true;
+			if ( !CloseState( eae6320::cBenchmarkRunner::NewState( shouldOpenStandardLibraries ), shouldLoadAssets ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+
+	bool SetUp_stringPool( lua_State& )
+	{
+		if ( s_stringPool.pool )
+		{
+			return true;
+		}
+		auto* const luaState = eae6320::cBenchmarkRunner::NewState();
+		if ( !luaState )
+		{
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return false;
+		}
+		// The tables are garbage as soon as they are loaded,
+		// but their strings must still be there when they are shared
+		lua_gc( luaState, LUA_GCSTOP, 0 );
+		if ( !LoadAssets( *luaState ) )
+		{
+			lua_close( luaState );
+			return false;
+		}
+		s_stringPool.pool = lua_newstringpool( luaState );
+		if ( !s_stringPool.pool )
+		{
+			std::cerr << "Failed to create the string pool" << std::endl;
+			lua_close( luaState );
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_newStateWithPool( lua_State&, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			constexpr bool shouldLoadAssets = false;
+			if ( !CloseState( eae6320::cBenchmarkRunner::NewState( *s_stringPool.pool ), shouldLoadAssets ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_newStateWithPoolAndLoadAssets( lua_State&, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			constexpr bool shouldOpenStandardLibraries = false;
+			constexpr bool shouldLoadAssets = true;
+			if ( !CloseState( eae6320::cBenchmarkRunner::NewState( *s_stringPool.pool, shouldOpenStandardLibraries ), shouldLoadAssets ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+#endif
+}
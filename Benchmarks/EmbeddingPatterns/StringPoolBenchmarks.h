@@ -0,0 +1,24 @@
+/*
+	These benchmarks time creating a state
+	so that states with their own strings can be compared with states that share a string pool
+	(which needs Lua to be built with LUA_USE_SHAREDSTRINGS; otherwise only the first kind is timed):
+		* Creating a state with the standard libraries and closing it
+		* Creating a state the way that cLuaStatePool does for cParallelAssetLoader,
+			loading the Tables example's three asset files with it, and closing it
+	The string pool is made from a state that opened the standard libraries and loaded the same asset files,
+	and so a state that shares it doesn't have to create (or allocate) any of those names and keys.
+	The allocations per operation show how much smaller each state is.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddStringPoolBenchmarks( eae6320::cBenchmarkRunner& io_runner );
@@ -0,0 +1,297 @@
+// Include Files
+//==============
+
+#include "TableBuildingBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <Engine/Results/Results.h>
+#include <Examples/Tables/cLuaTableBuilder.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The values of an asset table
+	struct sAsset
+	{
+		std::vector<std::string> texturePaths;
+		std::vector<std::string> parameterKeys;
+		std::vector<double> parameterValues;
+	};
+	// The asset in readNestedTableValues.lua
+	const sAsset& GetNestedAsset();
+	// The same shape but with 64 textures and 32 parameters
+	const sAsset& GetLargeAsset();
+
+	constexpr const char* s_assetKeys[] = { "textures", "parameters" };
+	constexpr size_t s_texturesKeyIndex = 0;
+	constexpr size_t s_parametersKeyIndex = 1;
+
+	// The set up leaves a userdata with these at index 1
+	// (its __gc metamethod cleans them up before the state is closed)
+	constexpr int s_stateIndex = 1;
+	struct sState
+	{
+		const sAsset* asset;
+		// These create empty tables
+		eae6320::cLuaTableBuilder assetBuilder;
+		eae6320::cLuaTableBuilder texturesBuilder;
+		eae6320::cLuaTableBuilder parametersBuilder;
+		// These create copies of the asset's "textures" and "parameters" tables
+		eae6320::cLuaTableBuilder texturesTemplate;
+		eae6320::cLuaTableBuilder parametersTemplate;
+	};
+	sState& GetState( lua_State& io_luaState );
+	int DestroyState( lua_State* io_luaState );
+
+	bool SetUp_nestedAsset( lua_State& io_luaState );
+	bool SetUp_largeAsset( lua_State& io_luaState );
+	bool SetUp( lua_State& io_luaState, const sAsset& i_asset );
+
+	bool Benchmark_oneKeyAtATime( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_presized( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_builder( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_templateCopy( lua_State& io_luaState, const uint64_t i_operationCount );
+}
+
+// Interface
+//==========
+
+void AddTableBuildingBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "build/one key at a time (nested asset)", SetUp_nestedAsset, Benchmark_oneKeyAtATime );
+	io_runner.Add( "build/lua_createtable (nested asset)", SetUp_nestedAsset, Benchmark_presized );
+	io_runner.Add( "build/cLuaTableBuilder (nested asset)", SetUp_nestedAsset, Benchmark_builder );
+	io_runner.Add( "build/template copy (nested asset)", SetUp_nestedAsset, Benchmark_templateCopy );
+	io_runner.Add( "build/one key at a time (64 textures, 32 parameters)", SetUp_largeAsset, Benchmark_oneKeyAtATime );
+	io_runner.Add( "build/lua_createtable (64 textures, 32 parameters)", SetUp_largeAsset, Benchmark_presized );
+	io_runner.Add( "build/cLuaTableBuilder (64 textures, 32 parameters)", SetUp_largeAsset, Benchmark_builder );
+	io_runner.Add( "build/template copy (64 textures, 32 parameters)", SetUp_largeAsset, Benchmark_templateCopy );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const sAsset& GetNestedAsset()
+	{
+		static const sAsset asset{ { "somePath", "someOtherPath" }, { "g_brightness", "g_speed" }, { 12.3, 4.56 } };
+		return asset;
+	}
+
+	const sAsset& GetLargeAsset()
+	{
+		static const sAsset asset = []()
+		{
+			constexpr size_t textureCount = 64;
+			constexpr size_t parameterCount = 32;
+			sAsset largeAsset;
+			for ( size_t i = 0; i < textureCount; ++i )
+			{
+				largeAsset.texturePaths.push_back( "textures/texture" + std::to_string( i + 1 ) + ".png" );
+			}
+			for ( size_t i = 0; i < parameterCount; ++i )
+			{
+				largeAsset.parameterKeys.push_back( "g_parameter" + std::to_string( i + 1 ) );
+				largeAsset.parameterValues.push_back( static_cast<double>( i ) * 0.5 );
+			}
+			return largeAsset;
+		}();
+		return asset;
+	}
+
+	sState& GetState( lua_State& io_luaState )
+	{
+		return *static_cast<sState*>( lua_touserdata( &io_luaState, s_stateIndex ) );
+	}
+
+	int DestroyState( lua_State* io_luaState )
+	{
+		static_cast<sState*>( lua_touserdata( io_luaState, 1 ) )->~sState();
+		constexpr int returnValueCount = 0;
+		return returnValueCount;
+	}
+
+	bool SetUp_nestedAsset( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, GetNestedAsset() );
+	}
+
+	bool SetUp_largeAsset( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, GetLargeAsset() );
+	}
+
+	bool SetUp( lua_State& io_luaState, const sAsset& i_asset )
+	{
+		auto* const state = new ( lua_newuserdata( &io_luaState, sizeof( sState ) ) ) sState;
+		state->asset = &i_asset;
+		lua_createtable( &io_luaState, 0, 1 );
+		lua_pushcfunction( &io_luaState, DestroyState );
+		lua_setfield( &io_luaState, -2, "__gc" );
+		lua_setmetatable( &io_luaState, -2 );
+
+		std::vector<const char*> parameterKeys;
+		for ( const auto& key : i_asset.parameterKeys )
+		{
+			parameterKeys.push_back( key.c_str() );
+		}
+		const auto textureCount = static_cast<int>( i_asset.texturePaths.size() );
+		if ( !state->assetBuilder.Initialize( io_luaState, 0, s_assetKeys, sizeof( s_assetKeys ) / sizeof( *s_assetKeys ) )
+			|| !state->texturesBuilder.Initialize( io_luaState, textureCount, nullptr, 0 )
+			|| !state->parametersBuilder.Initialize( io_luaState, 0, parameterKeys.data(), parameterKeys.size() ) )
+		{
+			return false;
+		}
+
+		// The templates are tables that already have the asset's values
+		{
+			state->texturesBuilder.PushNewTable();
+			for ( int i = 0; i < textureCount; ++i )
+			{
+				lua_pushstring( &io_luaState, i_asset.texturePaths[i].c_str() );
+				lua_rawseti( &io_luaState, -2, i + 1 );
+			}
+			const auto result = state->texturesTemplate.InitializeFromTemplate( io_luaState, -1 );
+			lua_pop( &io_luaState, 1 );
+			if ( !result )
+			{
+				return false;
+			}
+		}
+		{
+			state->parametersBuilder.PushNewTable();
+			for ( size_t i = 0; i < parameterKeys.size(); ++i )
+			{
+				lua_pushnumber( &io_luaState, i_asset.parameterValues[i] );
+				state->parametersBuilder.SetField( -2, i );
+			}
+			const auto result = state->parametersTemplate.InitializeFromTemplate( io_luaState, -1 );
+			lua_pop( &io_luaState, 1 );
+			if ( !result )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Benchmark_oneKeyAtATime( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& asset = *GetState( io_luaState ).asset;
+		const auto textureCount = static_cast<lua_Integer>( asset.texturePaths.size() );
+		const auto parameterCount = asset.parameterKeys.size();
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_newtable( &io_luaState );
+			{
+				lua_newtable( &io_luaState );
+				for ( lua_Integer j = 0; j < textureCount; ++j )
+				{
+					lua_pushstring( &io_luaState, asset.texturePaths[static_cast<size_t>( j )].c_str() );
+					lua_rawseti( &io_luaState, -2, j + 1 );
+				}
+				lua_setfield( &io_luaState, -2, s_assetKeys[s_texturesKeyIndex] );
+			}
+			{
+				lua_newtable( &io_luaState );
+				for ( size_t j = 0; j < parameterCount; ++j )
+				{
+					lua_pushnumber( &io_luaState, asset.parameterValues[j] );
+					lua_setfield( &io_luaState, -2, asset.parameterKeys[j].c_str() );
+				}
+				lua_setfield( &io_luaState, -2, s_assetKeys[s_parametersKeyIndex] );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+
+	bool Benchmark_presized( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& asset = *GetState( io_luaState ).asset;
+		const auto textureCount = static_cast<lua_Integer>( asset.texturePaths.size() );
+		const auto parameterCount = asset.parameterKeys.size();
+		constexpr int assetKeyCount = sizeof( s_assetKeys ) / sizeof( *s_assetKeys );
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_createtable( &io_luaState, 0, assetKeyCount );
+			{
+				lua_createtable( &io_luaState, static_cast<int>( textureCount ), 0 );
+				for ( lua_Integer j = 0; j < textureCount; ++j )
+				{
+					lua_pushstring( &io_luaState, asset.texturePaths[static_cast<size_t>( j )].c_str() );
+					lua_rawseti( &io_luaState, -2, j + 1 );
+				}
+				lua_setfield( &io_luaState, -2, s_assetKeys[s_texturesKeyIndex] );
+			}
+			{
+				lua_createtable( &io_luaState, 0, static_cast<int>( parameterCount ) );
+				for ( size_t j = 0; j < parameterCount; ++j )
+				{
+					lua_pushnumber( &io_luaState, asset.parameterValues[j] );
+					lua_setfield( &io_luaState, -2, asset.parameterKeys[j].c_str() );
+				}
+				lua_setfield( &io_luaState, -2, s_assetKeys[s_parametersKeyIndex] );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+
+	bool Benchmark_builder( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& state = GetState( io_luaState );
+		const auto& asset = *state.asset;
+		const auto textureCount = static_cast<lua_Integer>( asset.texturePaths.size() );
+		const auto parameterCount = asset.parameterKeys.size();
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			state.assetBuilder.PushNewTable();
+			{
+				state.texturesBuilder.PushNewTable();
+				for ( lua_Integer j = 0; j < textureCount; ++j )
+				{
+					lua_pushstring( &io_luaState, asset.texturePaths[static_cast<size_t>( j )].c_str() );
+					lua_rawseti( &io_luaState, -2, j + 1 );
+				}
+				state.assetBuilder.SetField( -2, s_texturesKeyIndex );
+			}
+			{
+				state.parametersBuilder.PushNewTable();
+				for ( size_t j = 0; j < parameterCount; ++j )
+				{
+					lua_pushnumber( &io_luaState, asset.parameterValues[j] );
+					state.parametersBuilder.SetField( -2, j );
+				}
+				state.assetBuilder.SetField( -2, s_parametersKeyIndex );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+
+	bool Benchmark_templateCopy( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		const auto& state = GetState( io_luaState );
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			state.assetBuilder.PushNewTable();
+			state.texturesTemplate.PushTemplateCopy();
+			state.assetBuilder.SetField( -2, s_texturesKeyIndex );
+			state.parametersTemplate.PushTemplateCopy();
+			state.assetBuilder.SetField( -2, s_parametersKeyIndex );
+			lua_pop( &io_luaState, 1 );
+		}
+		return true;
+	}
+}
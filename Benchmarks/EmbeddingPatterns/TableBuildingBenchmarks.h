@@ -0,0 +1,30 @@
+/*
+	These benchmarks time building tables from C++ with the shape of readNestedTableValues.lua
+	(an asset table with a "textures" array and a "parameters" dictionary)
+	once with the two textures and two parameters of that file and once with 64 textures and 32 parameters:
+		* One key at a time into tables created with lua_newtable(),
+			which are rehashed every time that they run out of room
+		* Into tables created with lua_createtable() with the final number of elements and keys
+		* With a cLuaTableBuilder (Examples/Tables), which presizes the tables the same way
+			and assigns keys that were interned once instead of pushing them
+		* By copying "shape template" tables with a cLuaTableBuilder
+	Each operation builds one whole asset table.
+
+	The "resizes/op" column counts every time that the array or hash part of a table is allocated,
+	and so it shows how often the tables were rehashed:
+	the presized tables are only allocated once (one allocation per non-empty part)
+	while every extra resize of the tables built one key at a time is a rehash.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddTableBuildingBenchmarks( eae6320::cBenchmarkRunner& io_runner );
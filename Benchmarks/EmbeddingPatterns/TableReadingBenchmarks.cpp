@@ -0,0 +1,144 @@
+// Include Files
+//==============
+
+#include "TableReadingBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This is the asset file from the Tables example
+	// (the build copies it to the output directory, which is where the benchmarks must be run from)
+	constexpr auto* const s_assetPath = "readTopLevelTableValues.lua";
+
+	// Leaves the asset table at index 1
+	bool SetUp_assetTable( lua_State& io_luaState );
+
+	bool Benchmark_stringKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_stringKey_getfield( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_integerKey( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_integerKey_rawgeti( lua_State& io_luaState, const uint64_t i_operationCount );
+
+	// Checks and pops the value that was read
+	bool PopStringValue( lua_State& io_luaState );
+}
+
+// Interface
+//==========
+
+void AddTableReadingBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "read/string key", SetUp_assetTable, Benchmark_stringKey );
+	io_runner.Add( "read/string key (lua_getfield)", SetUp_assetTable, Benchmark_stringKey_getfield );
+	io_runner.Add( "read/integer key", SetUp_assetTable, Benchmark_integerKey );
+	io_runner.Add( "read/integer key (lua_rawgeti)", SetUp_assetTable, Benchmark_integerKey_rawgeti );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool SetUp_assetTable( lua_State& io_luaState )
+	{
+		if ( luaL_loadfile( &io_luaState, s_assetPath ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		if ( !lua_istable( &io_luaState, -1 ) )
+		{
+			std::cerr << "Asset files must return a table (instead of a "
+				<< luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_stringKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			// The string is interned every time that it is pushed
+			lua_pushstring( &io_luaState, "name" );
+			lua_gettable( &io_luaState, -2 );
+			if ( !PopStringValue( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_stringKey_getfield( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_getfield( &io_luaState, -1, "name" );
+			if ( !PopStringValue( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_integerKey( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			lua_pushinteger( &io_luaState, 1 );
+			lua_gettable( &io_luaState, -2 );
+			if ( !PopStringValue( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool Benchmark_integerKey_rawgeti( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			// This ignores metatables (which an asset table doesn't have)
+			lua_rawgeti( &io_luaState, -1, 1 );
+			if ( !PopStringValue( io_luaState ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool PopStringValue( lua_State& io_luaState )
+	{
+		if ( lua_type( &io_luaState, -1 ) != LUA_TSTRING )
+		{
+			std::cerr << "The value must be a string (instead of a " << luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		// The characters are read so that the value is used
+		const auto didSucceed = *lua_tostring( &io_luaState, -1 ) != '\0';
+		lua_pop( &io_luaState, 1 );
+		return didSucceed;
+	}
+}
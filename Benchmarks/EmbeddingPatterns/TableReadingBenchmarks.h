@@ -0,0 +1,22 @@
+/*
+	These benchmarks time reading values from the asset table in readTopLevelTableValues.lua
+	the way that ReadTopLevelTableValues.cpp does:
+		* A string key ("name") with lua_pushstring() and lua_gettable()
+		* An integer key (1) with lua_pushinteger() and lua_gettable()
+	and with the shortcuts that push the key themselves
+	(lua_getfield() for the string key and lua_rawgeti() for the integer key).
+	Each operation is one read of a string value, including checking its type and popping it.
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddTableReadingBenchmarks( eae6320::cBenchmarkRunner& io_runner );
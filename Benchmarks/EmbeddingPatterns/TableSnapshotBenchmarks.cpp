@@ -0,0 +1,198 @@
+// Include Files
+//==============
+
+#include "TableSnapshotBenchmarks.h"
+
+#include "cBenchmarkRunner.h"
+
+#include <Engine/Results/Results.h>
+#include <Examples/Tables/cTableSnapshot.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <memory>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This is the asset file from the Tables example
+	// (the build copies it to the output directory, which is where the benchmarks must be run from)
+	constexpr auto* const s_configPath = "readNestedTableValues.lua";
+
+	// The snapshot is made by the first set up that needs it and is kept until the program exits
+	std::shared_ptr<const eae6320::cTableSnapshot> s_snapshot;
+
+	// The set up leaves a function at index 1 and the config at index 2.
+	// The function is called with the config and the operation count.
+	constexpr int s_functionIndex = 1;
+	constexpr int s_configIndex = 2;
+	constexpr auto* const s_readParameterSource =
+		"return function( config, count )\n"
+		"	local sum = 0\n"
+		"	for i = 1, count do\n"
+		"		sum = sum + config.parameters.g_brightness\n"
+		"	end\n"
+		"	return sum\n"
+		"end";
+	constexpr auto* const s_readTexturesSource =
+		"return function( config, count )\n"
+		"	local length = 0\n"
+		"	for i = 1, count do\n"
+		"		for _, path in ipairs( config.textures ) do\n"
+		"			length = length + #path\n"
+		"		end\n"
+		"	end\n"
+		"	return length\n"
+		"end";
+
+	// Pushes the table that the config file returns
+	bool LoadConfig( lua_State& io_luaState );
+	bool PushSnapshotProxy( lua_State& io_luaState );
+	bool SetUp( lua_State& io_luaState, const char* const i_functionSource, bool ( *i_pushConfig )( lua_State& ) );
+
+	bool SetUp_readParameter_table( lua_State& io_luaState );
+	bool SetUp_readParameter_snapshot( lua_State& io_luaState );
+	bool SetUp_readTextures_table( lua_State& io_luaState );
+	bool SetUp_readTextures_snapshot( lua_State& io_luaState );
+	bool SetUp_snapshot( lua_State& io_luaState );
+
+	bool Benchmark_read( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newState_table( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newState_snapshot( lua_State& io_luaState, const uint64_t i_operationCount );
+	bool Benchmark_newState( const uint64_t i_operationCount, bool ( *i_pushConfig )( lua_State& ) );
+}
+
+// Interface
+//==========
+
+void AddTableSnapshotBenchmarks( eae6320::cBenchmarkRunner& io_runner )
+{
+	io_runner.Add( "snapshot/config.parameters.g_brightness (table)", SetUp_readParameter_table, Benchmark_read );
+	io_runner.Add( "snapshot/config.parameters.g_brightness (snapshot proxy)", SetUp_readParameter_snapshot, Benchmark_read );
+	io_runner.Add( "snapshot/ipairs( config.textures ) (table)", SetUp_readTextures_table, Benchmark_read );
+	io_runner.Add( "snapshot/ipairs( config.textures ) (snapshot proxy)", SetUp_readTextures_snapshot, Benchmark_read );
+	io_runner.Add( "snapshot/new state with the config (table)", nullptr, Benchmark_newState_table );
+	io_runner.Add( "snapshot/new state with the config (snapshot proxy)", SetUp_snapshot, Benchmark_newState_snapshot );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool LoadConfig( lua_State& io_luaState )
+	{
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noMessageHandler = 0;
+		if ( ( luaL_loadfile( &io_luaState, s_configPath ) != LUA_OK )
+			|| ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK ) )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		return true;
+	}
+
+	bool PushSnapshotProxy( lua_State& io_luaState )
+	{
+		eae6320::cTableSnapshot::PushProxy( io_luaState, s_snapshot );
+		return true;
+	}
+
+	bool SetUp( lua_State& io_luaState, const char* const i_functionSource, bool ( *i_pushConfig )( lua_State& ) )
+	{
+		if ( luaL_dostring( &io_luaState, i_functionSource ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			return false;
+		}
+		return i_pushConfig( io_luaState );
+	}
+
+	bool SetUp_readParameter_table( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, s_readParameterSource, LoadConfig );
+	}
+
+	bool SetUp_readParameter_snapshot( lua_State& io_luaState )
+	{
+		return SetUp_snapshot( io_luaState ) && SetUp( io_luaState, s_readParameterSource, PushSnapshotProxy );
+	}
+
+	bool SetUp_readTextures_table( lua_State& io_luaState )
+	{
+		return SetUp( io_luaState, s_readTexturesSource, LoadConfig );
+	}
+
+	bool SetUp_readTextures_snapshot( lua_State& io_luaState )
+	{
+		return SetUp_snapshot( io_luaState ) && SetUp( io_luaState, s_readTexturesSource, PushSnapshotProxy );
+	}
+
+	bool SetUp_snapshot( lua_State& io_luaState )
+	{
+		if ( s_snapshot )
+		{
+			return true;
+		}
+		// The runner's state is only used to load the file
+		if ( !LoadConfig( io_luaState ) )
+		{
+			return false;
+		}
+		const auto result = eae6320::cTableSnapshot::Create( io_luaState, -1, s_snapshot );
+		lua_pop( &io_luaState, 1 );
+		return result.IsSuccess();
+	}
+
+	bool Benchmark_read( lua_State& io_luaState, const uint64_t i_operationCount )
+	{
+		lua_pushvalue( &io_luaState, s_functionIndex );
+		lua_pushvalue( &io_luaState, s_configIndex );
+		lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_operationCount ) );
+		constexpr int argumentCount = 2;
+		constexpr int returnValueCount = 0;
+		constexpr int noMessageHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK )
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+		return true;
+	}
+
+	bool Benchmark_newState_table( lua_State&, const uint64_t i_operationCount )
+	{
+		return Benchmark_newState( i_operationCount, LoadConfig );
+	}
+
+	bool Benchmark_newState_snapshot( lua_State&, const uint64_t i_operationCount )
+	{
+		return Benchmark_newState( i_operationCount, PushSnapshotProxy );
+	}
+
+	bool Benchmark_newState( const uint64_t i_operationCount, bool ( *i_pushConfig )( lua_State& ) )
+	{
+		for ( uint64_t i = 0; i < i_operationCount; ++i )
+		{
+			constexpr bool shouldOpenStandardLibraries = false;
+			auto* const luaState = eae6320::cBenchmarkRunner::NewState( shouldOpenStandardLibraries );
+			if ( !luaState )
+			{
+				std::cerr << "Failed to create a new Lua state" << std::endl;
+				return false;
+			}
+			const auto didSucceed = i_pushConfig( *luaState );
+			lua_close( luaState );
+			if ( !didSucceed )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,24 @@
+/*
+	These benchmarks compare reading a config table from Lua
+	when every state has its own copy (loaded from readNestedTableValues.lua)
+	and when every state reads a shared cTableSnapshot through a read-only proxy:
+		* Reading config.parameters.g_brightness (a nested string key)
+		* Reading every path of config.textures with ipairs()
+		* Creating a state (without the standard libraries) that has the config and closing it
+	Each read operation is one iteration of a loop in a Lua function.
+	For the new state benchmarks the allocations per operation show how much of each state is the config
+	(the snapshot's proxy only allocates the userdata and the state's proxy cache).
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBenchmarkRunner;
+}
+
+// Interface
+//==========
+
+void AddTableSnapshotBenchmarks( eae6320::cBenchmarkRunner& io_runner );
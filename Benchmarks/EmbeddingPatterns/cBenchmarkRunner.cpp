@@ -0,0 +1,316 @@
+// Include Files
+//==============
+
+#include "cBenchmarkRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iomanip>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Every call to the allocator that allocates memory (a new block or a reallocated one) is counted.
+	// The count is shared by every state that NewState() creates
+	// (and is atomic so that a benchmark can use states on other threads).
+	std::atomic<uint64_t> s_allocationCount( 0 );
+	// When Lua allocates a new object the allocator is given its type instead of an old size,
+	// and so any other allocation is a vector being created or resized
+	std::atomic<uint64_t> s_resizeCount( 0 );
+
+	void* Allocate( void*, void* i_block, size_t i_oldSize, size_t i_newSize );
+	int OnPanic( lua_State* io_luaState );
+
+	// Returns how many seconds it took
+	double TimeBenchmark( lua_State& io_luaState, const eae6320::cBenchmarkRunner::fBenchmark i_benchmark,
+		const uint64_t i_operationCount, bool& o_didSucceed );
+	void WriteJsonString( std::ostream& io_stream, const std::string& i_string );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+void eae6320::cBenchmarkRunner::Add( const char* const i_name, const fSetUp i_setUp, const fBenchmark i_benchmark )
+{
+	EAE6320_ASSERT( i_benchmark );
+	m_benchmarks.push_back( sBenchmark{ i_name, i_setUp, i_benchmark } );
+}
+
+eae6320::cResult eae6320::cBenchmarkRunner::Run( const char* const i_filter )
+{
+	auto result = Results::Success;
+
+	m_results.clear();
+	for ( const auto& benchmark : m_benchmarks )
+	{
+		if ( i_filter && ( benchmark.name.find( i_filter ) == std::string::npos ) )
+		{
+			continue;
+		}
+		sResult benchmarkResult;
+		if ( !( result = RunBenchmark( benchmark, benchmarkResult ) ) )
+		{
+			std::cerr << "The benchmark \"" << benchmark.name << "\" failed" << std::endl;
+			return result;
+		}
+		m_results.push_back( benchmarkResult );
+	}
+
+	return result;
+}
+
+void eae6320::cBenchmarkRunner::WriteTable( std::ostream& io_stream ) const
+{
+	size_t nameWidth = 9;
+	for ( const auto& result : m_results )
+	{
+		nameWidth = std::max( nameWidth, result.name.size() );
+	}
+	const auto flags = io_stream.flags();
+	io_stream << std::left << std::setw( static_cast<int>( nameWidth ) ) << "Benchmark"
+		<< std::right << std::setw( 12 ) << "ns/op" << std::setw( 12 ) << "allocs/op" << std::setw( 12 ) << "resizes/op"
+		<< std::setw( 14 ) << "operations" << "\n";
+	for ( const auto& result : m_results )
+	{
+		io_stream << std::left << std::setw( static_cast<int>( nameWidth ) ) << result.name
+			<< std::right << std::fixed
+			<< std::setw( 12 ) << std::setprecision( 1 ) << result.nanosecondsPerOperation
+			<< std::setw( 12 ) << std::setprecision( 2 ) << result.allocationsPerOperation
+			<< std::setw( 12 ) << std::setprecision( 2 ) << result.resizesPerOperation
+			<< std::setw( 14 ) << result.operationCount << "\n";
+	}
+	io_stream.flags( flags );
+	io_stream << std::flush;
+}
+
+void eae6320::cBenchmarkRunner::WriteJson( std::ostream& io_stream ) const
+{
+	const auto flags = io_stream.flags();
+	const auto precision = io_stream.precision();
+	io_stream << std::setprecision( 17 );
+	io_stream << "{\n"
+		"\t\"lua\": ";
+	WriteJsonString( io_stream, LUA_RELEASE );
+	io_stream << ",\n"
+		"\t\"minimumSecondsPerRun\": " << m_minimumSecondsPerRun << ",\n"
+		"\t\"runCount\": " << m_runCount << ",\n"
+		"\t\"benchmarks\": [";
+	for ( size_t i = 0; i < m_results.size(); ++i )
+	{
+		const auto& result = m_results[i];
+		io_stream << ( ( i == 0 ) ? "\n" : ",\n" ) << "\t\t{ \"name\": ";
+		WriteJsonString( io_stream, result.name );
+		io_stream << ", \"nanosecondsPerOperation\": " << result.nanosecondsPerOperation
+			<< ", \"allocationsPerOperation\": " << result.allocationsPerOperation
+			<< ", \"resizesPerOperation\": " << result.resizesPerOperation
+			<< ", \"operationCount\": " << result.operationCount << " }";
+	}
+	io_stream << "\n\t]\n"
+		"}" << std::endl;
+	io_stream.precision( precision );
+	io_stream.flags( flags );
+}
+
+lua_State* eae6320::cBenchmarkRunner::NewState( const bool i_shouldOpenStandardLibraries )
+{
+	auto* const luaState = lua_newstate( Allocate, nullptr );
+	if ( luaState )
+	{
+		lua_atpanic( luaState, OnPanic );
+		if ( i_shouldOpenStandardLibraries )
+		{
+			luaL_openlibs( luaState );
+		}
+	}
+	return luaState;
+}
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+
+lua_State* eae6320::cBenchmarkRunner::NewState( lua_StringPool& io_stringPool, const bool i_shouldOpenStandardLibraries )
+{
+	auto* const luaState = lua_newstatewithpool( Allocate, nullptr, &io_stringPool );
+	if ( luaState )
+	{
+		lua_atpanic( luaState, OnPanic );
+		if ( i_shouldOpenStandardLibraries )
+		{
+			luaL_openlibs( luaState );
+		}
+	}
+	return luaState;
+}
+
+#endif
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cBenchmarkRunner::cBenchmarkRunner( const double i_minimumSecondsPerRun, const unsigned int i_runCount )
+	:
+	m_minimumSecondsPerRun( i_minimumSecondsPerRun ), m_runCount( std::max( i_runCount, 1u ) )
+{
+
+}
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::cBenchmarkRunner::RunBenchmark( const sBenchmark& i_benchmark, sResult& o_result ) const
+{
+	auto result = Results::Success;
+
+	o_result.name = i_benchmark.name;
+
+	lua_State* luaState = NewState();
+	if ( !luaState )
+	{
+		result = Results::OutOfMemory;
+		std::cerr << "Failed to create a new Lua state" << std::endl;
+		goto OnExit;
+	}
+	if ( i_benchmark.setUp && !i_benchmark.setUp( *luaState ) )
+	{
+		result = Results::Failure;
+		goto OnExit;
+	}
+
+	{
+		bool didSucceed = true;
+
+		// Find how many operations take long enough to time
+		// (a tenth of the minimum is enough to estimate from)
+		uint64_t operationCount = 1;
+		for ( ;; )
+		{
+			const auto seconds = TimeBenchmark( *luaState, i_benchmark.benchmark, operationCount, didSucceed );
+			if ( !didSucceed )
+			{
+				result = Results::Failure;
+				goto OnExit;
+			}
+			if ( seconds >= ( m_minimumSecondsPerRun * 0.1 ) )
+			{
+				const auto scale = std::ceil( m_minimumSecondsPerRun / seconds );
+				operationCount = static_cast<uint64_t>( static_cast<double>( operationCount ) * std::max( scale, 1.0 ) );
+				break;
+			}
+			operationCount *= ( seconds < ( m_minimumSecondsPerRun * 0.001 ) ) ? 100 : 2;
+		}
+
+		// Time the runs and keep the fastest
+		o_result.operationCount = operationCount;
+		o_result.nanosecondsPerOperation = -1.0;
+		for ( unsigned int i = 0; i < m_runCount; ++i )
+		{
+			// Garbage left by a previous run shouldn't be collected during this one
+			lua_gc( luaState, LUA_GCCOLLECT, 0 );
+			const auto allocationCountBeforeRun = s_allocationCount.load();
+			const auto resizeCountBeforeRun = s_resizeCount.load();
+			const auto seconds = TimeBenchmark( *luaState, i_benchmark.benchmark, operationCount, didSucceed );
+			const auto allocationCount = s_allocationCount.load() - allocationCountBeforeRun;
+			const auto resizeCount = s_resizeCount.load() - resizeCountBeforeRun;
+			if ( !didSucceed )
+			{
+				result = Results::Failure;
+				goto OnExit;
+			}
+			const auto nanosecondsPerOperation = seconds * 1.0e9 / static_cast<double>( operationCount );
+			if ( ( o_result.nanosecondsPerOperation < 0.0 ) || ( nanosecondsPerOperation < o_result.nanosecondsPerOperation ) )
+			{
+				o_result.nanosecondsPerOperation = nanosecondsPerOperation;
+				o_result.allocationsPerOperation = static_cast<double>( allocationCount ) / static_cast<double>( operationCount );
+				o_result.resizesPerOperation = static_cast<double>( resizeCount ) / static_cast<double>( operationCount );
+			}
+		}
+	}
+
+OnExit:
+
+	if ( luaState )
+	{
+		lua_close( luaState );
+		luaState = nullptr;
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void* Allocate( void*, void* i_block, size_t i_oldSize, size_t i_newSize )
+	{
+		// This is the same as the allocator that luaL_newstate() uses
+		if ( i_newSize == 0 )
+		{
+			std::free( i_block );
+			return nullptr;
+		}
+		s_allocationCount.fetch_add( 1, std::memory_order_relaxed );
+		if ( i_block || ( i_oldSize == 0 ) )
+		{
+			s_resizeCount.fetch_add( 1, std::memory_order_relaxed );
+		}
+		return std::realloc( i_block, i_newSize );
+	}
+
+	int OnPanic( lua_State* io_luaState )
+	{
+		// This is the same as the panic function that luaL_newstate() sets
+		std::cerr << "PANIC: unprotected error in call to Lua API (" << lua_tostring( io_luaState, -1 ) << ")" << std::endl;
+		constexpr int returnToLuaToAbort = 0;
+		return returnToLuaToAbort;
+	}
+
+	double TimeBenchmark( lua_State& io_luaState, const eae6320::cBenchmarkRunner::fBenchmark i_benchmark,
+		const uint64_t i_operationCount, bool& o_didSucceed )
+	{
+		const auto stackTopBeforeRun = lua_gettop( &io_luaState );
+		const auto startTime = std::chrono::steady_clock::now();
+		o_didSucceed = i_benchmark( io_luaState, i_operationCount );
+		const auto endTime = std::chrono::steady_clock::now();
+		// A benchmark that changes the stack would make every later run do something different
+		EAE6320_ASSERTF( !o_didSucceed || ( lua_gettop( &io_luaState ) == stackTopBeforeRun ),
+			"A benchmark must leave the stack the way that it found it" );
+		lua_settop( &io_luaState, stackTopBeforeRun );
+		return std::chrono::duration<double>( endTime - startTime ).count();
+	}
+
+	void WriteJsonString( std::ostream& io_stream, const std::string& i_string )
+	{
+		io_stream << '"';
+		for ( const auto character : i_string )
+		{
+			if ( ( character == '"' ) || ( character == '\\' ) )
+			{
+				io_stream << '\\' << character;
+			}
+			else if ( static_cast<unsigned char>( character ) < 0x20 )
+			{
+				io_stream << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' ) << static_cast<int>( character )
+					<< std::dec << std::setfill( ' ' );
+			}
+			else
+			{
+				io_stream << character;
+			}
+		}
+		io_stream << '"';
+	}
+}
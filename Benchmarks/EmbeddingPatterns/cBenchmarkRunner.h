@@ -0,0 +1,135 @@
+/*
+	A benchmark runner times the patterns that the examples show for embedding Lua
+	(loading an asset file, calling functions in either direction, reading table values)
+	so that they can be compared with each other and between builds
+
+	A benchmark is a function that does one operation (e.g. one call or one table read) a given number of times.
+	The runner picks a number of operations that takes long enough to time accurately,
+	runs the benchmark several times, and reports the fastest time per operation
+	(the slower runs are the ones that were interrupted by something else).
+
+	Every state that a benchmark uses is created with a counting allocator,
+	and so the runner can also report how many blocks Lua allocated per operation
+	and how many of those were resizes (e.g. of the parts of a table when it is rehashed).
+*/
+
+#ifndef EAE6320_BENCHMARKS_CBENCHMARKRUNNER_H
+#define EAE6320_BENCHMARKS_CBENCHMARKRUNNER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+#if defined( LUA_USE_SHAREDSTRINGS )
+struct lua_StringPool;
+#endif
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cBenchmarkRunner
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Prepares the state before the benchmark is timed
+		// (e.g. by defining functions or by leaving a table on the stack).
+		// It returns false if something failed (after writing an error message).
+		typedef bool ( *fSetUp )( lua_State& io_luaState );
+		// Does the operation the given number of times.
+		// Anything that the set up function left on the stack must still be there when this returns.
+		// It returns false if something failed (after writing an error message).
+		typedef bool ( *fBenchmark )( lua_State& io_luaState, const uint64_t i_operationCount );
+
+		struct sResult
+		{
+			std::string name;
+			double nanosecondsPerOperation = 0.0;
+			double allocationsPerOperation = 0.0;
+			// Allocations of a vector rather than an object:
+			// a table's array or hash part (which is what a rehash allocates), but also e.g. a stack that grows
+			double resizesPerOperation = 0.0;
+			// How many operations the fastest run did
+			uint64_t operationCount = 0;
+		};
+
+		// Access
+		//-------
+
+		// The name should be "group/description" (e.g. "call/lua_pcall") so that related benchmarks can be filtered together.
+		// The set up function can be NULL.
+		void Add( const char* const i_name, const fSetUp i_setUp, const fBenchmark i_benchmark );
+		// Runs every benchmark whose name contains the filter
+		// (or every benchmark if the filter is NULL or empty)
+		cResult Run( const char* const i_filter = nullptr );
+
+		const std::vector<sResult>& GetResults() const { return m_results; }
+		void WriteTable( std::ostream& io_stream ) const;
+		// This is meant to be saved and compared with the results of a different build
+		void WriteJson( std::ostream& io_stream ) const;
+
+		// Creates a state that uses the counting allocator
+		// (a benchmark that creates its own states must use this so that their allocations are counted),
+		// or returns NULL if it couldn't be created.
+		// The states that benchmarks are given have the standard libraries open.
+		static lua_State* NewState( const bool i_shouldOpenStandardLibraries = true );
+#if defined( LUA_USE_SHAREDSTRINGS )
+		// The same, but the state shares the strings of the given pool (see lua_newstatewithpool())
+		static lua_State* NewState( lua_StringPool& io_stringPool, const bool i_shouldOpenStandardLibraries = true );
+#endif
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// i_minimumSecondsPerRun: How long each timed run must take at least
+		// i_runCount: How many times each benchmark is timed
+		cBenchmarkRunner( const double i_minimumSecondsPerRun = 0.2, const unsigned int i_runCount = 3 );
+
+		cBenchmarkRunner( const cBenchmarkRunner& ) = delete;
+		cBenchmarkRunner& operator =( const cBenchmarkRunner& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		struct sBenchmark
+		{
+			std::string name;
+			fSetUp setUp;
+			fBenchmark benchmark;
+		};
+
+		const double m_minimumSecondsPerRun;
+		const unsigned int m_runCount;
+		std::vector<sBenchmark> m_benchmarks;
+		std::vector<sResult> m_results;
+
+		// Implementation
+		//===============
+
+	private:
+
+		cResult RunBenchmark( const sBenchmark& i_benchmark, sResult& o_result ) const;
+	};
+}
+
+#endif	// EAE6320_BENCHMARKS_CBENCHMARKRUNNER_H
@@ -0,0 +1,109 @@
+--[[
+	This benchmark compares the incremental and generational garbage collectors
+	on a frame-based workload
+
+	Before the frames start a large amount of long-lived data is created
+	(like the asset tables that a game loads once and keeps),
+	and then every frame creates a lot of short-lived garbage
+	and only occasionally stores something new in the long-lived data.
+	The incremental collector has to traverse all of the long-lived data in every cycle,
+	but the generational collector's minor collections only traverse young objects
+	(and the old objects that were changed since the previous minor collection).
+
+	The "timed" mode uses the incremental collector but stops its automatic steps,
+	and instead gives it a fixed time budget at the end of every frame
+	(the way that an engine can schedule garbage collection into the idle time between frames).
+
+	The mode can be given on the command line (the default is to run all of them):
+		lua garbageCollectionModes.lua generational
+	A frame's time includes whatever garbage collection happened during it,
+	and so the slowest frames show the longest pauses.
+]]
+
+-- Settings
+--=========
+
+local frameCount = 2000
+local assetCount = 20000
+local garbageTablesPerFrame = 2000
+-- The time that the "timed" mode gives the collector every frame
+local gcBudgetInMicroseconds = 1000
+
+-- Helper Functions
+--=================
+
+local function CreateAssets()
+	local assets = {}
+	for i = 1, assetCount do
+		assets[i] = {
+			name = "asset" .. i,
+			position = { i * 0.25, i * 0.5, i * 0.75 },
+			tags = { "a" .. ( i % 7 ), "b" .. ( i % 11 ) },
+		}
+	end
+	return assets
+end
+
+local function RunFrame( io_assets, i_frameIndex )
+	-- Short-lived garbage (e.g. temporary vectors and strings)
+	local sum = 0
+	for i = 1, garbageTablesPerFrame do
+		local vector = { i, i_frameIndex, i * 0.5 }
+		local label = "frame" .. i_frameIndex .. "_" .. i
+		sum = sum + vector[1] + #label
+	end
+	-- An occasional change to the long-lived data
+	local asset = io_assets[( i_frameIndex * 7919 ) % assetCount + 1]
+	asset.lastFrame = { index = i_frameIndex }
+	return sum
+end
+
+local function Percentile( i_sortedValues, i_percentile )
+	local index = math.max( 1, math.ceil( #i_sortedValues * i_percentile / 100 ) )
+	return i_sortedValues[index]
+end
+
+-- Returns the frame times (in milliseconds) sorted from fastest to slowest, the total time, and the peak memory
+local function RunFrames( i_mode )
+	collectgarbage( "collect" )
+	collectgarbage( ( i_mode == "timed" ) and "incremental" or i_mode )
+	local assets = CreateAssets()
+	collectgarbage( "collect" )
+	if i_mode == "timed" then
+		collectgarbage( "stop" )
+	end
+	local frameTimes = {}
+	local peakMemoryInKb = 0
+	local startTime = os.clock()
+	for frameIndex = 1, frameCount do
+		local frameStartTime = os.clock()
+		RunFrame( assets, frameIndex )
+		if i_mode == "timed" then
+			collectgarbage( "steptime", gcBudgetInMicroseconds )
+		end
+		frameTimes[frameIndex] = ( os.clock() - frameStartTime ) * 1000
+		peakMemoryInKb = math.max( peakMemoryInKb, collectgarbage( "count" ) )
+	end
+	local totalTime = ( os.clock() - startTime ) * 1000
+	table.sort( frameTimes )
+	collectgarbage( "restart" )
+	collectgarbage( "incremental" )
+	return frameTimes, totalTime, peakMemoryInKb
+end
+
+-- Benchmark
+--==========
+
+local modes = { ... }
+if #modes == 0 then
+	modes = { "incremental", "generational", "timed" }
+end
+
+print( string.format( "%-13s %11s %11s %11s %11s %11s", "Mode", "Total (ms)", "Median (ms)", "p99 (ms)", "Max (ms)", "Peak (KB)" ) )
+for _, mode in ipairs( modes ) do
+	assert( mode == "incremental" or mode == "generational" or mode == "timed",
+		"The mode must be \"incremental\", \"generational\", or \"timed\"" )
+	local frameTimes, totalTime, peakMemoryInKb = RunFrames( mode )
+	print( string.format( "%-13s %11.1f %11.3f %11.3f %11.3f %11.0f", mode, totalTime,
+		Percentile( frameTimes, 50 ), Percentile( frameTimes, 99 ), frameTimes[#frameTimes], peakMemoryInKb ) )
+end
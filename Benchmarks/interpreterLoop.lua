@@ -0,0 +1,168 @@
+--[[
+	This benchmark measures CPU-bound scripts that spend almost all of their time in the interpreter loop
+	(luaV_execute()) rather than in the C library
+
+	By default the interpreter loop dispatches each instruction with a single switch statement.
+	To compare against dispatching with a jump table (which needs GCC or Clang)
+	run the same script with a Lua that was built with LUA_USE_JUMPTABLE:
+		make -C External/Lua/5.3.4 linux
+		External/Lua/5.3.4/src/lua Benchmarks/interpreterLoop.lua > switch.txt
+		make -C External/Lua/5.3.4 clean
+		make -C External/Lua/5.3.4 linux MYCFLAGS=-DLUA_USE_JUMPTABLE
+		External/Lua/5.3.4/src/lua Benchmarks/interpreterLoop.lua > jumpTable.txt
+
+	The names of the tests to run can be given on the command line (the default is all of them):
+		lua interpreterLoop.lua fib nbody
+]]
+
+-- Settings
+--=========
+
+local runCount = 5
+
+-- Tests
+--======
+
+local tests = {}
+local testOrder = {}
+local function AddTest( i_name, i_function )
+	tests[i_name] = i_function
+	testOrder[#testOrder + 1] = i_name
+end
+
+-- Recursive calls and integer arithmetic
+AddTest( "fib", function()
+	local function Fib( i_n )
+		if i_n < 2 then
+			return i_n
+		end
+		return Fib( i_n - 1 ) + Fib( i_n - 2 )
+	end
+	return Fib( 32 )
+end )
+
+-- Floating point arithmetic and field access
+AddTest( "nbody", function()
+	local pi = math.pi
+	local solarMass = 4 * pi * pi
+	local daysPerYear = 365.24
+	local function Body( i_x, i_y, i_z, i_vx, i_vy, i_vz, i_mass )
+		return { x = i_x, y = i_y, z = i_z,
+			vx = i_vx * daysPerYear, vy = i_vy * daysPerYear, vz = i_vz * daysPerYear,
+			mass = i_mass * solarMass }
+	end
+	local bodies = {
+		Body( 0, 0, 0, 0, 0, 0, 1 ),
+		Body( 4.84143144246472090e+00, -1.16032004402742839e+00, -1.03622044471123109e-01,
+			1.66007664274403694e-03, 7.69901118419740425e-03, -6.90460016972063023e-05, 9.54791938424326609e-04 ),
+		Body( 8.34336671824457987e+00, 4.12479856412430479e+00, -4.03523417114321381e-01,
+			-2.76742510726862411e-03, 4.99852801234917238e-03, 2.30417297573763929e-05, 2.85885980666130812e-04 ),
+		Body( 1.28943695621391310e+01, -1.51111514016986312e+01, -2.23307578892655734e-01,
+			2.96460137564761618e-03, 2.37847173959480950e-03, -2.96589568540237556e-05, 4.36624404335156298e-05 ),
+		Body( 1.53796971148509165e+01, -2.59193146099879641e+01, 1.79258772950371181e-01,
+			2.68067772490389322e-03, 1.62824170038242295e-03, -9.51592254519715870e-05, 5.15138902046611451e-05 ),
+	}
+	local bodyCount = #bodies
+	local function Advance( i_dt )
+		for i = 1, bodyCount do
+			local bi = bodies[i]
+			local bix, biy, biz, bimass = bi.x, bi.y, bi.z, bi.mass
+			local bivx, bivy, bivz = bi.vx, bi.vy, bi.vz
+			for j = i + 1, bodyCount do
+				local bj = bodies[j]
+				local dx, dy, dz = bix - bj.x, biy - bj.y, biz - bj.z
+				local distanceSquared = dx * dx + dy * dy + dz * dz
+				local magnitude = i_dt / ( distanceSquared * math.sqrt( distanceSquared ) )
+				local bjmass = bj.mass * magnitude
+				bivx = bivx - ( dx * bjmass )
+				bivy = bivy - ( dy * bjmass )
+				bivz = bivz - ( dz * bjmass )
+				bimass = bimass * magnitude
+				bj.vx = bj.vx + ( dx * bimass )
+				bj.vy = bj.vy + ( dy * bimass )
+				bj.vz = bj.vz + ( dz * bimass )
+				bimass = bi.mass
+			end
+			bi.vx, bi.vy, bi.vz = bivx, bivy, bivz
+			bi.x = bix + i_dt * bivx
+			bi.y = biy + i_dt * bivy
+			bi.z = biz + i_dt * bivz
+		end
+	end
+	for i = 1, 200000 do
+		Advance( 0.01 )
+	end
+	return bodies[1].x
+end )
+
+-- Array and hash reads and writes
+AddTest( "tables", function()
+	local count = 100000
+	local array = {}
+	for i = 1, count do
+		array[i] = i
+	end
+	local records = {}
+	for i = 1, 1000 do
+		records[i] = { id = i, value = 0, isDirty = false }
+	end
+	local sum = 0
+	for pass = 1, 20 do
+		for i = 1, count do
+			sum = sum + array[i]
+			array[i] = array[i] + pass
+		end
+		for i = 1, #records do
+			local record = records[i]
+			record.value = record.value + record.id * pass
+			record.isDirty = not record.isDirty
+		end
+	end
+	return sum
+end )
+
+-- Short string creation, concatenation, and table.concat()
+AddTest( "strings", function()
+	local totalLength = 0
+	for pass = 1, 20 do
+		local parts = {}
+		for i = 1, 20000 do
+			parts[i] = "item" .. i .. "=" .. ( i * pass )
+		end
+		local joined = table.concat( parts, "," )
+		local text = ""
+		for i = 1, 2000 do
+			text = text .. parts[i]:sub( 1, 4 )
+		end
+		totalLength = totalLength + #joined + #text
+	end
+	return totalLength
+end )
+
+-- Benchmark
+--==========
+
+local testNames = {}
+for i, argument in ipairs( arg or {} ) do
+	assert( tests[argument], "\"" .. argument .. "\" isn't the name of a test" )
+	testNames[i] = argument
+end
+if #testNames == 0 then
+	testNames = testOrder
+end
+
+print( string.format( "%-8s %14s %14s", "Test", "Fastest (ms)", "Average (ms)" ) )
+for _, testName in ipairs( testNames ) do
+	local test = tests[testName]
+	local fastestTime = math.huge
+	local totalTime = 0
+	for i = 1, runCount do
+		collectgarbage( "collect" )
+		local startTime = os.clock()
+		test()
+		local time = ( os.clock() - startTime ) * 1000
+		fastestTime = math.min( fastestTime, time )
+		totalTime = totalTime + time
+	end
+	print( string.format( "%-8s %14.1f %14.1f", testName, fastestTime, totalTime / runCount ) )
+end
@@ -0,0 +1,102 @@
+--[[
+	This benchmark measures how long loadfile() takes for large generated asset files
+
+	loadfile() goes through luaL_loadfilex(),
+	which (when Lua is built with LUA_USE_MAPFILE) maps a regular file into memory
+	and gives the whole file to the scanner as a single block.
+	To compare against reading the file in BUFSIZ pieces with fread()
+	run the same script with a Lua that was built with and without file mapping:
+		make -C External/Lua/5.3.4 linux MYCFLAGS=-DLUA_USE_MAPFILE
+		External/Lua/5.3.4/src/lua Benchmarks/loadLargeFiles.lua > mapped.txt
+		make -C External/Lua/5.3.4 clean
+		make -C External/Lua/5.3.4 linux
+		External/Lua/5.3.4/src/lua Benchmarks/loadLargeFiles.lua > read.txt
+
+	The sizes (in MB) can be given on the command line (the default is 10 25 50 100):
+		lua loadLargeFiles.lua 10 100
+	Each file is loaded both as source code and as a precompiled binary chunk
+	(the binary chunk is mostly copying and so the cost of reading the file is a larger part of it).
+]]
+
+-- Settings
+--=========
+
+local sizesInMb = {}
+for i, argument in ipairs( arg or {} ) do
+	sizesInMb[i] = assert( tonumber( argument ), "The arguments must be file sizes in MB" )
+end
+if #sizesInMb == 0 then
+	sizesInMb = { 10, 25, 50, 100 }
+end
+local loadCount = 5
+
+-- Helper Functions
+--=================
+
+-- Writes an asset file that returns a table of records until the file is at least the given size
+local function GenerateAssetFile( i_path, i_sizeInBytes )
+	local file = assert( io.open( i_path, "wb" ) )
+	file:write( "return\n{\n" )
+	local writtenSize = 0
+	local recordIndex = 0
+	local lines = {}
+	while writtenSize < i_sizeInBytes do
+		-- The records are written in batches so that the string building doesn't dominate
+		for i = 1, 1000 do
+			recordIndex = recordIndex + 1
+			lines[i] = string.format(
+				"\t{ name = \"record%d\", position = { %.3f, %.3f, %.3f }, isVisible = %s, tags = { \"a%d\", \"b%d\" } },\n",
+				recordIndex, recordIndex * 0.25, recordIndex * 0.5, recordIndex * 0.75,
+				tostring( recordIndex % 2 == 0 ), recordIndex % 7, recordIndex % 11 )
+		end
+		local batch = table.concat( lines )
+		file:write( batch )
+		writtenSize = writtenSize + #batch
+	end
+	file:write( "}\n" )
+	file:close()
+	return recordIndex
+end
+
+local function WriteBinaryChunk( i_sourcePath, i_binaryPath )
+	local chunk = assert( loadfile( i_sourcePath ) )
+	local file = assert( io.open( i_binaryPath, "wb" ) )
+	file:write( string.dump( chunk, true ) )
+	file:close()
+end
+
+-- Returns the fastest and the average time in milliseconds
+local function TimeLoading( i_path )
+	local fastestTime = math.huge
+	local totalTime = 0
+	for i = 1, loadCount do
+		collectgarbage( "collect" )
+		local startTime = os.clock()
+		local chunk = loadfile( i_path )
+		local time = ( os.clock() - startTime ) * 1000
+		assert( chunk, "The generated file couldn't be loaded" )
+		chunk = nil
+		fastestTime = math.min( fastestTime, time )
+		totalTime = totalTime + time
+	end
+	return fastestTime, totalTime / loadCount
+end
+
+-- Benchmark
+--==========
+
+local basePath = os.tmpname()
+print( string.format( "%-8s %-8s %10s %14s %14s", "Size", "Chunk", "Records", "Fastest (ms)", "Average (ms)" ) )
+for _, sizeInMb in ipairs( sizesInMb ) do
+	local sourcePath = basePath .. "_" .. sizeInMb .. "MB.lua"
+	local binaryPath = basePath .. "_" .. sizeInMb .. "MB.luac"
+	local recordCount = GenerateAssetFile( sourcePath, sizeInMb * 1024 * 1024 )
+	WriteBinaryChunk( sourcePath, binaryPath )
+	for _, test in ipairs{ { "source", sourcePath }, { "binary", binaryPath } } do
+		local fastestTime, averageTime = TimeLoading( test[2] )
+		print( string.format( "%-8s %-8s %10d %14.1f %14.1f", sizeInMb .. " MB", test[1], recordCount, fastestTime, averageTime ) )
+	end
+	os.remove( sourcePath )
+	os.remove( binaryPath )
+end
+os.remove( basePath )
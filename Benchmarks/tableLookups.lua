@@ -0,0 +1,155 @@
+--[[
+	This benchmark measures scripts that spend most of their time looking up keys in the hash part of tables
+	(luaH_getshortstr(), luaH_getint(), and luaH_get() in ltable.c)
+
+	By default the hash part of a table is a chained scatter table.
+	To compare against the open-addressing layout with a separate array of control bytes
+	run the same script with a Lua that was built with LUA_USE_HASHGROUPS:
+		make -C External/Lua/5.3.4 linux
+		External/Lua/5.3.4/src/lua Benchmarks/tableLookups.lua > chained.txt
+		make -C External/Lua/5.3.4 clean
+		make -C External/Lua/5.3.4 linux MYCFLAGS=-DLUA_USE_HASHGROUPS
+		External/Lua/5.3.4/src/lua Benchmarks/tableLookups.lua > groups.txt
+	(The EmbeddingPatterns benchmarks have the same lookups from C in their "hash/" benchmarks.)
+
+	The names of the tests to run can be given on the command line (the default is all of them):
+		lua tableLookups.lua assets misses
+]]
+
+-- Settings
+--=========
+
+local runCount = 5
+
+-- Tests
+--======
+
+local tests = {}
+local testOrder = {}
+local function AddTest( i_name, i_function )
+	tests[i_name] = i_function
+	testOrder[#testOrder + 1] = i_name
+end
+
+-- Builds a table like an asset file's, with the given number of string keys
+local function NewAssetTable( i_keyCount )
+	local asset = {}
+	local keys = {}
+	for i = 1, i_keyCount do
+		local key = "property" .. i
+		asset[key] = i
+		keys[i] = key
+	end
+	return asset, keys
+end
+
+-- Reading every key of tables with a few keys (like objects with fields)
+AddTest( "fields", function()
+	local objects = {}
+	for i = 1, 1000 do
+		objects[i] = { x = i, y = -i, z = 0, width = 1, height = 2, name = "object", isVisible = true, layer = i % 4 }
+	end
+	local sum = 0
+	for pass = 1, 500 do
+		for i = 1, #objects do
+			local object = objects[i]
+			if object.isVisible then
+				sum = sum + object.x + object.y + object.z + object.width * object.height + object.layer
+			end
+		end
+	end
+	return sum
+end )
+
+-- Reading every key of a table with hundreds of string keys (like a large asset file)
+AddTest( "assets", function()
+	local asset, keys = NewAssetTable( 500 )
+	local sum = 0
+	for pass = 1, 4000 do
+		for i = 1, #keys do
+			sum = sum + asset[keys[i]]
+		end
+	end
+	return sum
+end )
+
+-- Looking up string keys that aren't in the table (like optional properties that are usually missing)
+AddTest( "misses", function()
+	local asset = NewAssetTable( 500 )
+	local missingKeys = {}
+	for i = 1, 500 do
+		missingKeys[i] = "optional" .. i
+	end
+	local missCount = 0
+	for pass = 1, 4000 do
+		for i = 1, #missingKeys do
+			if asset[missingKeys[i]] == nil then
+				missCount = missCount + 1
+			end
+		end
+	end
+	return missCount
+end )
+
+-- Integer and float keys that don't fit in the array part
+AddTest( "numbers", function()
+	local sparse = {}
+	local keys = {}
+	for i = 1, 1000 do
+		local key = i * 7919
+		sparse[key] = i
+		sparse[key + 0.5] = -i
+		keys[i] = key
+	end
+	local sum = 0
+	for pass = 1, 1000 do
+		for i = 1, #keys do
+			local key = keys[i]
+			sum = sum + sparse[key] + sparse[key + 0.5]
+		end
+	end
+	return sum
+end )
+
+-- Building tables with string keys (which includes every rehash as they grow)
+AddTest( "build", function()
+	local _, keys = NewAssetTable( 100 )
+	local keyCount = #keys
+	local count = 0
+	for pass = 1, 10000 do
+		local asset = {}
+		for i = 1, keyCount do
+			asset[keys[i]] = i
+		end
+		count = count + #keys
+	end
+	return count
+end )
+
+-- Benchmark
+--==========
+
+local testNames = {}
+for i, argument in ipairs( arg or {} ) do
+	assert( tests[argument], "\"" .. argument .. "\" isn't the name of a test" )
+	testNames[i] = argument
+end
+if #testNames == 0 then
+	testNames = testOrder
+end
+
+print( string.format( "%-8s %14s %14s", "Test", "Fastest (ms)", "Average (ms)" ) )
+for _, testName in ipairs( testNames ) do
+	local test = tests[testName]
+	local fastestTime = math.huge
+	local totalTime = 0
+	for i = 1, runCount do
+		collectgarbage( "collect" )
+		local startTime = os.clock()
+		test()
+		local time = ( os.clock() - startTime ) * 1000
+		fastestTime = math.min( fastestTime, time )
+		totalTime = totalTime + time
+	end
+	print( string.format( "%-8s %14.1f %14.1f", testName, fastestTime, totalTime / runCount ) )
+end
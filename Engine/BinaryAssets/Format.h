@@ -0,0 +1,105 @@
+/*
+	This file defines the layout of a binary asset file
+
+	A binary asset is a Lua asset table that has already been evaluated
+	and flattened into a single block of memory.
+	Every reference inside of the block is an offset from the start of the file
+	(rather than a pointer),
+	and so the file can be memory mapped and used as-is without any parsing or allocation.
+
+	The file starts with an sHeader whose root value is the asset table.
+	A table refers to an sTable,
+	which refers to an array of sValues (the values with keys 1, 2, ..., n)
+	and an array of sDictionaryEntrys (the values with string keys, sorted by key).
+	Strings are stored once each (keys and values share the same copy)
+	and are followed by a terminating NULL so that they can be used as C strings.
+
+	The layout uses the native byte order and is meant to be built for the platform that reads it.
+*/
+
+#ifndef EAE6320_BINARYASSETS_FORMAT_H
+#define EAE6320_BINARYASSETS_FORMAT_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+
+// Format Definition
+//==================
+
+namespace eae6320
+{
+	namespace BinaryAssets
+	{
+		namespace Format
+		{
+			constexpr char s_magic[4] = { 'E', 'A', 'B', 'A' };
+			// This must be incremented whenever the layout changes
+			constexpr uint32_t s_version = 1;
+			// Every struct starts at a multiple of this
+			// so that the 8 byte numbers can be read directly from the mapped memory
+			constexpr uint32_t s_alignment = 8;
+			// This is only used to reject corrupted files
+			// (the compiler uses the same limit as the other asset loaders)
+			constexpr uint32_t s_maxTableDepth = 64;
+
+			enum class eType : uint8_t
+			{
+				Nil,
+				Boolean,
+				Integer,
+				Number,
+				String,
+				Table,
+			};
+
+			struct sValue
+			{
+				eType type;
+				uint8_t padding[3];
+				// The length of a string (not including the terminating NULL)
+				uint32_t length;
+				union
+				{
+					uint64_t boolean;
+					int64_t integer;
+					double number;
+					// The offset of a string's characters or a table's sTable
+					uint32_t offset;
+				};
+			};
+			static_assert( sizeof( sValue ) == 16, "The binary asset value layout must not depend on the compiler" );
+
+			struct sTable
+			{
+				uint32_t arrayOffset;
+				uint32_t arrayLength;
+				uint32_t dictionaryOffset;
+				uint32_t dictionaryLength;
+			};
+			static_assert( sizeof( sTable ) == 16, "The binary asset table layout must not depend on the compiler" );
+
+			struct sDictionaryEntry
+			{
+				uint32_t keyOffset;
+				uint32_t keyLength;
+				sValue value;
+			};
+			static_assert( sizeof( sDictionaryEntry ) == 24, "The binary asset dictionary layout must not depend on the compiler" );
+
+			struct sHeader
+			{
+				char magic[4];
+				uint32_t version;
+				// The size of the whole file in bytes
+				uint32_t size;
+				uint32_t padding;
+				sValue root;
+			};
+			static_assert( sizeof( sHeader ) == 32, "The binary asset header layout must not depend on the compiler" );
+		}
+	}
+}
+
+#endif	// EAE6320_BINARYASSETS_FORMAT_H
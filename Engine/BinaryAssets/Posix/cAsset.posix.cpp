@@ -0,0 +1,75 @@
+// Include Files
+//==============
+
+#include "../cAsset.h"
+
+#include <cerrno>
+#include <cstring>
+#include <Engine/Results/Results.h>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::BinaryAssets::cAsset::MapFile( const char* const i_path )
+{
+	auto result = Results::Success;
+
+	const auto file = open( i_path, O_RDONLY );
+	if ( file == -1 )
+	{
+		result = ( errno == ENOENT ) ? Results::FileDoesntExist : Results::Failure;
+		std::cerr << "The binary asset " << i_path << " couldn't be opened (" << std::strerror( errno ) << ")" << std::endl;
+		return result;
+	}
+	{
+		struct stat fileInfo;
+		if ( fstat( file, &fileInfo ) != 0 )
+		{
+			result = Results::Failure;
+			std::cerr << "The size of the binary asset " << i_path << " couldn't be found (" << std::strerror( errno ) << ")" << std::endl;
+			goto OnExit;
+		}
+		// Offsets are 32 bits, and so no valid file can be bigger than this
+		// (an empty file can't be mapped, but it wouldn't be valid anyway)
+		if ( ( fileInfo.st_size <= 0 ) || ( static_cast<uint64_t>( fileInfo.st_size ) > 0xffffffff ) )
+		{
+			result = Results::InvalidFile;
+			std::cerr << "The binary asset " << i_path << " has an invalid size (" << fileInfo.st_size << " bytes)" << std::endl;
+			goto OnExit;
+		}
+		m_size = static_cast<size_t>( fileInfo.st_size );
+	}
+	{
+		constexpr void* const letTheSystemChoose = nullptr;
+		constexpr off_t fromTheStart = 0;
+		auto* const data = mmap( letTheSystemChoose, m_size, PROT_READ, MAP_PRIVATE, file, fromTheStart );
+		if ( data == MAP_FAILED )
+		{
+			result = Results::Failure;
+			std::cerr << "The binary asset " << i_path << " couldn't be mapped (" << std::strerror( errno ) << ")" << std::endl;
+			goto OnExit;
+		}
+		m_data = static_cast<const uint8_t*>( data );
+	}
+
+OnExit:
+
+	// The mapping stays valid after the file is closed
+	close( file );
+	if ( !result )
+	{
+		m_size = 0;
+	}
+
+	return result;
+}
+
+void eae6320::BinaryAssets::cAsset::UnmapFile()
+{
+	munmap( const_cast<uint8_t*>( m_data ), m_size );
+}
@@ -0,0 +1,98 @@
+// Include Files
+//==============
+
+#include "../cAsset.h"
+
+#include <Engine/Results/Results.h>
+#include <Engine/Windows/Includes.h>
+#include <iostream>
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::BinaryAssets::cAsset::MapFile( const char* const i_path )
+{
+	auto result = Results::Success;
+
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE fileMapping = NULL;
+	{
+		constexpr DWORD noSharingRestrictions = FILE_SHARE_READ;
+		constexpr LPSECURITY_ATTRIBUTES useDefaultSecurity = NULL;
+		constexpr HANDLE noTemplate = NULL;
+		file = CreateFileA( i_path, GENERIC_READ, noSharingRestrictions, useDefaultSecurity,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, noTemplate );
+		if ( file == INVALID_HANDLE_VALUE )
+		{
+			const auto errorCode = GetLastError();
+			result = ( ( errorCode == ERROR_FILE_NOT_FOUND ) || ( errorCode == ERROR_PATH_NOT_FOUND ) )
+				? Results::FileDoesntExist : Results::Failure;
+			std::cerr << "The binary asset " << i_path << " couldn't be opened (error " << errorCode << ")" << std::endl;
+			goto OnExit;
+		}
+	}
+	{
+		LARGE_INTEGER fileSize;
+		if ( GetFileSizeEx( file, &fileSize ) == FALSE )
+		{
+			result = Results::Failure;
+			std::cerr << "The size of the binary asset " << i_path << " couldn't be found (error " << GetLastError() << ")" << std::endl;
+			goto OnExit;
+		}
+		// Offsets are 32 bits, and so no valid file can be bigger than this
+		// (an empty file can't be mapped, but it wouldn't be valid anyway)
+		if ( ( fileSize.QuadPart <= 0 ) || ( fileSize.QuadPart > 0xffffffff ) )
+		{
+			result = Results::InvalidFile;
+			std::cerr << "The binary asset " << i_path << " has an invalid size (" << fileSize.QuadPart << " bytes)" << std::endl;
+			goto OnExit;
+		}
+		m_size = static_cast<size_t>( fileSize.QuadPart );
+	}
+	{
+		constexpr LPSECURITY_ATTRIBUTES useDefaultSecurity = NULL;
+		constexpr DWORD mapTheWholeFile = 0;
+		constexpr LPCSTR noName = NULL;
+		fileMapping = CreateFileMappingA( file, useDefaultSecurity, PAGE_READONLY, mapTheWholeFile, mapTheWholeFile, noName );
+		if ( fileMapping == NULL )
+		{
+			result = Results::Failure;
+			std::cerr << "The binary asset " << i_path << " couldn't be mapped (error " << GetLastError() << ")" << std::endl;
+			goto OnExit;
+		}
+	}
+	{
+		constexpr DWORD fromTheStart = 0;
+		constexpr SIZE_T mapTheWholeFile = 0;
+		m_data = static_cast<const uint8_t*>( MapViewOfFile( fileMapping, FILE_MAP_READ, fromTheStart, fromTheStart, mapTheWholeFile ) );
+		if ( !m_data )
+		{
+			result = Results::Failure;
+			std::cerr << "A view of the binary asset " << i_path << " couldn't be mapped (error " << GetLastError() << ")" << std::endl;
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	// The view keeps the file mapping (and the file) open for as long as it exists
+	if ( fileMapping != NULL )
+	{
+		CloseHandle( fileMapping );
+	}
+	if ( file != INVALID_HANDLE_VALUE )
+	{
+		CloseHandle( file );
+	}
+	if ( !result )
+	{
+		m_size = 0;
+	}
+
+	return result;
+}
+
+void eae6320::BinaryAssets::cAsset::UnmapFile()
+{
+	UnmapViewOfFile( m_data );
+}
@@ -0,0 +1,205 @@
+// Include Files
+//==============
+
+#include "cAsset.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Results/Results.h>
+#include <iostream>
+#include <unordered_map>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	struct sValidation
+	{
+		const uint8_t* data;
+		size_t fileSize;
+		// Each table is only checked once
+		// (a corrupted file could otherwise refer to the same table from many places
+		// and make checking it take exponential time).
+		// A table's offset maps to whether it has been checked completely,
+		// and so a table that is reached again while it is still being checked is a cycle.
+		std::unordered_map<uint32_t, bool> tables;
+	};
+
+	// Checks that a range of the file is in bounds and aligned
+	bool IsRangeValid( const size_t i_fileSize, const uint32_t i_offset, const uint64_t i_size, const uint32_t i_alignment );
+	bool IsStringValid( const uint8_t* const i_data, const size_t i_fileSize, const uint32_t i_offset, const uint32_t i_length );
+	// Compares keys the same way that the compiler sorted them
+	// (by their bytes, with a shorter key first if one key is a prefix of the other)
+	bool IsKeyLess( const uint8_t* const i_data,
+		const eae6320::BinaryAssets::Format::sDictionaryEntry& i_a, const eae6320::BinaryAssets::Format::sDictionaryEntry& i_b );
+	bool IsValueValid( sValidation& io_validation, const eae6320::BinaryAssets::Format::sValue& i_value, const uint32_t i_depth );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+eae6320::BinaryAssets::cValue eae6320::BinaryAssets::cAsset::GetRoot() const
+{
+	if ( m_data )
+	{
+		return cValue( m_data, &reinterpret_cast<const Format::sHeader*>( m_data )->root );
+	}
+	return cValue();
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::BinaryAssets::cAsset::Load( const char* const i_path )
+{
+	auto result = Results::Success;
+
+	Unload();
+	if ( !( result = MapFile( i_path ) ) )
+	{
+		return result;
+	}
+	// The file is checked once here so that reading values never has to check anything
+	if ( !( result = Validate() ) )
+	{
+		std::cerr << "The binary asset " << i_path << " is invalid" << std::endl;
+		Unload();
+		return result;
+	}
+
+	return result;
+}
+
+void eae6320::BinaryAssets::cAsset::Unload()
+{
+	if ( m_data )
+	{
+		UnmapFile();
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
+
+eae6320::BinaryAssets::cAsset::~cAsset()
+{
+	Unload();
+}
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::BinaryAssets::cAsset::Validate() const
+{
+	if ( m_size < sizeof( Format::sHeader ) )
+	{
+		return Results::InvalidFile;
+	}
+	const auto& header = *reinterpret_cast<const Format::sHeader*>( m_data );
+	if ( ( std::memcmp( header.magic, Format::s_magic, sizeof( Format::s_magic ) ) != 0 )
+		|| ( header.version != Format::s_version ) || ( header.size != m_size ) )
+	{
+		return Results::InvalidFile;
+	}
+	sValidation validation;
+	{
+		validation.data = m_data;
+		validation.fileSize = m_size;
+	}
+	return IsValueValid( validation, header.root, 0 ) ? Results::Success : Results::InvalidFile;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool IsRangeValid( const size_t i_fileSize, const uint32_t i_offset, const uint64_t i_size, const uint32_t i_alignment )
+	{
+		return ( ( i_offset % i_alignment ) == 0 ) && ( ( static_cast<uint64_t>( i_offset ) + i_size ) <= i_fileSize );
+	}
+
+	bool IsStringValid( const uint8_t* const i_data, const size_t i_fileSize, const uint32_t i_offset, const uint32_t i_length )
+	{
+		// The terminating NULL must be in the file too
+		return IsRangeValid( i_fileSize, i_offset, static_cast<uint64_t>( i_length ) + 1, 1 ) && ( i_data[i_offset + i_length] == '\0' );
+	}
+
+	bool IsKeyLess( const uint8_t* const i_data,
+		const eae6320::BinaryAssets::Format::sDictionaryEntry& i_a, const eae6320::BinaryAssets::Format::sDictionaryEntry& i_b )
+	{
+		const auto comparison = std::memcmp( i_data + i_a.keyOffset, i_data + i_b.keyOffset, std::min( i_a.keyLength, i_b.keyLength ) );
+		return ( comparison < 0 ) || ( ( comparison == 0 ) && ( i_a.keyLength < i_b.keyLength ) );
+	}
+
+	bool IsValueValid( sValidation& io_validation, const eae6320::BinaryAssets::Format::sValue& i_value, const uint32_t i_depth )
+	{
+		namespace Format = eae6320::BinaryAssets::Format;
+
+		const auto* const data = io_validation.data;
+		const auto fileSize = io_validation.fileSize;
+		switch ( i_value.type )
+		{
+		case Format::eType::Nil:
+		case Format::eType::Boolean:
+		case Format::eType::Integer:
+		case Format::eType::Number:
+			return true;
+		case Format::eType::String:
+			return IsStringValid( data, fileSize, i_value.offset, i_value.length );
+		case Format::eType::Table:
+			{
+				{
+					const auto table = io_validation.tables.find( i_value.offset );
+					if ( table != io_validation.tables.end() )
+					{
+						// A table that is still being checked contains itself
+						return table->second;
+					}
+				}
+				// The depth limit keeps a corrupted file from recursing too deeply
+				if ( ( i_depth >= Format::s_maxTableDepth )
+					|| !IsRangeValid( fileSize, i_value.offset, sizeof( Format::sTable ), Format::s_alignment ) )
+				{
+					return false;
+				}
+				io_validation.tables.emplace( i_value.offset, false );
+				const auto& table = *reinterpret_cast<const Format::sTable*>( data + i_value.offset );
+				if ( !IsRangeValid( fileSize, table.arrayOffset,
+						static_cast<uint64_t>( table.arrayLength ) * sizeof( Format::sValue ), Format::s_alignment )
+					|| !IsRangeValid( fileSize, table.dictionaryOffset,
+						static_cast<uint64_t>( table.dictionaryLength ) * sizeof( Format::sDictionaryEntry ), Format::s_alignment ) )
+				{
+					return false;
+				}
+				const auto* const values = reinterpret_cast<const Format::sValue*>( data + table.arrayOffset );
+				for ( uint32_t i = 0; i < table.arrayLength; ++i )
+				{
+					if ( !IsValueValid( io_validation, values[i], i_depth + 1 ) )
+					{
+						return false;
+					}
+				}
+				const auto* const entries = reinterpret_cast<const Format::sDictionaryEntry*>( data + table.dictionaryOffset );
+				for ( uint32_t i = 0; i < table.dictionaryLength; ++i )
+				{
+					if ( !IsStringValid( data, fileSize, entries[i].keyOffset, entries[i].keyLength )
+						// cValue::Find() does a binary search,
+						// and so the keys must be in order (and each key can only be in a table once)
+						|| ( ( i > 0 ) && !IsKeyLess( data, entries[i - 1], entries[i] ) )
+						|| !IsValueValid( io_validation, entries[i].value, i_depth + 1 ) )
+					{
+						return false;
+					}
+				}
+				io_validation.tables[i_value.offset] = true;
+			}
+			return true;
+		default:
+			return false;
+		}
+	}
+}
@@ -0,0 +1,79 @@
+/*
+	An asset is a binary asset file that has been memory mapped
+
+	Binary asset files are made from Lua asset files by the BinaryAssetCompiler tool.
+	Loading one maps the file into memory and checks that every offset in it is valid;
+	after that the values are read directly from the mapped memory,
+	and so no Lua state (or any other allocation) is needed to use the asset.
+*/
+
+#ifndef EAE6320_BINARYASSETS_CASSET_H
+#define EAE6320_BINARYASSETS_CASSET_H
+
+// Include Files
+//==============
+
+#include "cValue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/cResult.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace BinaryAssets
+	{
+		class cAsset
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Access
+			//-------
+
+			// The root value is the table that the Lua asset file returned
+			// (it is nil if no asset is loaded)
+			cValue GetRoot() const;
+			size_t GetSize() const { return m_size; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// Any previously loaded asset is unloaded first
+			cResult Load( const char* const i_path );
+			void Unload();
+
+			cAsset() = default;
+			~cAsset();
+
+			cAsset( const cAsset& ) = delete;
+			cAsset& operator =( const cAsset& ) = delete;
+
+			// Implementation
+			//===============
+
+		private:
+
+			cResult Validate() const;
+
+			// These are implemented in the platform-specific files
+			cResult MapFile( const char* const i_path );
+			void UnmapFile();
+
+			// Data
+			//=====
+
+		private:
+
+			const uint8_t* m_data = nullptr;
+			size_t m_size = 0;
+		};
+	}
+}
+
+#endif	// EAE6320_BINARYASSETS_CASSET_H
@@ -0,0 +1,177 @@
+// Include Files
+//==============
+
+#include "cValue.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every nil value points to this so that the accessors never have to check for NULL
+	// (the type of a zero-initialized value is nil)
+	const eae6320::BinaryAssets::Format::sValue s_nilValue{};
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+bool eae6320::BinaryAssets::cValue::GetBoolean() const
+{
+	return ( m_value->type == eType::Boolean ) && ( m_value->boolean != 0 );
+}
+
+int64_t eae6320::BinaryAssets::cValue::GetInteger() const
+{
+	return ( m_value->type == eType::Integer ) ? m_value->integer : 0;
+}
+
+double eae6320::BinaryAssets::cValue::GetNumber() const
+{
+	switch ( m_value->type )
+	{
+	case eType::Number:
+		return m_value->number;
+	case eType::Integer:
+		return static_cast<double>( m_value->integer );
+	default:
+		return 0.0;
+	}
+}
+
+const char* eae6320::BinaryAssets::cValue::GetString( size_t* const o_length ) const
+{
+	if ( m_value->type == eType::String )
+	{
+		if ( o_length )
+		{
+			*o_length = m_value->length;
+		}
+		return reinterpret_cast<const char*>( m_data + m_value->offset );
+	}
+	else
+	{
+		if ( o_length )
+		{
+			*o_length = 0;
+		}
+		return "";
+	}
+}
+
+// Tables
+//-------
+
+size_t eae6320::BinaryAssets::cValue::GetArrayLength() const
+{
+	const auto* const table = GetTable();
+	return table ? table->arrayLength : 0;
+}
+
+eae6320::BinaryAssets::cValue eae6320::BinaryAssets::cValue::GetArrayValue( const size_t i_index ) const
+{
+	const auto* const table = GetTable();
+	if ( table && ( i_index < table->arrayLength ) )
+	{
+		const auto* const values = reinterpret_cast<const Format::sValue*>( m_data + table->arrayOffset );
+		return cValue( m_data, values + i_index );
+	}
+	return cValue();
+}
+
+size_t eae6320::BinaryAssets::cValue::GetDictionaryLength() const
+{
+	const auto* const table = GetTable();
+	return table ? table->dictionaryLength : 0;
+}
+
+const char* eae6320::BinaryAssets::cValue::GetDictionaryKey( const size_t i_index, size_t* const o_length ) const
+{
+	const auto* const table = GetTable();
+	if ( table && ( i_index < table->dictionaryLength ) )
+	{
+		const auto& entry = reinterpret_cast<const Format::sDictionaryEntry*>( m_data + table->dictionaryOffset )[i_index];
+		if ( o_length )
+		{
+			*o_length = entry.keyLength;
+		}
+		return reinterpret_cast<const char*>( m_data + entry.keyOffset );
+	}
+	if ( o_length )
+	{
+		*o_length = 0;
+	}
+	return "";
+}
+
+eae6320::BinaryAssets::cValue eae6320::BinaryAssets::cValue::GetDictionaryValue( const size_t i_index ) const
+{
+	const auto* const table = GetTable();
+	if ( table && ( i_index < table->dictionaryLength ) )
+	{
+		const auto& entry = reinterpret_cast<const Format::sDictionaryEntry*>( m_data + table->dictionaryOffset )[i_index];
+		return cValue( m_data, &entry.value );
+	}
+	return cValue();
+}
+
+eae6320::BinaryAssets::cValue eae6320::BinaryAssets::cValue::Find( const char* const i_key ) const
+{
+	return Find( i_key, std::strlen( i_key ) );
+}
+
+eae6320::BinaryAssets::cValue eae6320::BinaryAssets::cValue::Find( const char* const i_key, const size_t i_keyLength ) const
+{
+	const auto* const table = GetTable();
+	if ( table )
+	{
+		// The entries are sorted the same way that the compiler sorted them:
+		// by the bytes of the key, with a shorter key first if one key is a prefix of the other
+		const auto* const entries = reinterpret_cast<const Format::sDictionaryEntry*>( m_data + table->dictionaryOffset );
+		const auto* const entriesEnd = entries + table->dictionaryLength;
+		const auto* const data = m_data;
+		const auto* const entry = std::lower_bound( entries, entriesEnd, i_keyLength,
+			[data, i_key]( const Format::sDictionaryEntry& i_entry, const size_t i_length )
+			{
+				const auto comparison = std::memcmp( data + i_entry.keyOffset, i_key, std::min<size_t>( i_entry.keyLength, i_length ) );
+				return ( comparison < 0 ) || ( ( comparison == 0 ) && ( i_entry.keyLength < i_length ) );
+			} );
+		if ( ( entry != entriesEnd ) && ( entry->keyLength == i_keyLength )
+			&& ( std::memcmp( m_data + entry->keyOffset, i_key, i_keyLength ) == 0 ) )
+		{
+			return cValue( m_data, &entry->value );
+		}
+	}
+	return cValue();
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::BinaryAssets::cValue::cValue()
+	:
+	m_data( nullptr ), m_value( &s_nilValue )
+{
+
+}
+
+// Implementation
+//===============
+
+eae6320::BinaryAssets::cValue::cValue( const uint8_t* const i_data, const Format::sValue* const i_value )
+	:
+	m_data( i_data ), m_value( i_value )
+{
+
+}
+
+const eae6320::BinaryAssets::Format::sTable* eae6320::BinaryAssets::cValue::GetTable() const
+{
+	return ( m_value->type == eType::Table ) ? reinterpret_cast<const Format::sTable*>( m_data + m_value->offset ) : nullptr;
+}
@@ -0,0 +1,96 @@
+/*
+	A value is a read-only view of a value in a binary asset
+
+	A value is just two pointers into the asset's memory,
+	and so it is cheap to copy and pass around,
+	but it is only valid for as long as the cAsset that it came from is loaded.
+*/
+
+#ifndef EAE6320_BINARYASSETS_CVALUE_H
+#define EAE6320_BINARYASSETS_CVALUE_H
+
+// Include Files
+//==============
+
+#include "Format.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace BinaryAssets
+	{
+		class cValue
+		{
+			// Interface
+			//==========
+
+		public:
+
+			using eType = Format::eType;
+
+			// Access
+			//-------
+
+			eType GetType() const { return m_value->type; }
+			bool IsNil() const { return m_value->type == eType::Nil; }
+
+			// Each of these returns a default value if the value is a different type
+			// (a number can be read from an integer, though)
+			bool GetBoolean() const;
+			int64_t GetInteger() const;
+			double GetNumber() const;
+			// The returned string is NULL-terminated;
+			// if the length is needed it can be returned without calling strlen()
+			const char* GetString( size_t* const o_length = nullptr ) const;
+
+			// Tables
+			//-------
+
+			// The array part of a table is indexed from 0
+			// (i.e. the value that had the key 1 in Lua has the index 0 here)
+			size_t GetArrayLength() const;
+			cValue GetArrayValue( const size_t i_index ) const;
+			// The dictionary part of a table is sorted by key
+			size_t GetDictionaryLength() const;
+			const char* GetDictionaryKey( const size_t i_index, size_t* const o_length = nullptr ) const;
+			cValue GetDictionaryValue( const size_t i_index ) const;
+			// Returns a nil value if the value isn't a table or if the key doesn't exist
+			// (this is a binary search, and so it doesn't need to hash the key)
+			cValue Find( const char* const i_key ) const;
+			cValue Find( const char* const i_key, const size_t i_keyLength ) const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// A default-constructed value is nil
+			cValue();
+
+			// Implementation
+			//===============
+
+		private:
+
+			friend class cAsset;
+
+			cValue( const uint8_t* const i_data, const Format::sValue* const i_value );
+
+			const Format::sTable* GetTable() const;
+
+			// Data
+			//=====
+
+		private:
+
+			// The start of the asset's memory (which all offsets are relative to)
+			const uint8_t* m_data;
+			const Format::sValue* m_value;
+		};
+	}
+}
+
+#endif	// EAE6320_BINARYASSETS_CVALUE_H
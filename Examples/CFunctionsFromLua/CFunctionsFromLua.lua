@@ -89,3 +89,90 @@ do
 		end
 	end
 end
+
+-- ExampleStatsWithBinding
+do
+	-- This function does the same thing as ExampleStats(),
+	-- but the C++ function doesn't use the Lua API at all
+	-- (the code that reads the arguments and pushes the return values is generated by a binding):
+	local sum, product, average = ExampleStatsWithBinding( 1.2, 3.4, 5.6, 7.8 )
+	print( "ExampleStatsWithBinding() returns:\n"
+		.. "\tsum = " .. sum .. ", product = " .. product .. ", average = " .. average )
+	-- The binding checks the type of every argument:
+	local result, errorMessage = pcall( ExampleStatsWithBinding, 1.2, 3.4, "not a number", 7.8 )
+	if not result then
+		print( errorMessage )
+	end
+
+	-- The binding should be just as fast as writing the lua_CFunction by hand
+	local callCount = 1000000
+	local function TimeCalls( i_function )
+		local startTime = os.clock()
+		for i = 1, callCount do
+			i_function( i, 3.4, 5.6, 7.8 )
+		end
+		return ( os.clock() - startTime ) * 1e9 / callCount
+	end
+	-- The functions are each timed twice so that neither one is always first
+	local time_handWritten = TimeCalls( ExampleStats )
+	local time_binding = TimeCalls( ExampleStatsWithBinding )
+	time_handWritten = math.min( time_handWritten, TimeCalls( ExampleStats ) )
+	time_binding = math.min( time_binding, TimeCalls( ExampleStatsWithBinding ) )
+	print( string.format( "Calling ExampleStats() %d times: %.1f ns per call (hand-written), %.1f ns per call (binding)",
+		callCount, time_handWritten, time_binding ) )
+end
+
+-- numericarray
+do
+	-- ExampleStats() only works with four numbers,
+	-- but a numeric array stores any number of them contiguously in C
+	-- and its operations don't have to read each one out of a table:
+	local values = {}
+	for i = 1, 10000 do
+		values[i] = i % 100 + 0.5
+	end
+	local array = numericarray.fromtable( values )
+	print( "A numeric array of " .. #array .. " " .. array:type() .. " values (using "
+		.. numericarray.instructionset() .. "):\n"
+		.. "\tsum = " .. array:sum() .. ", mean = " .. array:mean()
+		.. ", min = " .. array:min() .. ", max = " .. array:max() )
+	-- Elements are indexed like a table's
+	array[1] = 100
+	print( "\tarray[1] = " .. array[1] .. ", array:totable()[2] = " .. array:totable()[2] )
+	-- Arrays of the same type and count can be combined
+	local integers = numericarray.fromtable( { 1, 2, 3, 4 }, "int32" )
+	local otherIntegers = numericarray.new( "int32", 4 )
+	otherIntegers:axpy( 10, integers ):add( integers )
+	print( "\t{ 1, 2, 3, 4 } dot { 11, 22, 33, 44 } = " .. integers:dot( otherIntegers ) )
+	local result, errorMessage = pcall( function() return integers:add( array ) end )
+	if not result then
+		print( errorMessage )
+	end
+
+	-- Compare summing the table in Lua with summing the array
+	-- using each instruction set that the CPU supports
+	local repetitionCount = 1000
+	local function TimeRepetitions( i_function )
+		local startTime = os.clock()
+		for i = 1, repetitionCount do
+			i_function()
+		end
+		return ( os.clock() - startTime ) * 1e6 / repetitionCount
+	end
+	local time_table = TimeRepetitions( function()
+			local sum = 0
+			for i = 1, #values do
+				sum = sum + values[i]
+			end
+			return sum
+		end )
+	print( string.format( "Summing %d numbers: %.1f microseconds (Lua table)", #values, time_table ) )
+	local instructionSet_fastest = numericarray.instructionset()
+	for _, instructionSet in ipairs{ "scalar", "SSE2", "AVX2" } do
+		if numericarray.setinstructionset( instructionSet ) then
+			local time_array = TimeRepetitions( function() return array:sum() end )
+			print( string.format( "\t%.2f microseconds (%s array)", time_array, instructionSet ) )
+		end
+	end
+	numericarray.setinstructionset( instructionSet_fastest )
+end
@@ -5,10 +5,14 @@
 // Include Files
 //==============
 
+#include "LuaBinding.h"
+#include "NumericArray.h"
+
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
 #include <External/Lua/Includes.h>
 #include <iostream>
+#include <tuple>
 
 // Helper Function Declarations
 //=============================
@@ -29,6 +33,10 @@ namespace
 	int ExampleStats( lua_State* io_luaState );
 	int ExampleError( lua_State* io_luaState );
 	int ExampleErrorChecking( lua_State* io_luaState );
+
+	// This is an ordinary C++ function that doesn't know anything about Lua;
+	// a binding generates the lua_CFunction that reads its arguments and pushes its return values
+	std::tuple<double, double, double> Stats( const double i_value1, const double i_value2, const double i_value3, const double i_value4 );
 }
 
 // Entry Point
@@ -62,6 +70,15 @@ int main( int i_argumentCount, char** i_arguments )
 		lua_register( luaState, "ExampleStats", ExampleStats );
 		lua_register( luaState, "ExampleError", ExampleError );
 		lua_register( luaState, "ExampleErrorChecking", ExampleErrorChecking );
+		// A binding can be registered the same way as any other lua_CFunction
+		lua_register( luaState, "ExampleStatsWithBinding", EAE6320_LUABINDING_FUNCTION( Stats ) );
+	}
+	// A library of C/C++ functions can be opened the same way as the standard libraries
+	// (this sets the table of functions as a global variable using the name provided)
+	{
+		constexpr int shouldSetGlobal = 1;
+		luaL_requiref( luaState, "numericarray", eae6320::NumericArray::Open, shouldSetGlobal );
+		lua_pop( luaState, 1 );
 	}
 
 	// Load and run the Lua script that calls the functions
@@ -231,4 +248,14 @@ namespace
 		constexpr int returnValueCount = 0;
 		return returnValueCount;
 	}
+
+	std::tuple<double, double, double> Stats( const double i_value1, const double i_value2, const double i_value3, const double i_value4 )
+	{
+		// This does the same thing as ExampleStats(),
+		// but the multiple return values are returned as a tuple
+		const auto sum = i_value1 + i_value2 + i_value3 + i_value4;
+		const auto product = i_value1 * i_value2 * i_value3 * i_value4;
+		const auto average = sum / 4.0;
+		return std::make_tuple( sum, product, average );
+	}
 }
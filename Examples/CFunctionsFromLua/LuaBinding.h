@@ -0,0 +1,89 @@
+/*
+	A Lua binding turns an ordinary C++ function into a lua_CFunction
+	so that the code to read the arguments and push the return values doesn't have to be written by hand
+
+	For example, given:
+		std::tuple<double, double, double> Stats( double, double, double, double );
+	the function can be registered with:
+		lua_register( luaState, "Stats", EAE6320_LUABINDING_FUNCTION( Stats ) );
+	and then called from Lua like any other function:
+		local sum, product, average = Stats( 1, 2, 3, 4 )
+
+	The lua_CFunction is a template instantiated with the function's address,
+	and so the call is a direct call (not through a pointer or a std::function)
+	that the compiler can inline.
+	Every argument is checked with the luaL_check*() functions,
+	which raise a Lua error with the usual "bad argument" message if the type is wrong.
+
+	Supported argument types are bool, integers, floating point numbers, and const char*.
+	Supported return types are void, those same types, std::string,
+	and std::tuple (or std::pair) of them for multiple return values.
+	(std::string isn't allowed as an argument type because it would allocate on every call;
+	use const char* instead.)
+*/
+
+#ifndef EAE6320_CFUNCTIONSFROMLUA_LUABINDING_H
+#define EAE6320_CFUNCTIONSFROMLUA_LUABINDING_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <External/Lua/Includes.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Interface
+//==========
+
+// This is the lua_CFunction that calls the given (non-member) function
+#define EAE6320_LUABINDING_FUNCTION( i_function )	\
+	( &eae6320::LuaBinding::sFunction<decltype( &i_function ), &i_function>::Call )
+
+namespace eae6320
+{
+	namespace LuaBinding
+	{
+		// Each of these checks and returns the argument at the given index of the stack
+		template <class tArgument, class tEnable = void>
+		struct sArgument;
+
+		// Each of these pushes a return value and returns how many values were pushed
+		// (a tuple pushes each of its elements)
+		int PushReturnValue( lua_State& io_luaState, const bool i_value );
+		int PushReturnValue( lua_State& io_luaState, const char* const i_value );
+		int PushReturnValue( lua_State& io_luaState, const std::string& i_value );
+		template <class tValue>
+		typename std::enable_if<std::is_integral<tValue>::value, int>::type
+			PushReturnValue( lua_State& io_luaState, const tValue i_value );
+		template <class tValue>
+		typename std::enable_if<std::is_floating_point<tValue>::value, int>::type
+			PushReturnValue( lua_State& io_luaState, const tValue i_value );
+		template <class... tValues>
+		int PushReturnValue( lua_State& io_luaState, const std::tuple<tValues...>& i_values );
+		template <class tFirst, class tSecond>
+		int PushReturnValue( lua_State& io_luaState, const std::pair<tFirst, tSecond>& i_values );
+
+		// This is what EAE6320_LUABINDING_FUNCTION() uses
+		template <class tFunction, tFunction tFunctionPointer>
+		struct sFunction;
+		template <class tReturn, class... tArguments, tReturn ( *tFunctionPointer )( tArguments... )>
+		struct sFunction<tReturn ( * )( tArguments... ), tFunctionPointer>
+		{
+			static int Call( lua_State* io_luaState );
+
+		private:
+
+			template <size_t... tIndices>
+			static int Call( lua_State& io_luaState, std::index_sequence<tIndices...>, std::false_type i_isVoid );
+			template <size_t... tIndices>
+			static int Call( lua_State& io_luaState, std::index_sequence<tIndices...>, std::true_type i_isVoid );
+		};
+	}
+}
+
+#include "LuaBinding.inl"
+
+#endif	// EAE6320_CFUNCTIONSFROMLUA_LUABINDING_H
@@ -0,0 +1,167 @@
+#ifndef EAE6320_CFUNCTIONSFROMLUA_LUABINDING_INL
+#define EAE6320_CFUNCTIONSFROMLUA_LUABINDING_INL
+
+// Include Files
+//==============
+
+#include "LuaBinding.h"
+
+// Arguments
+//==========
+
+namespace eae6320
+{
+	namespace LuaBinding
+	{
+		template <>
+		struct sArgument<bool>
+		{
+			static bool Check( lua_State& io_luaState, const int i_index )
+			{
+				// Only an actual boolean is accepted
+				// (rather than treating every value other than nil and false as true)
+				luaL_checktype( &io_luaState, i_index, LUA_TBOOLEAN );
+				return lua_toboolean( &io_luaState, i_index ) != 0;
+			}
+		};
+
+		template <class tArgument>
+		struct sArgument<tArgument, typename std::enable_if<std::is_integral<tArgument>::value>::type>
+		{
+			static tArgument Check( lua_State& io_luaState, const int i_index )
+			{
+				// A float is only accepted if it has an exact integer value
+				return static_cast<tArgument>( luaL_checkinteger( &io_luaState, i_index ) );
+			}
+		};
+
+		template <class tArgument>
+		struct sArgument<tArgument, typename std::enable_if<std::is_floating_point<tArgument>::value>::type>
+		{
+			static tArgument Check( lua_State& io_luaState, const int i_index )
+			{
+				return static_cast<tArgument>( luaL_checknumber( &io_luaState, i_index ) );
+			}
+		};
+
+		template <>
+		struct sArgument<const char*>
+		{
+			static const char* Check( lua_State& io_luaState, const int i_index )
+			{
+				// The string belongs to Lua, but it stays valid until the function returns
+				// because it is on the stack
+				return luaL_checkstring( &io_luaState, i_index );
+			}
+		};
+	}
+}
+
+// Return Values
+//==============
+
+inline int eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const bool i_value )
+{
+	lua_pushboolean( &io_luaState, i_value ? 1 : 0 );
+	return 1;
+}
+
+inline int eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const char* const i_value )
+{
+	lua_pushstring( &io_luaState, i_value );
+	return 1;
+}
+
+inline int eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const std::string& i_value )
+{
+	lua_pushlstring( &io_luaState, i_value.data(), i_value.size() );
+	return 1;
+}
+
+template <class tValue>
+typename std::enable_if<std::is_integral<tValue>::value, int>::type
+	eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const tValue i_value )
+{
+	lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_value ) );
+	return 1;
+}
+
+template <class tValue>
+typename std::enable_if<std::is_floating_point<tValue>::value, int>::type
+	eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const tValue i_value )
+{
+	lua_pushnumber( &io_luaState, static_cast<lua_Number>( i_value ) );
+	return 1;
+}
+
+namespace eae6320
+{
+	namespace LuaBinding
+	{
+		namespace Implementation
+		{
+			template <class tTuple, size_t... tIndices>
+			int PushTupleElements( lua_State& io_luaState, const tTuple& i_values, std::index_sequence<tIndices...> )
+			{
+				// The elements of an initializer list are evaluated in order,
+				// and so the values are pushed in order
+				// (the extra 0 is so that an empty tuple doesn't make an empty array)
+				const int pushedCounts[] = { 0, PushReturnValue( io_luaState, std::get<tIndices>( i_values ) )... };
+				int returnValueCount = 0;
+				for ( const auto pushedCount : pushedCounts )
+				{
+					returnValueCount += pushedCount;
+				}
+				return returnValueCount;
+			}
+		}
+	}
+}
+
+template <class... tValues>
+int eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const std::tuple<tValues...>& i_values )
+{
+	return Implementation::PushTupleElements( io_luaState, i_values, std::index_sequence_for<tValues...>() );
+}
+
+template <class tFirst, class tSecond>
+int eae6320::LuaBinding::PushReturnValue( lua_State& io_luaState, const std::pair<tFirst, tSecond>& i_values )
+{
+	return PushReturnValue( io_luaState, i_values.first ) + PushReturnValue( io_luaState, i_values.second );
+}
+
+// Functions
+//==========
+
+template <class tReturn, class... tArguments, tReturn ( *tFunctionPointer )( tArguments... )>
+int eae6320::LuaBinding::sFunction<tReturn ( * )( tArguments... ), tFunctionPointer>::Call( lua_State* io_luaState )
+{
+	return Call( *io_luaState, std::index_sequence_for<tArguments...>(), typename std::is_void<tReturn>::type() );
+}
+
+template <class tReturn, class... tArguments, tReturn ( *tFunctionPointer )( tArguments... )>
+template <size_t... tIndices>
+int eae6320::LuaBinding::sFunction<tReturn ( * )( tArguments... ), tFunctionPointer>::Call(
+	lua_State& io_luaState, std::index_sequence<tIndices...>, std::false_type )
+{
+	// The arguments are checked in a braced initializer (rather than directly in the function call)
+	// so that they are checked in order and an error is always reported for the first bad argument.
+	// Every supported argument type is trivially copyable, and so the tuple costs nothing.
+	const std::tuple<typename std::decay<tArguments>::type...> arguments{
+		sArgument<typename std::decay<tArguments>::type>::Check( io_luaState, static_cast<int>( tIndices + 1 ) )... };
+	return PushReturnValue( io_luaState, tFunctionPointer( std::get<tIndices>( arguments )... ) );
+}
+
+template <class tReturn, class... tArguments, tReturn ( *tFunctionPointer )( tArguments... )>
+template <size_t... tIndices>
+int eae6320::LuaBinding::sFunction<tReturn ( * )( tArguments... ), tFunctionPointer>::Call(
+	lua_State& io_luaState, std::index_sequence<tIndices...>, std::true_type )
+{
+	const std::tuple<typename std::decay<tArguments>::type...> arguments{
+		sArgument<typename std::decay<tArguments>::type>::Check( io_luaState, static_cast<int>( tIndices + 1 ) )... };
+	tFunctionPointer( std::get<tIndices>( arguments )... );
+	constexpr int returnValueCount = 0;
+	return returnValueCount;
+}
+
+#endif	// EAE6320_CFUNCTIONSFROMLUA_LUABINDING_INL
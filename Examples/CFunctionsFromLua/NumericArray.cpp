@@ -0,0 +1,597 @@
+// Include Files
+//==============
+
+#include "NumericArray.h"
+
+#include "NumericArrayKernels.h"
+
+#include <climits>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	// The elements of an array are stored right after this header in the same userdata
+	struct sHeader
+	{
+		size_t count;
+		eae6320::NumericArray::eType type;
+	};
+	// (this keeps the elements aligned)
+	constexpr size_t s_headerSize = ( ( sizeof( sHeader ) + sizeof( double ) - 1 ) / sizeof( double ) ) * sizeof( double );
+}
+
+// Static Data
+//============
+
+namespace
+{
+	constexpr auto* const s_metatableName = "numericarray";
+	const char* const s_typeNames[] = { "float64", "float32", "int32", nullptr };
+
+	// This is how many values are pushed on the stack at once when a table is read
+	constexpr int s_tableBatchSize = 32;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Library functions
+	int New( lua_State* io_luaState );
+	int FromTable( lua_State* io_luaState );
+	int GetInstructionSet( lua_State* io_luaState );
+	int ChooseInstructionSet( lua_State* io_luaState );
+
+	// Metamethods
+	int Index( lua_State* io_luaState );
+	int NewIndex( lua_State* io_luaState );
+	int Length( lua_State* io_luaState );
+	int ToString( lua_State* io_luaState );
+
+	// Methods
+	int Type( lua_State* io_luaState );
+	int ToTable( lua_State* io_luaState );
+	int Sum( lua_State* io_luaState );
+	int Product( lua_State* io_luaState );
+	int Mean( lua_State* io_luaState );
+	int Min( lua_State* io_luaState );
+	int Max( lua_State* io_luaState );
+	int Dot( lua_State* io_luaState );
+	int Axpy( lua_State* io_luaState );
+	int Add( lua_State* io_luaState );
+	int Mul( lua_State* io_luaState );
+
+	sHeader& CheckArray( lua_State& io_luaState, const int i_index );
+	// Checks that the array at the index has the same type and count as io_array
+	sHeader& CheckMatchingArray( lua_State& io_luaState, const int i_index, const sHeader& i_array );
+	sHeader& PushArray( lua_State& io_luaState, const eae6320::NumericArray::eType i_type, const lua_Integer i_count );
+	void* GetElements( sHeader& io_array );
+	size_t GetElementSize( const eae6320::NumericArray::eType i_type );
+	// Calls i_function with a pointer to the array's elements (double*, float*, or int32_t*)
+	template <class tFunction>
+	int VisitElements( sHeader& io_array, tFunction&& i_function );
+
+	const eae6320::NumericArray::sTypeKernels<double, double>& GetTypeKernels( const double* );
+	const eae6320::NumericArray::sTypeKernels<float, double>& GetTypeKernels( const float* );
+	const eae6320::NumericArray::sTypeKernels<int32_t, int64_t>& GetTypeKernels( const int32_t* );
+
+	// These return false if the value can't be stored as the element type
+	bool ToElement( lua_State& io_luaState, const int i_index, double& o_element );
+	bool ToElement( lua_State& io_luaState, const int i_index, float& o_element );
+	bool ToElement( lua_State& io_luaState, const int i_index, int32_t& o_element );
+	template <class tElement>
+	tElement CheckElement( lua_State& io_luaState, const int i_index, const sHeader& i_array );
+
+	// int32 elements (and their sums) are pushed as Lua integers
+	void PushValue( lua_State& io_luaState, const double i_value );
+	void PushValue( lua_State& io_luaState, const int32_t i_value );
+	void PushValue( lua_State& io_luaState, const int64_t i_value );
+}
+
+// Interface
+//==========
+
+int eae6320::NumericArray::Open( lua_State* io_luaState )
+{
+	// The metatable of every array
+	{
+		luaL_newmetatable( io_luaState, s_metatableName );
+		{
+			const luaL_Reg metamethods[] =
+			{
+				{ "__newindex", NewIndex },
+				{ "__len", Length },
+				{ "__tostring", ToString },
+				{ nullptr, nullptr }
+			};
+			luaL_setfuncs( io_luaState, metamethods, 0 );
+		}
+		// __index is a function (rather than the methods table)
+		// because an integer key has to return an element;
+		// any other key looks up a method in the table, which is an upvalue
+		{
+			const luaL_Reg methods[] =
+			{
+				{ "type", Type },
+				{ "totable", ToTable },
+				{ "sum", Sum },
+				{ "product", Product },
+				{ "mean", Mean },
+				{ "min", Min },
+				{ "max", Max },
+				{ "dot", Dot },
+				{ "axpy", Axpy },
+				{ "add", Add },
+				{ "mul", Mul },
+				{ nullptr, nullptr }
+			};
+			luaL_newlib( io_luaState, methods );
+			lua_pushcclosure( io_luaState, Index, 1 );
+			lua_setfield( io_luaState, -2, "__index" );
+		}
+		lua_pop( io_luaState, 1 );
+	}
+	// The library
+	{
+		const luaL_Reg functions[] =
+		{
+			{ "new", New },
+			{ "fromtable", FromTable },
+			{ "instructionset", GetInstructionSet },
+			{ "setinstructionset", ChooseInstructionSet },
+			{ nullptr, nullptr }
+		};
+		luaL_newlib( io_luaState, functions );
+	}
+
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+void* eae6320::NumericArray::Push( lua_State& io_luaState, const eType i_type, const size_t i_count )
+{
+	if ( i_count > static_cast<size_t>( std::numeric_limits<lua_Integer>::max() ) )
+	{
+		luaL_error( &io_luaState, "a numeric array can't have that many elements" );
+	}
+	return GetElements( PushArray( io_luaState, i_type, static_cast<lua_Integer>( i_count ) ) );
+}
+
+void* eae6320::NumericArray::ToArray( lua_State& io_luaState, const int i_index, eType& o_type, size_t& o_count )
+{
+	auto* const array = static_cast<sHeader*>( luaL_testudata( &io_luaState, i_index, s_metatableName ) );
+	if ( array )
+	{
+		o_type = array->type;
+		o_count = array->count;
+		return GetElements( *array );
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// Library functions
+	//------------------
+
+	int New( lua_State* io_luaState )
+	{
+		const auto type = static_cast<eae6320::NumericArray::eType>( luaL_checkoption( io_luaState, 1, nullptr, s_typeNames ) );
+		const auto count = luaL_checkinteger( io_luaState, 2 );
+		PushArray( *io_luaState, type, count );
+
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int FromTable( lua_State* io_luaState )
+	{
+		luaL_checktype( io_luaState, 1, LUA_TTABLE );
+		const auto type = static_cast<eae6320::NumericArray::eType>( luaL_checkoption( io_luaState, 2, "float64", s_typeNames ) );
+		const auto count = luaL_optinteger( io_luaState, 3, static_cast<lua_Integer>( lua_rawlen( io_luaState, 1 ) ) );
+		auto& array = PushArray( *io_luaState, type, count );
+		luaL_checkstack( io_luaState, s_tableBatchSize, "not enough stack space to read the table" );
+		return VisitElements( array, [io_luaState, &array]( auto* const o_elements )
+		{
+			for ( size_t i = 0; i < array.count; i += s_tableBatchSize )
+			{
+				// Push a batch of values
+				// (lua_rawgeti() doesn't call any metamethods, and so the values can't change while they are read)
+				const auto batchSize = static_cast<int>( ( ( array.count - i ) < static_cast<size_t>( s_tableBatchSize ) ) ? ( array.count - i ) : s_tableBatchSize );
+				for ( int j = 0; j < batchSize; ++j )
+				{
+					lua_rawgeti( io_luaState, 1, static_cast<lua_Integer>( i + j + 1 ) );
+				}
+				// Store them in the array
+				for ( int j = 0; j < batchSize; ++j )
+				{
+					if ( !ToElement( *io_luaState, j - batchSize, o_elements[i + j] ) )
+					{
+						return luaL_error( io_luaState, "value %I of the table (a %s) can't be stored in a %s array",
+							static_cast<lua_Integer>( i + j + 1 ), luaL_typename( io_luaState, j - batchSize ),
+							s_typeNames[static_cast<int>( array.type )] );
+					}
+				}
+				lua_pop( io_luaState, batchSize );
+			}
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int GetInstructionSet( lua_State* io_luaState )
+	{
+		lua_pushstring( io_luaState, eae6320::NumericArray::GetKernels().instructionSet );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int ChooseInstructionSet( lua_State* io_luaState )
+	{
+		const auto* const instructionSet = luaL_checkstring( io_luaState, 1 );
+		lua_pushboolean( io_luaState, eae6320::NumericArray::SetInstructionSet( instructionSet ) );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	// Metamethods
+	//------------
+
+	int Index( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		int isInteger;
+		const auto index = lua_tointegerx( io_luaState, 2, &isInteger );
+		if ( isInteger )
+		{
+			if ( ( index >= 1 ) && ( static_cast<lua_Unsigned>( index ) <= array.count ) )
+			{
+				VisitElements( array, [io_luaState, index]( const auto* const i_elements )
+				{
+					PushValue( *io_luaState, i_elements[index - 1] );
+					return 0;
+				} );
+			}
+			else
+			{
+				lua_pushnil( io_luaState );
+			}
+		}
+		else
+		{
+			lua_pushvalue( io_luaState, 2 );
+			lua_rawget( io_luaState, lua_upvalueindex( 1 ) );
+		}
+
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int NewIndex( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		const auto index = luaL_checkinteger( io_luaState, 2 );
+		luaL_argcheck( io_luaState, ( index >= 1 ) && ( static_cast<lua_Unsigned>( index ) <= array.count ), 2, "index out of range" );
+		return VisitElements( array, [io_luaState, &array, index]( auto* const o_elements )
+		{
+			o_elements[index - 1] = CheckElement<std::remove_pointer_t<decltype( o_elements )>>( *io_luaState, 3, array );
+			constexpr int returnValueCount = 0;
+			return returnValueCount;
+		} );
+	}
+
+	int Length( lua_State* io_luaState )
+	{
+		const auto& array = CheckArray( *io_luaState, 1 );
+		lua_pushinteger( io_luaState, static_cast<lua_Integer>( array.count ) );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int ToString( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		lua_pushfstring( io_luaState, "numericarray (%s[%I]): %p",
+			s_typeNames[static_cast<int>( array.type )], static_cast<lua_Integer>( array.count ), &array );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	// Methods
+	//--------
+
+	int Type( lua_State* io_luaState )
+	{
+		const auto& array = CheckArray( *io_luaState, 1 );
+		lua_pushstring( io_luaState, s_typeNames[static_cast<int>( array.type )] );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
+	int ToTable( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		lua_createtable( io_luaState, ( array.count <= INT_MAX ) ? static_cast<int>( array.count ) : 0, 0 );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			for ( size_t i = 0; i < array.count; ++i )
+			{
+				PushValue( *io_luaState, i_elements[i] );
+				lua_rawseti( io_luaState, -2, static_cast<lua_Integer>( i + 1 ) );
+			}
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Sum( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			PushValue( *io_luaState, GetTypeKernels( i_elements ).sum( i_elements, array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Product( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			PushValue( *io_luaState, GetTypeKernels( i_elements ).product( i_elements, array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Mean( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		luaL_argcheck( io_luaState, array.count > 0, 1, "the array is empty" );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			const auto sum = GetTypeKernels( i_elements ).sum( i_elements, array.count );
+			lua_pushnumber( io_luaState, static_cast<lua_Number>( sum ) / static_cast<lua_Number>( array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Min( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		luaL_argcheck( io_luaState, array.count > 0, 1, "the array is empty" );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			PushValue( *io_luaState, GetTypeKernels( i_elements ).min( i_elements, array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Max( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		luaL_argcheck( io_luaState, array.count > 0, 1, "the array is empty" );
+		return VisitElements( array, [io_luaState, &array]( const auto* const i_elements )
+		{
+			PushValue( *io_luaState, GetTypeKernels( i_elements ).max( i_elements, array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Dot( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		auto& other = CheckMatchingArray( *io_luaState, 2, array );
+		return VisitElements( array, [io_luaState, &array, &other]( const auto* const i_elements )
+		{
+			const auto* const otherElements = static_cast<decltype( i_elements )>( GetElements( other ) );
+			PushValue( *io_luaState, GetTypeKernels( i_elements ).dot( i_elements, otherElements, array.count ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Axpy( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		auto& other = CheckMatchingArray( *io_luaState, 3, array );
+		return VisitElements( array, [io_luaState, &array, &other]( auto* const io_elements )
+		{
+			typedef std::remove_pointer_t<decltype( io_elements )> tElement;
+			const auto scale = CheckElement<tElement>( *io_luaState, 2, array );
+			const auto* const otherElements = static_cast<const tElement*>( GetElements( other ) );
+			GetTypeKernels( io_elements ).axpy( scale, otherElements, io_elements, array.count );
+			// The array is returned so that calls can be chained
+			lua_settop( io_luaState, 1 );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Add( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		auto& other = CheckMatchingArray( *io_luaState, 2, array );
+		return VisitElements( array, [io_luaState, &array, &other]( auto* const io_elements )
+		{
+			const auto* const otherElements = static_cast<decltype( io_elements )>( GetElements( other ) );
+			GetTypeKernels( io_elements ).add( otherElements, io_elements, array.count );
+			lua_settop( io_luaState, 1 );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	int Mul( lua_State* io_luaState )
+	{
+		auto& array = CheckArray( *io_luaState, 1 );
+		auto& other = CheckMatchingArray( *io_luaState, 2, array );
+		return VisitElements( array, [io_luaState, &array, &other]( auto* const io_elements )
+		{
+			const auto* const otherElements = static_cast<decltype( io_elements )>( GetElements( other ) );
+			GetTypeKernels( io_elements ).mul( otherElements, io_elements, array.count );
+			lua_settop( io_luaState, 1 );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		} );
+	}
+
+	// Arrays
+	//-------
+
+	sHeader& CheckArray( lua_State& io_luaState, const int i_index )
+	{
+		return *static_cast<sHeader*>( luaL_checkudata( &io_luaState, i_index, s_metatableName ) );
+	}
+
+	sHeader& CheckMatchingArray( lua_State& io_luaState, const int i_index, const sHeader& i_array )
+	{
+		auto& array = CheckArray( io_luaState, i_index );
+		luaL_argcheck( &io_luaState, array.type == i_array.type, i_index, "the arrays have different types" );
+		luaL_argcheck( &io_luaState, array.count == i_array.count, i_index, "the arrays have different counts" );
+		return array;
+	}
+
+	sHeader& PushArray( lua_State& io_luaState, const eae6320::NumericArray::eType i_type, const lua_Integer i_count )
+	{
+		const auto elementSize = GetElementSize( i_type );
+		if ( ( i_count < 0 ) || ( static_cast<lua_Unsigned>( i_count ) > ( ( std::numeric_limits<size_t>::max() - s_headerSize ) / elementSize ) ) )
+		{
+			luaL_error( &io_luaState, "a numeric array can't have %I elements", i_count );
+		}
+		const auto count = static_cast<size_t>( i_count );
+		auto* const array = static_cast<sHeader*>( lua_newuserdata( &io_luaState, s_headerSize + ( count * elementSize ) ) );
+		array->count = count;
+		array->type = i_type;
+		std::memset( GetElements( *array ), 0, count * elementSize );
+		luaL_setmetatable( &io_luaState, s_metatableName );
+		return *array;
+	}
+
+	void* GetElements( sHeader& io_array )
+	{
+		return reinterpret_cast<uint8_t*>( &io_array ) + s_headerSize;
+	}
+
+	size_t GetElementSize( const eae6320::NumericArray::eType i_type )
+	{
+		switch ( i_type )
+		{
+		case eae6320::NumericArray::eType::Float64:
+			return sizeof( double );
+		case eae6320::NumericArray::eType::Float32:
+			return sizeof( float );
+		default:
+			return sizeof( int32_t );
+		}
+	}
+
+	template <class tFunction>
+	int VisitElements( sHeader& io_array, tFunction&& i_function )
+	{
+		switch ( io_array.type )
+		{
+		case eae6320::NumericArray::eType::Float64:
+			return i_function( static_cast<double*>( GetElements( io_array ) ) );
+		case eae6320::NumericArray::eType::Float32:
+			return i_function( static_cast<float*>( GetElements( io_array ) ) );
+		default:
+			return i_function( static_cast<int32_t*>( GetElements( io_array ) ) );
+		}
+	}
+
+	// Kernels
+	//--------
+
+	const eae6320::NumericArray::sTypeKernels<double, double>& GetTypeKernels( const double* )
+	{
+		return eae6320::NumericArray::GetKernels().float64;
+	}
+
+	const eae6320::NumericArray::sTypeKernels<float, double>& GetTypeKernels( const float* )
+	{
+		return eae6320::NumericArray::GetKernels().float32;
+	}
+
+	const eae6320::NumericArray::sTypeKernels<int32_t, int64_t>& GetTypeKernels( const int32_t* )
+	{
+		return eae6320::NumericArray::GetKernels().int32;
+	}
+
+	// Values
+	//-------
+
+	bool ToElement( lua_State& io_luaState, const int i_index, double& o_element )
+	{
+		int isNumber;
+		o_element = static_cast<double>( lua_tonumberx( &io_luaState, i_index, &isNumber ) );
+		return isNumber != 0;
+	}
+
+	bool ToElement( lua_State& io_luaState, const int i_index, float& o_element )
+	{
+		int isNumber;
+		o_element = static_cast<float>( lua_tonumberx( &io_luaState, i_index, &isNumber ) );
+		return isNumber != 0;
+	}
+
+	bool ToElement( lua_State& io_luaState, const int i_index, int32_t& o_element )
+	{
+		int isInteger;
+		const auto value = lua_tointegerx( &io_luaState, i_index, &isInteger );
+		if ( isInteger && ( value >= std::numeric_limits<int32_t>::min() ) && ( value <= std::numeric_limits<int32_t>::max() ) )
+		{
+			o_element = static_cast<int32_t>( value );
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	template <class tElement>
+	tElement CheckElement( lua_State& io_luaState, const int i_index, const sHeader& i_array )
+	{
+		tElement element = 0;
+		if ( !ToElement( io_luaState, i_index, element ) )
+		{
+			const auto* const errorMessage = lua_pushfstring( &io_luaState, "a %s can't be stored in a %s array",
+				luaL_typename( &io_luaState, i_index ), s_typeNames[static_cast<int>( i_array.type )] );
+			luaL_argerror( &io_luaState, i_index, errorMessage );
+		}
+		return element;
+	}
+
+	void PushValue( lua_State& io_luaState, const double i_value )
+	{
+		lua_pushnumber( &io_luaState, static_cast<lua_Number>( i_value ) );
+	}
+
+	void PushValue( lua_State& io_luaState, const int32_t i_value )
+	{
+		lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_value ) );
+	}
+
+	void PushValue( lua_State& io_luaState, const int64_t i_value )
+	{
+		lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_value ) );
+	}
+}
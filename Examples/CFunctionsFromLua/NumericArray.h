@@ -0,0 +1,73 @@
+/*
+	A numeric array is a userdata that stores float64, float32, or int32 numbers contiguously
+	so that bulk operations on thousands of numbers don't have to go through a Lua table of boxed values
+
+	The "numericarray" library is opened with:
+		luaL_requiref( luaState, "numericarray", eae6320::NumericArray::Open, 1 );
+	and then used from Lua like this:
+		local a = numericarray.fromtable( { 1, 2, 3, 4 }, "float32" )
+		local b = numericarray.new( "float32", #a )
+		b:axpy( 2, a )	-- b[i] = b[i] + 2 * a[i]
+		print( a:sum(), a:dot( b ), b[4], b:totable()[4] )
+
+	Library functions:
+		* new( type, count ): A new array of the type ("float64", "float32", or "int32") that is filled with zeros
+		* fromtable( table [, type [, count]] ): A new array (float64 by default) with the table's first count values
+			(the table's length by default)
+		* instructionset(): "scalar", "SSE2", or "AVX2" (see NumericArrayKernels.h)
+		* setinstructionset( name ): Chooses the kernels that every array uses and returns whether the CPU supports them
+	Array methods:
+		* #a, a[i], a[i] = value: Elements are indexed from 1 like a Lua sequence
+			(reading outside of the array returns nil so that ipairs() works, but writing is an error)
+		* a:type(), a:totable()
+		* a:sum(), a:product(), a:mean(), a:min(), a:max(), a:dot( b )
+		* a:axpy( scale, b ), a:add( b ), a:mul( b ): These change a in place and return it
+	Arrays used together must have the same type and count.
+	Values that are stored in an int32 array must be integers that fit in 32 bits
+	(the results of operations on int32 arrays wrap around instead).
+
+	Converting to or from a table has to copy every value
+	(a table stores each number in its own boxed TValue),
+	but the values are read in batches of lua_rawgeti() calls straight into the array
+	without any temporary buffer.
+*/
+
+#ifndef EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAY_H
+#define EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAY_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <External/Lua/Includes.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace NumericArray
+	{
+		enum class eType : uint8_t
+		{
+			Float64,
+			Float32,
+			Int32,
+		};
+
+		// This is a lua_CFunction that can be given to luaL_requiref()
+		int Open( lua_State* io_luaState );
+
+		// These let C++ code create and use arrays directly
+		// (the library must have been opened first):
+
+		// Pushes a new array that is filled with zeros and returns its elements
+		void* Push( lua_State& io_luaState, const eType i_type, const size_t i_count );
+		// Returns the elements of the array at the index
+		// (or NULL if the value isn't a numeric array)
+		void* ToArray( lua_State& io_luaState, const int i_index, eType& o_type, size_t& o_count );
+	}
+}
+
+#endif	// EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAY_H
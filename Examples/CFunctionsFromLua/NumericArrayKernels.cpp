@@ -0,0 +1,217 @@
+// Include Files
+//==============
+
+#include "NumericArrayKernels.h"
+
+#include <cstring>
+
+#if defined( EAE6320_NUMERICARRAY_X86 ) && defined( _MSC_VER )
+	#include <intrin.h>
+	#include <immintrin.h>
+#endif
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	#include "NumericArrayKernels.inl"
+
+	// The scalar kernels use "vectors" with a single lane
+	template <class tLane>
+	struct sScalar
+	{
+		typedef tLane tScalar;
+		typedef tLane tValue;
+		static constexpr size_t s_width = 1;
+
+		static tValue Zero() { return static_cast<tLane>( 0 ); }
+		static tValue Set( const tLane i_value ) { return i_value; }
+		template <class tElement>
+		static tValue Load( const tElement* const i_values ) { return static_cast<tLane>( *i_values ); }
+		static void Store( tLane* const o_values, const tValue i_value ) { *o_values = i_value; }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return AddElements( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return MulElements( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return ( i_value2 < i_value1 ) ? i_value2 : i_value1; }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return ( i_value2 > i_value1 ) ? i_value2 : i_value1; }
+
+		static tLane ReduceAdd( const tValue i_value ) { return i_value; }
+		static tLane ReduceMul( const tValue i_value ) { return i_value; }
+		static tLane ReduceMin( const tValue i_value ) { return i_value; }
+		static tLane ReduceMax( const tValue i_value ) { return i_value; }
+	};
+
+	enum class eInstructionSet
+	{
+		Scalar,
+		Sse2,
+		Avx2,
+	};
+
+	eae6320::NumericArray::sKernels& GetChosenKernels();
+	eInstructionSet GetFastestInstructionSet();
+	bool IsInstructionSetSupported( const eInstructionSet i_instructionSet );
+	void SetKernels( const eInstructionSet i_instructionSet, eae6320::NumericArray::sKernels& o_kernels );
+}
+
+// Interface
+//==========
+
+const eae6320::NumericArray::sKernels& eae6320::NumericArray::GetKernels()
+{
+	return GetChosenKernels();
+}
+
+bool eae6320::NumericArray::SetInstructionSet( const char* const i_instructionSet )
+{
+	eInstructionSet instructionSet;
+	if ( std::strcmp( i_instructionSet, "scalar" ) == 0 )
+	{
+		instructionSet = eInstructionSet::Scalar;
+	}
+	else if ( std::strcmp( i_instructionSet, "SSE2" ) == 0 )
+	{
+		instructionSet = eInstructionSet::Sse2;
+	}
+	else if ( std::strcmp( i_instructionSet, "AVX2" ) == 0 )
+	{
+		instructionSet = eInstructionSet::Avx2;
+	}
+	else
+	{
+		return false;
+	}
+	if ( !IsInstructionSetSupported( instructionSet ) )
+	{
+		return false;
+	}
+	SetKernels( instructionSet, GetChosenKernels() );
+	return true;
+}
+
+void eae6320::NumericArray::SetKernels_scalar( sKernels& io_kernels )
+{
+	io_kernels.instructionSet = "scalar";
+
+	io_kernels.float64.sum = Sum<sScalar<double>, double>;
+	io_kernels.float64.product = Product<sScalar<double>, double>;
+	io_kernels.float64.min = Min<sScalar<double>, double>;
+	io_kernels.float64.max = Max<sScalar<double>, double>;
+	io_kernels.float64.dot = Dot<sScalar<double>, double>;
+	io_kernels.float64.axpy = Axpy<sScalar<double>, double>;
+	io_kernels.float64.add = Add<sScalar<double>, double>;
+	io_kernels.float64.mul = Mul<sScalar<double>, double>;
+
+	io_kernels.float32.sum = Sum<sScalar<double>, float>;
+	io_kernels.float32.product = Product<sScalar<double>, float>;
+	io_kernels.float32.min = Min<sScalar<float>, float>;
+	io_kernels.float32.max = Max<sScalar<float>, float>;
+	io_kernels.float32.dot = Dot<sScalar<double>, float>;
+	io_kernels.float32.axpy = Axpy<sScalar<float>, float>;
+	io_kernels.float32.add = Add<sScalar<float>, float>;
+	io_kernels.float32.mul = Mul<sScalar<float>, float>;
+
+	io_kernels.int32.sum = Sum<sScalar<int64_t>, int32_t>;
+	io_kernels.int32.product = Product<sScalar<int64_t>, int32_t>;
+	io_kernels.int32.min = Min<sScalar<int32_t>, int32_t>;
+	io_kernels.int32.max = Max<sScalar<int32_t>, int32_t>;
+	io_kernels.int32.dot = Dot<sScalar<int64_t>, int32_t>;
+	io_kernels.int32.axpy = Axpy<sScalar<int32_t>, int32_t>;
+	io_kernels.int32.add = Add<sScalar<int32_t>, int32_t>;
+	io_kernels.int32.mul = Mul<sScalar<int32_t>, int32_t>;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::NumericArray::sKernels& GetChosenKernels()
+	{
+		// The CPU is only checked the first time
+		static eae6320::NumericArray::sKernels s_kernels = []()
+		{
+			eae6320::NumericArray::sKernels kernels;
+			SetKernels( GetFastestInstructionSet(), kernels );
+			return kernels;
+		}();
+		return s_kernels;
+	}
+
+	eInstructionSet GetFastestInstructionSet()
+	{
+		if ( IsInstructionSetSupported( eInstructionSet::Avx2 ) )
+		{
+			return eInstructionSet::Avx2;
+		}
+		else if ( IsInstructionSetSupported( eInstructionSet::Sse2 ) )
+		{
+			return eInstructionSet::Sse2;
+		}
+		return eInstructionSet::Scalar;
+	}
+
+	bool IsInstructionSetSupported( const eInstructionSet i_instructionSet )
+	{
+		switch ( i_instructionSet )
+		{
+		case eInstructionSet::Scalar:
+			return true;
+#if defined( EAE6320_NUMERICARRAY_X86 ) && defined( _MSC_VER )
+		case eInstructionSet::Sse2:
+			{
+				int registers[4];
+				__cpuid( registers, 1 );
+				return ( registers[3] & ( 1 << 26 ) ) != 0;
+			}
+		case eInstructionSet::Avx2:
+			{
+				int registers[4];
+				__cpuid( registers, 0 );
+				if ( registers[0] < 7 )
+				{
+					return false;
+				}
+				// The operating system must save the AVX registers when it switches threads
+				__cpuid( registers, 1 );
+				const auto isXsaveEnabled = ( registers[2] & ( 1 << 27 ) ) != 0;
+				const auto isAvxSupported = ( registers[2] & ( 1 << 28 ) ) != 0;
+				if ( !isXsaveEnabled || !isAvxSupported || ( ( _xgetbv( 0 ) & 0x6 ) != 0x6 ) )
+				{
+					return false;
+				}
+				__cpuidex( registers, 7, 0 );
+				return ( registers[1] & ( 1 << 5 ) ) != 0;
+			}
+#elif defined( EAE6320_NUMERICARRAY_X86 )
+		case eInstructionSet::Sse2:
+			__builtin_cpu_init();
+			return __builtin_cpu_supports( "sse2" ) != 0;
+		case eInstructionSet::Avx2:
+			// (this also checks that the operating system saves the AVX registers)
+			__builtin_cpu_init();
+			return __builtin_cpu_supports( "avx2" ) != 0;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	void SetKernels( const eInstructionSet i_instructionSet, eae6320::NumericArray::sKernels& o_kernels )
+	{
+		// Every instruction set starts with the scalar kernels
+		// and then replaces the ones that it can do faster
+		eae6320::NumericArray::SetKernels_scalar( o_kernels );
+#ifdef EAE6320_NUMERICARRAY_X86
+		if ( i_instructionSet != eInstructionSet::Scalar )
+		{
+			eae6320::NumericArray::SetKernels_sse2( o_kernels );
+		}
+		if ( i_instructionSet == eInstructionSet::Avx2 )
+		{
+			eae6320::NumericArray::SetKernels_avx2( o_kernels );
+		}
+#endif
+	}
+}
@@ -0,0 +1,85 @@
+/*
+	The kernels do the bulk operations of numeric arrays (see NumericArray.h)
+	on contiguous arrays of float64, float32, or int32 elements
+
+	Every kernel has a scalar version that works on any platform.
+	On x86 there are also versions that use SSE2 (which every x64 CPU has)
+	and AVX2 (which is checked for when the program runs),
+	and the fastest set that the CPU supports is chosen the first time that the kernels are used.
+
+	The vector versions add (or multiply) the elements in a different order than the scalar versions do,
+	and so the floating point results can differ in the last bits.
+	float32 elements are summed (and multiplied) as float64 so that long arrays don't lose precision.
+	int32 elements are summed as int64, but the element-wise operations wrap around like unsigned arithmetic.
+*/
+
+#ifndef EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_H
+#define EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+
+// Platform
+//=========
+
+#if defined( _M_X64 ) || defined( __x86_64__ ) || defined( _M_IX86 ) || defined( __i386__ )
+	#define EAE6320_NUMERICARRAY_X86
+#endif
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace NumericArray
+	{
+		// The kernels for one element type
+		// (tResult is the type that sums, products, and dot products are returned as)
+		template <class tElement, class tResult>
+		struct sTypeKernels
+		{
+			tResult ( *sum )( const tElement* const i_values, const size_t i_count );
+			tResult ( *product )( const tElement* const i_values, const size_t i_count );
+			// The count must not be 0
+			tElement ( *min )( const tElement* const i_values, const size_t i_count );
+			tElement ( *max )( const tElement* const i_values, const size_t i_count );
+			tResult ( *dot )( const tElement* const i_values1, const tElement* const i_values2, const size_t i_count );
+			// io_values[i] += i_scale * i_values[i]
+			void ( *axpy )( const tElement i_scale, const tElement* const i_values, tElement* const io_values, const size_t i_count );
+			// io_values[i] += i_values[i]
+			void ( *add )( const tElement* const i_values, tElement* const io_values, const size_t i_count );
+			// io_values[i] *= i_values[i]
+			void ( *mul )( const tElement* const i_values, tElement* const io_values, const size_t i_count );
+		};
+
+		struct sKernels
+		{
+			// "scalar", "SSE2", or "AVX2"
+			const char* instructionSet;
+			sTypeKernels<double, double> float64;
+			sTypeKernels<float, double> float32;
+			sTypeKernels<int32_t, int64_t> int32;
+		};
+
+		// Returns the fastest kernels that the CPU supports
+		// (or the ones chosen with SetInstructionSet())
+		const sKernels& GetKernels();
+		// Chooses the kernels for an instruction set ("scalar", "SSE2", or "AVX2")
+		// so that they can be compared with each other.
+		// Returns false (and doesn't change the kernels) if the CPU doesn't support the instruction set.
+		bool SetInstructionSet( const char* const i_instructionSet );
+
+		// Each of these replaces the kernels that the instruction set has
+		// (the scalar ones set every kernel, and the others only replace the ones that they can do faster)
+		void SetKernels_scalar( sKernels& io_kernels );
+#ifdef EAE6320_NUMERICARRAY_X86
+		void SetKernels_sse2( sKernels& io_kernels );
+		void SetKernels_avx2( sKernels& io_kernels );
+#endif
+	}
+}
+
+#endif	// EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_H
@@ -0,0 +1,226 @@
+/*
+	This file contains the kernels that are the same for every instruction set
+	(except for the vector type that they use)
+
+	It is included inside of an unnamed namespace by each file that implements an instruction set,
+	and so each one gets its own copies that are compiled for that instruction set.
+	(That's also why it doesn't include any headers:
+	an inline function from a standard header could be compiled with instructions that the CPU doesn't have
+	and then be used by code that runs on any CPU.)
+
+	A vector type tVector must have:
+		* tScalar: The type of each lane
+		* s_width: How many lanes there are
+		* tValue: The type of a vector
+		* Zero(), Set( tScalar ), Load( const tElement* ) for every element type that it is used with, Store( tScalar*, tValue )
+		* Add(), Mul(), Min(), Max() of two vectors (if the kernel that is used needs them)
+		* ReduceAdd(), ReduceMul(), ReduceMin(), ReduceMax() of the lanes of a vector (if the kernel that is used needs them)
+	The scalar kernels use a vector type with a single lane.
+*/
+
+#ifndef EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_INL
+#define EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_INL
+
+// Element Operations
+//===================
+
+// int32 elements wrap around instead of overflowing
+// (which would be undefined behavior)
+
+inline double AddElements( const double i_value1, const double i_value2 ) { return i_value1 + i_value2; }
+inline float AddElements( const float i_value1, const float i_value2 ) { return i_value1 + i_value2; }
+inline int32_t AddElements( const int32_t i_value1, const int32_t i_value2 )
+{
+	return static_cast<int32_t>( static_cast<uint32_t>( i_value1 ) + static_cast<uint32_t>( i_value2 ) );
+}
+inline int64_t AddElements( const int64_t i_value1, const int64_t i_value2 )
+{
+	return static_cast<int64_t>( static_cast<uint64_t>( i_value1 ) + static_cast<uint64_t>( i_value2 ) );
+}
+
+inline double MulElements( const double i_value1, const double i_value2 ) { return i_value1 * i_value2; }
+inline float MulElements( const float i_value1, const float i_value2 ) { return i_value1 * i_value2; }
+inline int32_t MulElements( const int32_t i_value1, const int32_t i_value2 )
+{
+	return static_cast<int32_t>( static_cast<uint32_t>( i_value1 ) * static_cast<uint32_t>( i_value2 ) );
+}
+inline int64_t MulElements( const int64_t i_value1, const int64_t i_value2 )
+{
+	return static_cast<int64_t>( static_cast<uint64_t>( i_value1 ) * static_cast<uint64_t>( i_value2 ) );
+}
+
+// Kernels
+//========
+
+// The reductions use four vectors so that each addition doesn't have to wait for the previous one
+
+template <class tVector, class tElement>
+typename tVector::tScalar Sum( const tElement* const i_values, const size_t i_count )
+{
+	typedef typename tVector::tScalar tScalar;
+	constexpr size_t width = tVector::s_width;
+	auto sum0 = tVector::Zero(), sum1 = tVector::Zero(), sum2 = tVector::Zero(), sum3 = tVector::Zero();
+	size_t i = 0;
+	for ( ; ( i + ( 4 * width ) ) <= i_count; i += 4 * width )
+	{
+		sum0 = tVector::Add( sum0, tVector::Load( i_values + i ) );
+		sum1 = tVector::Add( sum1, tVector::Load( i_values + i + width ) );
+		sum2 = tVector::Add( sum2, tVector::Load( i_values + i + ( 2 * width ) ) );
+		sum3 = tVector::Add( sum3, tVector::Load( i_values + i + ( 3 * width ) ) );
+	}
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		sum0 = tVector::Add( sum0, tVector::Load( i_values + i ) );
+	}
+	auto sum = tVector::ReduceAdd( tVector::Add( tVector::Add( sum0, sum1 ), tVector::Add( sum2, sum3 ) ) );
+	for ( ; i < i_count; ++i )
+	{
+		sum = AddElements( sum, static_cast<tScalar>( i_values[i] ) );
+	}
+	return sum;
+}
+
+template <class tVector, class tElement>
+typename tVector::tScalar Product( const tElement* const i_values, const size_t i_count )
+{
+	typedef typename tVector::tScalar tScalar;
+	constexpr size_t width = tVector::s_width;
+	const auto one = tVector::Set( static_cast<tScalar>( 1 ) );
+	auto product0 = one, product1 = one, product2 = one, product3 = one;
+	size_t i = 0;
+	for ( ; ( i + ( 4 * width ) ) <= i_count; i += 4 * width )
+	{
+		product0 = tVector::Mul( product0, tVector::Load( i_values + i ) );
+		product1 = tVector::Mul( product1, tVector::Load( i_values + i + width ) );
+		product2 = tVector::Mul( product2, tVector::Load( i_values + i + ( 2 * width ) ) );
+		product3 = tVector::Mul( product3, tVector::Load( i_values + i + ( 3 * width ) ) );
+	}
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		product0 = tVector::Mul( product0, tVector::Load( i_values + i ) );
+	}
+	auto product = tVector::ReduceMul( tVector::Mul( tVector::Mul( product0, product1 ), tVector::Mul( product2, product3 ) ) );
+	for ( ; i < i_count; ++i )
+	{
+		product = MulElements( product, static_cast<tScalar>( i_values[i] ) );
+	}
+	return product;
+}
+
+template <class tVector, class tElement>
+tElement Min( const tElement* const i_values, const size_t i_count )
+{
+	constexpr size_t width = tVector::s_width;
+	auto min = i_values[0];
+	size_t i = 0;
+	if ( i_count >= width )
+	{
+		auto mins = tVector::Load( i_values );
+		for ( i = width; ( i + width ) <= i_count; i += width )
+		{
+			mins = tVector::Min( mins, tVector::Load( i_values + i ) );
+		}
+		min = tVector::ReduceMin( mins );
+	}
+	for ( ; i < i_count; ++i )
+	{
+		min = ( i_values[i] < min ) ? i_values[i] : min;
+	}
+	return min;
+}
+
+template <class tVector, class tElement>
+tElement Max( const tElement* const i_values, const size_t i_count )
+{
+	constexpr size_t width = tVector::s_width;
+	auto max = i_values[0];
+	size_t i = 0;
+	if ( i_count >= width )
+	{
+		auto maxs = tVector::Load( i_values );
+		for ( i = width; ( i + width ) <= i_count; i += width )
+		{
+			maxs = tVector::Max( maxs, tVector::Load( i_values + i ) );
+		}
+		max = tVector::ReduceMax( maxs );
+	}
+	for ( ; i < i_count; ++i )
+	{
+		max = ( i_values[i] > max ) ? i_values[i] : max;
+	}
+	return max;
+}
+
+template <class tVector, class tElement>
+typename tVector::tScalar Dot( const tElement* const i_values1, const tElement* const i_values2, const size_t i_count )
+{
+	typedef typename tVector::tScalar tScalar;
+	constexpr size_t width = tVector::s_width;
+	auto sum0 = tVector::Zero(), sum1 = tVector::Zero(), sum2 = tVector::Zero(), sum3 = tVector::Zero();
+	size_t i = 0;
+	for ( ; ( i + ( 4 * width ) ) <= i_count; i += 4 * width )
+	{
+		sum0 = tVector::Add( sum0, tVector::Mul( tVector::Load( i_values1 + i ), tVector::Load( i_values2 + i ) ) );
+		sum1 = tVector::Add( sum1, tVector::Mul( tVector::Load( i_values1 + i + width ), tVector::Load( i_values2 + i + width ) ) );
+		sum2 = tVector::Add( sum2, tVector::Mul( tVector::Load( i_values1 + i + ( 2 * width ) ), tVector::Load( i_values2 + i + ( 2 * width ) ) ) );
+		sum3 = tVector::Add( sum3, tVector::Mul( tVector::Load( i_values1 + i + ( 3 * width ) ), tVector::Load( i_values2 + i + ( 3 * width ) ) ) );
+	}
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		sum0 = tVector::Add( sum0, tVector::Mul( tVector::Load( i_values1 + i ), tVector::Load( i_values2 + i ) ) );
+	}
+	auto sum = tVector::ReduceAdd( tVector::Add( tVector::Add( sum0, sum1 ), tVector::Add( sum2, sum3 ) ) );
+	for ( ; i < i_count; ++i )
+	{
+		sum = AddElements( sum, MulElements( static_cast<tScalar>( i_values1[i] ), static_cast<tScalar>( i_values2[i] ) ) );
+	}
+	return sum;
+}
+
+template <class tVector, class tElement>
+void Axpy( const tElement i_scale, const tElement* const i_values, tElement* const io_values, const size_t i_count )
+{
+	constexpr size_t width = tVector::s_width;
+	const auto scale = tVector::Set( i_scale );
+	size_t i = 0;
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		tVector::Store( io_values + i, tVector::Add( tVector::Load( io_values + i ), tVector::Mul( scale, tVector::Load( i_values + i ) ) ) );
+	}
+	for ( ; i < i_count; ++i )
+	{
+		io_values[i] = AddElements( io_values[i], MulElements( i_scale, i_values[i] ) );
+	}
+}
+
+template <class tVector, class tElement>
+void Add( const tElement* const i_values, tElement* const io_values, const size_t i_count )
+{
+	constexpr size_t width = tVector::s_width;
+	size_t i = 0;
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		tVector::Store( io_values + i, tVector::Add( tVector::Load( io_values + i ), tVector::Load( i_values + i ) ) );
+	}
+	for ( ; i < i_count; ++i )
+	{
+		io_values[i] = AddElements( io_values[i], i_values[i] );
+	}
+}
+
+template <class tVector, class tElement>
+void Mul( const tElement* const i_values, tElement* const io_values, const size_t i_count )
+{
+	constexpr size_t width = tVector::s_width;
+	size_t i = 0;
+	for ( ; ( i + width ) <= i_count; i += width )
+	{
+		tVector::Store( io_values + i, tVector::Mul( tVector::Load( io_values + i ), tVector::Load( i_values + i ) ) );
+	}
+	for ( ; i < i_count; ++i )
+	{
+		io_values[i] = MulElements( io_values[i], i_values[i] );
+	}
+}
+
+#endif	// EAE6320_CFUNCTIONSFROMLUA_NUMERICARRAYKERNELS_INL
@@ -0,0 +1,192 @@
+/*
+	This file contains the kernels that use AVX2
+	(see NumericArrayKernels.h)
+
+	These kernels are only chosen if the CPU supports AVX2 when the program runs,
+	and so only this file is compiled with AVX2 instructions.
+	It must not include any standard headers after the target is set
+	(see NumericArrayKernels.inl).
+*/
+
+// Include Files
+//==============
+
+#include "NumericArrayKernels.h"
+
+#ifdef EAE6320_NUMERICARRAY_X86
+
+// (Visual Studio can use any instruction set's intrinsics without being told to)
+#if defined( __GNUC__ ) && !defined( __AVX2__ )
+	#pragma GCC target( "avx2" )
+#endif
+#include <immintrin.h>
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	#include "NumericArrayKernels.inl"
+
+	double ReduceAdd128( const __m128d i_value ) { return _mm_cvtsd_f64( _mm_add_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+	double ReduceMul128( const __m128d i_value ) { return _mm_cvtsd_f64( _mm_mul_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+	double ReduceMin128( const __m128d i_value ) { return _mm_cvtsd_f64( _mm_min_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+	double ReduceMax128( const __m128d i_value ) { return _mm_cvtsd_f64( _mm_max_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+
+	struct sFloat64x4
+	{
+		typedef double tScalar;
+		typedef __m256d tValue;
+		static constexpr size_t s_width = 4;
+
+		static tValue Zero() { return _mm256_setzero_pd(); }
+		static tValue Set( const double i_value ) { return _mm256_set1_pd( i_value ); }
+		static tValue Load( const double* const i_values ) { return _mm256_loadu_pd( i_values ); }
+		// float32 elements are widened so that they are summed as float64
+		static tValue Load( const float* const i_values ) { return _mm256_cvtps_pd( _mm_loadu_ps( i_values ) ); }
+		static void Store( double* const o_values, const tValue i_value ) { _mm256_storeu_pd( o_values, i_value ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm256_add_pd( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm256_mul_pd( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return _mm256_min_pd( i_value1, i_value2 ); }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return _mm256_max_pd( i_value1, i_value2 ); }
+
+		static double ReduceAdd( const tValue i_value )
+		{
+			return ReduceAdd128( _mm_add_pd( _mm256_castpd256_pd128( i_value ), _mm256_extractf128_pd( i_value, 1 ) ) );
+		}
+		static double ReduceMul( const tValue i_value )
+		{
+			return ReduceMul128( _mm_mul_pd( _mm256_castpd256_pd128( i_value ), _mm256_extractf128_pd( i_value, 1 ) ) );
+		}
+		static double ReduceMin( const tValue i_value )
+		{
+			return ReduceMin128( _mm_min_pd( _mm256_castpd256_pd128( i_value ), _mm256_extractf128_pd( i_value, 1 ) ) );
+		}
+		static double ReduceMax( const tValue i_value )
+		{
+			return ReduceMax128( _mm_max_pd( _mm256_castpd256_pd128( i_value ), _mm256_extractf128_pd( i_value, 1 ) ) );
+		}
+	};
+
+	struct sFloat32x8
+	{
+		typedef float tScalar;
+		typedef __m256 tValue;
+		static constexpr size_t s_width = 8;
+
+		static tValue Zero() { return _mm256_setzero_ps(); }
+		static tValue Set( const float i_value ) { return _mm256_set1_ps( i_value ); }
+		static tValue Load( const float* const i_values ) { return _mm256_loadu_ps( i_values ); }
+		static void Store( float* const o_values, const tValue i_value ) { _mm256_storeu_ps( o_values, i_value ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm256_add_ps( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm256_mul_ps( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return _mm256_min_ps( i_value1, i_value2 ); }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return _mm256_max_ps( i_value1, i_value2 ); }
+
+		static float ReduceMin( const tValue i_value )
+		{
+			auto value = _mm_min_ps( _mm256_castps256_ps128( i_value ), _mm256_extractf128_ps( i_value, 1 ) );
+			value = _mm_min_ps( value, _mm_movehl_ps( value, value ) );
+			return _mm_cvtss_f32( _mm_min_ss( value, _mm_shuffle_ps( value, value, 1 ) ) );
+		}
+		static float ReduceMax( const tValue i_value )
+		{
+			auto value = _mm_max_ps( _mm256_castps256_ps128( i_value ), _mm256_extractf128_ps( i_value, 1 ) );
+			value = _mm_max_ps( value, _mm_movehl_ps( value, value ) );
+			return _mm_cvtss_f32( _mm_max_ss( value, _mm_shuffle_ps( value, value, 1 ) ) );
+		}
+	};
+
+	struct sInt32x8
+	{
+		typedef int32_t tScalar;
+		typedef __m256i tValue;
+		static constexpr size_t s_width = 8;
+
+		static tValue Set( const int32_t i_value ) { return _mm256_set1_epi32( i_value ); }
+		static tValue Load( const int32_t* const i_values ) { return _mm256_loadu_si256( reinterpret_cast<const __m256i*>( i_values ) ); }
+		static void Store( int32_t* const o_values, const tValue i_value ) { _mm256_storeu_si256( reinterpret_cast<__m256i*>( o_values ), i_value ); }
+
+		// (these wrap around)
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm256_add_epi32( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm256_mullo_epi32( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return _mm256_min_epi32( i_value1, i_value2 ); }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return _mm256_max_epi32( i_value1, i_value2 ); }
+
+		static int32_t ReduceMin( const tValue i_value )
+		{
+			auto value = _mm_min_epi32( _mm256_castsi256_si128( i_value ), _mm256_extracti128_si256( i_value, 1 ) );
+			value = _mm_min_epi32( value, _mm_shuffle_epi32( value, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			return _mm_cvtsi128_si32( _mm_min_epi32( value, _mm_shuffle_epi32( value, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+		}
+		static int32_t ReduceMax( const tValue i_value )
+		{
+			auto value = _mm_max_epi32( _mm256_castsi256_si128( i_value ), _mm256_extracti128_si256( i_value, 1 ) );
+			value = _mm_max_epi32( value, _mm_shuffle_epi32( value, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			return _mm_cvtsi128_si32( _mm_max_epi32( value, _mm_shuffle_epi32( value, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+		}
+	};
+
+	// This is only used to sum int32 elements and their products,
+	// and so each lane always holds a sign extended int32 when it is multiplied
+	// (which is what _mm256_mul_epi32() multiplies)
+	struct sInt64x4
+	{
+		typedef int64_t tScalar;
+		typedef __m256i tValue;
+		static constexpr size_t s_width = 4;
+
+		static tValue Zero() { return _mm256_setzero_si256(); }
+		// Four int32 elements are sign extended
+		static tValue Load( const int32_t* const i_values ) { return _mm256_cvtepi32_epi64( _mm_loadu_si128( reinterpret_cast<const __m128i*>( i_values ) ) ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm256_add_epi64( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm256_mul_epi32( i_value1, i_value2 ); }
+
+		static int64_t ReduceAdd( const tValue i_value )
+		{
+			int64_t lanes[s_width];
+			_mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), i_value );
+			return AddElements( AddElements( lanes[0], lanes[1] ), AddElements( lanes[2], lanes[3] ) );
+		}
+	};
+}
+
+// Interface
+//==========
+
+void eae6320::NumericArray::SetKernels_avx2( sKernels& io_kernels )
+{
+	io_kernels.instructionSet = "AVX2";
+
+	io_kernels.float64.sum = Sum<sFloat64x4, double>;
+	io_kernels.float64.product = Product<sFloat64x4, double>;
+	io_kernels.float64.min = Min<sFloat64x4, double>;
+	io_kernels.float64.max = Max<sFloat64x4, double>;
+	io_kernels.float64.dot = Dot<sFloat64x4, double>;
+	io_kernels.float64.axpy = Axpy<sFloat64x4, double>;
+	io_kernels.float64.add = Add<sFloat64x4, double>;
+	io_kernels.float64.mul = Mul<sFloat64x4, double>;
+
+	io_kernels.float32.sum = Sum<sFloat64x4, float>;
+	io_kernels.float32.product = Product<sFloat64x4, float>;
+	io_kernels.float32.min = Min<sFloat32x8, float>;
+	io_kernels.float32.max = Max<sFloat32x8, float>;
+	io_kernels.float32.dot = Dot<sFloat64x4, float>;
+	io_kernels.float32.axpy = Axpy<sFloat32x8, float>;
+	io_kernels.float32.add = Add<sFloat32x8, float>;
+	io_kernels.float32.mul = Mul<sFloat32x8, float>;
+
+	// (an int32 product is summed as int64, which AVX2 can't multiply)
+	io_kernels.int32.sum = Sum<sInt64x4, int32_t>;
+	io_kernels.int32.min = Min<sInt32x8, int32_t>;
+	io_kernels.int32.max = Max<sInt32x8, int32_t>;
+	io_kernels.int32.dot = Dot<sInt64x4, int32_t>;
+	io_kernels.int32.axpy = Axpy<sInt32x8, int32_t>;
+	io_kernels.int32.add = Add<sInt32x8, int32_t>;
+	io_kernels.int32.mul = Mul<sInt32x8, int32_t>;
+}
+
+#endif	// EAE6320_NUMERICARRAY_X86
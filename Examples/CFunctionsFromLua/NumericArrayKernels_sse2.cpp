@@ -0,0 +1,152 @@
+/*
+	This file contains the kernels that use SSE2
+	(see NumericArrayKernels.h)
+
+	Every x64 CPU has SSE2, but 32-bit builds check for it before these kernels are chosen.
+	SSE2 doesn't have 32-bit integer multiplication, min, max, or conversion to 64-bit integers,
+	and so the int32 kernels that need them stay scalar.
+*/
+
+// Include Files
+//==============
+
+#include "NumericArrayKernels.h"
+
+#ifdef EAE6320_NUMERICARRAY_X86
+
+// (32-bit GCC and Clang builds don't use SSE2 unless they are told to)
+#if defined( __GNUC__ ) && !defined( __SSE2__ )
+	#pragma GCC target( "sse2" )
+#endif
+#include <emmintrin.h>
+
+// Helper Class Declarations
+//==========================
+
+namespace
+{
+	#include "NumericArrayKernels.inl"
+
+	struct sFloat64x2
+	{
+		typedef double tScalar;
+		typedef __m128d tValue;
+		static constexpr size_t s_width = 2;
+
+		static tValue Zero() { return _mm_setzero_pd(); }
+		static tValue Set( const double i_value ) { return _mm_set1_pd( i_value ); }
+		static tValue Load( const double* const i_values ) { return _mm_loadu_pd( i_values ); }
+		// float32 elements are widened so that they are summed as float64
+		static tValue Load( const float* const i_values )
+		{
+			return _mm_cvtps_pd( _mm_castsi128_ps( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( i_values ) ) ) );
+		}
+		static void Store( double* const o_values, const tValue i_value ) { _mm_storeu_pd( o_values, i_value ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm_add_pd( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm_mul_pd( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return _mm_min_pd( i_value1, i_value2 ); }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return _mm_max_pd( i_value1, i_value2 ); }
+
+		static double ReduceAdd( const tValue i_value ) { return _mm_cvtsd_f64( _mm_add_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+		static double ReduceMul( const tValue i_value ) { return _mm_cvtsd_f64( _mm_mul_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+		static double ReduceMin( const tValue i_value ) { return _mm_cvtsd_f64( _mm_min_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+		static double ReduceMax( const tValue i_value ) { return _mm_cvtsd_f64( _mm_max_sd( i_value, _mm_unpackhi_pd( i_value, i_value ) ) ); }
+	};
+
+	struct sFloat32x4
+	{
+		typedef float tScalar;
+		typedef __m128 tValue;
+		static constexpr size_t s_width = 4;
+
+		static tValue Zero() { return _mm_setzero_ps(); }
+		static tValue Set( const float i_value ) { return _mm_set1_ps( i_value ); }
+		static tValue Load( const float* const i_values ) { return _mm_loadu_ps( i_values ); }
+		static void Store( float* const o_values, const tValue i_value ) { _mm_storeu_ps( o_values, i_value ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm_add_ps( i_value1, i_value2 ); }
+		static tValue Mul( const tValue i_value1, const tValue i_value2 ) { return _mm_mul_ps( i_value1, i_value2 ); }
+		static tValue Min( const tValue i_value1, const tValue i_value2 ) { return _mm_min_ps( i_value1, i_value2 ); }
+		static tValue Max( const tValue i_value1, const tValue i_value2 ) { return _mm_max_ps( i_value1, i_value2 ); }
+
+		static float ReduceMin( tValue i_value )
+		{
+			i_value = _mm_min_ps( i_value, _mm_movehl_ps( i_value, i_value ) );
+			return _mm_cvtss_f32( _mm_min_ss( i_value, _mm_shuffle_ps( i_value, i_value, 1 ) ) );
+		}
+		static float ReduceMax( tValue i_value )
+		{
+			i_value = _mm_max_ps( i_value, _mm_movehl_ps( i_value, i_value ) );
+			return _mm_cvtss_f32( _mm_max_ss( i_value, _mm_shuffle_ps( i_value, i_value, 1 ) ) );
+		}
+	};
+
+	struct sInt32x4
+	{
+		typedef int32_t tScalar;
+		typedef __m128i tValue;
+		static constexpr size_t s_width = 4;
+
+		static tValue Load( const int32_t* const i_values ) { return _mm_loadu_si128( reinterpret_cast<const __m128i*>( i_values ) ); }
+		static void Store( int32_t* const o_values, const tValue i_value ) { _mm_storeu_si128( reinterpret_cast<__m128i*>( o_values ), i_value ); }
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm_add_epi32( i_value1, i_value2 ); }
+	};
+
+	// This is only used to sum int32 elements
+	struct sInt64x2
+	{
+		typedef int64_t tScalar;
+		typedef __m128i tValue;
+		static constexpr size_t s_width = 2;
+
+		static tValue Zero() { return _mm_setzero_si128(); }
+		// Two int32 elements are sign extended
+		static tValue Load( const int32_t* const i_values )
+		{
+			const auto values = _mm_loadl_epi64( reinterpret_cast<const __m128i*>( i_values ) );
+			return _mm_unpacklo_epi32( values, _mm_srai_epi32( values, 31 ) );
+		}
+
+		static tValue Add( const tValue i_value1, const tValue i_value2 ) { return _mm_add_epi64( i_value1, i_value2 ); }
+
+		static int64_t ReduceAdd( const tValue i_value )
+		{
+			int64_t lanes[s_width];
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( lanes ), i_value );
+			return AddElements( lanes[0], lanes[1] );
+		}
+	};
+}
+
+// Interface
+//==========
+
+void eae6320::NumericArray::SetKernels_sse2( sKernels& io_kernels )
+{
+	io_kernels.instructionSet = "SSE2";
+
+	io_kernels.float64.sum = Sum<sFloat64x2, double>;
+	io_kernels.float64.product = Product<sFloat64x2, double>;
+	io_kernels.float64.min = Min<sFloat64x2, double>;
+	io_kernels.float64.max = Max<sFloat64x2, double>;
+	io_kernels.float64.dot = Dot<sFloat64x2, double>;
+	io_kernels.float64.axpy = Axpy<sFloat64x2, double>;
+	io_kernels.float64.add = Add<sFloat64x2, double>;
+	io_kernels.float64.mul = Mul<sFloat64x2, double>;
+
+	io_kernels.float32.sum = Sum<sFloat64x2, float>;
+	io_kernels.float32.product = Product<sFloat64x2, float>;
+	io_kernels.float32.min = Min<sFloat32x4, float>;
+	io_kernels.float32.max = Max<sFloat32x4, float>;
+	io_kernels.float32.dot = Dot<sFloat64x2, float>;
+	io_kernels.float32.axpy = Axpy<sFloat32x4, float>;
+	io_kernels.float32.add = Add<sFloat32x4, float>;
+	io_kernels.float32.mul = Mul<sFloat32x4, float>;
+
+	io_kernels.int32.sum = Sum<sInt64x2, int32_t>;
+	io_kernels.int32.add = Add<sInt32x4, int32_t>;
+}
+
+#endif	// EAE6320_NUMERICARRAY_X86
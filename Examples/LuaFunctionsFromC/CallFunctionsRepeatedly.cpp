@@ -0,0 +1,248 @@
+// Include Files
+//==============
+
+#include "CallFunctionsRepeatedly.h"
+
+#include "cLuaFunction.h"
+#include "LuaBatchCall.h"
+
+#include <chrono>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	constexpr unsigned int s_callCount = 1000000;
+
+	// The arguments of a row of ExampleAdd() calls
+	struct sAddends
+	{
+		lua_Number value1;
+		lua_Number value2;
+	};
+	void PushAddends( lua_State& io_luaState, const sAddends& i_addends );
+	void ReadSum( lua_State& io_luaState, lua_Number& o_sum );
+
+	lua_Number CallWithGlobalLookup( lua_State& io_luaState, const lua_Number i_value );
+	lua_Number CallWithHandle( lua_State& io_luaState, const eae6320::cLuaFunction& i_function, const lua_Number i_value );
+}
+
+// Interface
+//==========
+
+void CompareGlobalLookupsAndHandles( lua_State& io_luaState )
+{
+	eae6320::cLuaFunction exampleDouble;
+	if ( !exampleDouble.Bind( io_luaState, "ExampleDouble" ) )
+	{
+		return;
+	}
+
+	// The results are summed so that the calls can't be optimized away
+	// (and so that the two methods can be checked against each other)
+	lua_Number sum_globalLookup = 0.0;
+	const auto startTime_globalLookup = std::chrono::steady_clock::now();
+	for ( unsigned int i = 0; i < s_callCount; ++i )
+	{
+		sum_globalLookup += CallWithGlobalLookup( io_luaState, static_cast<lua_Number>( i ) );
+	}
+	const auto endTime_globalLookup = std::chrono::steady_clock::now();
+
+	lua_Number sum_handle = 0.0;
+	const auto startTime_handle = std::chrono::steady_clock::now();
+	for ( unsigned int i = 0; i < s_callCount; ++i )
+	{
+		sum_handle += CallWithHandle( io_luaState, exampleDouble, static_cast<lua_Number>( i ) );
+	}
+	const auto endTime_handle = std::chrono::steady_clock::now();
+
+	const auto nanosecondsPerCall_globalLookup = std::chrono::duration<double, std::nano>( endTime_globalLookup - startTime_globalLookup ).count() / s_callCount;
+	const auto nanosecondsPerCall_handle = std::chrono::duration<double, std::nano>( endTime_handle - startTime_handle ).count() / s_callCount;
+	std::cout << "Calling ExampleDouble() " << s_callCount << " times:\n"
+		"\tlua_getglobal() before every call: " << nanosecondsPerCall_globalLookup << " ns per call\n"
+		"\tcLuaFunction handle: " << nanosecondsPerCall_handle << " ns per call"
+		<< ( ( sum_globalLookup == sum_handle ) ? "" : " (the results were different!)" ) << std::endl;
+}
+
+bool ReloadScriptAndRebindHandles( lua_State& io_luaState )
+{
+	eae6320::cLuaFunction exampleDouble;
+	if ( !exampleDouble.Bind( io_luaState, "ExampleDouble" ) )
+	{
+		return false;
+	}
+
+	// Loading the script again defines every global function again
+	// (e.g. because the file was changed while the game was running)
+	{
+		const auto result = luaL_dofile( &io_luaState, "luaFunctionsFromC.lua" );
+		if ( result != LUA_OK )
+		{
+			const auto* const errorMessage = lua_tostring( &io_luaState, -1 );
+			std::cerr << errorMessage << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return false;
+		}
+	}
+	// The handle still refers to the function from the first time that the script was loaded
+	{
+		exampleDouble.Push();
+		lua_getglobal( &io_luaState, "ExampleDouble" );
+		const auto isCurrent = lua_rawequal( &io_luaState, -2, -1 ) != 0;
+		lua_pop( &io_luaState, 2 );
+		std::cout << "After reloading the script the handle refers to "
+			<< ( isCurrent ? "the new" : "the old" ) << " ExampleDouble()" << std::endl;
+	}
+	// ...until it is rebound
+	if ( !exampleDouble.Rebind() )
+	{
+		return false;
+	}
+	{
+		exampleDouble.Push();
+		lua_getglobal( &io_luaState, "ExampleDouble" );
+		const auto isCurrent = lua_rawequal( &io_luaState, -2, -1 ) != 0;
+		lua_pop( &io_luaState, 2 );
+		std::cout << "After rebinding the handle refers to "
+			<< ( isCurrent ? "the new" : "the old" ) << " ExampleDouble()" << std::endl;
+	}
+
+	return true;
+}
+
+void CompareCallLoopAndBatchCall( lua_State& io_luaState )
+{
+	eae6320::cLuaFunction exampleAdd;
+	if ( !exampleAdd.Bind( io_luaState, "ExampleAdd" ) )
+	{
+		return;
+	}
+	std::vector<sAddends> rows( s_callCount );
+	for ( unsigned int i = 0; i < s_callCount; ++i )
+	{
+		rows[i] = sAddends{ static_cast<lua_Number>( i ), 0.5 };
+	}
+	std::vector<lua_Number> sums_loop( s_callCount ), sums_batch( s_callCount );
+
+	// A protected call for every row
+	const auto startTime_loop = std::chrono::steady_clock::now();
+	for ( unsigned int i = 0; i < s_callCount; ++i )
+	{
+		exampleAdd.Push();
+		PushAddends( io_luaState, rows[i] );
+		constexpr int argumentCount = 2;
+		constexpr int returnValueCount = 1;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) == LUA_OK )
+		{
+			ReadSum( io_luaState, sums_loop[i] );
+			lua_pop( &io_luaState, returnValueCount );
+		}
+		else
+		{
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+		}
+	}
+	const auto endTime_loop = std::chrono::steady_clock::now();
+
+	// One protected call for all of the rows
+	std::vector<eae6320::LuaBatchCall::sRowError> errors;
+	const auto startTime_batch = std::chrono::steady_clock::now();
+	{
+		exampleAdd.Push();
+		constexpr int argumentCount = 2;
+		constexpr int returnValueCount = 1;
+		eae6320::LuaBatchCall::Call( io_luaState, -1, rows.data(), rows.size(), argumentCount, PushAddends,
+			sums_batch.data(), returnValueCount, ReadSum, errors );
+		lua_pop( &io_luaState, 1 );
+	}
+	const auto endTime_batch = std::chrono::steady_clock::now();
+
+	const auto nanosecondsPerCall_loop = std::chrono::duration<double, std::nano>( endTime_loop - startTime_loop ).count() / s_callCount;
+	const auto nanosecondsPerCall_batch = std::chrono::duration<double, std::nano>( endTime_batch - startTime_batch ).count() / s_callCount;
+	std::cout << "Calling ExampleAdd() for " << s_callCount << " rows:\n"
+		"\tlua_pcall() for every row: " << nanosecondsPerCall_loop << " ns per row\n"
+		"\tbatch call: " << nanosecondsPerCall_batch << " ns per row"
+		<< ( ( errors.empty() && ( sums_loop == sums_batch ) ) ? "" : " (the results were different!)" ) << std::endl;
+}
+
+void ShowBatchCallErrors( lua_State& io_luaState )
+{
+	// ExampleErrorChecking() expects a string,
+	// and so the rows without one will fail while the others are still called
+	const char* const rows[] = { "first row", nullptr, "third row", nullptr };
+	constexpr size_t rowCount = sizeof( rows ) / sizeof( *rows );
+	// The function doesn't return anything
+	// (but every row still needs an element in the output array)
+	bool results[rowCount] = {};
+	std::vector<eae6320::LuaBatchCall::sRowError> errors;
+	lua_getglobal( &io_luaState, "ExampleErrorChecking" );
+	{
+		constexpr int argumentCount = 1;
+		constexpr int returnValueCount = 0;
+		const auto result = eae6320::LuaBatchCall::Call( io_luaState, -1, rows, rowCount,
+			argumentCount, []( lua_State& io_luaState, const char* const& i_row )
+			{
+				// lua_pushstring() pushes nil for NULL
+				lua_pushstring( &io_luaState, i_row );
+			},
+			results, returnValueCount, []( lua_State&, bool& ) {}, errors );
+		if ( !result )
+		{
+			std::cerr << "The batch call couldn't be made" << std::endl;
+		}
+	}
+	lua_pop( &io_luaState, 1 );
+	for ( const auto& error : errors )
+	{
+		std::cerr << "Row #" << ( error.rowIndex + 1 ) << " of the batch call failed: " << error.message << std::endl;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void PushAddends( lua_State& io_luaState, const sAddends& i_addends )
+	{
+		lua_pushnumber( &io_luaState, i_addends.value1 );
+		lua_pushnumber( &io_luaState, i_addends.value2 );
+	}
+
+	void ReadSum( lua_State& io_luaState, lua_Number& o_sum )
+	{
+		o_sum = lua_tonumber( &io_luaState, -1 );
+	}
+
+	lua_Number CallWithGlobalLookup( lua_State& io_luaState, const lua_Number i_value )
+	{
+		// The name is interned and then looked up in the global table for every call
+		lua_getglobal( &io_luaState, "ExampleDouble" );
+		lua_pushnumber( &io_luaState, i_value );
+		constexpr int argumentCount = 1;
+		constexpr int returnValueCount = 1;
+		lua_call( &io_luaState, argumentCount, returnValueCount );
+		const auto result = lua_tonumber( &io_luaState, -1 );
+		lua_pop( &io_luaState, returnValueCount );
+		return result;
+	}
+
+	lua_Number CallWithHandle( lua_State& io_luaState, const eae6320::cLuaFunction& i_function, const lua_Number i_value )
+	{
+		i_function.Push();
+		lua_pushnumber( &io_luaState, i_value );
+		constexpr int argumentCount = 1;
+		constexpr int returnValueCount = 1;
+		lua_call( &io_luaState, argumentCount, returnValueCount );
+		const auto result = lua_tonumber( &io_luaState, -1 );
+		lua_pop( &io_luaState, returnValueCount );
+		return result;
+	}
+}
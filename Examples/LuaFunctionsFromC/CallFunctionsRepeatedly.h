@@ -0,0 +1,24 @@
+/*
+	These examples show how to call the same Lua function many times
+	(e.g. a callback for every entity every frame)
+	without looking it up by name every time
+*/
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+// Interface
+//==========
+
+// Times calling ExampleDouble() using lua_getglobal() before every call
+// and using a cLuaFunction handle
+void CompareGlobalLookupsAndHandles( lua_State& io_luaState );
+// Shows how a handle is rebound after the script that defines its function is reloaded
+bool ReloadScriptAndRebindHandles( lua_State& io_luaState );
+// Times calling ExampleAdd() for every row of an array using lua_pcall() for every row
+// and using a single batch call
+void CompareCallLoopAndBatchCall( lua_State& io_luaState );
+// Shows how the errors of individual rows of a batch call are reported
+void ShowBatchCallErrors( lua_State& io_luaState );
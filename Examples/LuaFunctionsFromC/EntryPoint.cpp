@@ -5,6 +5,9 @@
 // Include Files
 //==============
 
+#include "CallFunctionsRepeatedly.h"
+#include "ScheduleTasks.h"
+
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
 #include <External/Lua/Includes.h>
@@ -243,6 +246,35 @@ int main( int i_argumentCount, char** i_arguments )
 		}
 	}
 
+	// Calling the same function many times
+	{
+		// A function that is called often can be looked up once
+		// instead of before every call
+		CompareGlobalLookupsAndHandles( *luaState );
+		// The lookup has to be done again if the script is reloaded
+		if ( !ReloadScriptAndRebindHandles( *luaState ) )
+		{
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+		// A function that is called for every row of an array
+		// can be called for the whole array in one protected call
+		CompareCallLoopAndBatchCall( *luaState );
+		// An error in one row doesn't stop the others from being called
+		ShowBatchCallErrors( *luaState );
+	}
+
+	// Coroutines that wait
+	{
+		// A scheduler only resumes the tasks that are ready
+		// (instead of every coroutine being resumed every frame to check if it is done waiting)
+		if ( !RunScheduledTasks( *luaState ) )
+		{
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+	}
+
 OnExit:
 
 	if ( luaState )
@@ -0,0 +1,129 @@
+/*
+	A batch call calls the same Lua function once for every row of a C++ array
+	(e.g. a per-entity update function for every entity every frame)
+	and reads the results of each call into a matching output array
+
+	Calling the function with lua_pcall() in a loop pays for a protected call for every row:
+	luaD_rawrunprotected() sets up a new error handler (setjmp()) every time,
+	and the function has to be found and pushed again for every call.
+	A batch call makes one protected call for the whole batch instead:
+	inside it the function is pushed from a stack slot (not looked up),
+	the stack space is checked once,
+	and each row is an ordinary lua_call(), which reuses the same CallInfo (it is cached by the state)
+	and the same stack slots as the previous row.
+
+	An error in one row doesn't stop the batch.
+	The protected call ends, the row's error message is recorded,
+	and a new protected call continues with the next row
+	(and so a batch only costs more than one protected call when there are errors).
+	The results of a row whose function call had an error are left unchanged,
+	but if the error is raised by i_readResults (e.g. because a result had the wrong type)
+	whatever it assigned before the error is kept
+	(the results aren't read into a temporary first
+	because a Lua error is a longjmp() that would skip the temporary's destructor).
+
+	For example, given:
+		struct sEntity { lua_Number x, y, vx, vy; };
+		struct sPosition { lua_Number x, y; };
+	and UpdateEntity( x, y, vx, vy ) that returns the new x and y:
+		lua_getglobal( luaState, "UpdateEntity" );
+		std::vector<eae6320::LuaBatchCall::sRowError> errors;
+		eae6320::LuaBatchCall::Call( *luaState, -1, entities, entityCount,
+			4, []( lua_State& io_luaState, const sEntity& i_entity )
+			{
+				lua_pushnumber( &io_luaState, i_entity.x ); ...
+			},
+			positions, 2, []( lua_State& io_luaState, sPosition& o_position )
+			{
+				o_position.x = lua_tonumber( &io_luaState, -2 ); ...
+			},
+			errors );
+		lua_pop( luaState, 1 );
+
+	The argument pusher and the result reader are called inside the protected call,
+	and so they can raise Lua errors (e.g. luaL_error() if a result has the wrong type)
+	which are recorded as errors of the row.
+	Since a Lua error is a longjmp() they must not have any local objects with destructors
+	(which wouldn't be run).
+*/
+
+#ifndef EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_H
+#define EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace LuaBatchCall
+	{
+		struct sRowError
+		{
+			size_t rowIndex;
+			std::string message;
+		};
+
+		// Calls the function at the given stack index once for every row.
+		//	i_argumentCount: How many arguments i_pushArguments( lua_State&, const tRow& ) pushes for a row
+		//	i_resultCount: How many results i_readResults( lua_State&, tResult& ) reads from the top of the stack
+		//		(o_results must have as many elements as i_rows)
+		// The errors of any rows that failed are added to io_errors.
+		// A failure is only returned if the batch couldn't be run at all
+		// (a batch where some of the rows failed is still a success).
+		// The stack is left unchanged.
+		template <class tRow, class tResult, class tPushArguments, class tReadResults>
+		cResult Call( lua_State& io_luaState, const int i_functionIndex,
+			const tRow* const i_rows, const size_t i_rowCount, const int i_argumentCount, tPushArguments i_pushArguments,
+			tResult* const o_results, const int i_resultCount, tReadResults i_readResults,
+			std::vector<sRowError>& io_errors );
+
+		// Implementation
+		//===============
+
+		namespace Implementation
+		{
+			template <class tRow, class tResult, class tPushArguments, class tReadResults>
+			struct sBatch
+			{
+				const tRow* rows;
+				tResult* results;
+				size_t rowCount;
+				// The row that is being called
+				// (when the protected call fails this is the row that had the error)
+				size_t rowIndex;
+				int argumentCount;
+				int resultCount;
+				tPushArguments* pushArguments;
+				tReadResults* readResults;
+
+				// This is the lua_CFunction that is called in protected mode.
+				// Its arguments are the batch (as a light userdata) and the function to call.
+				static int CallRows( lua_State* io_luaState );
+			};
+
+			// Records the error message at the top of the stack and pops it
+			inline void AddRowError( lua_State& io_luaState, const size_t i_rowIndex, std::vector<sRowError>& io_errors );
+		}
+	}
+}
+
+#include "LuaBatchCall.inl"
+
+#endif	// EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_H
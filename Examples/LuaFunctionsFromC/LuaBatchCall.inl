@@ -0,0 +1,98 @@
+#ifndef EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_INL
+#define EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_INL
+
+// Include Files
+//==============
+
+#include "LuaBatchCall.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+
+// Interface
+//==========
+
+template <class tRow, class tResult, class tPushArguments, class tReadResults>
+eae6320::cResult eae6320::LuaBatchCall::Call( lua_State& io_luaState, const int i_functionIndex,
+	const tRow* const i_rows, const size_t i_rowCount, const int i_argumentCount, tPushArguments i_pushArguments,
+	tResult* const o_results, const int i_resultCount, tReadResults i_readResults,
+	std::vector<sRowError>& io_errors )
+{
+	EAE6320_ASSERT( ( i_argumentCount >= 0 ) && ( i_resultCount >= 0 ) );
+	EAE6320_ASSERT( ( i_rowCount == 0 ) || ( i_rows && o_results ) );
+	if ( !lua_isfunction( &io_luaState, i_functionIndex ) )
+	{
+		// A callable table or userdata would also work,
+		// but it is more likely that the wrong index was given
+		return Results::Failure;
+	}
+	// The protected call, the batch, and the function are pushed
+	if ( !lua_checkstack( &io_luaState, 3 ) )
+	{
+		return Results::OutOfMemory;
+	}
+
+	Implementation::sBatch<tRow, tResult, tPushArguments, tReadResults> batch;
+	batch.rows = i_rows;
+	batch.results = o_results;
+	batch.rowCount = i_rowCount;
+	batch.rowIndex = 0;
+	batch.argumentCount = i_argumentCount;
+	batch.resultCount = i_resultCount;
+	batch.pushArguments = &i_pushArguments;
+	batch.readResults = &i_readResults;
+	const auto functionIndex = lua_absindex( &io_luaState, i_functionIndex );
+	while ( batch.rowIndex < i_rowCount )
+	{
+		lua_pushcfunction( &io_luaState, batch.CallRows );
+		lua_pushlightuserdata( &io_luaState, &batch );
+		lua_pushvalue( &io_luaState, functionIndex );
+		constexpr int argumentCount = 2;
+		constexpr int returnValueCount = 0;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			// Continue with the row after the one that failed
+			Implementation::AddRowError( io_luaState, batch.rowIndex, io_errors );
+			++batch.rowIndex;
+		}
+	}
+
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+template <class tRow, class tResult, class tPushArguments, class tReadResults>
+int eae6320::LuaBatchCall::Implementation::sBatch<tRow, tResult, tPushArguments, tReadResults>::CallRows( lua_State* io_luaState )
+{
+	auto& batch = *static_cast<sBatch*>( lua_touserdata( io_luaState, 1 ) );
+	constexpr int functionIndex = 2;
+	// The stack is only checked once for every row
+	luaL_checkstack( io_luaState, 1 + std::max( batch.argumentCount, batch.resultCount ), "too many arguments or results for a batch call" );
+	for ( ; batch.rowIndex < batch.rowCount; ++batch.rowIndex )
+	{
+		lua_pushvalue( io_luaState, functionIndex );
+		( *batch.pushArguments )( *io_luaState, batch.rows[batch.rowIndex] );
+		EAE6320_ASSERTF( lua_gettop( io_luaState ) == ( functionIndex + 1 + batch.argumentCount ),
+			"The arguments of a batch call's row must push the number of arguments that the batch was given" );
+		lua_call( io_luaState, batch.argumentCount, batch.resultCount );
+		( *batch.readResults )( *io_luaState, batch.results[batch.rowIndex] );
+		lua_settop( io_luaState, functionIndex );
+	}
+	constexpr int returnValueCount = 0;
+	return returnValueCount;
+}
+
+inline void eae6320::LuaBatchCall::Implementation::AddRowError( lua_State& io_luaState, const size_t i_rowIndex, std::vector<sRowError>& io_errors )
+{
+	const auto* const errorMessage = lua_tostring( &io_luaState, -1 );
+	io_errors.push_back( sRowError{ i_rowIndex,
+		errorMessage ? errorMessage : "(the error object isn't a string)" } );
+	lua_pop( &io_luaState, 1 );
+}
+
+#endif	// EAE6320_LUAFUNCTIONSFROMC_LUABATCHCALL_INL
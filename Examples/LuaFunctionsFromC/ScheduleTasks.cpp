@@ -0,0 +1,101 @@
+// Include Files
+//==============
+
+#include "ScheduleTasks.h"
+
+#include "cTaskScheduler.h"
+
+#include <chrono>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <future>
+#include <iostream>
+#include <thread>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	constexpr double s_secondsPerFrame = 1.0 / 60.0;
+	// The tasks should all end well before this
+	constexpr unsigned int s_maxFrameCount = 300;
+
+	bool SpawnGlobalFunction( eae6320::cTaskScheduler& io_scheduler, lua_State& io_luaState, const char* const i_globalName );
+}
+
+// Interface
+//==========
+
+bool RunScheduledTasks( lua_State& io_luaState )
+{
+	eae6320::cTaskScheduler scheduler;
+	if ( !scheduler.Initialize( io_luaState ) )
+	{
+		return false;
+	}
+
+	// Start the tasks
+	{
+		lua_getglobal( &io_luaState, "ExampleBlinkingTask" );
+		lua_pushstring( &io_luaState, "The light" );
+		lua_pushnumber( &io_luaState, 0.25 );
+		lua_pushinteger( &io_luaState, 4 );
+		constexpr int argumentCount = 3;
+		if ( !scheduler.Spawn( argumentCount ) )
+		{
+			return false;
+		}
+	}
+	if ( !SpawnGlobalFunction( scheduler, io_luaState, "ExampleLoadingTask" ) )
+	{
+		return false;
+	}
+	{
+		lua_getglobal( &io_luaState, "ExampleCountdownTask" );
+		lua_pushnumber( &io_luaState, 0.75 );
+		constexpr int argumentCount = 1;
+		if ( !scheduler.Spawn( argumentCount ) )
+		{
+			return false;
+		}
+	}
+	// The assets are "loaded" on another thread,
+	// and the task that waits for them is resumed at the first tick after they are done
+	auto loadAssets = std::async( std::launch::async, []()
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 300 ) );
+		} ).share();
+	scheduler.SignalWhenReady( loadAssets, "assetsLoaded" );
+
+	// Tick the scheduler every frame
+	unsigned int frameCount = 0;
+	const auto startTime = std::chrono::steady_clock::now();
+	for ( ; ( scheduler.GetTaskCount() > 0 ) && ( frameCount < s_maxFrameCount ); ++frameCount )
+	{
+		scheduler.Tick( s_secondsPerFrame );
+		std::this_thread::sleep_until( startTime
+			+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<double>( ( frameCount + 1 ) * s_secondsPerFrame ) ) );
+	}
+	if ( scheduler.GetTaskCount() > 0 )
+	{
+		std::cerr << scheduler.GetTaskCount() << " tasks still hadn't ended after " << frameCount << " frames" << std::endl;
+		return false;
+	}
+	std::cout << "Every task ended after " << frameCount << " frames" << std::endl;
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool SpawnGlobalFunction( eae6320::cTaskScheduler& io_scheduler, lua_State& io_luaState, const char* const i_globalName )
+	{
+		lua_getglobal( &io_luaState, i_globalName );
+		constexpr int argumentCount = 0;
+		return io_scheduler.Spawn( argumentCount );
+	}
+}
@@ -0,0 +1,17 @@
+/*
+	This example shows how a task scheduler runs Lua functions as coroutines
+	that wait for time to pass, for conditions, and for events from C++
+	(instead of the C++ program resuming each coroutine every frame)
+*/
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+// Interface
+//==========
+
+// Runs the example tasks in luaFunctionsFromC.lua until they end
+// (simulating a frame every 1/60th of a second)
+bool RunScheduledTasks( lua_State& io_luaState );
@@ -0,0 +1,89 @@
+// Include Files
+//==============
+
+#include "cLuaFunction.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// The header can't include Lua just for this
+static_assert( LUA_NOREF == -2, "The default reference of a function handle must be LUA_NOREF" );
+
+// Interface
+//==========
+
+// Access
+//-------
+
+bool eae6320::cLuaFunction::IsBound() const
+{
+	return m_reference != LUA_NOREF;
+}
+
+void eae6320::cLuaFunction::Push() const
+{
+	EAE6320_ASSERT( IsBound() );
+	// The registry is a table like any other,
+	// and the references that luaL_ref() returns are keys in its array part
+	lua_rawgeti( m_luaState, LUA_REGISTRYINDEX, m_reference );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+bool eae6320::cLuaFunction::Bind( lua_State& io_luaState, const char* const i_globalName )
+{
+	Unbind();
+
+	lua_getglobal( &io_luaState, i_globalName );
+	if ( !lua_isfunction( &io_luaState, -1 ) )
+	{
+		std::cerr << "The global \"" << i_globalName << "\" can't be bound because it is a "
+			<< luaL_typename( &io_luaState, -1 ) << " (instead of a function)" << std::endl;
+		lua_pop( &io_luaState, 1 );
+		return false;
+	}
+	// luaL_ref() pops the function
+	m_reference = luaL_ref( &io_luaState, LUA_REGISTRYINDEX );
+	m_luaState = &io_luaState;
+	m_globalName = i_globalName;
+	return true;
+}
+
+bool eae6320::cLuaFunction::Rebind()
+{
+	if ( !IsBound() )
+	{
+		return false;
+	}
+
+	lua_getglobal( m_luaState, m_globalName.c_str() );
+	if ( !lua_isfunction( m_luaState, -1 ) )
+	{
+		std::cerr << "The global \"" << m_globalName << "\" can't be rebound because it is a "
+			<< luaL_typename( m_luaState, -1 ) << " (instead of a function)" << std::endl;
+		lua_pop( m_luaState, 1 );
+		return false;
+	}
+	// Overwriting the existing reference's value
+	// is cheaper than releasing it and creating a new one
+	lua_rawseti( m_luaState, LUA_REGISTRYINDEX, m_reference );
+	return true;
+}
+
+void eae6320::cLuaFunction::Unbind()
+{
+	if ( IsBound() )
+	{
+		luaL_unref( m_luaState, LUA_REGISTRYINDEX, m_reference );
+		m_reference = LUA_NOREF;
+	}
+	m_luaState = nullptr;
+	m_globalName.clear();
+}
+
+eae6320::cLuaFunction::~cLuaFunction()
+{
+	Unbind();
+}
@@ -0,0 +1,84 @@
+/*
+	A Lua function handle is a C++ reference to a global Lua function
+	that can be pushed onto the stack without looking the function up by name
+
+	Calling lua_getglobal() before every call hashes the name
+	and searches the global table for it every time.
+	A handle does that once when it is bound
+	and keeps its own reference to the function in the registry (using luaL_ref()),
+	and so pushing it is just an array lookup (using lua_rawgeti()).
+
+	The reference is to the function itself, not to the global variable,
+	and so if the script that defines the function is loaded again
+	the handle will keep calling the old function until it is rebound.
+*/
+
+#ifndef EAE6320_LUAFUNCTIONSFROMC_CLUAFUNCTION_H
+#define EAE6320_LUAFUNCTIONSFROMC_CLUAFUNCTION_H
+
+// Include Files
+//==============
+
+#include <string>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cLuaFunction
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Access
+		//-------
+
+		bool IsBound() const;
+		const std::string& GetGlobalName() const { return m_globalName; }
+
+		// Pushes the function onto the stack of the state that it was bound to
+		// (after this the arguments can be pushed and lua_call() or lua_pcall() can be called as usual).
+		// The handle must be bound.
+		void Push() const;
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// Looks up the global function with the given name and keeps a reference to it.
+		// Returns false (and leaves the handle unbound) if the global isn't a function.
+		bool Bind( lua_State& io_luaState, const char* const i_globalName );
+		// Looks up the global function again
+		// (this should be called after the script that defines the function has been reloaded).
+		// The same registry slot is reused,
+		// and if the global isn't a function anymore the handle keeps referring to the old one.
+		bool Rebind();
+		// This must be called (or the handle destroyed) before the state is closed
+		void Unbind();
+
+		cLuaFunction() = default;
+		~cLuaFunction();
+
+		cLuaFunction( const cLuaFunction& ) = delete;
+		cLuaFunction& operator =( const cLuaFunction& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		lua_State* m_luaState = nullptr;
+		std::string m_globalName;
+		// This is LUA_NOREF if the handle isn't bound
+		int m_reference = -2;
+	};
+}
+
+#endif	// EAE6320_LUAFUNCTIONSFROMC_CLUAFUNCTION_H
@@ -0,0 +1,419 @@
+// Include Files
+//==============
+
+#include "cTaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <utility>
+
+// The header can't include Lua just for this
+static_assert( LUA_NOREF == -2, "The default references of a task scheduler must be LUA_NOREF" );
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// std::push_heap() and std::pop_heap() make a max-heap,
+	// and so a min-heap compares which task wakes later
+	struct sWakesLater
+	{
+		template <typename tSleepingTask>
+		bool operator ()( const tSleepingTask& i_lhs, const tSleepingTask& i_rhs ) const
+		{
+			return ( i_lhs.wakeTime > i_rhs.wakeTime )
+				|| ( ( i_lhs.wakeTime == i_rhs.wakeTime ) && ( i_lhs.order > i_rhs.order ) );
+		}
+	};
+}
+
+// Interface
+//==========
+
+// Tasks
+//------
+
+eae6320::cResult eae6320::cTaskScheduler::Spawn( const int i_argumentCount )
+{
+	EAE6320_ASSERT( m_luaState );
+	EAE6320_ASSERT( ( i_argumentCount >= 0 ) && ( lua_gettop( m_luaState ) > i_argumentCount ) );
+
+	const auto functionIndex = lua_gettop( m_luaState ) - i_argumentCount;
+	if ( !lua_isfunction( m_luaState, functionIndex ) )
+	{
+		std::cerr << "A task can't be spawned with a " << luaL_typename( m_luaState, functionIndex )
+			<< " (instead of a function)" << std::endl;
+		lua_pop( m_luaState, i_argumentCount + 1 );
+		return Results::Failure;
+	}
+	// The function and its arguments are moved to the task's thread,
+	// where the first resume will call it
+	auto* const thread = lua_newthread( m_luaState );
+	lua_insert( m_luaState, functionIndex );
+	lua_xmove( m_luaState, thread, i_argumentCount + 1 );
+	// luaL_ref() pops the thread
+	const auto reference = luaL_ref( m_luaState, LUA_REGISTRYINDEX );
+	m_readyTasks.push_back( sTask{ thread, reference } );
+	++m_taskCount;
+	return Results::Success;
+}
+
+void eae6320::cTaskScheduler::Tick( const double i_secondsElapsed )
+{
+	EAE6320_ASSERT( m_luaState );
+	EAE6320_ASSERT( !m_runningThread );
+
+	m_time += i_secondsElapsed;
+
+	// Signal the events of futures that are ready
+	for ( size_t i = 0; i < m_futures.size(); )
+	{
+		if ( m_futures[i].future.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+		{
+			Signal( m_futures[i].eventName.c_str() );
+			if ( ( i + 1 ) < m_futures.size() )
+			{
+				m_futures[i] = std::move( m_futures.back() );
+			}
+			m_futures.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+	// Call the predicates of the tasks that are waiting until they are true
+	for ( size_t i = 0; i < m_pollingTasks.size(); )
+	{
+		const auto pollingTask = m_pollingTasks[i];
+		lua_rawgeti( m_luaState, LUA_REGISTRYINDEX, pollingTask.predicateReference );
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noMessageHandler = 0;
+		const auto result = lua_pcall( m_luaState, argumentCount, returnValueCount, noMessageHandler );
+		const auto isReady = ( result == LUA_OK ) && lua_toboolean( m_luaState, -1 );
+		if ( result != LUA_OK )
+		{
+			// A predicate's error ends its task
+			std::cerr << lua_tostring( m_luaState, -1 ) << std::endl;
+		}
+		lua_pop( m_luaState, 1 );
+		if ( ( result != LUA_OK ) || isReady )
+		{
+			luaL_unref( m_luaState, LUA_REGISTRYINDEX, pollingTask.predicateReference );
+			if ( isReady )
+			{
+				m_readyTasks.push_back( pollingTask.task );
+			}
+			else
+			{
+				EndTask( pollingTask.task );
+			}
+			m_pollingTasks[i] = m_pollingTasks.back();
+			m_pollingTasks.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+	// Wake the sleeping tasks that are due
+	// (which are at the front of the heap, and so the others aren't looked at)
+	while ( !m_sleepingTasks.empty() && ( m_sleepingTasks.front().wakeTime <= m_time ) )
+	{
+		std::pop_heap( m_sleepingTasks.begin(), m_sleepingTasks.end(), sWakesLater() );
+		m_readyTasks.push_back( m_sleepingTasks.back().task );
+		m_sleepingTasks.pop_back();
+	}
+	// Resume the ready tasks
+	// (any task that becomes ready while they run is added to the emptied list for the next tick)
+	m_resumingTasks.swap( m_readyTasks );
+	for ( const auto& task : m_resumingTasks )
+	{
+		Resume( task );
+	}
+	m_resumingTasks.clear();
+}
+
+// Events
+//-------
+
+size_t eae6320::cTaskScheduler::Signal( const char* const i_eventName )
+{
+	const auto iterator = m_eventTasks.find( i_eventName );
+	if ( iterator == m_eventTasks.end() )
+	{
+		return 0;
+	}
+	const auto& tasks = iterator->second;
+	const auto taskCount = tasks.size();
+	m_readyTasks.insert( m_readyTasks.end(), tasks.begin(), tasks.end() );
+	m_eventTasks.erase( iterator );
+	return taskCount;
+}
+
+void eae6320::cTaskScheduler::SignalWhenReady( std::shared_future<void> i_future, const char* const i_eventName )
+{
+	EAE6320_ASSERT( i_future.valid() );
+	m_futures.push_back( sFuture{ std::move( i_future ), i_eventName } );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::cTaskScheduler::Initialize( lua_State& io_luaState )
+{
+	CleanUp();
+
+	m_luaState = &io_luaState;
+	// Every scheduler function has the userdata as an upvalue,
+	// and the registry also keeps a reference to it so that it can be cleared when the scheduler is cleaned up
+	// (even if the functions are collected first)
+	m_self = static_cast<cTaskScheduler**>( lua_newuserdata( &io_luaState, sizeof( cTaskScheduler* ) ) );
+	*m_self = this;
+	lua_pushvalue( &io_luaState, -1 );
+	m_selfReference = luaL_ref( &io_luaState, LUA_REGISTRYINDEX );
+	{
+		const luaL_Reg functions[] =
+		{
+			{ "spawn", SpawnFromLua },
+			{ "wait", Wait },
+			{ "wait_until", WaitUntil },
+			{ "wait_event", WaitEvent },
+			{ "signal", SignalFromLua },
+			{ "time", Time },
+			{ nullptr, nullptr }
+		};
+		luaL_newlibtable( &io_luaState, functions );
+		lua_insert( &io_luaState, -2 );
+		constexpr int upvalueCount = 1;
+		luaL_setfuncs( &io_luaState, functions, upvalueCount );
+	}
+	lua_setglobal( &io_luaState, "scheduler" );
+
+	return Results::Success;
+}
+
+void eae6320::cTaskScheduler::CleanUp()
+{
+	if ( !m_luaState )
+	{
+		return;
+	}
+
+	for ( const auto& task : m_readyTasks )
+	{
+		EndTask( task );
+	}
+	m_readyTasks.clear();
+	for ( const auto& sleepingTask : m_sleepingTasks )
+	{
+		EndTask( sleepingTask.task );
+	}
+	m_sleepingTasks.clear();
+	for ( const auto& pollingTask : m_pollingTasks )
+	{
+		luaL_unref( m_luaState, LUA_REGISTRYINDEX, pollingTask.predicateReference );
+		EndTask( pollingTask.task );
+	}
+	m_pollingTasks.clear();
+	for ( const auto& eventTasks : m_eventTasks )
+	{
+		for ( const auto& task : eventTasks.second )
+		{
+			EndTask( task );
+		}
+	}
+	m_eventTasks.clear();
+	m_futures.clear();
+	EAE6320_ASSERT( m_taskCount == 0 );
+
+	*m_self = nullptr;
+	luaL_unref( m_luaState, LUA_REGISTRYINDEX, m_selfReference );
+	m_self = nullptr;
+	m_selfReference = LUA_NOREF;
+	m_luaState = nullptr;
+	m_time = 0.0;
+	m_sleepCount = 0;
+}
+
+eae6320::cTaskScheduler::~cTaskScheduler()
+{
+	CleanUp();
+}
+
+// Implementation
+//===============
+
+void eae6320::cTaskScheduler::Resume( const sTask& i_task )
+{
+	auto* const thread = i_task.thread;
+	// A task that hasn't started yet has its function and the function's arguments on its stack
+	int argumentCount = 0;
+	if ( lua_status( thread ) == LUA_OK )
+	{
+		// spawn() returns the thread, and so a script could have resumed it itself
+		// (with coroutine.resume()) and the function could have returned,
+		// which leaves the thread with an empty stack and nothing to resume
+		if ( lua_gettop( thread ) == 0 )
+		{
+			EndTask( i_task );
+			return;
+		}
+		argumentCount = lua_gettop( thread ) - 1;
+	}
+	m_runningThread = thread;
+	m_wait = eWait::Tick;
+	const auto result = lua_resume( thread, m_luaState, argumentCount );
+	m_runningThread = nullptr;
+	if ( result == LUA_YIELD )
+	{
+		// Anything that the task yielded is discarded
+		lua_settop( thread, 0 );
+		switch ( m_wait )
+		{
+		case eWait::Tick:
+			m_readyTasks.push_back( i_task );
+			break;
+		case eWait::Time:
+			m_sleepingTasks.push_back( sSleepingTask{ m_wakeTime, m_sleepCount++, i_task } );
+			std::push_heap( m_sleepingTasks.begin(), m_sleepingTasks.end(), sWakesLater() );
+			break;
+		case eWait::Predicate:
+			m_pollingTasks.push_back( sPollingTask{ i_task, m_predicateReference } );
+			m_predicateReference = LUA_NOREF;
+			break;
+		case eWait::Event:
+			m_eventTasks[m_eventName].push_back( i_task );
+			break;
+		}
+	}
+	else
+	{
+		if ( result != LUA_OK )
+		{
+			luaL_traceback( m_luaState, thread, lua_tostring( thread, -1 ), 0 );
+			std::cerr << lua_tostring( m_luaState, -1 ) << std::endl;
+			lua_pop( m_luaState, 1 );
+		}
+		EndTask( i_task );
+	}
+}
+
+void eae6320::cTaskScheduler::EndTask( const sTask& i_task )
+{
+	EAE6320_ASSERT( m_taskCount > 0 );
+	// Once the registry doesn't refer to the thread it can be collected
+	luaL_unref( m_luaState, LUA_REGISTRYINDEX, i_task.reference );
+	--m_taskCount;
+}
+
+// Scheduler Functions
+//--------------------
+
+eae6320::cTaskScheduler& eae6320::cTaskScheduler::GetScheduler( lua_State& io_luaState )
+{
+	auto* const scheduler = *static_cast<cTaskScheduler**>( lua_touserdata( &io_luaState, lua_upvalueindex( 1 ) ) );
+	if ( !scheduler )
+	{
+		luaL_error( &io_luaState, "the task scheduler has been cleaned up" );
+	}
+	return *scheduler;
+}
+
+void eae6320::cTaskScheduler::CheckIsTask( lua_State& io_luaState, const char* const i_functionName ) const
+{
+	if ( &io_luaState != m_runningThread )
+	{
+		luaL_error( &io_luaState, "scheduler.%s() can only be called by a task (and not by a coroutine that a task resumed)",
+			i_functionName );
+	}
+	if ( !lua_isyieldable( &io_luaState ) )
+	{
+		luaL_error( &io_luaState, "scheduler.%s() can't be called from a function that can't yield", i_functionName );
+	}
+}
+
+int eae6320::cTaskScheduler::SpawnFromLua( lua_State* io_luaState )
+{
+	auto& scheduler = GetScheduler( *io_luaState );
+	luaL_checktype( io_luaState, 1, LUA_TFUNCTION );
+
+	const auto argumentCount = lua_gettop( io_luaState ) - 1;
+	auto* const thread = lua_newthread( io_luaState );
+	lua_insert( io_luaState, 1 );
+	lua_xmove( io_luaState, thread, argumentCount + 1 );
+	// The thread is returned, and the registry refers to a copy of it
+	lua_pushvalue( io_luaState, 1 );
+	const auto reference = luaL_ref( io_luaState, LUA_REGISTRYINDEX );
+	scheduler.m_readyTasks.push_back( sTask{ thread, reference } );
+	++scheduler.m_taskCount;
+
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTaskScheduler::Wait( lua_State* io_luaState )
+{
+	auto& scheduler = GetScheduler( *io_luaState );
+	const auto seconds = luaL_checknumber( io_luaState, 1 );
+	// (a NaN would never be due, and it would break the order of the heap)
+	luaL_argcheck( io_luaState, !std::isnan( seconds ), 1, "the time can't be NaN" );
+	scheduler.CheckIsTask( *io_luaState, "wait" );
+
+	scheduler.m_wait = eWait::Time;
+	scheduler.m_wakeTime = scheduler.m_time + seconds;
+	constexpr int returnValueCount = 0;
+	return lua_yield( io_luaState, returnValueCount );
+}
+
+int eae6320::cTaskScheduler::WaitUntil( lua_State* io_luaState )
+{
+	auto& scheduler = GetScheduler( *io_luaState );
+	luaL_checktype( io_luaState, 1, LUA_TFUNCTION );
+	scheduler.CheckIsTask( *io_luaState, "wait_until" );
+
+	lua_settop( io_luaState, 1 );
+	scheduler.m_predicateReference = luaL_ref( io_luaState, LUA_REGISTRYINDEX );
+	scheduler.m_wait = eWait::Predicate;
+	constexpr int returnValueCount = 0;
+	return lua_yield( io_luaState, returnValueCount );
+}
+
+int eae6320::cTaskScheduler::WaitEvent( lua_State* io_luaState )
+{
+	auto& scheduler = GetScheduler( *io_luaState );
+	const auto* const eventName = luaL_checkstring( io_luaState, 1 );
+	scheduler.CheckIsTask( *io_luaState, "wait_event" );
+
+	scheduler.m_eventName = eventName;
+	scheduler.m_wait = eWait::Event;
+	constexpr int returnValueCount = 0;
+	return lua_yield( io_luaState, returnValueCount );
+}
+
+int eae6320::cTaskScheduler::SignalFromLua( lua_State* io_luaState )
+{
+	auto& scheduler = GetScheduler( *io_luaState );
+	const auto* const eventName = luaL_checkstring( io_luaState, 1 );
+
+	const auto taskCount = scheduler.Signal( eventName );
+	lua_pushinteger( io_luaState, static_cast<lua_Integer>( taskCount ) );
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTaskScheduler::Time( lua_State* io_luaState )
+{
+	const auto& scheduler = GetScheduler( *io_luaState );
+
+	lua_pushnumber( io_luaState, static_cast<lua_Number>( scheduler.m_time ) );
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
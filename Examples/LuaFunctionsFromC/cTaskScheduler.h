@@ -0,0 +1,202 @@
+/*
+	A task scheduler runs Lua functions as coroutines ("tasks") that wait for something to happen
+	and resumes each task only when what it is waiting for has happened
+	(instead of every game system resuming its own coroutines every frame to ask them if they are done waiting)
+
+	The scheduler adds a "scheduler" global to the state with these functions:
+		scheduler.spawn( f, ... )			Starts a task that calls f( ... ) at the next tick (and returns its thread)
+		scheduler.wait( seconds )			Waits until at least the given number of seconds have passed
+		scheduler.wait_until( predicate )	Waits until predicate() returns true (it is called once every tick)
+		scheduler.wait_event( name )		Waits until the event with the given name is signaled
+		scheduler.signal( name )			Signals an event (and returns how many tasks were waiting for it)
+		scheduler.time()					Returns how many seconds have passed (in ticks)
+	The host calls Tick() once per frame,
+	and can signal events itself or have a future signal one when it is ready:
+		scheduler.Signal( "levelLoaded" );
+		scheduler.SignalWhenReady( std::async( std::launch::async, LoadLevel ).share(), "levelLoaded" );
+
+	A sleeping task is in a min-heap ordered by the time that it wakes,
+	and so a tick only looks at the tasks that are due:
+	a task that is waiting for a time or for an event costs nothing until it is resumed.
+	(A task that is waiting with a predicate costs a call to the predicate every tick,
+	and a task that yields with coroutine.yield() is resumed at the next tick.)
+
+	An event is not remembered:
+	a task that starts waiting for an event after it was signaled waits for the next signal.
+	If a task has an error the error message (with a stack traceback) is written to std::cerr
+	and the task is ended.
+*/
+
+#ifndef EAE6320_LUAFUNCTIONSFROMC_CTASKSCHEDULER_H
+#define EAE6320_LUAFUNCTIONSFROMC_CTASKSCHEDULER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cTaskScheduler
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Tasks
+		//------
+
+		// Starts a task that calls the function below the given number of arguments at the top of the stack
+		// (which are popped) at the next tick
+		cResult Spawn( const int i_argumentCount );
+		// Advances the time, and then resumes every task that is ready:
+		//	* The tasks that were spawned (or that yielded) since the last tick
+		//	* The tasks whose predicates are true and whose events were signaled
+		//	* The tasks whose time to wake is now or earlier
+		// Tasks that become ready during the tick are resumed at the next one.
+		void Tick( const double i_secondsElapsed );
+
+		// Events
+		//-------
+
+		// Makes every task that is waiting for the event ready to be resumed at the next tick,
+		// and returns how many there were
+		size_t Signal( const char* const i_eventName );
+		// Signals the event at the first tick that the future is ready at
+		void SignalWhenReady( std::shared_future<void> i_future, const char* const i_eventName );
+
+		// Access
+		//-------
+
+		double GetTime() const { return m_time; }
+		// How many tasks haven't ended
+		size_t GetTaskCount() const { return m_taskCount; }
+		size_t GetSleepingTaskCount() const { return m_sleepingTasks.size(); }
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// Adds the "scheduler" global
+		cResult Initialize( lua_State& io_luaState );
+		// Ends every task (without resuming it).
+		// This must be called (or the scheduler destroyed) before the state is closed,
+		// and after it any call to a scheduler function from Lua is an error.
+		void CleanUp();
+
+		cTaskScheduler() = default;
+		~cTaskScheduler();
+
+		cTaskScheduler( const cTaskScheduler& ) = delete;
+		cTaskScheduler& operator =( const cTaskScheduler& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		struct sTask
+		{
+			lua_State* thread;
+			// The thread's reference in the registry (which keeps it from being collected)
+			int reference;
+		};
+		struct sSleepingTask
+		{
+			double wakeTime;
+			// Tasks that wake at the same time are resumed in the order that they started waiting
+			uint64_t order;
+			sTask task;
+		};
+		struct sPollingTask
+		{
+			sTask task;
+			int predicateReference;
+		};
+		struct sFuture
+		{
+			std::shared_future<void> future;
+			std::string eventName;
+		};
+
+		lua_State* m_luaState = nullptr;
+		// The scheduler functions find the scheduler through this userdata
+		// (which is set to NULL when the scheduler is cleaned up)
+		cTaskScheduler** m_self = nullptr;
+		int m_selfReference = -2;
+
+		double m_time = 0.0;
+		uint64_t m_sleepCount = 0;
+		size_t m_taskCount = 0;
+
+		std::vector<sTask> m_readyTasks;
+		// The ready tasks that a tick is resuming
+		// (which is a member so that its memory is reused)
+		std::vector<sTask> m_resumingTasks;
+		// This is a min-heap (the task that wakes first is at the front)
+		std::vector<sSleepingTask> m_sleepingTasks;
+		std::vector<sPollingTask> m_pollingTasks;
+		std::unordered_map<std::string, std::vector<sTask>> m_eventTasks;
+		std::vector<sFuture> m_futures;
+
+		// What the running task is waiting for
+		// (which the scheduler functions set before they yield)
+		enum class eWait
+		{
+			// A task that yields without calling a scheduler function is resumed at the next tick
+			Tick,
+			Time,
+			Predicate,
+			Event,
+		};
+		lua_State* m_runningThread = nullptr;
+		eWait m_wait = eWait::Tick;
+		double m_wakeTime = 0.0;
+		int m_predicateReference = -2;
+		std::string m_eventName;
+
+		// Implementation
+		//===============
+
+	private:
+
+		void Resume( const sTask& i_task );
+		void EndTask( const sTask& i_task );
+
+		// Scheduler Functions
+		//--------------------
+
+		// Returns the scheduler of the function that is running (or raises an error if it was cleaned up)
+		static cTaskScheduler& GetScheduler( lua_State& io_luaState );
+		// Raises an error if the calling thread isn't the running task
+		// (e.g. if it is a coroutine that the task resumed)
+		void CheckIsTask( lua_State& io_luaState, const char* const i_functionName ) const;
+
+		static int SpawnFromLua( lua_State* io_luaState );
+		static int Wait( lua_State* io_luaState );
+		static int WaitUntil( lua_State* io_luaState );
+		static int WaitEvent( lua_State* io_luaState );
+		static int SignalFromLua( lua_State* io_luaState );
+		static int Time( lua_State* io_luaState );
+	};
+}
+
+#endif	// EAE6320_LUAFUNCTIONSFROMC_CTASKSCHEDULER_H
@@ -60,3 +60,37 @@ function ExampleErrorChecking( i_argument )
 			"(instead of a string)" )
 	end
 end
+
+-- These functions are run as tasks by a task scheduler
+-- (refer to ScheduleTasks.cpp for how the C/C++ program runs them),
+-- which resumes a task only when what it is waiting for has happened
+
+-- This task waits for an amount of time between steps:
+function ExampleBlinkingTask( i_name, i_period, i_count )
+	for i = 1, i_count do
+		scheduler.wait( i_period )
+		print( string.format( "%.2f: %s is %s", scheduler.time(), i_name, ( ( i % 2 ) == 1 ) and "on" or "off" ) )
+	end
+end
+
+-- This task waits for an event that the C/C++ program signals:
+function ExampleLoadingTask()
+	print( string.format( "%.2f: Waiting for the assets to load", scheduler.time() ) )
+	scheduler.wait_event( "assetsLoaded" )
+	print( string.format( "%.2f: The assets have loaded", scheduler.time() ) )
+	-- A task can also signal events for other tasks
+	scheduler.signal( "levelStarted" )
+end
+
+-- This task waits until a condition is true:
+function ExampleCountdownTask( i_seconds )
+	local startTime = scheduler.time()
+	scheduler.spawn( function()
+		scheduler.wait_event( "levelStarted" )
+		print( string.format( "%.2f: The level has started", scheduler.time() ) )
+	end )
+	scheduler.wait_until( function()
+		return ( scheduler.time() - startTime ) >= i_seconds
+	end )
+	print( string.format( "%.2f: The countdown of %g seconds is over", scheduler.time(), i_seconds ) )
+end
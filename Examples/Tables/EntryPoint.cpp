@@ -5,35 +5,71 @@
 // Include Files
 //==============
 
+#include "LoadAssetsInParallel.h"
 #include "LoadTableFromFile.h"
 #include "ReadNestedTableValues.h"
+#include "ReadTableValuesWithSchema.h"
 #include "ReadTopLevelTableValues.h"
+#include "ShareTableSnapshot.h"
+
+#include "cBytecodeCache.h"
 
 #include <cstdlib>
 #include <Engine/Results/Results.h>
+#include <iostream>
 
 // Entry Point
 //============
 
 int main( int i_argumentCount, char** i_arguments )
 {
+	// Every example loads its asset files through the same bytecode cache
+	// so that a source file only has to be parsed when it has changed
+	eae6320::cBytecodeCache bytecodeCache;
+
 	// How to load an asset using a Lua table as its file format
-	if ( !LoadTableFromFile() )
+	if ( !LoadTableFromFile( bytecodeCache ) )
 	{
 		return EXIT_FAILURE;
 	}
 
 	// How to read basic values from an asset table
-	if ( !ReadTopLevelTableValues() )
+	if ( !ReadTopLevelTableValues( bytecodeCache ) )
 	{
 		return EXIT_FAILURE;
 	}
 
 	// How to read tables within an asset table
-	if ( !ReadNestedTableValues() )
+	if ( !ReadNestedTableValues( bytecodeCache ) )
 	{
 		return EXIT_FAILURE;
 	}
 
+	// How to read tables into C++ structs using a schema
+	if ( !ReadTableValuesWithSchema( bytecodeCache ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	// How to load many assets using multiple threads
+	if ( !LoadAssetsInParallel( bytecodeCache ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	// How to share one read-only table between the states of many threads
+	if ( !ShareTableSnapshot( bytecodeCache ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	// The first time the program runs every load of a new file will be a miss;
+	// after that every load should be a hit until a source file is changed
+	{
+		const auto statistics = bytecodeCache.GetStatistics();
+		std::cout << "Bytecode cache: " << statistics.hitCount << " hits, " << statistics.missCount << " misses ("
+			<< statistics.staleCount << " stale)" << std::endl;
+	}
+
 	return EXIT_SUCCESS;
 }
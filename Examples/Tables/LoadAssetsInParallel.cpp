@@ -0,0 +1,119 @@
+// Include Files
+//==============
+
+#include "LoadAssetsInParallel.h"
+
+#include "cBytecodeCache.h"
+#include "cParallelAssetLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <Engine/Results/Results.h>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	eae6320::cResult LoadAssets( const unsigned int i_threadCount, const std::vector<std::string>& i_paths,
+		eae6320::cBytecodeCache& io_bytecodeCache, double& o_secondsElapsed );
+}
+
+// Interface
+//==========
+
+eae6320::cResult LoadAssetsInParallel( eae6320::cBytecodeCache& io_bytecodeCache )
+{
+	// A lua_State can only be used by one thread at a time,
+	// but a program can have as many independent states as it wants.
+	// The cParallelAssetLoader gives every thread its own state
+	// and converts every asset table into a plain C++ sAssetValue
+	// so that the tables can be used after the states are gone.
+
+	auto result = eae6320::Results::Success;
+
+	// A real game would load many different assets,
+	// but for this example the same few files are loaded over and over
+	std::vector<std::string> paths;
+	{
+		constexpr size_t repetitionCount = 1000;
+		for ( size_t i = 0; i < repetitionCount; ++i )
+		{
+			paths.emplace_back( "loadTableFromFile.lua" );
+			paths.emplace_back( "readTopLevelTableValues.lua" );
+			paths.emplace_back( "readNestedTableValues.lua" );
+		}
+	}
+
+	// Compare a single thread with one thread per hardware thread
+	double secondsElapsed_singleThread;
+	if ( !( result = LoadAssets( 1, paths, io_bytecodeCache, secondsElapsed_singleThread ) ) )
+	{
+		return result;
+	}
+	const auto hardwareThreadCount = std::max( std::thread::hardware_concurrency(), 1u );
+	double secondsElapsed_allThreads;
+	if ( !( result = LoadAssets( hardwareThreadCount, paths, io_bytecodeCache, secondsElapsed_allThreads ) ) )
+	{
+		return result;
+	}
+	std::cout << "Using " << hardwareThreadCount << " threads was " << ( secondsElapsed_singleThread / secondsElapsed_allThreads )
+		<< " times as fast as using 1" << std::endl;
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult LoadAssets( const unsigned int i_threadCount, const std::vector<std::string>& i_paths,
+		eae6320::cBytecodeCache& io_bytecodeCache, double& o_secondsElapsed )
+	{
+		auto result = eae6320::Results::Success;
+
+		eae6320::cParallelAssetLoader loader( i_threadCount, &io_bytecodeCache );
+#if defined( LUA_USE_SHAREDSTRINGS )
+		// Every asset in this example is one of the first three,
+		// and so the workers' states will find every name and key in the shared strings
+		constexpr size_t typicalAssetCount = 3;
+		const std::vector<std::string> typicalPaths( i_paths.begin(), i_paths.begin() + std::min( i_paths.size(), typicalAssetCount ) );
+		if ( !( result = loader.ShareStringsOf( typicalPaths ) ) )
+		{
+			std::cerr << "Failed to make the shared strings" << std::endl;
+			return result;
+		}
+#endif
+		std::vector<eae6320::cParallelAssetLoader::sLoadedAsset> loadedAssets;
+		const auto startTime = std::chrono::steady_clock::now();
+		result = loader.LoadAssets( i_paths, loadedAssets );
+		o_secondsElapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+		if ( !result )
+		{
+			std::cerr << "Failed to load every asset using " << i_threadCount << " thread(s)" << std::endl;
+			return result;
+		}
+		std::cout << "Loaded " << loadedAssets.size() << " assets using " << i_threadCount << " thread(s) in "
+			<< ( o_secondsElapsed * 1000.0 ) << " ms (" << ( static_cast<double>( loadedAssets.size() ) / o_secondsElapsed ) << " assets/second)"
+			<< std::endl;
+
+		// The loaded assets are plain C++ data now, and can be used without Lua:
+		{
+			const auto& asset = loadedAssets[1].table;
+			const auto* const name = asset.Find( "name" );
+			if ( !name || ( name->type != eae6320::sAssetValue::eType::String ) || ( asset.array.size() != 3 ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << "The copy of readTopLevelTableValues.lua doesn't have the expected values" << std::endl;
+				return result;
+			}
+		}
+
+		return result;
+	}
+}
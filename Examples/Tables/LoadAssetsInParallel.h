@@ -0,0 +1,17 @@
+/*
+	This example shows how to load many assets at once using multiple threads
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBytecodeCache;
+	class cResult;
+}
+
+// Interface
+//==========
+
+eae6320::cResult LoadAssetsInParallel( eae6320::cBytecodeCache& io_bytecodeCache );
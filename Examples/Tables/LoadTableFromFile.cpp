@@ -3,25 +3,44 @@
 
 #include "LoadTableFromFile.h"
 
+#include "cBytecodeCache.h"
+#include "cLuaArenaAllocator.h"
+#include "cLuaStatePool.h"
+
+#include <algorithm>
+#include <chrono>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Results/Results.h>
 #include <External/Lua/Includes.h>
 #include <iostream>
+#include <vector>
 
 // Helper Function Declarations
 //=============================
 
 namespace
 {
-	eae6320::cResult LoadAsset_method1( const char* const i_path );
-	eae6320::cResult LoadAsset_method2( const char* const i_path );
-	eae6320::cResult LoadAsset_hybridMethod( const char* const i_path );
+	eae6320::cResult LoadAsset_method1( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+	eae6320::cResult LoadAsset_method2( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+	eae6320::cResult LoadAsset_hybridMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+	eae6320::cResult LoadAsset_pooledMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		eae6320::cLuaStatePool& io_luaStatePool );
+	eae6320::cResult LoadAsset_arenaMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		eae6320::cLuaArenaAllocator::sStatistics& o_allocatorStatistics );
+	// Loads and executes an asset file in an existing state:
+	// If this succeeds the asset's table will be at the top of the stack,
+	// and if it fails the stack will be the same as before
+	eae6320::cResult LoadAssetTable( lua_State& io_luaState, const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+
+	eae6320::cResult CompareFreshAndPooledStates( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+	void PrintLoadTimes( const char* const i_description, const std::vector<double>& i_loadTimesInMicroseconds );
+	void PrintAllocatorStatistics( const eae6320::cLuaArenaAllocator::sStatistics& i_statistics );
 }
 
 // Interface
 //==========
 
-eae6320::cResult LoadTableFromFile()
+eae6320::cResult LoadTableFromFile( eae6320::cBytecodeCache& io_bytecodeCache )
 {
 	// In our class an asset file using Lua as a format
 	// must _always_ conform to two rules:
@@ -50,20 +69,35 @@ eae6320::cResult LoadTableFromFile()
 	// (which is what #1 does)
 	// if you wanted to do the maximum amount of error checking.
 
+	// Every method loads the file through a bytecode cache
+	// (see cBytecodeCache.h) instead of calling luaL_loadfile() directly.
+	// The cache behaves exactly like luaL_loadfile(),
+	// but once a file has been loaded its precompiled chunk is reused
+	// until the file changes.
+
 	// This file shows all three methods:
 	
 	auto result = eae6320::Results::Success;
 
 	constexpr auto* const path = "loadTableFromFile.lua";
-	if ( !( result = LoadAsset_method1( path ) ) )
+	if ( !( result = LoadAsset_method1( path, io_bytecodeCache ) ) )
+	{
+		return result;
+	}
+	if ( !( result = LoadAsset_method2( path, io_bytecodeCache ) ) )
 	{
 		return result;
 	}
-	if ( !( result = LoadAsset_method2( path ) ) )
+	if ( !( result = LoadAsset_hybridMethod( path, io_bytecodeCache ) ) )
 	{
 		return result;
 	}
-	if ( !( result = LoadAsset_hybridMethod( path ) ) )
+
+	// Every method above creates a new Lua state for the asset and then closes it.
+	// When many assets are loaded it is faster to reuse states
+	// or to give each new state an allocator that doesn't call malloc() for every small block,
+	// and so the final example loads the asset many times each way and compares how long each load takes:
+	if ( !( result = CompareFreshAndPooledStates( path, io_bytecodeCache ) ) )
 	{
 		return result;
 	}
@@ -76,7 +110,7 @@ eae6320::cResult LoadTableFromFile()
 
 namespace
 {
-	eae6320::cResult LoadAsset_method1( const char* const i_path )
+	eae6320::cResult LoadAsset_method1( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
 	{
 		auto result = eae6320::Results::Success;
 
@@ -95,7 +129,13 @@ namespace
 		// Load the asset file into a table at the top of the stack
 		{
 			const auto stackTopBeforeLoading = lua_gettop( luaState );
-			const auto luaResult = luaL_dofile( luaState, i_path );
+			// luaL_dofile() is a macro that calls luaL_loadfile() and then lua_pcall() with LUA_MULTRET;
+			// the same thing is done here, but with the bytecode cache instead of luaL_loadfile()
+			auto luaResult = io_bytecodeCache.LoadFile( *luaState, i_path );
+			if ( luaResult == LUA_OK )
+			{
+				luaResult = lua_pcall( luaState, 0, LUA_MULTRET, 0 );
+			}
 			if ( luaResult == LUA_OK )
 			{
 				// A well-behaved asset file will only return a single value
@@ -153,7 +193,7 @@ namespace
 		return result;
 	}
 
-	eae6320::cResult LoadAsset_method2( const char* const i_path )
+	eae6320::cResult LoadAsset_method2( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
 	{
 		auto result = eae6320::Results::Success;
 
@@ -169,49 +209,9 @@ namespace
 			}
 		}
 
-		// Load the asset file as a "chunk",
-		// meaning there will be a callable function at the top of the stack
+		if ( !( result = LoadAssetTable( *luaState, i_path, io_bytecodeCache ) ) )
 		{
-			const auto luaResult = luaL_loadfile( luaState, i_path );
-			if ( luaResult != LUA_OK )
-			{
-				result = eae6320::Results::Failure;
-				std::cerr << lua_tostring( luaState, -1 ) << std::endl;
-				// Pop the error message
-				lua_pop( luaState, 1 );
-				goto OnExit;
-			}
-		}
-		// Execute the "chunk", which should load the asset
-		// into a table at the top of the stack
-		{
-			// Right now, the chunk is at index -1
-			// (that's what luaL_loadfile() does)
-			constexpr int argumentCount = 0;
-			constexpr int returnValueCount = 1;	// We expect an asset table to be returned
-			constexpr int noErrorHandler = 0;
-			const auto luaResult = lua_pcall( luaState, argumentCount, returnValueCount, noErrorHandler );
-			if ( luaResult == LUA_OK )
-			{
-				// A correct asset file _must_ return a table
-				if ( !lua_istable( luaState, -1 ) )
-				{
-					result = eae6320::Results::InvalidFile;
-					std::cerr << "Asset files must return a table (instead of a "
-						<< luaL_typename( luaState, -1 ) << ")" << std::endl;
-					// Pop the returned non-table value
-					lua_pop( luaState, 1 );
-					goto OnExit;
-				}
-			}
-			else
-			{
-				result = eae6320::Results::InvalidFile;
-				std::cerr << lua_tostring( luaState, -1 ) << std::endl;
-				// Pop the error message
-				lua_pop( luaState, 1 );
-				goto OnExit;
-			}
+			goto OnExit;
 		}
 
 		// If this code is reached the asset file was loaded successfully,
@@ -234,7 +234,7 @@ namespace
 		return result;
 	}
 
-	eae6320::cResult LoadAsset_hybridMethod( const char* const i_path )
+	eae6320::cResult LoadAsset_hybridMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
 	{
 		auto result = eae6320::Results::Success;
 
@@ -254,7 +254,9 @@ namespace
 		// meaning there will be a callable function at the top of the stack
 		const auto stackTopBeforeLoad = lua_gettop( luaState );
 		{
-			const auto luaResult = luaL_loadfile( luaState, i_path );
+			// The bytecode cache behaves like luaL_loadfile(),
+			// but avoids parsing the source file when a valid precompiled chunk exists
+			const auto luaResult = io_bytecodeCache.LoadFile( *luaState, i_path );
 			if ( luaResult != LUA_OK )
 			{
 				eae6320::Results::Failure;
@@ -327,4 +329,207 @@ namespace
 
 		return result;
 	}
+
+	eae6320::cResult LoadAsset_pooledMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		eae6320::cLuaStatePool& io_luaStatePool )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Get a Lua state from the pool
+		// (this only creates a new state if there isn't an unused one available)
+		lua_State* luaState = io_luaStatePool.AcquireState();
+		if ( !luaState )
+		{
+			result = eae6320::Results::OutOfMemory;
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return result;
+		}
+
+		result = LoadAssetTable( *luaState, i_path, io_bytecodeCache );
+
+		// The asset table (if there is one) doesn't need to be popped explicitly;
+		// releasing the state back to the pool clears its stack
+		io_luaStatePool.ReleaseState( luaState );
+
+		return result;
+	}
+
+	eae6320::cResult LoadAsset_arenaMethod( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		eae6320::cLuaArenaAllocator::sStatistics& o_allocatorStatistics )
+	{
+		auto result = eae6320::Results::Success;
+
+		// The allocator only lives as long as the state
+		// (all of its memory is freed at once when the state is closed)
+		eae6320::cLuaArenaAllocator allocator;
+		lua_State* luaState = allocator.NewState();
+		if ( !luaState )
+		{
+			result = eae6320::Results::OutOfMemory;
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return result;
+		}
+
+		result = LoadAssetTable( *luaState, i_path, io_bytecodeCache );
+
+		// The asset table (if there is one) doesn't need to be popped explicitly
+		// since the state is closed
+		allocator.CloseState( luaState );
+		o_allocatorStatistics = allocator.GetStatistics();
+
+		return result;
+	}
+
+	eae6320::cResult LoadAssetTable( lua_State& io_luaState, const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Load the asset file as a "chunk",
+		// meaning there will be a callable function at the top of the stack
+		{
+			// The bytecode cache behaves like luaL_loadfile(),
+			// but avoids parsing the source file when a valid precompiled chunk exists
+			const auto luaResult = io_bytecodeCache.LoadFile( io_luaState, i_path );
+			if ( luaResult != LUA_OK )
+			{
+				result = eae6320::Results::Failure;
+				std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+				// Pop the error message
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+		}
+		// Execute the "chunk", which should load the asset
+		// into a table at the top of the stack
+		{
+			// Right now, the chunk is at index -1
+			// (that's what luaL_loadfile() and the bytecode cache do)
+			constexpr int argumentCount = 0;
+			constexpr int returnValueCount = 1;	// We expect an asset table to be returned
+			constexpr int noErrorHandler = 0;
+			const auto luaResult = lua_pcall( &io_luaState, argumentCount, returnValueCount, noErrorHandler );
+			if ( luaResult == LUA_OK )
+			{
+				// A correct asset file _must_ return a table
+				if ( !lua_istable( &io_luaState, -1 ) )
+				{
+					result = eae6320::Results::InvalidFile;
+					std::cerr << "Asset files must return a table (instead of a "
+						<< luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+					// Pop the returned non-table value
+					lua_pop( &io_luaState, 1 );
+					return result;
+				}
+			}
+			else
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+				// Pop the error message
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+		}
+
+		return result;
+	}
+
+	eae6320::cResult CompareFreshAndPooledStates( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
+	{
+		auto result = eae6320::Results::Success;
+
+		constexpr size_t loadCount = 100;
+		std::vector<double> loadTimes_freshStates, loadTimes_pooledStates, loadTimes_arenaStates;
+		loadTimes_freshStates.reserve( loadCount );
+		loadTimes_pooledStates.reserve( loadCount );
+		loadTimes_arenaStates.reserve( loadCount );
+
+		// Create a new state for every load
+		for ( size_t i = 0; i < loadCount; ++i )
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			if ( !( result = LoadAsset_method2( i_path, io_bytecodeCache ) ) )
+			{
+				return result;
+			}
+			loadTimes_freshStates.push_back( std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - startTime ).count() );
+		}
+		// Reuse a single state for every load
+		{
+			// Only one state is needed since the loads happen one after another,
+			// and a small garbage collection step is done each time a state is released
+			// so that the previously loaded tables don't accumulate
+			constexpr size_t maxAvailableStateCount = 1;
+			constexpr int garbageCollectionStepSize = 16;
+			eae6320::cLuaStatePool luaStatePool( maxAvailableStateCount, garbageCollectionStepSize );
+			for ( size_t i = 0; i < loadCount; ++i )
+			{
+				const auto startTime = std::chrono::steady_clock::now();
+				if ( !( result = LoadAsset_pooledMethod( i_path, io_bytecodeCache, luaStatePool ) ) )
+				{
+					return result;
+				}
+				loadTimes_pooledStates.push_back( std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - startTime ).count() );
+			}
+			const auto statistics = luaStatePool.GetStatistics();
+			std::cout << "The Lua state pool created " << statistics.createdStateCount << " state(s) and reused them "
+				<< statistics.reusedStateCount << " times" << std::endl;
+		}
+		// Create a new state with an arena allocator for every load
+		{
+			eae6320::cLuaArenaAllocator::sStatistics allocatorStatistics;
+			for ( size_t i = 0; i < loadCount; ++i )
+			{
+				const auto startTime = std::chrono::steady_clock::now();
+				if ( !( result = LoadAsset_arenaMethod( i_path, io_bytecodeCache, allocatorStatistics ) ) )
+				{
+					return result;
+				}
+				loadTimes_arenaStates.push_back( std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - startTime ).count() );
+			}
+			// Every load is the same, and so the last one's statistics are representative
+			PrintAllocatorStatistics( allocatorStatistics );
+		}
+
+		PrintLoadTimes( "Load times with a new Lua state each time:", loadTimes_freshStates );
+		PrintLoadTimes( "Load times with a pooled Lua state:", loadTimes_pooledStates );
+		PrintLoadTimes( "Load times with a new Lua state using an arena allocator each time:", loadTimes_arenaStates );
+
+		return result;
+	}
+
+	void PrintLoadTimes( const char* const i_description, const std::vector<double>& i_loadTimesInMicroseconds )
+	{
+		if ( i_loadTimesInMicroseconds.empty() )
+		{
+			return;
+		}
+		double totalTime = 0.0;
+		for ( const auto loadTime : i_loadTimesInMicroseconds )
+		{
+			totalTime += loadTime;
+		}
+		const auto minMax = std::minmax_element( i_loadTimesInMicroseconds.begin(), i_loadTimesInMicroseconds.end() );
+		std::cout << i_description << "\n"
+			"\taverage = " << ( totalTime / static_cast<double>( i_loadTimesInMicroseconds.size() ) ) << " us"
+			", min = " << *minMax.first << " us, max = " << *minMax.second << " us"
+			" (" << i_loadTimesInMicroseconds.size() << " loads)" << std::endl;
+	}
+
+	void PrintAllocatorStatistics( const eae6320::cLuaArenaAllocator::sStatistics& i_statistics )
+	{
+		std::cout << "The arena allocator used " << i_statistics.chunkCount << " chunk(s) for one load"
+			" (" << i_statistics.inPlaceReallocationCount << " reallocations stayed in place):\n";
+		for ( size_t i = 0; i < eae6320::cLuaArenaAllocator::s_sizeClassCount; ++i )
+		{
+			const auto& sizeClass = i_statistics.sizeClasses[i];
+			if ( sizeClass.allocationCount > 0 )
+			{
+				std::cout << "\t" << eae6320::cLuaArenaAllocator::GetBlockSize( i ) << " bytes: "
+					<< sizeClass.allocationCount << " allocations, peak = " << sizeClass.peakBlockCount << " blocks\n";
+			}
+		}
+		std::cout << "\tlarger: " << i_statistics.largeBlocks.allocationCount << " allocations, peak = "
+			<< i_statistics.peakLargeByteCount << " bytes" << std::endl;
+	}
 }
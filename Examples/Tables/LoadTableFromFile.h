@@ -7,10 +7,11 @@
 
 namespace eae6320
 {
+	class cBytecodeCache;
 	class cResult;
 }
 
 // Interface
 //==========
 
-eae6320::cResult LoadTableFromFile();
+eae6320::cResult LoadTableFromFile( eae6320::cBytecodeCache& io_bytecodeCache );
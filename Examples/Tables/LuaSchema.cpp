@@ -0,0 +1,93 @@
+// Include Files
+//==============
+
+#include "LuaSchema.h"
+
+#include <climits>
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Interface
+//==========
+
+// Value Readers
+//--------------
+
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, bool& o_value )
+{
+	if ( lua_type( &io_luaState, -1 ) == LUA_TBOOLEAN )
+	{
+		o_value = lua_toboolean( &io_luaState, -1 ) != 0;
+		return Results::Success;
+	}
+	return Results::InvalidFile;
+}
+
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, double& o_value )
+{
+	// lua_isnumber() isn't used because it would accept strings that can be converted
+	if ( lua_type( &io_luaState, -1 ) == LUA_TNUMBER )
+	{
+		o_value = static_cast<double>( lua_tonumber( &io_luaState, -1 ) );
+		return Results::Success;
+	}
+	return Results::InvalidFile;
+}
+
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, float& o_value )
+{
+	if ( lua_type( &io_luaState, -1 ) == LUA_TNUMBER )
+	{
+		o_value = static_cast<float>( lua_tonumber( &io_luaState, -1 ) );
+		return Results::Success;
+	}
+	return Results::InvalidFile;
+}
+
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, int& o_value )
+{
+	if ( lua_type( &io_luaState, -1 ) == LUA_TNUMBER )
+	{
+		// A float is only accepted if it has an exact integer value,
+		// and an integer is only accepted if an int can hold it
+		int isInteger;
+		const auto value = lua_tointegerx( &io_luaState, -1, &isInteger );
+		if ( isInteger && ( value >= INT_MIN ) && ( value <= INT_MAX ) )
+		{
+			o_value = static_cast<int>( value );
+			return Results::Success;
+		}
+	}
+	return Results::InvalidFile;
+}
+
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, std::string& o_value )
+{
+	if ( lua_type( &io_luaState, -1 ) == LUA_TSTRING )
+	{
+		size_t length;
+		const auto* const value = lua_tolstring( &io_luaState, -1, &length );
+		o_value.assign( value, length );
+		return Results::Success;
+	}
+	return Results::InvalidFile;
+}
+
+// Implementation
+//===============
+
+void eae6320::LuaSchema::Implementation::PrintFieldError( lua_State& io_luaState, const char* const i_key )
+{
+	// The value is at the top of the stack.
+	// For a nested table the innermost key is printed first
+	// and each outer key is printed on a following line.
+	if ( lua_isnil( &io_luaState, -1 ) )
+	{
+		std::cerr << "No value for \"" << i_key << "\" was found in the asset table" << std::endl;
+	}
+	else
+	{
+		std::cerr << "The value for \"" << i_key << "\" is invalid "
+			"(it is a " << luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+	}
+}
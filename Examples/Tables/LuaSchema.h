@@ -0,0 +1,122 @@
+/*
+	A Lua schema describes how the values of an asset table map to the members of a C++ struct
+	so that the code to read them doesn't have to be written by hand
+
+	A schema is a constant array of fields, for example:
+		struct sParameters { float g_brightness; float g_speed; };
+		constexpr eae6320::LuaSchema::sField<sParameters> s_parametersSchema[] =
+		{
+			EAE6320_LUASCHEMA_FIELD( sParameters, g_brightness ),
+			EAE6320_LUASCHEMA_OPTIONALFIELD( sParameters, g_speed ),
+		};
+	and then a table can be read with:
+		eae6320::LuaSchema::ReadTable( luaState, -1, s_parametersSchema, parameters );
+
+	Each field is read with lua_getfield(),
+	and so it is found the same way as a field access like t.name in Lua
+	(including through a metatable's __index, e.g. for defaults that an asset inherits from another table).
+	The keys of a schema are constant strings,
+	and Lua caches the strings that lua_getfield() interns by their addresses
+	and so a key usually isn't hashed again.
+*/
+
+#ifndef EAE6320_TABLES_LUASCHEMA_H
+#define EAE6320_TABLES_LUASCHEMA_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Field Definition
+//=================
+
+namespace eae6320
+{
+	namespace LuaSchema
+	{
+		template <class tStruct>
+		struct sField
+		{
+			// The key in the Lua table
+			const char* key;
+			// If a field isn't required then a missing (nil) value leaves the member unchanged
+			bool isRequired;
+			// Reads the value at the top of the stack into the corresponding member of the struct
+			cResult ( *readValue )( lua_State& io_luaState, tStruct& io_struct );
+		};
+	}
+}
+
+// The key is the same as the member's name
+#define EAE6320_LUASCHEMA_FIELD( i_struct, i_member )	\
+	{ #i_member, true, &eae6320::LuaSchema::ReadMember<i_struct, decltype( i_struct::i_member ), &i_struct::i_member> }
+#define EAE6320_LUASCHEMA_OPTIONALFIELD( i_struct, i_member )	\
+	{ #i_member, false, &eae6320::LuaSchema::ReadMember<i_struct, decltype( i_struct::i_member ), &i_struct::i_member> }
+// A nested table is read into a member struct using its own schema
+#define EAE6320_LUASCHEMA_TABLEFIELD( i_struct, i_member, i_memberSchema )	\
+	{ #i_member, true, &eae6320::LuaSchema::ReadTableMember<i_struct, decltype( i_struct::i_member ), &i_struct::i_member,	\
+		i_memberSchema, sizeof( i_memberSchema ) / sizeof( *i_memberSchema )> }
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace LuaSchema
+	{
+		// Reads every field of the schema from the table at the given index (which must be a table).
+		// The stack is left unchanged.
+		template <class tStruct, size_t tFieldCount>
+		cResult ReadTable( lua_State& io_luaState, const int i_tableIndex,
+			const sField<tStruct> ( &i_schema )[tFieldCount], tStruct& io_struct );
+		template <class tStruct>
+		cResult ReadTable( lua_State& io_luaState, const int i_tableIndex,
+			const sField<tStruct>* const i_schema, const size_t i_fieldCount, tStruct& io_struct );
+
+		// Value Readers
+		//--------------
+
+		// Each of these reads the value at the top of the stack (and leaves it there)
+
+		cResult ReadValue( lua_State& io_luaState, bool& o_value );
+		cResult ReadValue( lua_State& io_luaState, double& o_value );
+		cResult ReadValue( lua_State& io_luaState, float& o_value );
+		cResult ReadValue( lua_State& io_luaState, int& o_value );
+		cResult ReadValue( lua_State& io_luaState, std::string& o_value );
+		// An array is a table with keys 1, 2, ..., n
+		template <class tElement>
+		cResult ReadValue( lua_State& io_luaState, std::vector<tElement>& o_values );
+
+		// These are what the schema macros use
+		template <class tStruct, class tMember, tMember tStruct::*tMemberPointer>
+		cResult ReadMember( lua_State& io_luaState, tStruct& io_struct );
+		template <class tStruct, class tMember, tMember tStruct::*tMemberPointer,
+			const sField<tMember>* tMemberSchema, size_t tMemberFieldCount>
+		cResult ReadTableMember( lua_State& io_luaState, tStruct& io_struct );
+
+		// Implementation
+		//===============
+
+		namespace Implementation
+		{
+			void PrintFieldError( lua_State& io_luaState, const char* const i_key );
+		}
+	}
+}
+
+#include "LuaSchema.inl"
+
+#endif	// EAE6320_TABLES_LUASCHEMA_H
@@ -0,0 +1,115 @@
+#ifndef EAE6320_TABLES_LUASCHEMA_INL
+#define EAE6320_TABLES_LUASCHEMA_INL
+
+// Include Files
+//==============
+
+#include "LuaSchema.h"
+
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+
+// Interface
+//==========
+
+template <class tStruct, size_t tFieldCount>
+eae6320::cResult eae6320::LuaSchema::ReadTable( lua_State& io_luaState, const int i_tableIndex,
+	const sField<tStruct> ( &i_schema )[tFieldCount], tStruct& io_struct )
+{
+	return ReadTable( io_luaState, i_tableIndex, i_schema, tFieldCount, io_struct );
+}
+
+template <class tStruct>
+eae6320::cResult eae6320::LuaSchema::ReadTable( lua_State& io_luaState, const int i_tableIndex,
+	const sField<tStruct>* const i_schema, const size_t i_fieldCount, tStruct& io_struct )
+{
+	auto result = Results::Success;
+
+	const auto tableIndex = lua_absindex( &io_luaState, i_tableIndex );
+	// Only a field's value is pushed
+	// (and a nested table or array makes sure that there is room for its own values)
+	if ( !lua_checkstack( &io_luaState, 1 ) )
+	{
+		result = Results::OutOfMemory;
+		return result;
+	}
+	for ( size_t i = 0; i < i_fieldCount; ++i )
+	{
+		const auto& field = i_schema[i];
+		if ( lua_getfield( &io_luaState, tableIndex, field.key ) != LUA_TNIL )
+		{
+			result = field.readValue( io_luaState, io_struct );
+		}
+		else if ( field.isRequired )
+		{
+			result = Results::InvalidFile;
+		}
+		if ( !result )
+		{
+			Implementation::PrintFieldError( io_luaState, field.key );
+			// Pop the value
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+		// Pop the value
+		lua_pop( &io_luaState, 1 );
+	}
+
+	return result;
+}
+
+// Value Readers
+//--------------
+
+template <class tElement>
+eae6320::cResult eae6320::LuaSchema::ReadValue( lua_State& io_luaState, std::vector<tElement>& o_values )
+{
+	auto result = Results::Success;
+
+	if ( !lua_istable( &io_luaState, -1 ) )
+	{
+		result = Results::InvalidFile;
+		return result;
+	}
+	if ( !lua_checkstack( &io_luaState, 1 ) )
+	{
+		result = Results::OutOfMemory;
+		return result;
+	}
+	const auto valueCount = lua_rawlen( &io_luaState, -1 );
+	o_values.resize( valueCount );
+	for ( size_t i = 0; i < valueCount; ++i )
+	{
+		lua_rawgeti( &io_luaState, -1, static_cast<lua_Integer>( i + 1 ) );
+		result = ReadValue( io_luaState, o_values[i] );
+		lua_pop( &io_luaState, 1 );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+
+	return result;
+}
+
+template <class tStruct, class tMember, tMember tStruct::*tMemberPointer>
+eae6320::cResult eae6320::LuaSchema::ReadMember( lua_State& io_luaState, tStruct& io_struct )
+{
+	return ReadValue( io_luaState, io_struct.*tMemberPointer );
+}
+
+template <class tStruct, class tMember, tMember tStruct::*tMemberPointer,
+	const eae6320::LuaSchema::sField<tMember>* tMemberSchema, size_t tMemberFieldCount>
+eae6320::cResult eae6320::LuaSchema::ReadTableMember( lua_State& io_luaState, tStruct& io_struct )
+{
+	if ( lua_istable( &io_luaState, -1 ) )
+	{
+		return ReadTable( io_luaState, -1, tMemberSchema, tMemberFieldCount, io_struct.*tMemberPointer );
+	}
+	else
+	{
+		return Results::InvalidFile;
+	}
+}
+
+#endif	// EAE6320_TABLES_LUASCHEMA_INL
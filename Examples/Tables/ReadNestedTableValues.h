@@ -8,10 +8,11 @@
 
 namespace eae6320
 {
+	class cBytecodeCache;
 	class cResult;
 }
 
 // Interface
 //==========
 
-eae6320::cResult ReadNestedTableValues();
+eae6320::cResult ReadNestedTableValues( eae6320::cBytecodeCache& io_bytecodeCache );
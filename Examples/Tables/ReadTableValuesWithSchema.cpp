@@ -0,0 +1,287 @@
+// Include Files
+//==============
+
+#include "ReadTableValuesWithSchema.h"
+
+#include "cBytecodeCache.h"
+#include "LuaSchema.h"
+
+#include <chrono>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Asset Structs
+//==============
+
+namespace
+{
+	// These match the layout of readNestedTableValues.lua
+	struct sParameters
+	{
+		float g_brightness = 0.0f;
+		float g_speed = 0.0f;
+	};
+	struct sNestedAsset
+	{
+		std::vector<std::string> textures;
+		sParameters parameters;
+	};
+
+	// These match the layout of readTopLevelTableValues.lua
+	// (the array values don't have keys and so aren't part of the schema)
+	struct sTopLevelAsset
+	{
+		std::string name;
+		int age = 0;
+	};
+}
+
+// Schemas
+//========
+
+namespace
+{
+	// A nested schema must be declared before the schema that uses it
+	constexpr eae6320::LuaSchema::sField<sParameters> s_parametersSchema[] =
+	{
+		EAE6320_LUASCHEMA_FIELD( sParameters, g_brightness ),
+		EAE6320_LUASCHEMA_FIELD( sParameters, g_speed ),
+	};
+	constexpr eae6320::LuaSchema::sField<sNestedAsset> s_nestedAssetSchema[] =
+	{
+		EAE6320_LUASCHEMA_FIELD( sNestedAsset, textures ),
+		EAE6320_LUASCHEMA_TABLEFIELD( sNestedAsset, parameters, s_parametersSchema ),
+	};
+
+	constexpr eae6320::LuaSchema::sField<sTopLevelAsset> s_topLevelAssetSchema[] =
+	{
+		EAE6320_LUASCHEMA_FIELD( sTopLevelAsset, name ),
+		EAE6320_LUASCHEMA_OPTIONALFIELD( sTopLevelAsset, age ),
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This reads the same values as the schema does,
+	// but by hand the way that the ReadNestedTableValues example does
+	eae6320::cResult ReadNestedAsset_handWritten( lua_State& io_luaState, sNestedAsset& o_asset );
+
+	eae6320::cResult CompareSchemaAndHandWrittenReads( lua_State& io_luaState );
+
+	eae6320::cResult LoadAsset( lua_State& io_luaState, const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
+}
+
+// Interface
+//==========
+
+eae6320::cResult ReadTableValuesWithSchema( eae6320::cBytecodeCache& io_bytecodeCache )
+{
+	// The previous examples pushed every key, called lua_gettable(), checked the type, and popped.
+	// That is a lot of code to write for every asset type, and it is easy to make mistakes with the stack.
+	// A schema (see LuaSchema.h) declares which key goes into which struct member
+	// and the code that reads the values is generated from it.
+
+	auto result = eae6320::Results::Success;
+
+	lua_State* luaState = luaL_newstate();
+	if ( !luaState )
+	{
+		result = eae6320::Results::OutOfMemory;
+		std::cerr << "Failed to create a new Lua state" << std::endl;
+		return result;
+	}
+
+	// Read the top-level values
+	{
+		if ( !( result = LoadAsset( *luaState, "readTopLevelTableValues.lua", io_bytecodeCache ) ) )
+		{
+			goto OnExit;
+		}
+		sTopLevelAsset asset;
+		result = eae6320::LuaSchema::ReadTable( *luaState, -1, s_topLevelAssetSchema, asset );
+		// Pop the asset table
+		lua_pop( luaState, 1 );
+		if ( !result )
+		{
+			goto OnExit;
+		}
+		std::cout << "The schema read name = \"" << asset.name << "\" and age = " << asset.age << std::endl;
+	}
+
+	// Read the nested values
+	{
+		if ( !( result = LoadAsset( *luaState, "readNestedTableValues.lua", io_bytecodeCache ) ) )
+		{
+			goto OnExit;
+		}
+		sNestedAsset asset;
+		result = eae6320::LuaSchema::ReadTable( *luaState, -1, s_nestedAssetSchema, asset );
+		if ( result )
+		{
+			std::cout << "The schema read " << asset.textures.size() << " texture paths"
+				" and parameters g_brightness = " << asset.parameters.g_brightness
+				<< " and g_speed = " << asset.parameters.g_speed << std::endl;
+			// Compare how long it takes to read the table with the schema and by hand
+			result = CompareSchemaAndHandWrittenReads( *luaState );
+		}
+		// Pop the asset table
+		lua_pop( luaState, 1 );
+	}
+
+OnExit:
+
+	EAE6320_ASSERT( lua_gettop( luaState ) == 0 );
+	lua_close( luaState );
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult ReadNestedAsset_handWritten( lua_State& io_luaState, sNestedAsset& o_asset )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Textures
+		{
+			lua_pushstring( &io_luaState, "textures" );
+			lua_gettable( &io_luaState, -2 );
+			if ( !lua_istable( &io_luaState, -1 ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+			const auto textureCount = luaL_len( &io_luaState, -1 );
+			o_asset.textures.resize( static_cast<size_t>( textureCount ) );
+			for ( int i = 1; i <= textureCount; ++i )
+			{
+				lua_pushinteger( &io_luaState, i );
+				lua_gettable( &io_luaState, -2 );
+				if ( lua_type( &io_luaState, -1 ) != LUA_TSTRING )
+				{
+					result = eae6320::Results::InvalidFile;
+					lua_pop( &io_luaState, 2 );
+					return result;
+				}
+				o_asset.textures[i - 1] = lua_tostring( &io_luaState, -1 );
+				lua_pop( &io_luaState, 1 );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Parameters
+		{
+			lua_pushstring( &io_luaState, "parameters" );
+			lua_gettable( &io_luaState, -2 );
+			if ( !lua_istable( &io_luaState, -1 ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+			float* const values[] = { &o_asset.parameters.g_brightness, &o_asset.parameters.g_speed };
+			const char* const keys[] = { "g_brightness", "g_speed" };
+			for ( size_t i = 0; i < 2; ++i )
+			{
+				lua_pushstring( &io_luaState, keys[i] );
+				lua_gettable( &io_luaState, -2 );
+				if ( lua_type( &io_luaState, -1 ) != LUA_TNUMBER )
+				{
+					result = eae6320::Results::InvalidFile;
+					lua_pop( &io_luaState, 2 );
+					return result;
+				}
+				*values[i] = static_cast<float>( lua_tonumber( &io_luaState, -1 ) );
+				lua_pop( &io_luaState, 1 );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+
+		return result;
+	}
+
+	eae6320::cResult CompareSchemaAndHandWrittenReads( lua_State& io_luaState )
+	{
+		auto result = eae6320::Results::Success;
+
+		constexpr size_t readCount = 100000;
+		// The same struct is reused so that memory allocation of the std::strings doesn't dominate the timing
+		sNestedAsset asset;
+
+		const auto startTime_handWritten = std::chrono::steady_clock::now();
+		for ( size_t i = 0; i < readCount; ++i )
+		{
+			if ( !( result = ReadNestedAsset_handWritten( io_luaState, asset ) ) )
+			{
+				return result;
+			}
+		}
+		const auto startTime_schema = std::chrono::steady_clock::now();
+		for ( size_t i = 0; i < readCount; ++i )
+		{
+			if ( !( result = eae6320::LuaSchema::ReadTable( io_luaState, -1, s_nestedAssetSchema, asset ) ) )
+			{
+				return result;
+			}
+		}
+		const auto endTime = std::chrono::steady_clock::now();
+
+		const auto nanosecondsPerRead_handWritten = std::chrono::duration<double, std::nano>( startTime_schema - startTime_handWritten ).count()
+			/ static_cast<double>( readCount );
+		const auto nanosecondsPerRead_schema = std::chrono::duration<double, std::nano>( endTime - startTime_schema ).count()
+			/ static_cast<double>( readCount );
+		std::cout << "Reading readNestedTableValues.lua " << readCount << " times:\n"
+			"\thand-written: " << nanosecondsPerRead_handWritten << " ns per read\n"
+			"\tschema: " << nanosecondsPerRead_schema << " ns per read" << std::endl;
+
+		return result;
+	}
+
+	eae6320::cResult LoadAsset( lua_State& io_luaState, const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
+	{
+		auto result = eae6320::Results::Success;
+
+		// This is the same as LoadAsset_method2() in the LoadTableFromFile example
+		// except that the state is provided by the caller
+		// and the table is left at the top of the stack if the load succeeds
+		auto luaResult = io_bytecodeCache.LoadFile( io_luaState, i_path );
+		if ( luaResult != LUA_OK )
+		{
+			result = eae6320::Results::Failure;
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noMessageHandler = 0;
+		luaResult = lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler );
+		if ( luaResult != LUA_OK )
+		{
+			result = eae6320::Results::InvalidFile;
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+		if ( !lua_istable( &io_luaState, -1 ) )
+		{
+			result = eae6320::Results::InvalidFile;
+			std::cerr << "Asset files must return a table (instead of a "
+				<< luaL_typename( &io_luaState, -1 ) << ")" << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+
+		return result;
+	}
+}
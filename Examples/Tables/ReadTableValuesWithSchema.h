@@ -0,0 +1,18 @@
+/*
+	This example shows how to read table values into a C++ struct
+	using a schema instead of hand-written code
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBytecodeCache;
+	class cResult;
+}
+
+// Interface
+//==========
+
+eae6320::cResult ReadTableValuesWithSchema( eae6320::cBytecodeCache& io_bytecodeCache );
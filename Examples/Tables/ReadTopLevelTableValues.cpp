@@ -3,6 +3,8 @@
 
 #include "ReadTopLevelTableValues.h"
 
+#include "cBytecodeCache.h"
+
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Results/Results.h>
 #include <External/Lua/Includes.h>
@@ -19,13 +21,13 @@ namespace
 	eae6320::cResult LoadTableValues_integerKeys( lua_State& io_luaState );
 	eae6320::cResult LoadTableValues_allKeys( lua_State& io_luaState );
 
-	eae6320::cResult LoadAsset( const char* const i_path );
+	eae6320::cResult LoadAsset( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache );
 }
 
 // Interface
 //==========
 
-eae6320::cResult ReadTopLevelTableValues()
+eae6320::cResult ReadTopLevelTableValues( eae6320::cBytecodeCache& io_bytecodeCache )
 {
 	// The LoadAsset() function does _exactly_ what was shown
 	// in the LoadTableFromFile examples.
@@ -36,7 +38,7 @@ eae6320::cResult ReadTopLevelTableValues()
 	auto result = eae6320::Results::Success;
 
 	constexpr auto* const path = "readTopLevelTableValues.lua";
-	if ( !( result = LoadAsset( path ) ) )
+	if ( !( result = LoadAsset( path, io_bytecodeCache ) ) )
 	{
 		return result;
 	}
@@ -338,7 +340,7 @@ namespace
 		return eae6320::Results::Success;
 	}
 
-	eae6320::cResult LoadAsset( const char* const i_path )
+	eae6320::cResult LoadAsset( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache )
 	{
 		auto result = eae6320::Results::Success;
 
@@ -358,7 +360,9 @@ namespace
 		// meaning there will be a callable function at the top of the stack
 		const auto stackTopBeforeLoad = lua_gettop( luaState );
 		{
-			const auto luaResult = luaL_loadfile( luaState, i_path );
+			// The bytecode cache behaves like luaL_loadfile(),
+			// but avoids parsing the source file when a valid precompiled chunk exists
+			const auto luaResult = io_bytecodeCache.LoadFile( *luaState, i_path );
 			if ( luaResult != LUA_OK )
 			{
 				result = eae6320::Results::Failure;
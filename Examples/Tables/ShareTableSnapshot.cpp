@@ -0,0 +1,189 @@
+// Include Files
+//==============
+
+#include "ShareTableSnapshot.h"
+
+#include "cBytecodeCache.h"
+#include "cTableSnapshot.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Every worker runs this with the snapshot as the global "config"
+	constexpr auto* const s_workerScript = R"(
+		local textureCount = 0
+		for _, path in ipairs( config.textures ) do
+			textureCount = textureCount + 1
+		end
+		local parameterCount = 0
+		for key, value in pairs( config.parameters ) do
+			parameterCount = parameterCount + 1
+		end
+		-- The snapshot can't be changed
+		local couldChange = pcall( function() config.parameters.g_speed = 0 end )
+		return textureCount, parameterCount, config.parameters.g_brightness, couldChange
+	)";
+
+	struct sWorkerResult
+	{
+		eae6320::cResult result;
+		lua_Integer textureCount = 0;
+		lua_Integer parameterCount = 0;
+		lua_Number brightness = 0.0;
+	};
+
+	eae6320::cResult CreateSnapshot( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		std::shared_ptr<const eae6320::cTableSnapshot>& o_snapshot );
+	void RunWorker( const std::shared_ptr<const eae6320::cTableSnapshot>& i_snapshot, sWorkerResult& o_result );
+}
+
+// Interface
+//==========
+
+eae6320::cResult ShareTableSnapshot( eae6320::cBytecodeCache& io_bytecodeCache )
+{
+	// A config table that every worker needs could be loaded by every worker's state,
+	// but then each state would have its own copy.
+	// A cTableSnapshot is a copy that isn't in any state,
+	// and every state that is given a proxy of it reads the same copy.
+
+	auto result = eae6320::Results::Success;
+
+	std::shared_ptr<const eae6320::cTableSnapshot> snapshot;
+	if ( !( result = CreateSnapshot( "readNestedTableValues.lua", io_bytecodeCache, snapshot ) ) )
+	{
+		return result;
+	}
+
+	// Every worker thread uses its own state
+	const auto threadCount = std::max( std::thread::hardware_concurrency(), 2u );
+	std::vector<sWorkerResult> workerResults( threadCount );
+	{
+		std::vector<std::thread> threads;
+		threads.reserve( threadCount );
+		for ( unsigned int i = 0; i < threadCount; ++i )
+		{
+			threads.emplace_back( RunWorker, std::cref( snapshot ), std::ref( workerResults[i] ) );
+		}
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+	}
+
+	for ( const auto& workerResult : workerResults )
+	{
+		if ( !workerResult.result )
+		{
+			return workerResult.result;
+		}
+	}
+	// The proxies were collected when the workers' states were closed,
+	// and so this is the only reference left
+	EAE6320_ASSERT( snapshot.use_count() == 1 );
+	const auto& workerResult = workerResults.front();
+	std::cout << threadCount << " states read the same " << snapshot->GetSize() << " byte snapshot of "
+		<< snapshot->GetTableCount() << " tables: " << workerResult.textureCount << " texture paths, "
+		<< workerResult.parameterCount << " parameters, and g_brightness = " << workerResult.brightness << std::endl;
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult CreateSnapshot( const char* const i_path, eae6320::cBytecodeCache& io_bytecodeCache,
+		std::shared_ptr<const eae6320::cTableSnapshot>& o_snapshot )
+	{
+		auto result = eae6320::Results::Success;
+
+		// The state is only needed until the snapshot has been made
+		lua_State* luaState = luaL_newstate();
+		if ( !luaState )
+		{
+			result = eae6320::Results::OutOfMemory;
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			return result;
+		}
+
+		// Load the asset file and copy the table that it returns
+		{
+			if ( io_bytecodeCache.LoadFile( *luaState, i_path ) != LUA_OK )
+			{
+				result = eae6320::Results::Failure;
+				std::cerr << lua_tostring( luaState, -1 ) << std::endl;
+				lua_pop( luaState, 1 );
+				goto OnExit;
+			}
+			constexpr int argumentCount = 0;
+			constexpr int returnValueCount = 1;
+			constexpr int noMessageHandler = 0;
+			if ( lua_pcall( luaState, argumentCount, returnValueCount, noMessageHandler ) != LUA_OK )
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << lua_tostring( luaState, -1 ) << std::endl;
+				lua_pop( luaState, 1 );
+				goto OnExit;
+			}
+			result = eae6320::cTableSnapshot::Create( *luaState, -1, o_snapshot );
+			// Pop the asset table
+			lua_pop( luaState, 1 );
+		}
+
+	OnExit:
+
+		EAE6320_ASSERT( lua_gettop( luaState ) == 0 );
+		lua_close( luaState );
+
+		return result;
+	}
+
+	void RunWorker( const std::shared_ptr<const eae6320::cTableSnapshot>& i_snapshot, sWorkerResult& o_result )
+	{
+		lua_State* luaState = luaL_newstate();
+		if ( !luaState )
+		{
+			o_result.result = eae6320::Results::OutOfMemory;
+			return;
+		}
+		luaL_openlibs( luaState );
+
+		eae6320::cTableSnapshot::PushProxy( *luaState, i_snapshot );
+		lua_setglobal( luaState, "config" );
+		if ( luaL_dostring( luaState, s_workerScript ) != LUA_OK )
+		{
+			o_result.result = eae6320::Results::Failure;
+			std::cerr << lua_tostring( luaState, -1 ) << std::endl;
+		}
+		else
+		{
+			o_result.textureCount = lua_tointeger( luaState, 1 );
+			o_result.parameterCount = lua_tointeger( luaState, 2 );
+			o_result.brightness = lua_tonumber( luaState, 3 );
+			if ( lua_toboolean( luaState, 4 ) )
+			{
+				o_result.result = eae6320::Results::Failure;
+				std::cerr << "A worker was able to change the snapshot" << std::endl;
+			}
+			else
+			{
+				o_result.result = eae6320::Results::Success;
+			}
+		}
+
+		lua_close( luaState );
+	}
+}
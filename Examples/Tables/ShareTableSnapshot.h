@@ -0,0 +1,18 @@
+/*
+	This example shows how the states of many threads can share a single read-only copy of a table
+	instead of each state loading and holding its own
+*/
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBytecodeCache;
+	class cResult;
+}
+
+// Interface
+//==========
+
+eae6320::cResult ShareTableSnapshot( eae6320::cBytecodeCache& io_bytecodeCache );
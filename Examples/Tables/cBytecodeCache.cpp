@@ -0,0 +1,352 @@
+// Include Files
+//==============
+
+#include "cBytecodeCache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <External/Lua/Includes.h>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <vector>
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	#include <Engine/Windows/Includes.h>
+#else
+	#include <unistd.h>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// A cache file starts with this header and is followed by the output of lua_dump()
+	struct sCacheHeader
+	{
+		char magic[4];
+		uint32_t version;
+		uint64_t sourceSize;
+		uint64_t sourceHash;
+		uint64_t bytecodeSize;
+		uint64_t bytecodeHash;
+	};
+	constexpr char s_magic[4] = { 'E', 'L', 'B', 'C' };
+	// This should be incremented whenever the header changes
+	// (a change in the Lua version is detected by lua_load() itself)
+	constexpr uint32_t s_version = 2;
+
+	bool IsRegularFile( const char* const i_path );
+	bool ReadFile( const char* const i_path, std::vector<char>& o_contents );
+	uint64_t CalculateHash( const std::vector<char>& i_contents );
+	// Loads a source file that has already been read the same way that luaL_loadfile() would
+	int LoadSource( lua_State& io_luaState, const std::vector<char>& i_source, const char* const i_chunkName );
+
+	// A cache file that is truncated or whose bytecode doesn't match its checksum is rejected
+	bool ReadCacheFile( const char* const i_path, sCacheHeader& o_header, std::vector<char>& o_bytecode );
+	// The cache file is written to a temporary file that then replaces it,
+	// and so a program that exits while writing (or another thread or process writing the same file)
+	// never leaves a partial cache file
+	bool WriteCacheFile( const char* const i_path, const sCacheHeader& i_header, const std::vector<char>& i_bytecode );
+	bool ReplaceFile( const char* const i_temporaryPath, const char* const i_path );
+
+	int WriteBytecode( lua_State*, const void* const i_data, const size_t i_size, void* io_userData );
+}
+
+// Interface
+//==========
+
+// Loading
+//--------
+
+int eae6320::cBytecodeCache::LoadFile( lua_State& io_luaState, const char* const i_path )
+{
+	// The source file is always read:
+	// Hashing it is much faster than lexing and parsing it,
+	// and the precompiled chunk is only trusted if it was compiled from exactly the same source
+	std::vector<char> source;
+	if ( !IsRegularFile( i_path ) || !ReadFile( i_path, source ) )
+	{
+		// Let Lua report the error in its usual way
+		// (or load a pipe or device, which can't be cached)
+		++m_missCount;
+		return luaL_loadfile( &io_luaState, i_path );
+	}
+	const auto sourceHash = CalculateHash( source );
+	// Lua uses an '@' prefix to indicate that a chunk name is a file name
+	const auto chunkName = std::string( "@" ) + i_path;
+
+	// Try to load the precompiled chunk
+	const auto cachePath = GetCachePath( i_path );
+	sCacheHeader header;
+	std::vector<char> bytecode;
+	bool wasCacheFileFound = false;
+	if ( ReadCacheFile( cachePath.c_str(), header, bytecode ) )
+	{
+		wasCacheFileFound = true;
+		if ( ( header.sourceSize == source.size() ) && ( header.sourceHash == sourceHash ) )
+		{
+			// The "b" mode guarantees that only a binary chunk will be accepted
+			const auto luaResult = luaL_loadbufferx( &io_luaState, bytecode.data(), bytecode.size(), chunkName.c_str(), "b" );
+			if ( luaResult == LUA_OK )
+			{
+				++m_hitCount;
+				return luaResult;
+			}
+			// If the precompiled chunk can't be loaded
+			// (e.g. it was created by a different version of Lua)
+			// it is treated as stale
+			lua_pop( &io_luaState, 1 );
+		}
+	}
+
+	// Load the source file (from the contents that were already read)
+	++m_missCount;
+	if ( wasCacheFileFound )
+	{
+		++m_staleCount;
+	}
+	const auto luaResult = LoadSource( io_luaState, source, chunkName.c_str() );
+	if ( luaResult != LUA_OK )
+	{
+		return luaResult;
+	}
+
+	// Update the cache file
+	{
+		bytecode.clear();
+		if ( lua_dump( &io_luaState, WriteBytecode, &bytecode, m_shouldDebugInformationBeStripped ? 1 : 0 ) == 0 )
+		{
+			for ( size_t i = 0; i < sizeof( s_magic ); ++i )
+			{
+				header.magic[i] = s_magic[i];
+			}
+			header.version = s_version;
+			header.sourceSize = source.size();
+			header.sourceHash = sourceHash;
+			header.bytecodeSize = bytecode.size();
+			header.bytecodeHash = CalculateHash( bytecode );
+			// A failure to write the cache file isn't an error;
+			// the source file will just be loaded again next time
+			WriteCacheFile( cachePath.c_str(), header, bytecode );
+		}
+	}
+
+	return luaResult;
+}
+
+// Access
+//-------
+
+eae6320::cBytecodeCache::sStatistics eae6320::cBytecodeCache::GetStatistics() const
+{
+	sStatistics statistics;
+	{
+		statistics.hitCount = m_hitCount;
+		statistics.missCount = m_missCount;
+		statistics.staleCount = m_staleCount;
+	}
+	return statistics;
+}
+
+void eae6320::cBytecodeCache::ResetStatistics()
+{
+	m_hitCount = 0;
+	m_missCount = 0;
+	m_staleCount = 0;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cBytecodeCache::cBytecodeCache( const char* const i_cacheDirectory, const bool i_shouldDebugInformationBeStripped )
+	:
+	m_cacheDirectory( i_cacheDirectory ? i_cacheDirectory : "" ),
+	m_shouldDebugInformationBeStripped( i_shouldDebugInformationBeStripped ),
+	m_hitCount( 0 ), m_missCount( 0 ), m_staleCount( 0 )
+{
+
+}
+
+// Implementation
+//===============
+
+std::string eae6320::cBytecodeCache::GetCachePath( const char* const i_sourcePath ) const
+{
+	constexpr auto* const extension = ".bytecode";
+	if ( m_cacheDirectory.empty() )
+	{
+		return std::string( i_sourcePath ) + extension;
+	}
+	else
+	{
+		// Every source file gets a unique file name in the cache directory
+		std::string cachePath = m_cacheDirectory;
+		for ( const auto* character = i_sourcePath; *character != '\0'; ++character )
+		{
+			const auto c = *character;
+			cachePath += ( ( c == '/' ) || ( c == '\\' ) || ( c == ':' ) ) ? '_' : c;
+		}
+		return cachePath + extension;
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	bool IsRegularFile( const char* const i_path )
+	{
+#if defined( EAE6320_PLATFORM_WINDOWS )
+		struct _stat64 fileInfo;
+		if ( _stat64( i_path, &fileInfo ) != 0 )
+#else
+		struct stat fileInfo;
+		if ( stat( i_path, &fileInfo ) != 0 )
+#endif
+		{
+			return false;
+		}
+		return ( fileInfo.st_mode & S_IFMT ) == S_IFREG;
+	}
+
+	bool ReadFile( const char* const i_path, std::vector<char>& o_contents )
+	{
+		std::ifstream file( i_path, std::ios::binary );
+		if ( !file )
+		{
+			return false;
+		}
+		o_contents.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+		return !file.bad();
+	}
+
+	uint64_t CalculateHash( const std::vector<char>& i_contents )
+	{
+		// 64-bit FNV-1a
+		uint64_t hash = 0xcbf29ce484222325;
+		for ( const auto c : i_contents )
+		{
+			hash ^= static_cast<uint8_t>( c );
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	int LoadSource( lua_State& io_luaState, const std::vector<char>& i_source, const char* const i_chunkName )
+	{
+		const auto* source = i_source.data();
+		auto size = i_source.size();
+		// Skip a UTF-8 BOM
+		if ( ( size >= 3 ) && ( std::memcmp( source, "\xEF\xBB\xBF", 3 ) == 0 ) )
+		{
+			source += 3;
+			size -= 3;
+		}
+		// Skip a first line that starts with '#'
+		// (but not the newline that ends it, so that line numbers stay correct)
+		if ( ( size > 0 ) && ( *source == '#' ) )
+		{
+			const auto* endOfLine = static_cast<const char*>( std::memchr( source, '\n', size ) );
+			if ( endOfLine )
+			{
+				// A binary chunk can follow the line, though, and must start at its first byte
+				if ( ( endOfLine + 1 < source + size ) && ( endOfLine[1] == LUA_SIGNATURE[0] ) )
+				{
+					++endOfLine;
+				}
+				size -= static_cast<size_t>( endOfLine - source );
+				source = endOfLine;
+			}
+			else
+			{
+				size = 0;
+			}
+		}
+		return luaL_loadbuffer( &io_luaState, source, size, i_chunkName );
+	}
+
+	bool ReadCacheFile( const char* const i_path, sCacheHeader& o_header, std::vector<char>& o_bytecode )
+	{
+		std::ifstream file( i_path, std::ios::binary );
+		if ( !file || !file.read( reinterpret_cast<char*>( &o_header ), sizeof( o_header ) ) )
+		{
+			return false;
+		}
+		for ( size_t i = 0; i < sizeof( s_magic ); ++i )
+		{
+			if ( o_header.magic[i] != s_magic[i] )
+			{
+				return false;
+			}
+		}
+		if ( o_header.version != s_version )
+		{
+			return false;
+		}
+		o_bytecode.resize( static_cast<size_t>( o_header.bytecodeSize ) );
+		if ( !o_bytecode.empty() && !file.read( o_bytecode.data(), o_bytecode.size() ) )
+		{
+			return false;
+		}
+		// Loading a corrupt binary chunk isn't safe
+		// (Lua doesn't verify bytecode)
+		return CalculateHash( o_bytecode ) == o_header.bytecodeHash;
+	}
+
+	bool WriteCacheFile( const char* const i_path, const sCacheHeader& i_header, const std::vector<char>& i_bytecode )
+	{
+		// The temporary file's name is unique to this process and this call
+		static std::atomic<uint64_t> s_temporaryFileCount( 0 );
+#if defined( EAE6320_PLATFORM_WINDOWS )
+		const auto processId = static_cast<uint64_t>( GetCurrentProcessId() );
+#else
+		const auto processId = static_cast<uint64_t>( getpid() );
+#endif
+		const auto temporaryPath = std::string( i_path ) + "." + std::to_string( processId )
+			+ "." + std::to_string( s_temporaryFileCount++ ) + ".tmp";
+		{
+			std::ofstream file( temporaryPath, std::ios::binary | std::ios::trunc );
+			if ( !file )
+			{
+				return false;
+			}
+			if ( !file.write( reinterpret_cast<const char*>( &i_header ), sizeof( i_header ) )
+				|| !file.write( i_bytecode.data(), i_bytecode.size() ) || !file.flush() )
+			{
+				file.close();
+				std::remove( temporaryPath.c_str() );
+				return false;
+			}
+		}
+		if ( !ReplaceFile( temporaryPath.c_str(), i_path ) )
+		{
+			std::remove( temporaryPath.c_str() );
+			return false;
+		}
+		return true;
+	}
+
+	bool ReplaceFile( const char* const i_temporaryPath, const char* const i_path )
+	{
+#if defined( EAE6320_PLATFORM_WINDOWS )
+		// std::rename() fails on Windows if the destination exists
+		return MoveFileExA( i_temporaryPath, i_path, MOVEFILE_REPLACE_EXISTING ) != FALSE;
+#else
+		// rename() atomically replaces the destination,
+		// and so a reader sees either the old cache file or the new one
+		return std::rename( i_temporaryPath, i_path ) == 0;
+#endif
+	}
+
+	int WriteBytecode( lua_State*, const void* const i_data, const size_t i_size, void* io_userData )
+	{
+		auto& bytecode = *static_cast<std::vector<char>*>( io_userData );
+		const auto* const data = static_cast<const char*>( i_data );
+		bytecode.insert( bytecode.end(), data, data + i_size );
+		return 0;
+	}
+}
@@ -0,0 +1,100 @@
+/*
+	A bytecode cache stores the precompiled form of Lua asset files
+	so that their source text doesn't have to be lexed and parsed every time they are loaded
+
+	The output of lua_dump() is saved in a cache file for each source file
+	along with the source file's size, a hash of its contents, and a checksum of the bytecode.
+	The source file is still read and hashed every time (which is much cheaper than compiling it)
+	and the precompiled chunk is only loaded if both hashes match;
+	when the cache file is stale (or missing, or corrupt) the source file is loaded and the cache file is rewritten.
+	A cache file is written to a temporary file that then replaces it,
+	and so a crash or a concurrent writer never leaves a partial cache file.
+*/
+
+#ifndef EAE6320_TABLES_CBYTECODECACHE_H
+#define EAE6320_TABLES_CBYTECODECACHE_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cBytecodeCache
+	{
+		// Interface
+		//==========
+
+	public:
+
+		struct sStatistics
+		{
+			// A hit means that the precompiled chunk was loaded
+			uint64_t hitCount = 0;
+			// A miss means that the source file had to be loaded
+			uint64_t missCount = 0;
+			// The subset of misses where a cache file existed but was out of date
+			uint64_t staleCount = 0;
+		};
+
+		// Loading
+		//--------
+
+		// This is a drop-in replacement for luaL_loadfile():
+		//	* On success it returns LUA_OK and pushes the loaded chunk
+		//	* On failure it returns the Lua error code and pushes an error message
+		int LoadFile( lua_State& io_luaState, const char* const i_path );
+
+		// Access
+		//-------
+
+		sStatistics GetStatistics() const;
+		void ResetStatistics();
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// If no directory is provided then each cache file is written next to its source file.
+		// A directory must already exist and should include the trailing slash.
+		// Stripping debug information makes the cache files smaller and faster to load,
+		// but Lua error messages will no longer include line numbers.
+		cBytecodeCache( const char* const i_cacheDirectory = "", const bool i_shouldDebugInformationBeStripped = false );
+
+		cBytecodeCache( const cBytecodeCache& ) = delete;
+		cBytecodeCache& operator =( const cBytecodeCache& ) = delete;
+
+		// Implementation
+		//===============
+
+	private:
+
+		std::string GetCachePath( const char* const i_sourcePath ) const;
+
+		// Data
+		//=====
+
+	private:
+
+		const std::string m_cacheDirectory;
+		const bool m_shouldDebugInformationBeStripped;
+
+		// The counters are atomic so that a single cache can be shared by multiple loading threads
+		// (each thread must still use its own lua_State)
+		std::atomic<uint64_t> m_hitCount;
+		std::atomic<uint64_t> m_missCount;
+		std::atomic<uint64_t> m_staleCount;
+	};
+}
+
+#endif	// EAE6320_TABLES_CBYTECODECACHE_H
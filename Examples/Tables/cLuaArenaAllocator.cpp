@@ -0,0 +1,269 @@
+// Include Files
+//==============
+
+#include "cLuaArenaAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	constexpr size_t s_maxSmallBlockSize = eae6320::cLuaArenaAllocator::GetBlockSize( eae6320::cLuaArenaAllocator::s_sizeClassCount - 1 );
+
+	constexpr size_t GetSizeClassIndex( const size_t i_size ) { return ( i_size - 1 ) / eae6320::cLuaArenaAllocator::s_sizeClassGranularity; }
+	constexpr bool IsSmall( const size_t i_size ) { return i_size <= s_maxSmallBlockSize; }
+
+	void CountAllocation( eae6320::cLuaArenaAllocator::sSizeClassStatistics& io_statistics );
+	void CountFree( eae6320::cLuaArenaAllocator::sSizeClassStatistics& io_statistics );
+
+	int OnPanic( lua_State* io_luaState );
+}
+
+// Every block in a chunk must be aligned for any type that Lua stores in it
+static_assert( ( eae6320::cLuaArenaAllocator::s_sizeClassGranularity % alignof( std::max_align_t ) ) == 0
+	|| ( alignof( std::max_align_t ) % eae6320::cLuaArenaAllocator::s_sizeClassGranularity ) == 0,
+	"The size class granularity must be compatible with malloc()'s alignment" );
+
+// Interface
+//==========
+
+// Access
+//-------
+
+lua_State* eae6320::cLuaArenaAllocator::NewState()
+{
+	EAE6320_ASSERTF( !m_luaState, "An arena allocator can only be used by one Lua state at a time" );
+	m_luaState = lua_newstate( Allocate, this );
+	if ( m_luaState )
+	{
+		lua_atpanic( m_luaState, OnPanic );
+	}
+	return m_luaState;
+}
+
+void eae6320::cLuaArenaAllocator::CloseState( lua_State*& io_luaState )
+{
+	if ( !io_luaState )
+	{
+		return;
+	}
+	EAE6320_ASSERT( io_luaState == m_luaState );
+	// Closing the state frees every block that it allocated
+	// (which puts the small ones on the free lists),
+	// and then the chunks themselves can be freed without looking at the individual blocks
+	lua_close( io_luaState );
+	io_luaState = m_luaState = nullptr;
+	FreeChunks();
+}
+
+void* eae6320::cLuaArenaAllocator::Allocate( void* io_userData, void* i_block, size_t i_oldSize, size_t i_newSize )
+{
+	auto& allocator = *static_cast<cLuaArenaAllocator*>( io_userData );
+	if ( !i_block )
+	{
+		// When there is no block Lua passes the type of object in the "old size"
+		// (which this allocator doesn't need)
+		return ( i_newSize > 0 ) ? allocator.AllocateBlock( i_newSize ) : nullptr;
+	}
+	else if ( i_newSize == 0 )
+	{
+		allocator.FreeBlock( i_block, i_oldSize );
+		return nullptr;
+	}
+	else
+	{
+		return allocator.ReallocateBlock( i_block, i_oldSize, i_newSize );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cLuaArenaAllocator::cLuaArenaAllocator( const size_t i_chunkSize )
+	:
+	m_chunkSize( std::max( i_chunkSize, s_maxSmallBlockSize ) )
+{
+
+}
+
+eae6320::cLuaArenaAllocator::~cLuaArenaAllocator()
+{
+	// If the state were still open it would be left with dangling pointers to the chunks
+	EAE6320_ASSERTF( !m_luaState, "A Lua state must be closed before the arena allocator that it uses is destroyed" );
+	FreeChunks();
+}
+
+// Implementation
+//===============
+
+void* eae6320::cLuaArenaAllocator::AllocateBlock( const size_t i_size )
+{
+	if ( !IsSmall( i_size ) )
+	{
+		auto* const block = std::malloc( i_size );
+		if ( block )
+		{
+			CountAllocation( m_statistics.largeBlocks );
+			m_statistics.currentLargeByteCount += i_size;
+			m_statistics.peakLargeByteCount = std::max( m_statistics.peakLargeByteCount, m_statistics.currentLargeByteCount );
+		}
+		return block;
+	}
+
+	const auto sizeClassIndex = GetSizeClassIndex( i_size );
+	void* block = nullptr;
+	if ( auto* const freeBlock = m_freeBlocks[sizeClassIndex] )
+	{
+		m_freeBlocks[sizeClassIndex] = freeBlock->next;
+		block = freeBlock;
+	}
+	else
+	{
+		const auto blockSize = GetBlockSize( sizeClassIndex );
+		if ( static_cast<size_t>( m_chunkEnd - m_chunkPosition ) < blockSize )
+		{
+			// Whatever is left at the end of the current chunk is wasted
+			// (it is always smaller than the largest size class)
+			auto* const chunk = static_cast<uint8_t*>( std::malloc( m_chunkSize ) );
+			if ( !chunk )
+			{
+				return nullptr;
+			}
+			m_chunks.push_back( chunk );
+			m_chunkPosition = chunk;
+			m_chunkEnd = chunk + m_chunkSize;
+			m_statistics.chunkCount = m_chunks.size();
+		}
+		block = m_chunkPosition;
+		m_chunkPosition += blockSize;
+	}
+	CountAllocation( m_statistics.sizeClasses[sizeClassIndex] );
+	return block;
+}
+
+void eae6320::cLuaArenaAllocator::FreeBlock( void* const i_block, const size_t i_size )
+{
+	if ( !IsSmall( i_size ) )
+	{
+		std::free( i_block );
+		CountFree( m_statistics.largeBlocks );
+		m_statistics.currentLargeByteCount -= i_size;
+		return;
+	}
+
+	const auto sizeClassIndex = GetSizeClassIndex( i_size );
+	auto* const freeBlock = static_cast<sFreeBlock*>( i_block );
+	freeBlock->next = m_freeBlocks[sizeClassIndex];
+	m_freeBlocks[sizeClassIndex] = freeBlock;
+	CountFree( m_statistics.sizeClasses[sizeClassIndex] );
+}
+
+void* eae6320::cLuaArenaAllocator::ReallocateBlock( void* const i_block, const size_t i_oldSize, const size_t i_newSize )
+{
+	const auto isOldSizeSmall = IsSmall( i_oldSize );
+	const auto isNewSizeSmall = IsSmall( i_newSize );
+	if ( isOldSizeSmall && isNewSizeSmall )
+	{
+		if ( GetSizeClassIndex( i_oldSize ) == GetSizeClassIndex( i_newSize ) )
+		{
+			++m_statistics.inPlaceReallocationCount;
+			return i_block;
+		}
+	}
+	else if ( !isOldSizeSmall && !isNewSizeSmall )
+	{
+		auto* const newBlock = std::realloc( i_block, i_newSize );
+		if ( newBlock )
+		{
+			m_statistics.currentLargeByteCount = m_statistics.currentLargeByteCount - i_oldSize + i_newSize;
+			m_statistics.peakLargeByteCount = std::max( m_statistics.peakLargeByteCount, m_statistics.currentLargeByteCount );
+		}
+		else if ( i_newSize < i_oldSize )
+		{
+			// Lua assumes that shrinking a block never fails,
+			// and the old block is still big enough
+			m_statistics.currentLargeByteCount = m_statistics.currentLargeByteCount - i_oldSize + i_newSize;
+			return i_block;
+		}
+		return newBlock;
+	}
+
+	// The block has to move to a different size class
+	// (or between a chunk and malloc())
+	auto* const newBlock = AllocateBlock( i_newSize );
+	if ( !newBlock )
+	{
+		if ( i_newSize < i_oldSize )
+		{
+			// Lua assumes that shrinking a block never fails.
+			// The old block is still big enough, and it is OK for Lua to use it as if it were the smaller size:
+			// When it is freed it will go onto the free list of the smaller size class
+			// (even if it came from malloc(), in which case it won't be freed until the process exits,
+			// but that can only happen when the program is already out of memory).
+			if ( isOldSizeSmall )
+			{
+				CountFree( m_statistics.sizeClasses[GetSizeClassIndex( i_oldSize )] );
+			}
+			else
+			{
+				CountFree( m_statistics.largeBlocks );
+				m_statistics.currentLargeByteCount -= i_oldSize;
+			}
+			CountAllocation( m_statistics.sizeClasses[GetSizeClassIndex( i_newSize )] );
+			return i_block;
+		}
+		return nullptr;
+	}
+	std::memcpy( newBlock, i_block, std::min( i_oldSize, i_newSize ) );
+	FreeBlock( i_block, i_oldSize );
+	return newBlock;
+}
+
+void eae6320::cLuaArenaAllocator::FreeChunks()
+{
+	for ( auto* const chunk : m_chunks )
+	{
+		std::free( chunk );
+	}
+	m_chunks.clear();
+	m_chunkPosition = m_chunkEnd = nullptr;
+	for ( auto& freeBlock : m_freeBlocks )
+	{
+		freeBlock = nullptr;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void CountAllocation( eae6320::cLuaArenaAllocator::sSizeClassStatistics& io_statistics )
+	{
+		++io_statistics.allocationCount;
+		++io_statistics.currentBlockCount;
+		io_statistics.peakBlockCount = std::max( io_statistics.peakBlockCount, io_statistics.currentBlockCount );
+	}
+
+	void CountFree( eae6320::cLuaArenaAllocator::sSizeClassStatistics& io_statistics )
+	{
+		EAE6320_ASSERT( io_statistics.currentBlockCount > 0 );
+		++io_statistics.freeCount;
+		--io_statistics.currentBlockCount;
+	}
+
+	int OnPanic( lua_State* io_luaState )
+	{
+		// This is the same as the panic function that luaL_newstate() sets
+		std::cerr << "PANIC: unprotected error in call to Lua API (" << lua_tostring( io_luaState, -1 ) << ")" << std::endl;
+		constexpr int returnToLuaToAbort = 0;
+		return returnToLuaToAbort;
+	}
+}
@@ -0,0 +1,132 @@
+/*
+	An arena allocator is a lua_Alloc that a single Lua state can be created with
+	instead of using the default allocator (which calls realloc() and free() for every block)
+
+	Almost everything that Lua allocates is small
+	(strings, tables and their node arrays, closures, upvalues, etc.),
+	and so small blocks are rounded up to a size class
+	and carved out of large chunks that are only allocated occasionally.
+	A freed block goes onto a free list for its size class
+	and is reused by the next allocation of that class.
+	Blocks larger than the largest size class still use malloc().
+
+	Lua always tells the allocator how big a block is when it is freed or reallocated,
+	and so the blocks don't need any header.
+
+	Every chunk is freed at once when the state is closed with CloseState(),
+	which means that a short-lived state (e.g. one that loads a single asset)
+	only calls malloc() and free() a handful of times.
+*/
+
+#ifndef EAE6320_TABLES_CLUAARENAALLOCATOR_H
+#define EAE6320_TABLES_CLUAARENAALLOCATOR_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cLuaArenaAllocator
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Size classes are multiples of the granularity,
+		// and so the largest block that comes from a chunk is 256 bytes
+		static constexpr size_t s_sizeClassGranularity = 16;
+		static constexpr size_t s_sizeClassCount = 16;
+
+		struct sSizeClassStatistics
+		{
+			uint64_t allocationCount = 0;
+			uint64_t freeCount = 0;
+			size_t currentBlockCount = 0;
+			size_t peakBlockCount = 0;
+		};
+		struct sStatistics
+		{
+			sSizeClassStatistics sizeClasses[s_sizeClassCount];
+			// Blocks larger than the largest size class
+			sSizeClassStatistics largeBlocks;
+			size_t currentLargeByteCount = 0;
+			size_t peakLargeByteCount = 0;
+			// A reallocation that stays in the same size class returns the same block
+			uint64_t inPlaceReallocationCount = 0;
+			size_t chunkCount = 0;
+		};
+
+		// Access
+		//-------
+
+		// Creates a state that uses this allocator
+		// (the same way that luaL_newstate() does, including setting a panic function),
+		// or returns NULL if it couldn't be created.
+		// Only one state can use an allocator at a time.
+		lua_State* NewState();
+		// Closes the state and frees every chunk
+		// (after this the allocator can be used to create a new state)
+		void CloseState( lua_State*& io_luaState );
+
+		const sStatistics& GetStatistics() const { return m_statistics; }
+		static constexpr size_t GetBlockSize( const size_t i_sizeClassIndex ) { return ( i_sizeClassIndex + 1 ) * s_sizeClassGranularity; }
+
+		// This is the lua_Alloc function
+		// (the user data must be the allocator)
+		static void* Allocate( void* io_userData, void* i_block, size_t i_oldSize, size_t i_newSize );
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// i_chunkSize: How many bytes are allocated at a time for small blocks
+		cLuaArenaAllocator( const size_t i_chunkSize = 64 * 1024 );
+		~cLuaArenaAllocator();
+
+		cLuaArenaAllocator( const cLuaArenaAllocator& ) = delete;
+		cLuaArenaAllocator& operator =( const cLuaArenaAllocator& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		struct sFreeBlock
+		{
+			sFreeBlock* next;
+		};
+
+		const size_t m_chunkSize;
+		std::vector<void*> m_chunks;
+		// New blocks are carved out of the most recent chunk
+		uint8_t* m_chunkPosition = nullptr;
+		uint8_t* m_chunkEnd = nullptr;
+		sFreeBlock* m_freeBlocks[s_sizeClassCount] = {};
+		lua_State* m_luaState = nullptr;
+		sStatistics m_statistics;
+
+		// Implementation
+		//===============
+
+	private:
+
+		void* AllocateBlock( const size_t i_size );
+		void FreeBlock( void* const i_block, const size_t i_size );
+		void* ReallocateBlock( void* const i_block, const size_t i_oldSize, const size_t i_newSize );
+		void FreeChunks();
+	};
+}
+
+#endif	// EAE6320_TABLES_CLUAARENAALLOCATOR_H
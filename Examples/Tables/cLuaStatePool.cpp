@@ -0,0 +1,271 @@
+// Include Files
+//==============
+
+#include "cLuaStatePool.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The registry key of a table with shallow copies of the global table and the registry
+	// as they were when the state was created
+	char s_newStateKey;
+
+	// These are called in protected mode
+	// (since they allocate, and a memory error would otherwise end the program)
+	int SaveNewState( lua_State* io_luaState );
+	int RestoreNewState( lua_State* io_luaState );
+
+	void CopyTable( lua_State& io_luaState, const int i_index );
+	// Removes every key that isn't in the copy and sets every key that is back to its copied value
+	void RestoreTable( lua_State& io_luaState, const int i_index, const int i_copyIndex, const void* const i_keyToKeep );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+lua_State* eae6320::cLuaStatePool::AcquireState()
+{
+#if defined( LUA_USE_SHAREDSTRINGS )
+	lua_StringPool* stringPool;
+#endif
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if ( !m_availableStates.empty() )
+		{
+			auto* const luaState = m_availableStates.back();
+			m_availableStates.pop_back();
+			++m_statistics.reusedStateCount;
+			return luaState;
+		}
+#if defined( LUA_USE_SHAREDSTRINGS )
+		stringPool = m_stringPool;
+#endif
+	}
+
+	// A new state is created outside of the lock
+	// so that other threads can keep acquiring and releasing
+#if defined( LUA_USE_SHAREDSTRINGS )
+	auto* const luaState = stringPool ? luaL_newstatewithpool( stringPool ) : luaL_newstate();
+#else
+	auto* const luaState = luaL_newstate();
+#endif
+	if ( luaState )
+	{
+		lua_pushcfunction( luaState, SaveNewState );
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 0;
+		constexpr int noErrorHandler = 0;
+		if ( lua_pcall( luaState, argumentCount, returnValueCount, noErrorHandler ) != LUA_OK )
+		{
+			lua_close( luaState );
+			return nullptr;
+		}
+		std::lock_guard<std::mutex> lock( m_mutex );
+		++m_statistics.createdStateCount;
+	}
+	return luaState;
+}
+
+void eae6320::cLuaStatePool::ReleaseState( lua_State*& io_luaState )
+{
+	if ( !io_luaState )
+	{
+		return;
+	}
+	auto* const luaState = io_luaState;
+	io_luaState = nullptr;
+
+	// Drop everything that the caller left on the stack
+	// (e.g. the loaded asset table),
+	// which makes it garbage
+	lua_settop( luaState, 0 );
+	// Restore the globals and the registry
+	// so that nothing that one load left behind (e.g. a global that the asset file assigned)
+	// can be seen by the next load
+	bool wasStateRestored;
+	{
+		lua_pushcfunction( luaState, RestoreNewState );
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 0;
+		constexpr int noErrorHandler = 0;
+		wasStateRestored = lua_pcall( luaState, argumentCount, returnValueCount, noErrorHandler ) == LUA_OK;
+		lua_settop( luaState, 0 );
+	}
+	if ( m_garbageCollectionStepSizeOnRelease > 0 )
+	{
+		// A full collection would make releasing expensive,
+		// but a bounded step keeps garbage from accumulating across many loads
+		lua_gc( luaState, LUA_GCSTEP, m_garbageCollectionStepSizeOnRelease );
+	}
+
+	const bool shouldStateBeReused = wasStateRestored && ( ( m_maxMemoryKilobytesToReuse <= 0 )
+		|| ( lua_gc( luaState, LUA_GCCOUNT, 0 ) <= m_maxMemoryKilobytesToReuse ) );
+	if ( shouldStateBeReused )
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if ( m_availableStates.size() < m_maxAvailableStateCount )
+		{
+			m_availableStates.push_back( luaState );
+			return;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		++m_statistics.discardedStateCount;
+	}
+	lua_close( luaState );
+}
+
+eae6320::cLuaStatePool::sStatistics eae6320::cLuaStatePool::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	return m_statistics;
+}
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+
+eae6320::cResult eae6320::cLuaStatePool::ShareStrings( lua_State*& io_luaState )
+{
+	EAE6320_ASSERT( io_luaState );
+	auto* const luaState = io_luaState;
+	io_luaState = nullptr;
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( m_stringPool )
+	{
+		EAE6320_ASSERTF( false, "The states of a pool can only share the strings of one state" );
+		lua_close( luaState );
+		return Results::Failure;
+	}
+	m_stringPool = lua_newstringpool( luaState );
+	if ( !m_stringPool )
+	{
+		lua_close( luaState );
+		return Results::OutOfMemory;
+	}
+	return Results::Success;
+}
+
+#endif
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cLuaStatePool::cLuaStatePool( const size_t i_maxAvailableStateCount,
+	const int i_garbageCollectionStepSizeOnRelease, const int i_maxMemoryKilobytesToReuse )
+	:
+	m_maxAvailableStateCount( i_maxAvailableStateCount ),
+	m_garbageCollectionStepSizeOnRelease( i_garbageCollectionStepSizeOnRelease ),
+	m_maxMemoryKilobytesToReuse( i_maxMemoryKilobytesToReuse )
+{
+
+}
+
+eae6320::cLuaStatePool::~cLuaStatePool()
+{
+	for ( auto* const luaState : m_availableStates )
+	{
+		EAE6320_ASSERT( lua_gettop( luaState ) == 0 );
+		lua_close( luaState );
+	}
+	m_availableStates.clear();
+#if defined( LUA_USE_SHAREDSTRINGS )
+	if ( m_stringPool )
+	{
+		// States that are still in use keep the strings alive until they are closed
+		lua_closestringpool( m_stringPool );
+		m_stringPool = nullptr;
+	}
+#endif
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	int SaveNewState( lua_State* io_luaState )
+	{
+		lua_createtable( io_luaState, 0, 2 );
+		lua_rawgeti( io_luaState, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS );
+		CopyTable( *io_luaState, -1 );
+		lua_setfield( io_luaState, -3, "globals" );
+		lua_pop( io_luaState, 1 );
+		CopyTable( *io_luaState, LUA_REGISTRYINDEX );
+		lua_setfield( io_luaState, -2, "registry" );
+		lua_rawsetp( io_luaState, LUA_REGISTRYINDEX, &s_newStateKey );
+		return 0;
+	}
+
+	int RestoreNewState( lua_State* io_luaState )
+	{
+		lua_rawgetp( io_luaState, LUA_REGISTRYINDEX, &s_newStateKey );
+		const auto newStateIndex = lua_gettop( io_luaState );
+		lua_getfield( io_luaState, newStateIndex, "registry" );
+		RestoreTable( *io_luaState, LUA_REGISTRYINDEX, lua_gettop( io_luaState ), &s_newStateKey );
+		lua_pop( io_luaState, 1 );
+		// The global table itself is never replaced (it is restored as part of the registry)
+		lua_rawgeti( io_luaState, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS );
+		lua_getfield( io_luaState, newStateIndex, "globals" );
+		RestoreTable( *io_luaState, -2, lua_gettop( io_luaState ), nullptr );
+		// A new state's global table doesn't have a metatable
+		lua_pushnil( io_luaState );
+		lua_setmetatable( io_luaState, -3 );
+		return 0;
+	}
+
+	void CopyTable( lua_State& io_luaState, const int i_index )
+	{
+		const auto index = lua_absindex( &io_luaState, i_index );
+		lua_newtable( &io_luaState );
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, index ) != 0 )
+		{
+			lua_pushvalue( &io_luaState, -2 );
+			lua_insert( &io_luaState, -2 );
+			lua_rawset( &io_luaState, -4 );
+		}
+	}
+
+	void RestoreTable( lua_State& io_luaState, const int i_index, const int i_copyIndex, const void* const i_keyToKeep )
+	{
+		const auto index = lua_absindex( &io_luaState, i_index );
+		// Remove the new keys
+		// (assigning nil to an existing key is allowed while traversing a table)
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, index ) != 0 )
+		{
+			lua_pop( &io_luaState, 1 );
+			lua_pushvalue( &io_luaState, -1 );
+			lua_rawget( &io_luaState, i_copyIndex );
+			const auto wasKeyCopied = !lua_isnil( &io_luaState, -1 );
+			lua_pop( &io_luaState, 1 );
+			if ( !wasKeyCopied
+				&& !( i_keyToKeep && ( lua_type( &io_luaState, -1 ) == LUA_TLIGHTUSERDATA )
+					&& ( lua_touserdata( &io_luaState, -1 ) == i_keyToKeep ) ) )
+			{
+				lua_pushvalue( &io_luaState, -1 );
+				lua_pushnil( &io_luaState );
+				lua_rawset( &io_luaState, index );
+			}
+		}
+		// Restore the values of the original keys
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, i_copyIndex ) != 0 )
+		{
+			lua_pushvalue( &io_luaState, -2 );
+			lua_insert( &io_luaState, -2 );
+			lua_rawset( &io_luaState, index );
+		}
+	}
+}
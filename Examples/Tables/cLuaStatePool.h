@@ -0,0 +1,121 @@
+/*
+	A Lua state pool keeps Lua states alive between asset loads
+	so that the cost of creating a new state (the string table, registry, global table, etc.)
+	only has to be paid once instead of once per asset
+
+	A state that is released back to the pool has its stack cleared
+	(which drops the loaded asset table)
+	and can optionally run a bounded garbage collection step before it is reused.
+	Its global table and registry are also restored to what they were when the state was created
+	(the keys that were added are removed and the values that were changed are set back),
+	and so nothing that one load leaves behind (e.g. a global that an asset file assigned,
+	or a library that was opened) can be seen by the next load.
+	(This is shallow: a table that was in the state when it was created,
+	like package.loaded if the pool's states opened libraries, isn't restored itself.)
+
+	When Lua is built with LUA_USE_SHAREDSTRINGS the pool can also give its states a shared string pool
+	so that the names and keys that every asset uses (e.g. "textures" or "parameters")
+	are only stored once instead of once per state.
+*/
+
+#ifndef EAE6320_TABLES_CLUASTATEPOOL_H
+#define EAE6320_TABLES_CLUASTATEPOOL_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/cResult.h>
+#include <mutex>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+#if defined( LUA_USE_SHAREDSTRINGS )
+struct lua_StringPool;
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cLuaStatePool
+	{
+		// Interface
+		//==========
+
+	public:
+
+		struct sStatistics
+		{
+			uint64_t createdStateCount = 0;
+			uint64_t reusedStateCount = 0;
+			// States are closed instead of being reused when they have grown too large,
+			// when their globals and registry couldn't be restored,
+			// or when the pool already has as many unused states as it keeps
+			uint64_t discardedStateCount = 0;
+		};
+
+		// Access
+		//-------
+
+		// Returns a state with an empty stack,
+		// or NULL if a new state was required and couldn't be created
+		lua_State* AcquireState();
+		// The state's stack is cleared, its globals and registry are restored, and the pointer is set to NULL
+		void ReleaseState( lua_State*& io_luaState );
+
+		sStatistics GetStatistics() const;
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+		// The states that are created after this is called share the short strings of the given state
+		// (e.g. the names and keys that loading typical assets made) instead of making their own copies.
+		// The given state is frozen and must not be used again (the string pool closes it when it is no longer needed),
+		// and so the pointer is set to NULL (even if this fails).
+		// This fails if the states already share strings or if there isn't enough memory.
+		cResult ShareStrings( lua_State*& io_luaState );
+#endif
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// i_maxAvailableStateCount: How many unused states will be kept alive
+		//	(when more than this are released the extras are closed)
+		// i_garbageCollectionStepSizeOnRelease: The "size" passed to lua_gc( LUA_GCSTEP ) when a state is released
+		//	(0 means that no collection is done)
+		// i_maxMemoryKilobytesToReuse: A released state using more memory than this is closed rather than reused
+		//	(0 means that there is no limit)
+		cLuaStatePool( const size_t i_maxAvailableStateCount = 4,
+			const int i_garbageCollectionStepSizeOnRelease = 0, const int i_maxMemoryKilobytesToReuse = 0 );
+		~cLuaStatePool();
+
+		cLuaStatePool( const cLuaStatePool& ) = delete;
+		cLuaStatePool& operator =( const cLuaStatePool& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		const size_t m_maxAvailableStateCount;
+		const int m_garbageCollectionStepSizeOnRelease;
+		const int m_maxMemoryKilobytesToReuse;
+
+		// The pool can be shared by multiple threads
+		// (although any single state can only be used by one thread at a time)
+		mutable std::mutex m_mutex;
+		std::vector<lua_State*> m_availableStates;
+		sStatistics m_statistics;
+#if defined( LUA_USE_SHAREDSTRINGS )
+		// Every state that uses the string pool keeps it alive,
+		// and so it can be released when this pool is destroyed even if states that it created are still in use
+		lua_StringPool* m_stringPool = nullptr;
+#endif
+	};
+}
+
+#endif	// EAE6320_TABLES_CLUASTATEPOOL_H
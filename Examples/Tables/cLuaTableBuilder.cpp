@@ -0,0 +1,278 @@
+// Include Files
+//==============
+
+#include "cLuaTableBuilder.h"
+
+#include <climits>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// The interned keys are assigned and the template is copied using Lua's internal table functions
+// (the public API can only assign a key after it has been pushed)
+extern "C"
+{
+	#include <External/Lua/5.3.4/src/lgc.h>
+	#include <External/Lua/5.3.4/src/lstate.h>
+	#include <External/Lua/5.3.4/src/ltable.h>
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	constexpr auto* const s_templateKey = "template";
+
+	// Returns the table at the given index
+	// (which can be any index that the API accepts, like lua_rawset()'s)
+	Table* GetTable( lua_State& io_luaState, const int i_index );
+}
+
+// Interface
+//==========
+
+// Table Creation
+//---------------
+
+void eae6320::cLuaTableBuilder::PushNewTable() const
+{
+	EAE6320_ASSERTF( m_luaState, "The table builder wasn't initialized" );
+	lua_createtable( m_luaState, m_arrayCount, static_cast<int>( m_keys.size() ) );
+}
+
+void eae6320::cLuaTableBuilder::PushTemplateCopy() const
+{
+	EAE6320_ASSERTF( m_template, "The table builder wasn't initialized from a template" );
+	auto* const luaState = m_luaState;
+	PushNewTable();
+	auto* const copy = hvalue( luaState->top - 1 );
+	const auto* const source = static_cast<const Table*>( m_template );
+	// The copy already has room for every key,
+	// and so none of these assignments can rehash it (or allocate anything)
+	for ( unsigned int i = 0; i < source->sizearray; ++i )
+	{
+		const auto* const value = &source->array[i];
+		if ( !ttisnil( value ) )
+		{
+			luaH_setint( luaState, copy, static_cast<lua_Integer>( i ) + 1, const_cast<TValue*>( value ) );
+			luaC_barrierback( luaState, copy, value );
+		}
+	}
+	const auto nodeCount = sizenode( source );
+	for ( int i = 0; i < nodeCount; ++i )
+	{
+		const auto* const node = gnode( source, i );
+		const auto* const value = gval( node );
+		if ( !ttisnil( value ) )
+		{
+			auto* const slot = luaH_set( luaState, copy, gkey( node ) );
+			setobj2t( luaState, slot, value );
+			luaC_barrierback( luaState, copy, value );
+		}
+	}
+}
+
+// Population
+//-----------
+
+void eae6320::cLuaTableBuilder::SetField( const int i_tableIndex, const size_t i_keyIndex ) const
+{
+	EAE6320_ASSERT( i_keyIndex < m_keys.size() );
+	auto* const luaState = m_luaState;
+	auto* const table = GetTable( *luaState, i_tableIndex );
+	// This is what lua_rawset() does, but with a key that doesn't have to be pushed first
+	TValue key;
+	setsvalue( luaState, &key, static_cast<TString*>( const_cast<void*>( m_keys[i_keyIndex] ) ) );
+	auto* const value = luaState->top - 1;
+	auto* const slot = luaH_set( luaState, table, &key );
+	setobj2t( luaState, slot, value );
+	invalidateTMcache( table );
+	luaC_barrierback( luaState, table, value );
+	--luaState->top;
+}
+
+// Access
+//-------
+
+size_t eae6320::cLuaTableBuilder::FindKey( const char* const i_key ) const
+{
+	for ( size_t i = 0; i < m_keys.size(); ++i )
+	{
+		if ( std::strcmp( getstr( static_cast<const TString*>( m_keys[i] ) ), i_key ) == 0 )
+		{
+			return i;
+		}
+	}
+	return m_keys.size();
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::cLuaTableBuilder::Initialize( lua_State& io_luaState,
+	const int i_arrayCount, const char* const* const i_keys, const size_t i_keyCount )
+{
+	EAE6320_ASSERTF( !m_luaState, "The table builder was already initialized" );
+	if ( ( i_arrayCount < 0 ) || ( i_keyCount > static_cast<size_t>( INT_MAX ) ) )
+	{
+		std::cerr << "A table can't have " << i_arrayCount << " array elements and " << i_keyCount << " other keys" << std::endl;
+		return Results::Failure;
+	}
+	if ( !lua_checkstack( &io_luaState, 2 ) )
+	{
+		return Results::OutOfMemory;
+	}
+
+	// Every key is interned once here
+	// and then referenced by the keys table for as long as the builder exists
+	auto* const luaState = &io_luaState;
+	lua_createtable( luaState, static_cast<int>( i_keyCount ), 1 );
+	m_keys.resize( i_keyCount );
+	for ( size_t i = 0; i < i_keyCount; ++i )
+	{
+		lua_pushstring( luaState, i_keys[i] );
+		m_keys[i] = tsvalue( luaState->top - 1 );
+		lua_rawseti( luaState, -2, static_cast<lua_Integer>( i + 1 ) );
+	}
+	m_reference = luaL_ref( luaState, LUA_REGISTRYINDEX );
+	m_luaState = luaState;
+	m_arrayCount = i_arrayCount;
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::cLuaTableBuilder::InitializeFromTemplate( lua_State& io_luaState, const int i_templateIndex )
+{
+	auto result = Results::Success;
+
+	auto* const luaState = &io_luaState;
+	const auto templateIndex = lua_absindex( luaState, i_templateIndex );
+	if ( !lua_istable( luaState, templateIndex ) )
+	{
+		std::cerr << "A table builder's template must be a table (instead of a " << luaL_typename( luaState, templateIndex ) << ")" << std::endl;
+		return Results::Failure;
+	}
+	// Copying the template pushes the keys table, the copy, and a key and value (and the key again)
+	if ( !lua_checkstack( luaState, 5 ) )
+	{
+		return Results::OutOfMemory;
+	}
+
+	// Sort the template's keys into array elements and other (string) keys
+	const auto arrayCount = static_cast<lua_Integer>( lua_rawlen( luaState, templateIndex ) );
+	// The strings stay valid while they are being interned again because the template still references them
+	std::vector<const char*> keys;
+	lua_pushnil( luaState );
+	while ( lua_next( luaState, templateIndex ) != 0 )
+	{
+		// Don't use lua_tostring() on the key because it would change a number to a string and confuse lua_next()
+		if ( lua_type( luaState, -2 ) == LUA_TSTRING )
+		{
+			keys.push_back( lua_tostring( luaState, -2 ) );
+		}
+		else
+		{
+			int isInteger;
+			const auto key = lua_tointegerx( luaState, -2, &isInteger );
+			if ( !isInteger || ( key < 1 ) || ( key > arrayCount ) )
+			{
+				std::cerr << "A table builder's template can only have string keys and array indices "
+					"(not " << luaL_typename( luaState, -2 ) << " keys)" << std::endl;
+				// Pop the key and the value
+				lua_pop( luaState, 2 );
+				return Results::Failure;
+			}
+		}
+		// Pop the value
+		lua_pop( luaState, 1 );
+	}
+	if ( arrayCount > INT_MAX )
+	{
+		std::cerr << "A table builder's template can't have " << arrayCount << " array elements" << std::endl;
+		return Results::Failure;
+	}
+	if ( !( result = Initialize( io_luaState, static_cast<int>( arrayCount ), keys.data(), keys.size() ) ) )
+	{
+		return result;
+	}
+
+	// Copy the template into the keys table
+	// (so that the builder doesn't change if the original does)
+	lua_rawgeti( luaState, LUA_REGISTRYINDEX, m_reference );
+	PushNewTable();
+	lua_pushnil( luaState );
+	while ( lua_next( luaState, templateIndex ) != 0 )
+	{
+		lua_pushvalue( luaState, -2 );
+		lua_insert( luaState, -2 );
+		lua_rawset( luaState, -4 );
+	}
+	m_template = hvalue( luaState->top - 1 );
+	lua_setfield( luaState, -2, s_templateKey );
+	// Pop the keys table
+	lua_pop( luaState, 1 );
+
+	return result;
+}
+
+void eae6320::cLuaTableBuilder::CleanUp()
+{
+	if ( m_luaState )
+	{
+		luaL_unref( m_luaState, LUA_REGISTRYINDEX, m_reference );
+		m_luaState = nullptr;
+	}
+	m_reference = 0;
+	m_keys.clear();
+	m_template = nullptr;
+	m_arrayCount = 0;
+}
+
+eae6320::cLuaTableBuilder::~cLuaTableBuilder()
+{
+	CleanUp();
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	Table* GetTable( lua_State& io_luaState, const int i_index )
+	{
+		// This is what index2addr() in lapi.c does
+		auto* const luaState = &io_luaState;
+		const auto* const callInfo = luaState->ci;
+		const TValue* value;
+		if ( i_index > 0 )
+		{
+			// A positive index is relative to the current function's stack frame
+			EAE6320_ASSERTF( i_index <= ( luaState->top - ( callInfo->func + 1 ) ), "The table index isn't on the stack" );
+			value = callInfo->func + i_index;
+		}
+		else if ( i_index > LUA_REGISTRYINDEX )
+		{
+			// A negative index is relative to the top of the stack
+			EAE6320_ASSERTF( ( i_index != 0 ) && ( -i_index <= ( luaState->top - ( callInfo->func + 1 ) ) ),
+				"The table index isn't on the stack" );
+			value = luaState->top + i_index;
+		}
+		else if ( i_index == LUA_REGISTRYINDEX )
+		{
+			value = &G( luaState )->l_registry;
+		}
+		else
+		{
+			// Any other pseudo-index is an upvalue of the running C function
+			const auto upvalueIndex = LUA_REGISTRYINDEX - i_index;
+			EAE6320_ASSERTF( ttisCclosure( callInfo->func ) && ( upvalueIndex <= clCvalue( callInfo->func )->nupvalues ),
+				"The table index isn't an upvalue of the running C function" );
+			value = &clCvalue( callInfo->func )->upvalue[upvalueIndex - 1];
+		}
+		EAE6320_ASSERTF( ttistable( value ), "A table builder can only set fields of a table" );
+		return hvalue( value );
+	}
+}
@@ -0,0 +1,129 @@
+/*
+	A Lua table builder creates tables of a known shape from C++
+	(e.g. the "textures" array and "parameters" dictionary of readNestedTableValues.lua)
+	without the table having to be rehashed while it is being populated
+
+	When a table is created with lua_newtable() and filled one key at a time
+	it starts without any room and is rehashed (luaH_resize() in ltable.c) every time that it runs out,
+	which for a table with n keys is about log2(n) rehashes that each allocate new parts and move every key.
+	A builder knows the final shape up front:
+		* how many array elements (keys 1, 2, ..., n) and how many other keys the table will have,
+			which are passed to lua_createtable() so that both parts are allocated once at their final size
+		* the string keys, which are interned once when the builder is initialized
+			and then assigned directly without being pushed (and so without being hashed or interned again)
+
+	A builder can also be initialized from a "shape template" table,
+	and then it can push copies of that table (with the template's values as defaults)
+	which are allocated at the right size and copied node by node.
+
+	For example:
+		constexpr const char* parameterKeys[] = { "g_brightness", "g_speed" };
+		eae6320::cLuaTableBuilder parametersBuilder;
+		parametersBuilder.Initialize( *luaState, 0, parameterKeys, 2 );
+		...
+		parametersBuilder.PushNewTable();
+		lua_pushnumber( luaState, 12.3 );
+		parametersBuilder.SetField( -2, 0 );	// g_brightness
+		lua_pushnumber( luaState, 4.56 );
+		parametersBuilder.SetField( -2, 1 );	// g_speed
+
+	A builder belongs to the state that it was initialized with
+	and must be cleaned up (or destroyed) before that state is closed.
+*/
+
+#ifndef EAE6320_TABLES_CLUATABLEBUILDER_H
+#define EAE6320_TABLES_CLUATABLEBUILDER_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cLuaTableBuilder
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Table Creation
+		//---------------
+
+		// Pushes a new empty table with room for every key of the shape
+		void PushNewTable() const;
+		// Pushes a new table with the same keys and values as the template
+		// (this can only be used if the builder was initialized from a template)
+		void PushTemplateCopy() const;
+
+		// Population
+		//-----------
+
+		// Pops the value at the top of the stack and assigns it to the given key of the shape
+		// in the table at the given index.
+		// The assignment is raw (like lua_rawset()), and so the table's metatable is ignored.
+		// (Array elements can be assigned with lua_rawseti(),
+		// which doesn't need a key to be pushed and won't rehash an array part that already has room.)
+		void SetField( const int i_tableIndex, const size_t i_keyIndex ) const;
+
+		// Access
+		//-------
+
+		// Returns the index of the key to use with SetField(),
+		// or GetKeyCount() if it isn't one of the shape's keys
+		size_t FindKey( const char* const i_key ) const;
+		size_t GetKeyCount() const { return m_keys.size(); }
+		int GetArrayCount() const { return m_arrayCount; }
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// i_arrayCount: How many array elements (keys 1, 2, ..., n) a table will have
+		// i_keys: The other keys, which must all be different strings
+		cResult Initialize( lua_State& io_luaState, const int i_arrayCount, const char* const* const i_keys, const size_t i_keyCount );
+		// The template is the table at the given index.
+		// Its keys must be strings or array indices (1, 2, ..., n),
+		// and it is copied so that changing it later doesn't change the builder.
+		cResult InitializeFromTemplate( lua_State& io_luaState, const int i_templateIndex );
+		void CleanUp();
+
+		cLuaTableBuilder() = default;
+		~cLuaTableBuilder();
+
+		cLuaTableBuilder( const cLuaTableBuilder& ) = delete;
+		cLuaTableBuilder& operator =( const cLuaTableBuilder& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		lua_State* m_luaState = nullptr;
+		// A reference in the registry to a table
+		// whose array holds the key strings (so that they won't be collected)
+		// and whose "template" field holds the copy of the template (if there is one)
+		int m_reference = 0;
+		// The interned key strings and the template's table
+		// (Lua never moves an object, and so these stay valid while they are referenced)
+		std::vector<const void*> m_keys;
+		const void* m_template = nullptr;
+		int m_arrayCount = 0;
+	};
+}
+
+#endif	// EAE6320_TABLES_CLUATABLEBUILDER_H
@@ -0,0 +1,174 @@
+// Include Files
+//==============
+
+#include "cParallelAssetLoader.h"
+
+#include "cBytecodeCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <thread>
+
+// Interface
+//==========
+
+// Loading
+//--------
+
+eae6320::cResult eae6320::cParallelAssetLoader::LoadAssets( const std::vector<std::string>& i_paths, std::vector<sLoadedAsset>& o_loadedAssets )
+{
+	o_loadedAssets.clear();
+	o_loadedAssets.resize( i_paths.size() );
+	if ( i_paths.empty() )
+	{
+		return Results::Success;
+	}
+
+	// Assets are handed out one at a time from a shared counter
+	// (rather than splitting the list into equal parts up front)
+	// so that a thread that gets a few large assets doesn't hold up the others
+	std::atomic<size_t> nextAssetIndex( 0 );
+	const auto worker = [this, &i_paths, &o_loadedAssets, &nextAssetIndex]()
+	{
+		auto* luaState = m_luaStatePool.AcquireState();
+		for ( auto assetIndex = nextAssetIndex++; assetIndex < i_paths.size(); assetIndex = nextAssetIndex++ )
+		{
+			// Every thread writes to different elements of the output,
+			// and so no synchronization is needed
+			auto& loadedAsset = o_loadedAssets[assetIndex];
+			if ( luaState )
+			{
+				loadedAsset.result = LoadAsset( *luaState, i_paths[assetIndex].c_str(), loadedAsset.table );
+			}
+			else
+			{
+				loadedAsset.result = Results::OutOfMemory;
+			}
+		}
+		m_luaStatePool.ReleaseState( luaState );
+	};
+
+	// The calling thread does its share of the work too
+	// instead of waiting idly for the others
+	const auto threadCount = static_cast<unsigned int>( std::min( static_cast<size_t>( m_threadCount ), i_paths.size() ) );
+	{
+		std::vector<std::thread> threads;
+		threads.reserve( threadCount - 1 );
+		for ( unsigned int i = 1; i < threadCount; ++i )
+		{
+			threads.emplace_back( worker );
+		}
+		worker();
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+	}
+
+	for ( const auto& loadedAsset : o_loadedAssets )
+	{
+		if ( !loadedAsset.result )
+		{
+			return loadedAsset.result;
+		}
+	}
+	return Results::Success;
+}
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+
+eae6320::cResult eae6320::cParallelAssetLoader::ShareStringsOf( const std::vector<std::string>& i_paths )
+{
+	auto* luaState = luaL_newstate();
+	if ( !luaState )
+	{
+		return Results::OutOfMemory;
+	}
+	// The tables are garbage as soon as they are loaded,
+	// but their strings must still be there when they are shared
+	lua_gc( luaState, LUA_GCSTOP, 0 );
+	for ( const auto& path : i_paths )
+	{
+		sAssetValue table;
+		const auto result = LoadAsset( *luaState, path.c_str(), table );
+		if ( !result )
+		{
+			lua_close( luaState );
+			return result;
+		}
+	}
+	return m_luaStatePool.ShareStrings( luaState );
+}
+
+#endif
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cParallelAssetLoader::cParallelAssetLoader( const unsigned int i_threadCount, cBytecodeCache* const i_bytecodeCache )
+	:
+	m_threadCount( ( i_threadCount > 0 ) ? i_threadCount : std::max( std::thread::hardware_concurrency(), 1u ) ),
+	m_bytecodeCache( i_bytecodeCache ),
+	// Every thread needs its own state,
+	// and a garbage collection step is done when a state is given back
+	// so that the tables from one call don't accumulate until the next
+	m_luaStatePool( m_threadCount, 64 )
+{
+
+}
+
+// Implementation
+//===============
+
+eae6320::cResult eae6320::cParallelAssetLoader::LoadAsset( lua_State& io_luaState, const char* const i_path, sAssetValue& o_table )
+{
+	auto result = Results::Success;
+
+	// Load the asset file as a "chunk"
+	{
+		const auto luaResult = m_bytecodeCache ? m_bytecodeCache->LoadFile( io_luaState, i_path ) : luaL_loadfile( &io_luaState, i_path );
+		if ( luaResult != LUA_OK )
+		{
+			result = Results::Failure;
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+	}
+	// Execute the chunk, which should return the asset table
+	{
+		constexpr int argumentCount = 0;
+		constexpr int returnValueCount = 1;
+		constexpr int noMessageHandler = 0;
+		const auto luaResult = lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler );
+		if ( luaResult != LUA_OK )
+		{
+			result = Results::InvalidFile;
+			std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+	}
+	if ( lua_istable( &io_luaState, -1 ) )
+	{
+		// Copy the table so that it doesn't depend on the Lua state
+		result = sAssetValue::LoadFromLua( io_luaState, -1, o_table );
+		if ( !result )
+		{
+			std::cerr << "(The invalid asset was " << i_path << ")" << std::endl;
+		}
+	}
+	else
+	{
+		result = Results::InvalidFile;
+		std::cerr << "Asset files must return a table (instead of a "
+			<< luaL_typename( &io_luaState, -1 ) << "): " << i_path << std::endl;
+	}
+	// Pop the returned value
+	lua_pop( &io_luaState, 1 );
+
+	return result;
+}
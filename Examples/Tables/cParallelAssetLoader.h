@@ -0,0 +1,96 @@
+/*
+	A parallel asset loader loads many asset files at once using multiple threads
+
+	A single lua_State can only be used by one thread at a time,
+	but independent states can be used in parallel,
+	and so every worker thread loads its share of the assets with its own state.
+	Each asset table is converted into an sAssetValue
+	so that it no longer depends on the state that loaded it.
+*/
+
+#ifndef EAE6320_TABLES_CPARALLELASSETLOADER_H
+#define EAE6320_TABLES_CPARALLELASSETLOADER_H
+
+// Include Files
+//==============
+
+#include "cLuaStatePool.h"
+#include "sAssetValue.h"
+
+#include <Engine/Results/cResult.h>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	class cBytecodeCache;
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cParallelAssetLoader
+	{
+		// Interface
+		//==========
+
+	public:
+
+		struct sLoadedAsset
+		{
+			// The asset table is only valid if the result is a success
+			cResult result;
+			sAssetValue table;
+		};
+
+		// Loading
+		//--------
+
+		// Every path gets a corresponding loaded asset in the output (in the same order).
+		// The returned result is only a success if every asset was loaded successfully.
+		cResult LoadAssets( const std::vector<std::string>& i_paths, std::vector<sLoadedAsset>& o_loadedAssets );
+
+#if defined( LUA_USE_SHAREDSTRINGS )
+		// Loads the given (typical) assets with a state whose strings are then shared by every state that loads assets
+		// (see cLuaStatePool::ShareStrings()),
+		// which makes each worker's state smaller and faster to create.
+		// This must be called before the first call to LoadAssets() (the states that already exist don't share the strings).
+		cResult ShareStringsOf( const std::vector<std::string>& i_paths );
+#endif
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// If the thread count is 0 then one thread is used per hardware thread.
+		// If a bytecode cache is provided it must be valid for as long as the loader is.
+		cParallelAssetLoader( const unsigned int i_threadCount = 0, cBytecodeCache* const i_bytecodeCache = nullptr );
+
+		cParallelAssetLoader( const cParallelAssetLoader& ) = delete;
+		cParallelAssetLoader& operator =( const cParallelAssetLoader& ) = delete;
+
+		// Implementation
+		//===============
+
+	private:
+
+		cResult LoadAsset( lua_State& io_luaState, const char* const i_path, sAssetValue& o_table );
+
+		// Data
+		//=====
+
+	private:
+
+		const unsigned int m_threadCount;
+		cBytecodeCache* const m_bytecodeCache;
+		// Each worker takes a state from the pool for the duration of a LoadAssets() call,
+		// and so states are only created during the first call
+		cLuaStatePool m_luaStatePool;
+	};
+}
+
+#endif	// EAE6320_TABLES_CPARALLELASSETLOADER_H
@@ -0,0 +1,581 @@
+// Include Files
+//==============
+
+#include "cTableSnapshot.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+// Helper Class Declarations
+//==========================
+
+// A proxy is a userdata that refers to one of the snapshot's tables
+// and keeps the snapshot alive until it is collected
+struct eae6320::cTableSnapshot::sProxy
+{
+	std::shared_ptr<const cTableSnapshot> snapshot;
+	const sTable* table;
+};
+
+// The tables that have been copied (or are being copied) while a snapshot is made
+struct eae6320::cTableSnapshot::sCopiedTables
+{
+	// A table's lua_topointer() maps to its index in m_tables
+	std::unordered_map<const void*, uint32_t> indices;
+	// Whether each table in m_tables has been copied completely
+	// (a table that is reached again before it has been copied contains itself)
+	std::vector<bool> areCopied;
+};
+
+// Static Data
+//============
+
+namespace
+{
+	constexpr auto* const s_metatableName = "eae6320.tablesnapshot";
+	// The metatable's field that holds the weak table of every proxy in the state
+	// (the metatable is protected by __metatable, and so Lua code can't get to it)
+	constexpr auto* const s_proxiesKey = "proxies";
+
+	// Copying a table recurses into its nested tables,
+	// and so nesting is limited to a depth that no reasonable table would reach
+	// (this is the same as for an sAssetValue)
+	constexpr unsigned int s_maxTableDepth = 64;
+}
+
+// Interface
+//==========
+
+// Proxies
+//--------
+
+void eae6320::cTableSnapshot::PushProxy( lua_State& io_luaState, const std::shared_ptr<const cTableSnapshot>& i_snapshot )
+{
+	EAE6320_ASSERT( i_snapshot && !i_snapshot->m_tables.empty() );
+	luaL_checkstack( &io_luaState, 5, "not enough stack space for a table snapshot" );
+	// The metatable is created the first time that a state is given a proxy
+	if ( luaL_newmetatable( &io_luaState, s_metatableName ) )
+	{
+		// The weak table of proxies (keyed by the snapshot's tables)
+		// is the first upvalue of every metamethod that pushes a nested table
+		lua_newtable( &io_luaState );
+		{
+			lua_createtable( &io_luaState, 0, 1 );
+			lua_pushliteral( &io_luaState, "v" );
+			lua_setfield( &io_luaState, -2, "__mode" );
+			lua_setmetatable( &io_luaState, -2 );
+		}
+		lua_pushvalue( &io_luaState, -1 );
+		lua_setfield( &io_luaState, -3, s_proxiesKey );
+		// __pairs returns Next(), which is created once
+		{
+			lua_pushvalue( &io_luaState, -1 );
+			lua_pushcclosure( &io_luaState, Next, 1 );
+			lua_pushcclosure( &io_luaState, Pairs, 1 );
+			lua_setfield( &io_luaState, -3, "__pairs" );
+		}
+		{
+			const luaL_Reg metamethods[] =
+			{
+				{ "__index", Index },
+				{ "__newindex", NewIndex },
+				{ "__len", Length },
+				{ "__tostring", ToString },
+				{ "__gc", CollectGarbage },
+				{ nullptr, nullptr }
+			};
+			constexpr int upvalueCount = 1;
+			luaL_setfuncs( &io_luaState, metamethods, upvalueCount );
+		}
+		lua_pushboolean( &io_luaState, 0 );
+		lua_setfield( &io_luaState, -2, "__metatable" );
+	}
+	lua_getfield( &io_luaState, -1, s_proxiesKey );
+	constexpr uint32_t rootTableIndex = 0;
+	PushTableProxy( io_luaState, lua_absindex( &io_luaState, -1 ), i_snapshot, rootTableIndex );
+	// Remove the metatable and the proxies
+	lua_replace( &io_luaState, -3 );
+	lua_pop( &io_luaState, 1 );
+}
+
+// Access
+//-------
+
+size_t eae6320::cTableSnapshot::GetSize() const
+{
+	return sizeof( *this ) + ( m_tables.capacity() * sizeof( sTable ) ) + ( m_arrayValues.capacity() * sizeof( sValue ) )
+		+ ( m_slots.capacity() * sizeof( sSlot ) ) + m_strings.capacity();
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::cTableSnapshot::Create( lua_State& io_luaState, const int i_index, std::shared_ptr<const cTableSnapshot>& o_snapshot )
+{
+	auto result = Results::Success;
+
+	if ( !lua_istable( &io_luaState, i_index ) )
+	{
+		result = Results::InvalidFile;
+		std::cerr << "A snapshot can only be made of a table (instead of a " << luaL_typename( &io_luaState, i_index ) << ")" << std::endl;
+		return result;
+	}
+
+	std::shared_ptr<cTableSnapshot> snapshot( new cTableSnapshot );
+	sCopiedTables copiedTables;
+	uint32_t tableIndex;
+	if ( !( result = snapshot->AddTable( io_luaState, lua_absindex( &io_luaState, i_index ), 0, copiedTables, tableIndex ) ) )
+	{
+		return result;
+	}
+	EAE6320_ASSERT( tableIndex == 0 );
+	// The snapshot never changes again
+	snapshot->m_tables.shrink_to_fit();
+	snapshot->m_arrayValues.shrink_to_fit();
+	snapshot->m_slots.shrink_to_fit();
+	snapshot->m_strings.shrink_to_fit();
+	o_snapshot = std::move( snapshot );
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Copying
+//--------
+
+eae6320::cResult eae6320::cTableSnapshot::AddTable( lua_State& io_luaState, const int i_index, const unsigned int i_depth,
+	sCopiedTables& io_copiedTables, uint32_t& o_tableIndex )
+{
+	auto result = Results::Success;
+
+	// A table that is referenced more than once is only copied the first time
+	const auto* const luaTable = lua_topointer( &io_luaState, i_index );
+	{
+		const auto copiedTable = io_copiedTables.indices.find( luaTable );
+		if ( copiedTable != io_copiedTables.indices.end() )
+		{
+			if ( !io_copiedTables.areCopied[copiedTable->second] )
+			{
+				result = Results::InvalidFile;
+				std::cerr << "Snapshot tables can't contain themselves" << std::endl;
+				return result;
+			}
+			o_tableIndex = copiedTable->second;
+			return result;
+		}
+	}
+	if ( i_depth >= s_maxTableDepth )
+	{
+		result = Results::InvalidFile;
+		std::cerr << "Snapshot tables can't be nested more than " << s_maxTableDepth << " levels deep" << std::endl;
+		return result;
+	}
+	// Every level of nesting needs a few stack slots (a key, a value, and the nested table's key and value)
+	if ( !lua_checkstack( &io_luaState, 4 ) )
+	{
+		result = Results::OutOfMemory;
+		std::cerr << "The Lua stack couldn't grow to read a nested table" << std::endl;
+		return result;
+	}
+
+	// The table's entry is added before any nested table's entry
+	// so that the table that the snapshot is made from is the first one
+	o_tableIndex = static_cast<uint32_t>( m_tables.size() );
+	m_tables.emplace_back();
+	io_copiedTables.indices.emplace( luaTable, o_tableIndex );
+	io_copiedTables.areCopied.push_back( false );
+
+	// The values are read before any of them are added
+	// because the nested tables add their own values while this table's are being read
+	// (lua_rawlen() and lua_rawgeti() are used because a snapshot doesn't copy metatables)
+	const auto arrayLength = static_cast<lua_Integer>( lua_rawlen( &io_luaState, i_index ) );
+	std::vector<sValue> arrayValues( static_cast<size_t>( arrayLength ) );
+	for ( lua_Integer i = 1; i <= arrayLength; ++i )
+	{
+		lua_rawgeti( &io_luaState, i_index, i );
+		result = AddValue( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, io_copiedTables, arrayValues[static_cast<size_t>( i - 1 )] );
+		lua_pop( &io_luaState, 1 );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	std::vector<sSlot> fields;
+	lua_pushnil( &io_luaState );
+	while ( lua_next( &io_luaState, i_index ) )
+	{
+		// The key is at -2 and the value is at -1
+		const auto keyType = lua_type( &io_luaState, -2 );
+		if ( keyType == LUA_TSTRING )
+		{
+			size_t keyLength;
+			const auto* const key = lua_tolstring( &io_luaState, -2, &keyLength );
+			fields.emplace_back();
+			auto& field = fields.back();
+			field.hash = Hash( key, keyLength );
+			field.keyOffset = AddString( key, keyLength );
+			field.keyLength = static_cast<uint32_t>( keyLength );
+			result = AddValue( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, io_copiedTables, field.value );
+		}
+		else if ( ( keyType == LUA_TNUMBER ) && lua_isinteger( &io_luaState, -2 ) )
+		{
+			// Array keys were already copied
+			const auto key = lua_tointeger( &io_luaState, -2 );
+			if ( ( key < 1 ) || ( key > arrayLength ) )
+			{
+				result = Results::InvalidFile;
+				std::cerr << "The integer key " << key << " isn't part of the table's array"
+					" (which has " << arrayLength << " values)" << std::endl;
+			}
+		}
+		else
+		{
+			result = Results::InvalidFile;
+			std::cerr << "Snapshot table keys can't be a " << luaL_typename( &io_luaState, -2 ) << std::endl;
+		}
+		if ( !result )
+		{
+			// Pop the key and the value
+			lua_pop( &io_luaState, 2 );
+			return result;
+		}
+		// Pop the value, but leave the key for lua_next()
+		lua_pop( &io_luaState, 1 );
+	}
+
+	auto& table = m_tables[o_tableIndex];
+	// Add the array part
+	table.firstArrayValue = static_cast<uint32_t>( m_arrayValues.size() );
+	table.arrayLength = static_cast<uint32_t>( arrayLength );
+	m_arrayValues.insert( m_arrayValues.end(), arrayValues.begin(), arrayValues.end() );
+	// Add the hash part
+	// (at most 3/4 of the slots are used so that a probe sequence is short and always ends at an empty slot)
+	if ( !fields.empty() )
+	{
+		uint32_t slotCount = 1;
+		while ( ( slotCount - ( slotCount / 4 ) ) <= fields.size() )
+		{
+			slotCount *= 2;
+		}
+		table.firstSlot = static_cast<uint32_t>( m_slots.size() );
+		table.slotCount = slotCount;
+		m_slots.resize( m_slots.size() + slotCount );
+		const auto mask = slotCount - 1;
+		for ( const auto& field : fields )
+		{
+			auto i = field.hash & mask;
+			while ( m_slots[table.firstSlot + i].value.type != sValue::eType::Nil )
+			{
+				i = ( i + 1 ) & mask;
+			}
+			m_slots[table.firstSlot + i] = field;
+		}
+	}
+	io_copiedTables.areCopied[o_tableIndex] = true;
+
+	return result;
+}
+
+eae6320::cResult eae6320::cTableSnapshot::AddValue( lua_State& io_luaState, const int i_index, const unsigned int i_depth,
+	sCopiedTables& io_copiedTables, sValue& o_value )
+{
+	switch ( lua_type( &io_luaState, i_index ) )
+	{
+	case LUA_TNIL:
+		// (This can only be a hole in the array part)
+		o_value.type = sValue::eType::Nil;
+		break;
+	case LUA_TBOOLEAN:
+		o_value.type = sValue::eType::Boolean;
+		o_value.boolean = lua_toboolean( &io_luaState, i_index ) != 0;
+		break;
+	case LUA_TNUMBER:
+		if ( lua_isinteger( &io_luaState, i_index ) )
+		{
+			o_value.type = sValue::eType::Integer;
+			o_value.integer = static_cast<int64_t>( lua_tointeger( &io_luaState, i_index ) );
+		}
+		else
+		{
+			o_value.type = sValue::eType::Float;
+			o_value.number = static_cast<double>( lua_tonumber( &io_luaState, i_index ) );
+		}
+		break;
+	case LUA_TSTRING:
+		{
+			o_value.type = sValue::eType::String;
+			size_t length;
+			const auto* const value = lua_tolstring( &io_luaState, i_index, &length );
+			o_value.string.offset = AddString( value, length );
+			o_value.string.length = static_cast<uint32_t>( length );
+		}
+		break;
+	case LUA_TTABLE:
+		{
+			uint32_t tableIndex;
+			const auto result = AddTable( io_luaState, i_index, i_depth, io_copiedTables, tableIndex );
+			if ( !result )
+			{
+				return result;
+			}
+			o_value.type = sValue::eType::Table;
+			o_value.table = tableIndex;
+		}
+		break;
+	default:
+		std::cerr << "Snapshot values can't be a " << luaL_typename( &io_luaState, i_index ) << std::endl;
+		return Results::InvalidFile;
+	}
+	return Results::Success;
+}
+
+uint32_t eae6320::cTableSnapshot::AddString( const char* const i_string, const size_t i_length )
+{
+	EAE6320_ASSERTF( ( m_strings.size() + i_length ) <= std::numeric_limits<uint32_t>::max(),
+		"A snapshot's strings must fit in 4 GB" );
+	const auto offset = static_cast<uint32_t>( m_strings.size() );
+	m_strings.append( i_string, i_length );
+	return offset;
+}
+
+// Proxies
+//--------
+
+void eae6320::cTableSnapshot::PushTableProxy( lua_State& io_luaState, const int i_proxiesIndex,
+	const std::shared_ptr<const cTableSnapshot>& i_snapshot, const uint32_t i_tableIndex )
+{
+	const auto* const table = &i_snapshot->m_tables[i_tableIndex];
+	if ( lua_rawgetp( &io_luaState, i_proxiesIndex, table ) != LUA_TNIL )
+	{
+		return;
+	}
+	lua_pop( &io_luaState, 1 );
+	new ( lua_newuserdata( &io_luaState, sizeof( sProxy ) ) ) sProxy{ i_snapshot, table };
+	// The metatable is set right away so that the proxy is destroyed even if there is an error later
+	luaL_setmetatable( &io_luaState, s_metatableName );
+	lua_pushvalue( &io_luaState, -1 );
+	lua_rawsetp( &io_luaState, i_proxiesIndex, table );
+}
+
+void eae6320::cTableSnapshot::PushValue( lua_State& io_luaState, const sProxy& i_proxy, const sValue& i_value )
+{
+	switch ( i_value.type )
+	{
+	case sValue::eType::Nil:
+		lua_pushnil( &io_luaState );
+		break;
+	case sValue::eType::Boolean:
+		lua_pushboolean( &io_luaState, i_value.boolean ? 1 : 0 );
+		break;
+	case sValue::eType::Integer:
+		lua_pushinteger( &io_luaState, static_cast<lua_Integer>( i_value.integer ) );
+		break;
+	case sValue::eType::Float:
+		lua_pushnumber( &io_luaState, static_cast<lua_Number>( i_value.number ) );
+		break;
+	case sValue::eType::String:
+		lua_pushlstring( &io_luaState, &i_proxy.snapshot->m_strings[i_value.string.offset], i_value.string.length );
+		break;
+	case sValue::eType::Table:
+		// This is only called by metamethods, whose first upvalue is the state's proxies
+		PushTableProxy( io_luaState, lua_upvalueindex( 1 ), i_proxy.snapshot, i_value.table );
+		break;
+	}
+}
+
+const eae6320::cTableSnapshot::sSlot* eae6320::cTableSnapshot::FindSlot( const sTable& i_table, const char* const i_key, const size_t i_keyLength ) const
+{
+	if ( i_table.slotCount == 0 )
+	{
+		return nullptr;
+	}
+	const auto hash = Hash( i_key, i_keyLength );
+	const auto mask = i_table.slotCount - 1;
+	for ( auto i = hash & mask; ; i = ( i + 1 ) & mask )
+	{
+		const auto& slot = m_slots[i_table.firstSlot + i];
+		if ( slot.value.type == sValue::eType::Nil )
+		{
+			return nullptr;
+		}
+		if ( ( slot.hash == hash ) && ( slot.keyLength == i_keyLength )
+			&& ( std::memcmp( &m_strings[slot.keyOffset], i_key, i_keyLength ) == 0 ) )
+		{
+			return &slot;
+		}
+	}
+}
+
+const eae6320::cTableSnapshot::sValue* eae6320::cTableSnapshot::Find( const sTable& i_table, const int64_t i_key ) const
+{
+	return ( ( i_key >= 1 ) && ( static_cast<uint64_t>( i_key ) <= i_table.arrayLength ) )
+		? &m_arrayValues[i_table.firstArrayValue + static_cast<size_t>( i_key - 1 )] : nullptr;
+}
+
+uint32_t eae6320::cTableSnapshot::Hash( const char* const i_key, const size_t i_keyLength )
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for ( size_t i = 0; i < i_keyLength; ++i )
+	{
+		hash = ( hash ^ static_cast<uint8_t>( i_key[i] ) ) * 16777619u;
+	}
+	return hash;
+}
+
+// Metamethods
+//------------
+
+int eae6320::cTableSnapshot::Index( lua_State* io_luaState )
+{
+	// The metatable is protected and so Lua code can't call a metamethod directly,
+	// which means that the first argument can only be a proxy
+	const auto& proxy = *static_cast<const sProxy*>( lua_touserdata( io_luaState, 1 ) );
+	const sValue* value = nullptr;
+	switch ( lua_type( io_luaState, 2 ) )
+	{
+	case LUA_TSTRING:
+		{
+			size_t keyLength;
+			const auto* const key = lua_tolstring( io_luaState, 2, &keyLength );
+			const auto* const slot = proxy.snapshot->FindSlot( *proxy.table, key, keyLength );
+			value = slot ? &slot->value : nullptr;
+		}
+		break;
+	case LUA_TNUMBER:
+		{
+			// A float with an integer value (e.g. 2.0) is the same key as the integer
+			int isInteger;
+			const auto key = lua_tointegerx( io_luaState, 2, &isInteger );
+			value = isInteger ? proxy.snapshot->Find( *proxy.table, static_cast<int64_t>( key ) ) : nullptr;
+		}
+		break;
+	}
+	if ( value )
+	{
+		PushValue( *io_luaState, proxy, *value );
+	}
+	else
+	{
+		lua_pushnil( io_luaState );
+	}
+
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTableSnapshot::NewIndex( lua_State* io_luaState )
+{
+	return luaL_error( io_luaState, "a table snapshot can't be changed" );
+}
+
+int eae6320::cTableSnapshot::Length( lua_State* io_luaState )
+{
+	const auto& proxy = *static_cast<const sProxy*>( lua_touserdata( io_luaState, 1 ) );
+	lua_pushinteger( io_luaState, static_cast<lua_Integer>( proxy.table->arrayLength ) );
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTableSnapshot::Pairs( lua_State* io_luaState )
+{
+	// Return Next(), the proxy, and nil (like pairs() does for a table)
+	lua_pushvalue( io_luaState, lua_upvalueindex( 1 ) );
+	lua_pushvalue( io_luaState, 1 );
+	lua_pushnil( io_luaState );
+	constexpr int returnValueCount = 3;
+	return returnValueCount;
+}
+
+int eae6320::cTableSnapshot::Next( lua_State* io_luaState )
+{
+	// Unlike the metamethods, this is returned to Lua code by pairs()
+	// and so it can be called with anything
+	const auto& proxy = *static_cast<const sProxy*>( luaL_checkudata( io_luaState, 1, s_metatableName ) );
+	const auto& snapshot = *proxy.snapshot;
+	const auto& table = *proxy.table;
+	// The array values come first (in order) and then the slots of the hash part
+	uint32_t position = 0;
+	lua_settop( io_luaState, 2 );
+	switch ( lua_type( io_luaState, 2 ) )
+	{
+	case LUA_TNIL:
+		break;
+	case LUA_TNUMBER:
+		{
+			int isInteger;
+			const auto key = lua_tointegerx( io_luaState, 2, &isInteger );
+			if ( !isInteger || !snapshot.Find( table, static_cast<int64_t>( key ) ) )
+			{
+				return luaL_error( io_luaState, "invalid key to 'next'" );
+			}
+			position = static_cast<uint32_t>( key );
+		}
+		break;
+	case LUA_TSTRING:
+		{
+			size_t keyLength;
+			const auto* const key = lua_tolstring( io_luaState, 2, &keyLength );
+			const auto* const slot = snapshot.FindSlot( table, key, keyLength );
+			if ( !slot )
+			{
+				return luaL_error( io_luaState, "invalid key to 'next'" );
+			}
+			position = table.arrayLength + static_cast<uint32_t>( slot - &snapshot.m_slots[table.firstSlot] ) + 1;
+		}
+		break;
+	default:
+		return luaL_error( io_luaState, "invalid key to 'next'" );
+	}
+
+	// Holes in the array are skipped like the empty slots
+	for ( ; position < table.arrayLength; ++position )
+	{
+		const auto& value = snapshot.m_arrayValues[table.firstArrayValue + position];
+		if ( value.type != sValue::eType::Nil )
+		{
+			lua_pushinteger( io_luaState, static_cast<lua_Integer>( position + 1 ) );
+			PushValue( *io_luaState, proxy, value );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+	for ( auto i = position - table.arrayLength; i < table.slotCount; ++i )
+	{
+		const auto& slot = snapshot.m_slots[table.firstSlot + i];
+		if ( slot.value.type != sValue::eType::Nil )
+		{
+			lua_pushlstring( io_luaState, &snapshot.m_strings[slot.keyOffset], slot.keyLength );
+			PushValue( *io_luaState, proxy, slot.value );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+	lua_pushnil( io_luaState );
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTableSnapshot::ToString( lua_State* io_luaState )
+{
+	const auto& proxy = *static_cast<const sProxy*>( lua_touserdata( io_luaState, 1 ) );
+	lua_pushfstring( io_luaState, "tablesnapshot: %p", static_cast<const void*>( proxy.table ) );
+	constexpr int returnValueCount = 1;
+	return returnValueCount;
+}
+
+int eae6320::cTableSnapshot::CollectGarbage( lua_State* io_luaState )
+{
+	static_cast<sProxy*>( lua_touserdata( io_luaState, 1 ) )->~sProxy();
+	constexpr int returnValueCount = 0;
+	return returnValueCount;
+}
@@ -0,0 +1,190 @@
+/*
+	A table snapshot is an immutable copy of a Lua table that is stored outside of every Lua state
+	(e.g. a large config table of constants, lookup tables, and shader parameter dictionaries)
+	so that many states can read a single copy instead of each state loading and holding its own
+
+	A snapshot is made from a table in one state and can then be pushed into any number of states as a read-only proxy:
+		eae6320::cTableSnapshot::PushProxy( *luaState, snapshot );
+		lua_setglobal( luaState, "config" );
+	which Lua reads like the original table:
+		local brightness = config.parameters.g_brightness
+		for i, path in ipairs( config.textures ) do ... end
+		for key, value in pairs( config.parameters ) do ... end
+	but which can't be changed (assigning to any key is an error).
+
+	A snapshot is never changed after it is made and every proxy keeps it alive with a std::shared_ptr
+	(whose reference count is atomic),
+	and so states on different threads can read the same snapshot at the same time without any locks.
+
+	Like an sAssetValue, a table can only have string keys and array keys (1, 2, ..., n).
+	A table that is referenced from more than one place is only copied once
+	(and so its proxies are the same userdata, like the original table would be),
+	but a table can't contain itself.
+	Every table is stored as an array part and an open-addressing hash part whose slots keep the hashes of their keys,
+	and so a lookup by __index hashes the key once and usually only compares a single key.
+	Each state keeps the proxies of nested tables in a weak table
+	so that e.g. config.parameters returns the same userdata every time (without allocating a new one).
+*/
+
+#ifndef EAE6320_TABLES_CTABLESNAPSHOT_H
+#define EAE6320_TABLES_CTABLESNAPSHOT_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	class cTableSnapshot
+	{
+		// Interface
+		//==========
+
+	public:
+
+		// Proxies
+		//--------
+
+		// Pushes a read-only proxy of the snapshot's table
+		// (the snapshot can be pushed into any number of states, which can be on different threads)
+		static void PushProxy( lua_State& io_luaState, const std::shared_ptr<const cTableSnapshot>& i_snapshot );
+
+		// Access
+		//-------
+
+		size_t GetTableCount() const { return m_tables.size(); }
+		// How many bytes the snapshot uses (which every state that reads it shares)
+		size_t GetSize() const;
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// Copies the table at the given index (which is left unchanged).
+		// Functions, userdata, and threads aren't allowed anywhere in the table.
+		static cResult Create( lua_State& io_luaState, const int i_index, std::shared_ptr<const cTableSnapshot>& o_snapshot );
+
+		cTableSnapshot( const cTableSnapshot& ) = delete;
+		cTableSnapshot& operator =( const cTableSnapshot& ) = delete;
+
+		// Data
+		//=====
+
+	private:
+
+		struct sValue
+		{
+			enum class eType : uint8_t
+			{
+				// Only an empty slot of a hash part is nil
+				Nil,
+				Boolean,
+				Integer,
+				Float,
+				String,
+				Table,
+			};
+			eType type = eType::Nil;
+
+			union
+			{
+				bool boolean;
+				int64_t integer;
+				double number;
+				// A string is stored in m_strings
+				struct
+				{
+					uint32_t offset;
+					uint32_t length;
+				} string;
+				// An index into m_tables
+				uint32_t table;
+			};
+		};
+		struct sSlot
+		{
+			uint32_t hash = 0;
+			// The key is stored in m_strings
+			uint32_t keyOffset = 0;
+			uint32_t keyLength = 0;
+			sValue value;
+		};
+		struct sTable
+		{
+			// The values with keys 1, 2, ..., n are in m_arrayValues
+			uint32_t firstArrayValue = 0;
+			uint32_t arrayLength = 0;
+			// The hash part is in m_slots,
+			// and its size is either 0 or a power of 2
+			uint32_t firstSlot = 0;
+			uint32_t slotCount = 0;
+		};
+
+		// The first table is the one that the snapshot was made from
+		std::vector<sTable> m_tables;
+		std::vector<sValue> m_arrayValues;
+		std::vector<sSlot> m_slots;
+		std::string m_strings;
+
+		// Implementation
+		//===============
+
+	private:
+
+		cTableSnapshot() = default;
+
+		// Copying
+		//--------
+
+		struct sCopiedTables;
+
+		cResult AddTable( lua_State& io_luaState, const int i_index, const unsigned int i_depth, sCopiedTables& io_copiedTables,
+			uint32_t& o_tableIndex );
+		cResult AddValue( lua_State& io_luaState, const int i_index, const unsigned int i_depth, sCopiedTables& io_copiedTables,
+			sValue& o_value );
+		uint32_t AddString( const char* const i_string, const size_t i_length );
+
+		// Proxies
+		//--------
+
+		struct sProxy;
+
+		// A state's proxies are kept in a weak table (at the given index) so that each table only has one
+		static void PushTableProxy( lua_State& io_luaState, const int i_proxiesIndex,
+			const std::shared_ptr<const cTableSnapshot>& i_snapshot, const uint32_t i_tableIndex );
+		static void PushValue( lua_State& io_luaState, const sProxy& i_proxy, const sValue& i_value );
+		// These return NULL if the key isn't in the table
+		const sSlot* FindSlot( const sTable& i_table, const char* const i_key, const size_t i_keyLength ) const;
+		const sValue* Find( const sTable& i_table, const int64_t i_key ) const;
+
+		static uint32_t Hash( const char* const i_key, const size_t i_keyLength );
+
+		// Metamethods
+		static int Index( lua_State* io_luaState );
+		static int NewIndex( lua_State* io_luaState );
+		static int Length( lua_State* io_luaState );
+		static int Pairs( lua_State* io_luaState );
+		static int Next( lua_State* io_luaState );
+		static int ToString( lua_State* io_luaState );
+		static int CollectGarbage( lua_State* io_luaState );
+	};
+}
+
+#endif	// EAE6320_TABLES_CTABLESNAPSHOT_H
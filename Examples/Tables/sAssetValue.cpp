@@ -0,0 +1,172 @@
+// Include Files
+//==============
+
+#include "sAssetValue.h"
+
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Tables that contain themselves (directly or indirectly) would recurse forever,
+	// and so nesting is limited to a depth that no reasonable asset would reach
+	constexpr unsigned int s_maxTableDepth = 64;
+
+	eae6320::cResult LoadFromLua( lua_State& io_luaState, const int i_index, const unsigned int i_depth, eae6320::sAssetValue& o_value );
+	eae6320::cResult LoadTableFromLua( lua_State& io_luaState, const int i_index, const unsigned int i_depth, eae6320::sAssetValue& o_value );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+const eae6320::sAssetValue* eae6320::sAssetValue::Find( const char* const i_key ) const
+{
+	if ( type == eType::Table )
+	{
+		for ( const auto& keyValuePair : dictionary )
+		{
+			if ( keyValuePair.first == i_key )
+			{
+				return &keyValuePair.second;
+			}
+		}
+	}
+	return nullptr;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::sAssetValue::LoadFromLua( lua_State& io_luaState, const int i_index, sAssetValue& o_value )
+{
+	return ::LoadFromLua( io_luaState, lua_absindex( &io_luaState, i_index ), 0, o_value );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult LoadFromLua( lua_State& io_luaState, const int i_index, const unsigned int i_depth, eae6320::sAssetValue& o_value )
+	{
+		using eType = eae6320::sAssetValue::eType;
+
+		o_value = eae6320::sAssetValue();
+		switch ( lua_type( &io_luaState, i_index ) )
+		{
+		case LUA_TNIL:
+			o_value.type = eType::Nil;
+			break;
+		case LUA_TBOOLEAN:
+			o_value.type = eType::Boolean;
+			o_value.boolean = lua_toboolean( &io_luaState, i_index ) != 0;
+			break;
+		case LUA_TNUMBER:
+			o_value.type = eType::Number;
+			o_value.number = static_cast<double>( lua_tonumber( &io_luaState, i_index ) );
+			break;
+		case LUA_TSTRING:
+			{
+				o_value.type = eType::String;
+				size_t length;
+				const auto* const value = lua_tolstring( &io_luaState, i_index, &length );
+				o_value.string.assign( value, length );
+			}
+			break;
+		case LUA_TTABLE:
+			return LoadTableFromLua( io_luaState, i_index, i_depth, o_value );
+		default:
+			std::cerr << "Asset values can't be a " << luaL_typename( &io_luaState, i_index ) << std::endl;
+			return eae6320::Results::InvalidFile;
+		}
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult LoadTableFromLua( lua_State& io_luaState, const int i_index, const unsigned int i_depth, eae6320::sAssetValue& o_value )
+	{
+		auto result = eae6320::Results::Success;
+
+		if ( i_depth >= s_maxTableDepth )
+		{
+			result = eae6320::Results::InvalidFile;
+			std::cerr << "Asset tables can't be nested more than " << s_maxTableDepth << " levels deep" << std::endl;
+			return result;
+		}
+		// Every level of nesting needs a few stack slots (a key, a value, and the nested table's key and value)
+		if ( !lua_checkstack( &io_luaState, 4 ) )
+		{
+			result = eae6320::Results::OutOfMemory;
+			std::cerr << "The Lua stack couldn't grow to read a nested asset table" << std::endl;
+			return result;
+		}
+
+		o_value.type = eae6320::sAssetValue::eType::Table;
+
+		// Copy the array part
+		// (lua_rawlen() and lua_rawgeti() are used because asset tables shouldn't have metatables)
+		const auto arrayLength = static_cast<lua_Integer>( lua_rawlen( &io_luaState, i_index ) );
+		o_value.array.resize( static_cast<size_t>( arrayLength ) );
+		for ( lua_Integer i = 1; i <= arrayLength; ++i )
+		{
+			lua_rawgeti( &io_luaState, i_index, i );
+			result = LoadFromLua( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, o_value.array[static_cast<size_t>( i - 1 )] );
+			lua_pop( &io_luaState, 1 );
+			if ( !result )
+			{
+				return result;
+			}
+		}
+
+		// Copy the dictionary part
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, i_index ) )
+		{
+			// The key is at -2 and the value is at -1
+			const auto keyType = lua_type( &io_luaState, -2 );
+			if ( keyType == LUA_TSTRING )
+			{
+				size_t keyLength;
+				const auto* const key = lua_tolstring( &io_luaState, -2, &keyLength );
+				o_value.dictionary.emplace_back( std::string( key, keyLength ), eae6320::sAssetValue() );
+				result = LoadFromLua( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, o_value.dictionary.back().second );
+				if ( !result )
+				{
+					// Pop the key and the value
+					lua_pop( &io_luaState, 2 );
+					return result;
+				}
+			}
+			else if ( ( keyType == LUA_TNUMBER ) && lua_isinteger( &io_luaState, -2 ) )
+			{
+				// Array keys were already copied
+				const auto key = lua_tointeger( &io_luaState, -2 );
+				if ( ( key < 1 ) || ( key > arrayLength ) )
+				{
+					result = eae6320::Results::InvalidFile;
+					std::cerr << "The integer key " << key << " isn't part of the asset table's array"
+						" (which has " << arrayLength << " values)" << std::endl;
+					lua_pop( &io_luaState, 2 );
+					return result;
+				}
+			}
+			else
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << "Asset table keys can't be a " << luaL_typename( &io_luaState, -2 ) << std::endl;
+				lua_pop( &io_luaState, 2 );
+				return result;
+			}
+			// Pop the value, but leave the key for lua_next()
+			lua_pop( &io_luaState, 1 );
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,77 @@
+/*
+	An asset value is a plain C++ copy of a value from a Lua asset table
+	so that the asset can be used after its Lua state has been closed
+	(or, when loading in parallel, given back to another thread)
+
+	Asset tables in our class use strings as keys for dictionaries
+	and consecutive integers starting at 1 as keys for arrays,
+	and so a table is stored as an array part and a dictionary part.
+*/
+
+#ifndef EAE6320_TABLES_SASSETVALUE_H
+#define EAE6320_TABLES_SASSETVALUE_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	struct sAssetValue
+	{
+		// Data
+		//=====
+
+		enum class eType : uint8_t
+		{
+			Nil,
+			Boolean,
+			Number,
+			String,
+			Table,
+		};
+		eType type = eType::Nil;
+
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		// A table's values with keys 1, 2, ..., n
+		std::vector<sAssetValue> array;
+		// A table's values with string keys
+		// (in the order that lua_next() returned them, which is _not_ deterministic)
+		std::vector<std::pair<std::string, sAssetValue>> dictionary;
+
+		// Access
+		//-------
+
+		// Returns NULL if the value isn't a table or if the key doesn't exist
+		const sAssetValue* Find( const char* const i_key ) const;
+
+		// Initialization / Clean Up
+		//--------------------------
+
+		// Copies the value at the given index of the stack (which is left unchanged).
+		// A table can only have string keys and array keys,
+		// and functions, userdata, and threads aren't allowed anywhere.
+		static cResult LoadFromLua( lua_State& io_luaState, const int i_index, sAssetValue& o_value );
+	};
+}
+
+#endif	// EAE6320_TABLES_SASSETVALUE_H
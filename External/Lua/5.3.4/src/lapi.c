@@ -1078,7 +1078,8 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
         luaC_checkGC(L);
       }
       g->gcrunning = oldrunning;  /* restore previous state */
-      if (debt > 0 && g->gcstate == GCSpause)  /* end of cycle? */
+      /* end of cycle? (in generational mode every step is a whole cycle) */
+      if (debt > 0 && (g->gcstate == GCSpause || isgenerational(g)))
         res = 1;  /* signal it */
       break;
     }
@@ -1093,10 +1094,37 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
       g->gcstepmul = data;
       break;
     }
+    case LUA_GCSETMAJORINC: {
+      res = g->genmajormul;
+      g->genmajormul = data;
+      break;
+    }
     case LUA_GCISRUNNING: {
       res = g->gcrunning;
       break;
     }
+    case LUA_GCGEN: {  /* change collector to generational mode */
+      res = isgenerational(g) ? LUA_GCGEN : LUA_GCINC;
+      if (data != 0)
+        g->genminormul = data;
+      luaC_changemode(L, KGC_GEN);
+      break;
+    }
+    case LUA_GCINC: {  /* change collector to incremental mode */
+      res = isgenerational(g) ? LUA_GCGEN : LUA_GCINC;
+      luaC_changemode(L, KGC_NORMAL);
+      break;
+    }
+    case LUA_GCSTEPTIME: {  /* step for at most 'data' microseconds */
+      /* returns the percentage of the cycle left (0 if it finished) */
+      res = luaC_steptime(L, cast(lua_Integer, data) * 1000);
+      break;
+    }
+    case LUA_GCSTATS: {  /* turn the telemetry on or off */
+      res = (g->gcstats != NULL);
+      luaC_enablestats(L, data);
+      break;
+    }
     default: res = -1;  /* invalid option */
   }
   lua_unlock(L);
@@ -1104,6 +1132,28 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
 }
 
 
+/*
+** Gets the statistics of the cycle in progress ('n' == 0) or of the
+** 'n'th most recent finished cycle. Returns 0 if the telemetry is off
+** or if there is no such cycle.
+*/
+LUA_API int lua_getgcstats (lua_State *L, int n, lua_GCCycleStats *stats) {
+  int res = 0;
+  GCStats *s;
+  lua_lock(L);
+  s = G(L)->gcstats;
+  if (s != NULL && 0 <= n && n < LUA_GCSTATSCYCLES) {
+    int i = (s->current - n + LUA_GCSTATSCYCLES) % LUA_GCSTATSCYCLES;
+    if (s->cycles[i].cycle > 0) {  /* was the entry used? */
+      *stats = s->cycles[i];
+      res = 1;
+    }
+  }
+  lua_unlock(L);
+  return res;
+}
+
+
 
 /*
 ** miscellaneous functions
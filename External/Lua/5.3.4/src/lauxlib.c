@@ -642,6 +642,147 @@ LUALIB_API void luaL_unref (lua_State *L, int t, int ref) {
 ** =======================================================
 */
 
+/*
+** {------------------------------------------------------
+** Memory-mapped files: 'l_mapfile' maps a whole regular file into
+** memory (read only) and returns its address, or returns NULL if the
+** file cannot be mapped (e.g., a pipe, a device, or a file smaller
+** than LUA_MAPFILEMIN), in which case the file is read with 'fread'
+** instead. 'l_unmapfile' releases a mapping.
+** Mapping is off unless LUA_USE_MAPFILE is defined, because it has a
+** hazard that 'fread' does not: if another process truncates the file
+** while it is being loaded, reading the part of the mapping past the
+** new end of the file raises SIGBUS (or an in-page exception on
+** Windows) and ends the program, where 'fread' would just see EOF.
+** Only define it when the files that are loaded are not changed while
+** the program runs (e.g., shipped assets).
+** -------------------------------------------------------
+*/
+#if !defined(l_mapfile)	/* { */
+
+/* smaller files gain nothing from a mapping and are read with 'fread' */
+#if !defined(LUA_MAPFILEMIN)
+#define LUA_MAPFILEMIN	(64 * 1024)
+#endif
+
+#if defined(LUA_USE_POSIX) && defined(LUA_USE_MAPFILE)	/* { */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char *l_mapfile (const char *filename, size_t *size) {
+  struct stat st;
+  void *p = NULL;
+  int fd = open(filename, O_RDONLY);
+  if (fd == -1) return NULL;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) &&
+      st.st_size >= LUA_MAPFILEMIN && st.st_size > 0 &&
+      (unsigned long long)st.st_size <= (unsigned long long)(~(size_t)0)) {
+    *size = (size_t)st.st_size;
+    p = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) p = NULL;
+    else  /* the chunk is read once, from start to end */
+      (void)posix_madvise(p, *size, POSIX_MADV_SEQUENTIAL);
+  }
+  close(fd);  /* a mapping stays valid after its file is closed */
+  return (const char *)p;
+}
+
+#define l_unmapfile(p,size)	((void)munmap((void *)(p), size))
+
+#elif defined(LUA_USE_WINDOWS) && defined(LUA_USE_MAPFILE)	/* }{ */
+
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+static const char *l_mapfile (const char *filename, size_t *size) {
+  LARGE_INTEGER fsize;
+  HANDLE m;
+  void *p = NULL;
+  HANDLE f = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                         OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (f == INVALID_HANDLE_VALUE) return NULL;
+  if (GetFileType(f) == FILE_TYPE_DISK && GetFileSizeEx(f, &fsize) &&
+      fsize.QuadPart >= LUA_MAPFILEMIN && fsize.QuadPart > 0 &&
+      (ULONGLONG)fsize.QuadPart <= (ULONGLONG)(~(size_t)0)) {
+    m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m != NULL) {
+      *size = (size_t)fsize.QuadPart;
+      p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(m);  /* the view keeps the mapping alive */
+    }
+  }
+  CloseHandle(f);
+  return (const char *)p;
+}
+
+#define l_unmapfile(p,size)	((void)(size), (void)UnmapViewOfFile(p))
+
+#else				/* }{ */
+
+/* ISO C definitions */
+#define l_mapfile(filename,size)	((void)(filename), (void)(size), \
+	                                 (const char *)NULL)
+#define l_unmapfile(p,size)	((void)(p), (void)(size))
+
+#endif				/* } */
+
+#endif				/* } */
+/* }------------------------------------------------------ */
+
+
+typedef struct LoadM {
+  const char *s;  /* first (or only) block of the chunk */
+  size_t size;
+} LoadM;
+
+
+static const char *getM (lua_State *L, void *ud, size_t *size) {
+  LoadM *lm = (LoadM *)ud;
+  (void)L;  /* not used */
+  if (lm->size == 0) return NULL;
+  *size = lm->size;  /* the whole file goes to the scanner as one block */
+  lm->size = 0;
+  return lm->s;
+}
+
+
+/*
+** Loads a mapped file. Like 'skipcomment', it skips an optional BOM
+** mark and a first line starting with '#'; the newline that ends that
+** line is kept so that line numbers stay correct. (Text and binary
+** chunks need no distinction because the mapping holds the raw bytes.)
+*/
+static int loadmapped (lua_State *L, const char *p, size_t size,
+                       const char *chunkname, const char *mode) {
+  LoadM lm;
+  if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) {  /* UTF-8 BOM? */
+    p += 3;
+    size -= 3;
+  }
+  if (size > 0 && *p == '#') {  /* first line is a comment? */
+    const char *eol = (const char *)memchr(p, '\n', size);
+    if (eol != NULL) {
+      /* keep the end of line, unless a binary chunk follows it */
+      if (eol + 1 < p + size && eol[1] == LUA_SIGNATURE[0]) eol++;
+      size -= (size_t)(eol - p);
+      p = eol;
+    }
+    else {  /* the whole file is a comment */
+      p = "\n";
+      size = 1;
+    }
+  }
+  lm.s = p;
+  lm.size = size;
+  return lua_load(L, getM, &lm, chunkname, mode);
+}
+
+
 typedef struct LoadF {
   int n;  /* number of pre-read characters */
   FILE *f;  /* file being read */
@@ -721,7 +862,16 @@ LUALIB_API int luaL_loadfilex (lua_State *L, const char *filename,
     lf.f = stdin;
   }
   else {
+    size_t size;
+    const char *p;
     lua_pushfstring(L, "@%s", filename);
+    p = l_mapfile(filename, &size);
+    if (p != NULL) {  /* regular file? load it without copying */
+      status = loadmapped(L, p, size, lua_tostring(L, -1), mode);
+      l_unmapfile(p, size);
+      lua_remove(L, fnameindex);
+      return status;
+    }
     lf.f = fopen(filename, "r");
     if (lf.f == NULL) return errfile(L, "open", fnameindex);
   }
@@ -1033,13 +1183,382 @@ static int panic (lua_State *L) {
 }
 
 
+/*
+** {======================================================
+** Allocation profiler: when Lua is built with LUA_ALLOCPROFILE,
+** 'luaL_newstate' wraps 'l_alloc' with an allocator that takes a sample
+** every time LUAI_ALLOCPROFINTERVAL more bytes have been allocated. A
+** sample attributes the allocated block to a call site (the innermost
+** Lua function and line running, plus the C function that it called,
+** if any) and counts it as the bytes allocated since the last sample,
+** so the per-site numbers are estimates of all allocations. The live
+** and peak bytes of each site are tracked until its sampled blocks are
+** freed. 'luaL_allocreport' writes a report sorted by live bytes; if the
+** environment variable LUA_ALLOCREPORT names a file ("-" for stderr),
+** a report with the peaks of each site is written when the state is
+** closed.
+**
+** The allocator only knows the main thread, so an allocation made by a
+** coroutine is attributed to the call that resumed the coroutine.
+** =======================================================
+*/
+#if defined(LUA_ALLOCPROFILE)	/* { */
+
+#if !defined(LUAI_ALLOCPROFINTERVAL)
+#define LUAI_ALLOCPROFINTERVAL	4096
+#endif
+
+/* number of buckets in the hash table of call sites */
+#define NSITEBUCKETS	1024
+
+/* maximum number of stack levels searched for a Lua function */
+#define MAXSITELEVELS	32
+
+
+typedef struct AllocSite {
+  struct AllocSite *next;  /* next site in the same bucket */
+  size_t live;  /* estimated bytes still allocated */
+  size_t peak;  /* largest value of 'live' */
+  size_t allocated;  /* estimated bytes allocated in total */
+  size_t samples;  /* number of sampled allocations */
+  char name[1];  /* (allocated with the size of the name) */
+} AllocSite;
+
+
+/* a sampled block that is still allocated */
+typedef struct AllocBlock {
+  void *ptr;  /* NULL for an empty slot */
+  AllocSite *site;
+  size_t weight;  /* bytes that the block represents */
+} AllocBlock;
+
+
+typedef struct AllocProfile {
+  lua_State *L;  /* main thread (NULL while the state is being created) */
+  size_t untilsample;  /* bytes to allocate before the next sample */
+  size_t live, peak;  /* totals of all sites */
+  AllocSite *sites[NSITEBUCKETS];
+  AllocBlock *blocks;  /* hash table of sampled blocks */
+  size_t nblocks, sizeblocks;
+} AllocProfile;
+
+
+static size_t sampleweight (size_t size) {
+  return (size >= LUAI_ALLOCPROFINTERVAL) ? size : LUAI_ALLOCPROFINTERVAL;
+}
+
+
+static size_t ptrhash (AllocProfile *p, void *ptr) {
+  return ((size_t)ptr >> 4) & (p->sizeblocks - 1);
+}
+
+
+static AllocBlock *findblock (AllocProfile *p, void *ptr) {
+  size_t i;
+  if (p->nblocks == 0) return NULL;
+  for (i = ptrhash(p, ptr); p->blocks[i].ptr != NULL;
+       i = (i + 1) & (p->sizeblocks - 1)) {
+    if (p->blocks[i].ptr == ptr) return &p->blocks[i];
+  }
+  return NULL;
+}
+
+
+/* inserts a block (returns 0 if there is no memory for the table) */
+static int addblock (AllocProfile *p, void *ptr, AllocSite *site,
+                                      size_t weight) {
+  size_t i;
+  if (2 * (p->nblocks + 1) > p->sizeblocks) {  /* grow the table? */
+    size_t oldsize = p->sizeblocks;
+    AllocBlock *old = p->blocks;
+    size_t newsize = (oldsize == 0) ? 64 : 2 * oldsize;
+    AllocBlock *blocks = (AllocBlock *)calloc(newsize, sizeof(AllocBlock));
+    if (blocks == NULL) return 0;
+    p->blocks = blocks;
+    p->sizeblocks = newsize;
+    p->nblocks = 0;
+    for (i = 0; i < oldsize; i++) {  /* reinsert the old blocks */
+      if (old[i].ptr != NULL)
+        addblock(p, old[i].ptr, old[i].site, old[i].weight);
+    }
+    free(old);
+  }
+  for (i = ptrhash(p, ptr); p->blocks[i].ptr != NULL;
+       i = (i + 1) & (p->sizeblocks - 1)) { /* empty */ }
+  p->blocks[i].ptr = ptr;
+  p->blocks[i].site = site;
+  p->blocks[i].weight = weight;
+  p->nblocks++;
+  return 1;
+}
+
+
+/* removes a block, moving back the blocks after it in its cluster */
+static void removeblock (AllocProfile *p, AllocBlock *b) {
+  size_t mask = p->sizeblocks - 1;
+  size_t i = (size_t)(b - p->blocks);
+  size_t j = i;
+  for (;;) {
+    size_t home;
+    p->blocks[i].ptr = NULL;
+    do {
+      j = (j + 1) & mask;
+      if (p->blocks[j].ptr == NULL) {
+        p->nblocks--;
+        return;
+      }
+      home = ptrhash(p, p->blocks[j].ptr);
+      /* can the block at 'j' stay (is 'home' cyclically in (i, j])? */
+    } while ((i <= j) ? (i < home && home <= j) : (i < home || home <= j));
+    p->blocks[i] = p->blocks[j];
+    i = j;
+  }
+}
+
+
+static void addlive (AllocProfile *p, AllocSite *site, size_t weight) {
+  site->live += weight;
+  if (site->live > site->peak) site->peak = site->live;
+  p->live += weight;
+  if (p->live > p->peak) p->peak = p->live;
+}
+
+
+static void sublive (AllocProfile *p, AllocSite *site, size_t weight) {
+  site->live -= weight;
+  p->live -= weight;
+}
+
+
+static AllocSite *getsite (AllocProfile *p, const char *name) {
+  size_t h = 0;
+  const char *c;
+  AllocSite *site;
+  for (c = name; *c != '\0'; c++)
+    h = h * 31 + (unsigned char)*c;
+  h %= NSITEBUCKETS;
+  for (site = p->sites[h]; site != NULL; site = site->next) {
+    if (strcmp(site->name, name) == 0) return site;
+  }
+  site = (AllocSite *)malloc(sizeof(AllocSite) + strlen(name));
+  if (site == NULL) return NULL;
+  site->live = site->peak = site->allocated = site->samples = 0;
+  strcpy(site->name, name);
+  site->next = p->sites[h];
+  p->sites[h] = site;
+  return site;
+}
+
+
+/*
+** Finds the call site of the allocation being made. This runs before
+** the block is (re)allocated: if it is the stack itself, the stack must
+** still be valid. (Options "Sln" of 'lua_getinfo' do not allocate.)
+*/
+static AllocSite *findsite (AllocProfile *p) {
+  char name[LUA_IDSIZE + 64];
+  const char *cname = NULL;
+  lua_Debug ar;
+  int level;
+  strcpy(name, "(no Lua function)");
+  for (level = 0; p->L != NULL && level < MAXSITELEVELS &&
+                  lua_getstack(p->L, level, &ar); level++) {
+    lua_getinfo(p->L, "Sln", &ar);
+    if (*ar.what == 'C') {  /* C function? */
+      if (cname == NULL)
+        cname = (ar.name != NULL) ? ar.name : "?";
+    }
+    else {  /* innermost Lua function */
+      char line[32];
+      l_sprintf(line, sizeof(line), ":%d", ar.currentline);
+      strcpy(name, ar.short_src);
+      strcat(name, line);
+      if (cname != NULL) {
+        strcat(name, " (");
+        strncat(name, cname, 40);
+        strcat(name, " [C])");
+      }
+      break;
+    }
+  }
+  return getsite(p, name);
+}
+
+
+static void freeprofile (AllocProfile *p) {
+  int i;
+  for (i = 0; i < NSITEBUCKETS; i++) {
+    AllocSite *site = p->sites[i];
+    while (site != NULL) {
+      AllocSite *next = site->next;
+      free(site);
+      site = next;
+    }
+  }
+  free(p->blocks);
+  free(p);
+}
+
+
+static int comparesites (const void *a, const void *b) {
+  const AllocSite *s1 = *(const AllocSite *const *)a;
+  const AllocSite *s2 = *(const AllocSite *const *)b;
+  if (s1->live != s2->live) return (s1->live < s2->live) ? 1 : -1;
+  if (s1->peak != s2->peak) return (s1->peak < s2->peak) ? 1 : -1;
+  return strcmp(s1->name, s2->name);
+}
+
+
+static int writereport (AllocProfile *p, FILE *f) {
+  size_t n = 0, i;
+  AllocSite **sorted;
+  AllocSite *site;
+  int b;
+  for (b = 0; b < NSITEBUCKETS; b++)
+    for (site = p->sites[b]; site != NULL; site = site->next) n++;
+  sorted = (AllocSite **)malloc((n > 0 ? n : 1) * sizeof(AllocSite *));
+  if (sorted == NULL) return 0;
+  n = 0;
+  for (b = 0; b < NSITEBUCKETS; b++)
+    for (site = p->sites[b]; site != NULL; site = site->next)
+      sorted[n++] = site;
+  qsort(sorted, n, sizeof(AllocSite *), comparesites);
+  fprintf(f, "Lua allocation profile (a sample every %lu bytes)\n",
+             (unsigned long)LUAI_ALLOCPROFINTERVAL);
+  fprintf(f, "live: %lu KB, peak: %lu KB\n", (unsigned long)(p->live / 1024),
+             (unsigned long)(p->peak / 1024));
+  fprintf(f, "%10s %10s %14s %8s  %s\n", "live (KB)", "peak (KB)",
+             "allocated (KB)", "samples", "site");
+  for (i = 0; i < n; i++) {
+    site = sorted[i];
+    fprintf(f, "%10lu %10lu %14lu %8lu  %s\n",
+               (unsigned long)(site->live / 1024),
+               (unsigned long)(site->peak / 1024),
+               (unsigned long)(site->allocated / 1024),
+               (unsigned long)site->samples, site->name);
+  }
+  free(sorted);
+  return !ferror(f);
+}
+
+
+/* writes the report requested by LUA_ALLOCREPORT when a state closes */
+static void reportatclose (AllocProfile *p) {
+  const char *filename = getenv("LUA_ALLOCREPORT");
+  if (filename == NULL) return;
+  if (strcmp(filename, "-") == 0)
+    writereport(p, stderr);
+  else {
+    FILE *f = fopen(filename, "w");
+    if (f == NULL) return;
+    writereport(p, f);
+    fclose(f);
+  }
+}
+
+
+static void *l_profalloc (void *ud, void *ptr, size_t osize, size_t nsize) {
+  AllocProfile *p = (AllocProfile *)ud;
+  size_t oldsize = (ptr == NULL) ? 0 : osize;  /* (else 'osize' is a tag) */
+  AllocBlock *b = (ptr == NULL) ? NULL : findblock(p, ptr);
+  AllocSite *site = NULL;
+  void *newptr;
+  if (nsize > oldsize && b == NULL) {  /* allocating unsampled memory? */
+    size_t size = nsize - oldsize;
+    if (size < p->untilsample)
+      p->untilsample -= size;
+    else {  /* sample this allocation */
+      p->untilsample = LUAI_ALLOCPROFINTERVAL;
+      site = findsite(p);
+    }
+  }
+  else if (nsize == 0 && p->L != NULL && ptr == lua_getextraspace(p->L)) {
+    /* the state is freeing its main block, so it is being closed */
+    l_alloc(NULL, ptr, osize, 0);
+    reportatclose(p);
+    freeprofile(p);
+    return NULL;
+  }
+  newptr = l_alloc(NULL, ptr, osize, nsize);
+  if (newptr == NULL && nsize > 0)  /* allocation failed? */
+    return NULL;  /* (the block did not change) */
+  if (b != NULL) {  /* freeing or reallocating a sampled block? */
+    AllocSite *bsite = b->site;
+    size_t oldweight = b->weight;
+    sublive(p, bsite, oldweight);
+    removeblock(p, b);
+    if (nsize > 0) {  /* block keeps its site */
+      size_t weight = sampleweight(nsize);
+      if (weight > oldweight)
+        bsite->allocated += weight - oldweight;
+      if (addblock(p, newptr, bsite, weight))
+        addlive(p, bsite, weight);
+    }
+  }
+  else if (site != NULL) {
+    size_t weight = sampleweight(nsize);
+    if (addblock(p, newptr, site, weight)) {
+      site->allocated += weight;
+      site->samples++;
+      addlive(p, site, weight);
+    }
+  }
+  return newptr;
+}
+
+
+LUALIB_API int luaL_allocreport (lua_State *L, FILE *f) {
+  void *ud;
+  if (lua_getallocf(L, &ud) != l_profalloc) return 0;  /* not profiled */
+  return writereport((AllocProfile *)ud, f);
+}
+
+
+static lua_State *newstate (void) {
+  lua_State *L;
+  AllocProfile *p = (AllocProfile *)calloc(1, sizeof(AllocProfile));
+  if (p == NULL) return NULL;
+  p->untilsample = LUAI_ALLOCPROFINTERVAL;
+  L = lua_newstate(l_profalloc, p);
+  if (L == NULL) freeprofile(p);
+  else p->L = L;
+  return L;
+}
+
+#else				/* }{ */
+
+LUALIB_API int luaL_allocreport (lua_State *L, FILE *f) {
+  (void)L; (void)f;
+  return 0;  /* allocation profiler is not built */
+}
+
+#define newstate()	lua_newstate(l_alloc, NULL)
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  lua_State *L = newstate();
   if (L) lua_atpanic(L, &panic);
   return L;
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+/*
+** Same as 'luaL_newstate', but the state shares the strings of a pool
+** (and isn't profiled by the allocation profiler)
+*/
+LUALIB_API lua_State *luaL_newstatewithpool (lua_StringPool *pool) {
+  lua_State *L = lua_newstatewithpool(l_alloc, NULL, pool);
+  if (L) lua_atpanic(L, &panic);
+  return L;
+}
+#endif
+
+
 LUALIB_API void luaL_checkversion_ (lua_State *L, lua_Number ver, size_t sz) {
   const lua_Number *v = lua_version(L);
   if (sz != LUAL_NUMSIZES)  /* check numeric types */
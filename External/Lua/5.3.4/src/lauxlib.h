@@ -90,6 +90,10 @@ LUALIB_API int (luaL_loadbufferx) (lua_State *L, const char *buff, size_t sz,
 LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s);
 
 LUALIB_API lua_State *(luaL_newstate) (void);
+#if defined(LUA_USE_SHAREDSTRINGS)
+LUALIB_API lua_State *(luaL_newstatewithpool) (lua_StringPool *pool);
+#endif
+LUALIB_API int (luaL_allocreport) (lua_State *L, FILE *f);
 
 LUALIB_API lua_Integer (luaL_len) (lua_State *L, int idx);
 
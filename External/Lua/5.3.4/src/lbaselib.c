@@ -170,26 +170,122 @@ static int luaB_rawset (lua_State *L) {
 }
 
 
+/*
+** {======================================================
+** GC telemetry
+** =======================================================
+*/
+
+/* pseudo-option for 'collectgarbage("stats")' */
+#define GCSTATSLIST	(-1)
+
+/* names of the collector states, in the order of 'lgc.h' */
+static const char *const gcstatenames[LUA_NUMGCSTATES] = {"propagate",
+  "atomic", "sweepallgc", "sweepfinobj", "sweeptobefnz", "sweepend",
+  "callfin", "pause"};
+
+
+/* times are given to Lua in seconds, like 'os.clock' */
+static void setgctime (lua_State *L, const char *k, lua_Integer ns) {
+  lua_pushnumber(L, (lua_Number)ns / 1e9);
+  lua_setfield(L, -2, k);
+}
+
+
+static void setgccount (lua_State *L, const char *k, lua_Integer n) {
+  lua_pushinteger(L, n);
+  lua_setfield(L, -2, k);
+}
+
+
+static void pushgccycle (lua_State *L, const lua_GCCycleStats *c) {
+  int i;
+  lua_createtable(L, 0, 7);
+  setgccount(L, "cycle", c->cycle);
+  setgccount(L, "memory", c->memory);
+  setgccount(L, "pauses", c->pauses);
+  setgctime(L, "pausetime", c->pausetime);
+  setgctime(L, "maxpause", c->maxpause);
+  lua_createtable(L, LUA_GCSTATSBUCKETS, 0);
+  for (i = 0; i < LUA_GCSTATSBUCKETS; i++) {
+    lua_pushinteger(L, c->histogram[i]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  lua_setfield(L, -2, "histogram");
+  lua_createtable(L, 0, LUA_NUMGCSTATES);
+  for (i = 0; i < LUA_NUMGCSTATES; i++) {
+    const lua_GCStateStats *st = &c->states[i];
+    lua_createtable(L, 0, 7);
+    setgccount(L, "steps", st->steps);
+    setgctime(L, "time", st->time);
+    setgctime(L, "maxtime", st->maxtime);
+    setgccount(L, "traversed", st->traversed);
+    setgccount(L, "swept", st->swept);
+    setgccount(L, "freed", st->freed);
+    setgccount(L, "finalized", st->finalized);
+    lua_setfield(L, -2, gcstatenames[i]);
+  }
+  lua_setfield(L, -2, "states");
+}
+
+
+/*
+** Returns a list with the statistics of the finished cycles that are
+** still recorded, the most recent first (or nil if the telemetry is off)
+*/
+static int pushgcstats (lua_State *L) {
+  lua_GCCycleStats c;
+  int n;
+  if (!lua_getgcstats(L, 0, &c)) {  /* telemetry is off? */
+    lua_pushnil(L);
+    return 1;
+  }
+  lua_newtable(L);
+  for (n = 1; lua_getgcstats(L, n, &c); n++) {
+    pushgccycle(L, &c);
+    lua_rawseti(L, -2, n);
+  }
+  return 1;
+}
+
+/* }====================================================== */
+
+
 static int luaB_collectgarbage (lua_State *L) {
   static const char *const opts[] = {"stop", "restart", "collect",
-    "count", "step", "setpause", "setstepmul",
-    "isrunning", NULL};
+    "count", "step", "setpause", "setstepmul", "setmajorinc",
+    "isrunning", "generational", "incremental", "setstats", "stats",
+    "steptime", NULL};
   static const int optsnum[] = {LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT,
     LUA_GCCOUNT, LUA_GCSTEP, LUA_GCSETPAUSE, LUA_GCSETSTEPMUL,
-    LUA_GCISRUNNING};
+    LUA_GCSETMAJORINC, LUA_GCISRUNNING, LUA_GCGEN, LUA_GCINC, LUA_GCSTATS,
+    GCSTATSLIST, LUA_GCSTEPTIME};
   int o = optsnum[luaL_checkoption(L, 1, "collect", opts)];
-  int ex = (int)luaL_optinteger(L, 2, 0);
-  int res = lua_gc(L, o, ex);
+  int ex;
+  int res;
+  if (o == GCSTATSLIST)
+    return pushgcstats(L);
+  if (o == LUA_GCSTATS && lua_isboolean(L, 2))  /* on/off as a boolean? */
+    ex = lua_toboolean(L, 2);
+  else if (o == LUA_GCSTATS)
+    ex = (int)luaL_optinteger(L, 2, 1);  /* (default is on) */
+  else
+    ex = (int)luaL_optinteger(L, 2, 0);
+  res = lua_gc(L, o, ex);
   switch (o) {
     case LUA_GCCOUNT: {
       int b = lua_gc(L, LUA_GCCOUNTB, 0);
       lua_pushnumber(L, (lua_Number)res + ((lua_Number)b/1024));
       return 1;
     }
-    case LUA_GCSTEP: case LUA_GCISRUNNING: {
+    case LUA_GCSTEP: case LUA_GCISRUNNING: case LUA_GCSTATS: {
       lua_pushboolean(L, res);
       return 1;
     }
+    case LUA_GCGEN: case LUA_GCINC: {  /* return the previous mode */
+      lua_pushstring(L, (res == LUA_GCGEN) ? "generational" : "incremental");
+      return 1;
+    }
     default: {
       lua_pushinteger(L, res);
       return 1;
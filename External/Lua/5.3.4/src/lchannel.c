@@ -0,0 +1,800 @@
+/*
+** $Id: lchannel.c $
+** Channels for sending values between states
+** See Copyright Notice in lua.h
+*/
+
+#define lchannel_c
+#define LUA_LIB
+
+#include "lprefix.h"
+
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lua.h"
+
+#include "lauxlib.h"
+#include "lualib.h"
+
+
+/*
+** A channel is a bounded queue of messages that lives outside of every
+** state, so that states running on different threads can send values
+** to each other:
+**   local channel = require "channel"
+**   local jobs = channel.open("jobs")  -- same queue in every state
+**   jobs:send{ path = "level1.lua", priority = 2 }
+**   local job = jobs:receive()
+** A message is a copy of a nil, boolean, number, string, or table
+** (whose keys and values are also copied, without their metatables);
+** it is serialized into a compact buffer by 'send' and rebuilt by
+** 'receive' in the receiving state.
+**
+** The queue is the bounded multi-producer multi-consumer queue of
+** Dmitry Vyukov: every cell has a sequence number that tells whether it
+** is ready for a send or a receive of a given position, so a send or a
+** receive only needs one compare-and-swap (of its position) and no lock.
+** Short messages are copied into the cell itself; longer ones are
+** allocated with 'malloc' (no state allocator can be used, because the
+** message is freed by another state).
+**
+** When a channel is full (for 'send') or empty (for 'receive'), a
+** coroutine yields the channel to whoever resumed it, so that a
+** scheduler can run other coroutines and resume it later (when it tries
+** again); a thread that cannot yield (e.g. the main one) waits instead,
+** giving up its time slice between attempts.
+**
+** Channels are found by name in a process-wide list (the only lock is
+** the one that protects that list). A channel, and any message still in
+** it, is freed when no state has it open.
+*/
+
+
+/* default number of messages that a channel can hold */
+#if !defined(LUAI_CHANNELSIZE)
+#define LUAI_CHANNELSIZE	1024
+#endif
+
+/* messages up to this size are stored in the queue itself */
+#if !defined(LUAI_CHANNELINLINE)
+#define LUAI_CHANNELINLINE	40
+#endif
+
+/* maximum nesting of tables in a message */
+#if !defined(LUAI_CHANNELDEPTH)
+#define LUAI_CHANNELDEPTH	64
+#endif
+
+/* attempts that a waiting thread makes before giving up its time slice */
+#if !defined(LUAI_CHANNELSPINS)
+#define LUAI_CHANNELSPINS	16
+#endif
+
+
+#define MAXCHANNELSIZE	(1 << 20)
+
+/* (so that the positions of sends and receives are in different lines) */
+#define CACHELINE	64
+
+
+#define CHANNELHANDLE	"CHANNEL*"
+
+
+/*
+** {======================================================
+** Atomic operations: 'l_load' has acquire semantics, 'l_store' has
+** release semantics, and 'l_cas' (compare and swap) is a full barrier
+** =======================================================
+*/
+
+#if defined(_MSC_VER) && !defined(__GNUC__)	/* { */
+
+#include <intrin.h>
+
+/* (with the default /volatile:ms, volatile accesses are acquire/release) */
+#define l_load(p)	(*(p))
+#define l_store(p,v)	(*(p) = (v))
+#define l_cas(p,o,n)	(_InterlockedCompareExchange((p), (n), (o)) == (o))
+
+#else				/* }{ */
+
+#define l_load(p)	__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define l_store(p,v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define l_cas(p,o,n)	__sync_bool_compare_and_swap((p), (o), (n))
+
+#endif				/* } */
+
+
+#if defined(LUA_USE_POSIX)	/* { */
+
+#include <sched.h>
+#define l_yieldthread()	sched_yield()
+
+#elif defined(LUA_USE_WINDOWS)	/* }{ */
+
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define l_yieldthread()	SwitchToThread()
+
+#else				/* }{ */
+
+/* ISO C: no way to give up the time slice */
+#define l_yieldthread()	((void)0)
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
+/*
+** Positions wrap around, so they are compared by their difference
+** (computed as unsigned, where overflow is defined)
+*/
+typedef long l_seq;
+
+#define seqadd(s,n)	((l_seq)((unsigned long)(s) + (unsigned long)(n)))
+#define seqdiff(a,b)	((long)((unsigned long)(a) - (unsigned long)(b)))
+
+
+typedef struct Cell {
+  volatile l_seq seq;  /* position of the next send or receive of the cell */
+  size_t size;  /* size of the message */
+  char *data;  /* message, if it is not in 'buff' */
+  char buff[LUAI_CHANNELINLINE];
+} Cell;
+
+
+typedef struct Channel {
+  volatile l_seq sendpos;  /* position of the next send */
+  char pad1[CACHELINE - sizeof(l_seq)];
+  volatile l_seq receivepos;  /* position of the next receive */
+  char pad2[CACHELINE - sizeof(l_seq)];
+  /* the fields below are protected by 'listlock' */
+  struct Channel *next;  /* in the list of open channels */
+  int nopen;  /* number of handles (in every state) */
+  size_t mask;  /* number of cells - 1 (a power of 2 - 1) */
+  const char *name;  /* (after the cells) */
+  Cell cells[1];
+} Channel;
+
+
+/*
+** Per-state buffer where messages are serialized, shared by the
+** functions of the library as their upvalue (so that an error while
+** serializing does not leak memory). Serializing never runs a
+** finalizer, and so it cannot be reentered.
+*/
+typedef struct Scratch {
+  char *buff;
+  size_t size;
+} Scratch;
+
+
+/* list of open channels */
+static Channel *channels = NULL;
+static volatile long listlock = 0;
+
+
+static void lockchannels (void) {
+  while (!l_cas(&listlock, 0, 1))
+    l_yieldthread();
+}
+
+
+static void unlockchannels (void) {
+  l_store(&listlock, 0);
+}
+
+
+/*
+** {======================================================
+** Queue
+** =======================================================
+*/
+
+/* returns 0 if the channel is full */
+static int enqueue (Channel *ch, const char *msg, size_t size, char *data) {
+  l_seq pos = l_load(&ch->sendpos);
+  Cell *cell;
+  for (;;) {
+    long dif;
+    cell = &ch->cells[(size_t)pos & ch->mask];
+    dif = seqdiff(l_load(&cell->seq), pos);
+    if (dif == 0) {  /* cell is free for this position? */
+      if (l_cas(&ch->sendpos, pos, seqadd(pos, 1)))
+        break;  /* claimed it */
+      pos = l_load(&ch->sendpos);  /* another send claimed it */
+    }
+    else if (dif < 0)  /* cell still has the message of the previous lap */
+      return 0;
+    else  /* another send got further */
+      pos = l_load(&ch->sendpos);
+  }
+  cell->size = size;
+  cell->data = data;
+  if (data == NULL)
+    memcpy(cell->buff, msg, size);
+  l_store(&cell->seq, seqadd(pos, 1));  /* publish it */
+  return 1;
+}
+
+
+/*
+** Claims the cell of the next message, or returns NULL if the channel
+** is empty. The cell must be released after the message is copied.
+*/
+static Cell *dequeue (Channel *ch, l_seq *pos) {
+  l_seq p = l_load(&ch->receivepos);
+  for (;;) {
+    Cell *cell = &ch->cells[(size_t)p & ch->mask];
+    long dif = seqdiff(l_load(&cell->seq), seqadd(p, 1));
+    if (dif == 0) {  /* cell has the message for this position? */
+      if (l_cas(&ch->receivepos, p, seqadd(p, 1))) {
+        *pos = p;
+        return cell;
+      }
+      p = l_load(&ch->receivepos);
+    }
+    else if (dif < 0)  /* message not sent yet */
+      return NULL;
+    else
+      p = l_load(&ch->receivepos);
+  }
+}
+
+
+static void release (Channel *ch, Cell *cell, l_seq pos) {
+  /* ready for the send of the next lap */
+  l_store(&cell->seq, seqadd(pos, ch->mask + 1));
+}
+
+
+static Channel *newchannel (const char *name, size_t len, size_t size) {
+  size_t cellsize = offsetof(Channel, cells) + size * sizeof(Cell);
+  Channel *ch = (Channel *)malloc(cellsize + len + 1);
+  size_t i;
+  if (ch == NULL) return NULL;
+  ch->sendpos = ch->receivepos = 0;
+  ch->next = NULL;
+  ch->nopen = 1;
+  ch->mask = size - 1;
+  ch->name = (char *)ch + cellsize;
+  memcpy((char *)ch->name, name, len + 1);
+  for (i = 0; i < size; i++) {
+    ch->cells[i].seq = (l_seq)i;
+    ch->cells[i].data = NULL;
+  }
+  return ch;
+}
+
+
+static void freechannel (Channel *ch) {
+  l_seq pos;
+  for (pos = ch->receivepos; seqdiff(ch->sendpos, pos) > 0;
+       pos = seqadd(pos, 1))
+    free(ch->cells[(size_t)pos & ch->mask].data);  /* unreceived messages */
+  free(ch);
+}
+
+/* }====================================================== */
+
+
+/*
+** {======================================================
+** Messages: a value is a tag byte followed by
+**   M_INT: the integer (zigzag encoded) as a varint
+**   M_FLOAT: the bytes of the lua_Number
+**   M_STRING: the length as a varint and the bytes
+**   M_TABLE: the array length and the number of other fields as
+**     varints, the array values, and then each other key and value
+** =======================================================
+*/
+
+enum { M_NIL, M_FALSE, M_TRUE, M_INT, M_FLOAT, M_STRING, M_TABLE };
+
+
+typedef struct Encoder {
+  lua_State *L;
+  Scratch *s;
+  size_t n;  /* bytes written */
+} Encoder;
+
+
+static char *reserve (Encoder *e, size_t size) {
+  Scratch *s = e->s;
+  if (s->size - e->n < size) {
+    size_t newsize = (s->size < 256) ? 256 : s->size * 2;
+    char *newbuff;
+    while (newsize - e->n < size) newsize *= 2;
+    newbuff = (char *)realloc(s->buff, newsize);
+    if (newbuff == NULL)
+      luaL_error(e->L, "not enough memory");
+    s->buff = newbuff;
+    s->size = newsize;
+  }
+  return s->buff + e->n;
+}
+
+
+static void addbytes (Encoder *e, const void *b, size_t size) {
+  memcpy(reserve(e, size), b, size);
+  e->n += size;
+}
+
+
+static void addtag (Encoder *e, int tag) {
+  *reserve(e, 1) = (char)tag;
+  e->n++;
+}
+
+
+static void addvarint (Encoder *e, lua_Unsigned x) {
+  char *p = reserve(e, (sizeof(x) * 8 + 6) / 7);
+  size_t n = 0;
+  while (x >= 0x80) {
+    p[n++] = (char)((x & 0x7f) | 0x80);
+    x >>= 7;
+  }
+  p[n++] = (char)x;
+  e->n += n;
+}
+
+
+static int isarraykey (lua_State *L, int idx, lua_Integer narray) {
+  if (lua_isinteger(L, idx)) {
+    lua_Integer k = lua_tointeger(L, idx);
+    return (1 <= k && k <= narray);
+  }
+  return 0;
+}
+
+
+static void encode (Encoder *e, int idx, int depth);
+
+
+static void encodetable (Encoder *e, int idx, int depth) {
+  lua_State *L = e->L;
+  lua_Integer narray = (lua_Integer)lua_rawlen(L, idx);
+  lua_Unsigned nhash = 0;
+  lua_Integer i;
+  if (depth >= LUAI_CHANNELDEPTH)
+    luaL_error(L, "table too deep (or cyclic) to send");
+  luaL_checkstack(L, 3, "table too deep to send");
+  lua_pushnil(L);
+  while (lua_next(L, idx)) {
+    if (!isarraykey(L, -2, narray)) nhash++;
+    lua_pop(L, 1);
+  }
+  addtag(e, M_TABLE);
+  addvarint(e, (lua_Unsigned)narray);
+  addvarint(e, nhash);
+  for (i = 1; i <= narray; i++) {
+    lua_rawgeti(L, idx, i);
+    encode(e, lua_gettop(L), depth + 1);
+    lua_pop(L, 1);
+  }
+  lua_pushnil(L);
+  while (lua_next(L, idx)) {
+    int top = lua_gettop(L);
+    if (!isarraykey(L, top - 1, narray)) {
+      encode(e, top - 1, depth + 1);  /* key */
+      encode(e, top, depth + 1);  /* value */
+    }
+    lua_pop(L, 1);
+  }
+}
+
+
+static void encode (Encoder *e, int idx, int depth) {
+  lua_State *L = e->L;
+  switch (lua_type(L, idx)) {
+    case LUA_TNIL:
+      addtag(e, M_NIL);
+      break;
+    case LUA_TBOOLEAN:
+      addtag(e, lua_toboolean(L, idx) ? M_TRUE : M_FALSE);
+      break;
+    case LUA_TNUMBER:
+      if (lua_isinteger(L, idx)) {
+        lua_Integer i = lua_tointeger(L, idx);
+        lua_Unsigned u = (lua_Unsigned)i << 1;
+        addtag(e, M_INT);
+        addvarint(e, (i < 0) ? ~u : u);  /* (small negatives stay short) */
+      }
+      else {
+        lua_Number n = lua_tonumber(L, idx);
+        addtag(e, M_FLOAT);
+        addbytes(e, &n, sizeof(n));
+      }
+      break;
+    case LUA_TSTRING: {
+      size_t len;
+      const char *s = lua_tolstring(L, idx, &len);
+      addtag(e, M_STRING);
+      addvarint(e, (lua_Unsigned)len);
+      addbytes(e, s, len);
+      break;
+    }
+    case LUA_TTABLE:
+      encodetable(e, idx, depth);
+      break;
+    default:
+      luaL_error(L, "cannot send a %s", luaL_typename(L, idx));
+  }
+}
+
+
+static lua_Unsigned getvarint (const char **p) {
+  lua_Unsigned x = 0;
+  int shift = 0;
+  unsigned char c;
+  do {
+    c = (unsigned char)*(*p)++;
+    x |= (lua_Unsigned)(c & 0x7f) << shift;
+    shift += 7;
+  } while (c & 0x80);
+  return x;
+}
+
+
+static int tablesize (lua_Unsigned n) {
+  return (n < (lua_Unsigned)INT_MAX) ? (int)n : INT_MAX;
+}
+
+
+/* pushes the value that starts at '*p' */
+static void decode (lua_State *L, const char **p) {
+  switch (*(*p)++) {
+    case M_NIL: lua_pushnil(L); break;
+    case M_FALSE: lua_pushboolean(L, 0); break;
+    case M_TRUE: lua_pushboolean(L, 1); break;
+    case M_INT: {
+      lua_Unsigned u = getvarint(p);
+      lua_pushinteger(L, (lua_Integer)((u & 1) ? ~(u >> 1) : (u >> 1)));
+      break;
+    }
+    case M_FLOAT: {
+      lua_Number n;
+      memcpy(&n, *p, sizeof(n));
+      *p += sizeof(n);
+      lua_pushnumber(L, n);
+      break;
+    }
+    case M_STRING: {
+      size_t len = (size_t)getvarint(p);
+      lua_pushlstring(L, *p, len);
+      *p += len;
+      break;
+    }
+    case M_TABLE: {
+      lua_Unsigned narray = getvarint(p);
+      lua_Unsigned nhash = getvarint(p);
+      lua_Unsigned i;
+      luaL_checkstack(L, 3, "message too deep");
+      lua_createtable(L, tablesize(narray), tablesize(nhash));
+      for (i = 1; i <= narray; i++) {
+        decode(L, p);
+        lua_rawseti(L, -2, (lua_Integer)i);
+      }
+      for (i = 0; i < nhash; i++) {
+        decode(L, p);  /* key */
+        decode(L, p);  /* value */
+        lua_rawset(L, -3);
+      }
+      break;
+    }
+    default: lua_assert(0);
+  }
+}
+
+/* }====================================================== */
+
+
+#define toscratch(L)	((Scratch *)lua_touserdata(L, lua_upvalueindex(1)))
+
+
+static Channel *tochannel (lua_State *L) {
+  Channel **box = (Channel **)luaL_checkudata(L, 1, CHANNELHANDLE);
+  if (*box == NULL)
+    luaL_error(L, "attempt to use a closed channel");
+  return *box;
+}
+
+
+static void waitturn (int *attempts) {
+  if (++*attempts > LUAI_CHANNELSPINS)
+    l_yieldthread();
+}
+
+
+/*
+** Serializes the value at index 2, and returns the message to give to
+** 'enqueue' (NULL if it fits in a cell; the message is then in the
+** scratch buffer)
+*/
+static char *newmessage (lua_State *L, size_t *size) {
+  Encoder e;
+  char *data = NULL;
+  e.L = L;
+  e.s = toscratch(L);
+  e.n = 0;
+  encode(&e, 2, 0);
+  if (e.n > LUAI_CHANNELINLINE) {
+    data = (char *)malloc(e.n);
+    if (data == NULL)
+      luaL_error(L, "not enough memory");
+    memcpy(data, e.s->buff, e.n);
+  }
+  *size = e.n;
+  return data;
+}
+
+
+/* rebuilds the long message given as a light userdata */
+static int decodelong (lua_State *L) {
+  const char *p = (const char *)lua_touserdata(L, 1);
+  decode(L, &p);
+  return 1;
+}
+
+
+/*
+** Pushes the next message and returns 1, or returns 0 if there is none.
+** Rebuilding a message allocates, and so it can run a finalizer that
+** receives from a channel itself; each call therefore keeps its message
+** to itself (a short one on the C stack, and a long one in a local that
+** a protected call makes sure is freed, even if rebuilding fails).
+*/
+static int pushmessage (lua_State *L, Channel *ch) {
+  char msg[LUAI_CHANNELINLINE];
+  const char *p;
+  char *data;
+  l_seq pos;
+  Cell *cell;
+  luaL_checkstack(L, 2, NULL);  /* (before a message is taken) */
+  cell = dequeue(ch, &pos);
+  if (cell == NULL) return 0;
+  data = cell->data;
+  if (data == NULL) {  /* copy it before the cell is reused */
+    memcpy(msg, cell->buff, cell->size);
+    p = msg;
+  }
+  release(ch, cell, pos);
+  if (data == NULL)
+    decode(L, &p);
+  else {
+    int status;
+    lua_pushcfunction(L, decodelong);
+    lua_pushlightuserdata(L, data);
+    status = lua_pcall(L, 1, 1, 0);
+    free(data);
+    if (status != LUA_OK)
+      lua_error(L);  /* propagate the error */
+  }
+  return 1;
+}
+
+
+static int ch_send (lua_State *L);
+static int ch_receive (lua_State *L);
+
+
+static int sendk (lua_State *L, int status, lua_KContext ctx) {
+  (void)status; (void)ctx;
+  lua_settop(L, 2);  /* remove the values given to 'resume' */
+  return ch_send(L);
+}
+
+
+static int ch_send (lua_State *L) {
+  Channel *ch = tochannel(L);
+  size_t size;
+  char *data;
+  int attempts = 0;
+  luaL_checkany(L, 2);
+  lua_settop(L, 2);
+  data = newmessage(L, &size);
+  while (!enqueue(ch, toscratch(L)->buff, size, data)) {
+    if (lua_isyieldable(L)) {  /* let something else run? */
+      free(data);  /* (it is serialized again when resumed) */
+      lua_pushvalue(L, 1);
+      return lua_yieldk(L, 1, 0, sendk);
+    }
+    waitturn(&attempts);
+  }
+  return 0;
+}
+
+
+static int ch_trysend (lua_State *L) {
+  Channel *ch = tochannel(L);
+  size_t size;
+  char *data;
+  int sent;
+  luaL_checkany(L, 2);
+  lua_settop(L, 2);
+  data = newmessage(L, &size);
+  sent = enqueue(ch, toscratch(L)->buff, size, data);
+  if (!sent) free(data);
+  lua_pushboolean(L, sent);
+  return 1;
+}
+
+
+static int receivek (lua_State *L, int status, lua_KContext ctx) {
+  (void)status; (void)ctx;
+  lua_settop(L, 1);  /* remove the values given to 'resume' */
+  return ch_receive(L);
+}
+
+
+static int ch_receive (lua_State *L) {
+  Channel *ch = tochannel(L);
+  int attempts = 0;
+  while (!pushmessage(L, ch)) {
+    if (lua_isyieldable(L)) {
+      lua_pushvalue(L, 1);
+      return lua_yieldk(L, 1, 0, receivek);
+    }
+    waitturn(&attempts);
+  }
+  return 1;
+}
+
+
+static int ch_tryreceive (lua_State *L) {
+  Channel *ch = tochannel(L);
+  lua_pushboolean(L, 1);
+  if (pushmessage(L, ch))
+    return 2;
+  lua_pushboolean(L, 0);
+  return 1;
+}
+
+
+/* number of messages in the channel (which other threads may change) */
+static int ch_len (lua_State *L) {
+  Channel *ch = tochannel(L);
+  long n = seqdiff(l_load(&ch->sendpos), l_load(&ch->receivepos));
+  if (n < 0) n = 0;
+  else if ((size_t)n > ch->mask + 1) n = (long)(ch->mask + 1);
+  lua_pushinteger(L, n);
+  return 1;
+}
+
+
+static int ch_capacity (lua_State *L) {
+  Channel *ch = tochannel(L);
+  lua_pushinteger(L, (lua_Integer)(ch->mask + 1));
+  return 1;
+}
+
+
+static int ch_close (lua_State *L) {
+  Channel **box = (Channel **)luaL_checkudata(L, 1, CHANNELHANDLE);
+  Channel *ch = *box;
+  if (ch != NULL) {
+    *box = NULL;
+    lockchannels();
+    if (--ch->nopen == 0) {  /* last handle? */
+      Channel **prev = &channels;
+      while (*prev != ch) prev = &(*prev)->next;
+      *prev = ch->next;
+    }
+    else ch = NULL;
+    unlockchannels();
+    if (ch != NULL) freechannel(ch);
+  }
+  return 0;
+}
+
+
+static int ch_tostring (lua_State *L) {
+  Channel **box = (Channel **)luaL_checkudata(L, 1, CHANNELHANDLE);
+  if (*box == NULL)
+    lua_pushliteral(L, "channel (closed)");
+  else
+    lua_pushfstring(L, "channel (%s)", (*box)->name);
+  return 1;
+}
+
+
+/*
+** channel.open(name [, capacity]) returns a handle to the channel with
+** the given name, which is created (with room for 'capacity' messages,
+** rounded up to a power of 2) if no state has it open
+*/
+static int ch_open (lua_State *L) {
+  size_t len;
+  const char *name = luaL_checklstring(L, 1, &len);
+  lua_Integer capacity = luaL_optinteger(L, 2, LUAI_CHANNELSIZE);
+  Channel **box;
+  Channel *ch;
+  size_t size = 2;
+  luaL_argcheck(L, 0 < capacity && capacity <= MAXCHANNELSIZE, 2,
+                   "capacity out of range");
+  while (size < (size_t)capacity) size *= 2;
+  box = (Channel **)lua_newuserdata(L, sizeof(Channel *));
+  *box = NULL;
+  luaL_setmetatable(L, CHANNELHANDLE);
+  lockchannels();
+  for (ch = channels; ch != NULL; ch = ch->next) {
+    if (strcmp(ch->name, name) == 0) {
+      ch->nopen++;
+      break;
+    }
+  }
+  if (ch == NULL) {
+    ch = newchannel(name, len, size);
+    if (ch != NULL) {
+      ch->next = channels;
+      channels = ch;
+    }
+  }
+  unlockchannels();
+  if (ch == NULL)
+    return luaL_error(L, "not enough memory");
+  *box = ch;
+  return 1;
+}
+
+
+static int scratch_gc (lua_State *L) {
+  Scratch *s = (Scratch *)lua_touserdata(L, 1);
+  free(s->buff);
+  s->buff = NULL;
+  s->size = 0;
+  return 0;
+}
+
+
+static const luaL_Reg ch_methods[] = {
+  {"send", ch_send},
+  {"trysend", ch_trysend},
+  {"receive", ch_receive},
+  {"tryreceive", ch_tryreceive},
+  {"capacity", ch_capacity},
+  {"close", ch_close},
+  {NULL, NULL}
+};
+
+
+static const luaL_Reg ch_metamethods[] = {
+  {"__len", ch_len},
+  {"__gc", ch_close},
+  {"__tostring", ch_tostring},
+  {NULL, NULL}
+};
+
+
+static const luaL_Reg ch_funcs[] = {
+  {"open", ch_open},
+  {NULL, NULL}
+};
+
+
+LUAMOD_API int luaopen_channel (lua_State *L) {
+  Scratch *s;
+  luaL_newlib(L, ch_funcs);
+  luaL_newmetatable(L, CHANNELHANDLE);
+  luaL_setfuncs(L, ch_metamethods, 0);
+  luaL_newlibtable(L, ch_methods);
+  s = (Scratch *)lua_newuserdata(L, sizeof(Scratch));  /* methods' upvalue */
+  s->buff = NULL;
+  s->size = 0;
+  lua_createtable(L, 0, 1);
+  lua_pushcfunction(L, scratch_gc);
+  lua_setfield(L, -2, "__gc");
+  lua_setmetatable(L, -2);
+  luaL_setfuncs(L, ch_methods, 1);
+  lua_setfield(L, -2, "__index");
+  lua_pop(L, 1);  /* metatable */
+  return 1;
+}
+
@@ -60,10 +60,10 @@
 
 
 /*
-** 'makewhite' erases all color bits then sets only the current white
-** bit
+** 'makewhite' erases all color bits (and the old bit) then sets only
+** the current white bit
 */
-#define maskcolors	(~(bitmask(BLACKBIT) | WHITEBITS))
+#define maskcolors	(~(bitmask(BLACKBIT) | WHITEBITS | bitmask(OLDBIT)))
 #define makewhite(g,x)	\
  (x->marked = cast_byte((x->marked & maskcolors) | luaC_white(g)))
 
@@ -150,7 +150,9 @@ static int iscleared (global_State *g, const TValue *o) {
 ** barrier that moves collector forward, that is, mark the white object
 ** being pointed by a black object. (If in sweep phase, clear the black
 ** object to white [sweep it] to avoid other barrier calls for this
-** same object.)
+** same object.) In generational mode the invariant is always kept, so
+** a young object stored into an old (black) one is marked here and
+** survives the next minor collection.
 */
 void luaC_barrier_ (lua_State *L, GCObject *o, GCObject *v) {
   global_State *g = G(L);
@@ -166,7 +168,9 @@ void luaC_barrier_ (lua_State *L, GCObject *o, GCObject *v) {
 
 /*
 ** barrier that moves collector backward, that is, mark the black object
-** pointing to a white object as gray again.
+** pointing to a white object as gray again. In generational mode this is
+** how an old table that receives young values is remembered: it stays in
+** 'grayagain' until the next minor collection traverses it again.
 */
 void luaC_barrierback_ (lua_State *L, Table *t) {
   global_State *g = G(L);
@@ -193,11 +197,16 @@ void luaC_upvalbarrier_ (lua_State *L, UpVal *uv) {
 
 void luaC_fix (lua_State *L, GCObject *o) {
   global_State *g = G(L);
+#if defined(LUA_USE_SHAREDSTRINGS)
+  if (isshared(o))  /* already fixed in the state that owns its pool? */
+    return;
+#endif
   lua_assert(g->allgc == o);  /* object must be 1st in 'allgc' list! */
   white2gray(o);  /* they will be gray forever */
   g->allgc = o->next;  /* remove object from 'allgc' list */
   o->next = g->fixedgc;  /* link it to 'fixedgc' list */
   g->fixedgc = o;
+  g->GCnumobjs--;  /* fixed objects are never swept (until the state closes) */
 }
 
 
@@ -212,6 +221,7 @@ GCObject *luaC_newobj (lua_State *L, int tt, size_t sz) {
   o->tt = tt;
   o->next = g->allgc;
   g->allgc = o;
+  g->GCnumobjs++;
   return o;
 }
 
@@ -378,6 +388,8 @@ static void traverseweakvalue (global_State *g, Table *h) {
     linkgclist(h, g->grayagain);  /* must retraverse it in atomic phase */
   else if (hasclears)
     linkgclist(h, g->weak);  /* has to be cleared later */
+  else if (isgenerational(g))
+    linkgclist(h, g->grayagain);  /* gray tables must stay in a list */
 }
 
 
@@ -426,6 +438,8 @@ static int traverseephemeron (global_State *g, Table *h) {
     linkgclist(h, g->ephemeron);  /* have to propagate again */
   else if (hasclears)  /* table has white keys? */
     linkgclist(h, g->allweak);  /* may have to clean white keys */
+  else if (isgenerational(g))
+    linkgclist(h, g->grayagain);  /* gray tables must stay in a list */
   return marked;
 }
 
@@ -625,6 +639,191 @@ static void convergeephemerons (global_State *g) {
 /* }====================================================== */
 
 
+/*
+** {======================================================
+** GC telemetry
+** =======================================================
+*/
+
+/*
+** 'l_gcclock' returns a monotonic time in nanoseconds (except with
+** ISO C, which only has processor time). It is only called when the GC
+** telemetry is on or a step has a time budget.
+*/
+#if !defined(l_gcclock)
+
+#include <time.h>
+
+#if defined(LUA_USE_POSIX)	/* { */
+
+static lua_Integer l_gcclock (void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return cast(lua_Integer, ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+#elif defined(LUA_USE_WINDOWS)	/* }{ */
+
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+/* (the performance counter is monotonic, unlike the system time) */
+static lua_Integer l_gcclock (void) {
+  static LARGE_INTEGER frequency;  /* (never changes while running) */
+  LARGE_INTEGER count;
+  if (frequency.QuadPart == 0)
+    QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&count);
+  /* (seconds and the remainder separately, to avoid an overflow) */
+  return cast(lua_Integer, count.QuadPart / frequency.QuadPart) * 1000000000 +
+         cast(lua_Integer, (count.QuadPart % frequency.QuadPart) *
+                           1000000000 / frequency.QuadPart);
+}
+
+#else				/* }{ */
+
+/* ISO C only has processor time */
+#define l_gcclock()  \
+	cast(lua_Integer, (cast(double, clock()) / CLOCKS_PER_SEC) * 1e9)
+
+#endif				/* } */
+
+#endif
+
+
+/* states where the work of a step is the memory traversed */
+#define ismarkstate(s)	((s) == GCSpause || (s) == GCSpropagate || (s) == GCSatomic)
+
+
+/* statistics of the cycle in progress */
+#define currcycle(s)	(&(s)->cycles[(s)->current])
+
+
+/* time from 'start' to 'now' (a clock that is not monotonic may go back) */
+static lua_Integer elapsed (lua_Integer start, lua_Integer now) {
+  return (now > start) ? now - start : 0;
+}
+
+
+/*
+** Turns the telemetry on (starting with an empty history) or off
+*/
+void luaC_enablestats (lua_State *L, int enable) {
+  global_State *g = G(L);
+  if (enable && g->gcstats == NULL) {
+    GCStats *s = luaM_new(L, GCStats);
+    memset(s, 0, sizeof(GCStats));
+    s->cycles[0].cycle = 1;
+    s->segstate = -1;
+    g->gcstats = s;
+  }
+  else if (!enable && g->gcstats != NULL) {
+    /* (a call being timed checks again whether the telemetry is on) */
+    luaM_free(L, g->gcstats);
+    g->gcstats = NULL;
+  }
+}
+
+
+/*
+** Ends the current segment, adding its time to the state of its steps
+*/
+static void closesegment (GCStats *s, lua_Integer now) {
+  if (s->segstate >= 0) {
+    lua_GCStateStats *st = &currcycle(s)->states[s->segstate];
+    lua_Integer d = elapsed(s->segstart, now);
+    st->time += d;
+    if (d > st->maxtime) st->maxtime = d;
+    s->segstate = -1;
+  }
+  s->segstart = now;
+}
+
+
+/*
+** The cycle in progress has finished; the next one reuses the oldest
+** entry of the ring buffer
+*/
+static void newcycle (global_State *g, GCStats *s) {
+  lua_Integer next = currcycle(s)->cycle + 1;
+  currcycle(s)->memory = cast(lua_Integer, gettotalbytes(g));
+  s->current = (s->current + 1) % LUA_GCSTATSCYCLES;
+  memset(currcycle(s), 0, sizeof(lua_GCCycleStats));
+  currcycle(s)->cycle = next;
+}
+
+
+/*
+** A call into the collector (a pause) starts. Calls can nest (e.g.,
+** 'luaC_fullgc' calls 'luaC_runtilstate', and a finalizer can call the
+** collector), and only the outermost one is a pause.
+*/
+static void statsenter (global_State *g) {
+  GCStats *s = g->gcstats;
+  if (s != NULL && s->depth++ == 0) {
+    s->pausestart = s->segstart = l_gcclock();
+    s->segstate = -1;
+    s->pausecycle = s->current;
+  }
+}
+
+
+static void statsleave (global_State *g) {
+  GCStats *s = g->gcstats;
+  if (s != NULL && s->depth > 0 && --s->depth == 0) {
+    lua_Integer now = l_gcclock();
+    lua_GCCycleStats *c = &s->cycles[s->pausecycle];
+    lua_Integer d = elapsed(s->pausestart, now);
+    lua_Integer us = d / 1000;
+    int bucket = 0;
+    closesegment(s, now);
+    while (us > 0 && bucket < LUA_GCSTATSBUCKETS - 1) {
+      us >>= 1;
+      bucket++;
+    }
+    c->pauses++;
+    c->pausetime += d;
+    if (d > c->maxpause) c->maxpause = d;
+    c->histogram[bucket]++;
+  }
+}
+
+
+/*
+** Accounts for a single step done in state 'oldstate'. The clock is
+** only read when the step changes the state.
+*/
+static void statsstep (global_State *g, int oldstate, lu_mem work) {
+  GCStats *s = g->gcstats;
+  if (s != NULL && s->depth > 0) {
+    lua_GCStateStats *st = &currcycle(s)->states[oldstate];
+    if (s->segstate >= 0 && s->segstate != oldstate)  /* state was changed */
+      closesegment(s, l_gcclock());  /* outside a step (e.g., 'entersweep') */
+    st->steps++;
+    if (ismarkstate(oldstate))  /* is 'work' the memory traversed? */
+      st->traversed += cast(lua_Integer, work);
+    s->segstate = oldstate;
+    if (g->gcstate != oldstate) {  /* end of a segment? */
+      closesegment(s, l_gcclock());
+      if (g->gcstate == GCSpause)  /* end of the cycle? */
+        newcycle(g, s);
+    }
+  }
+}
+
+
+/* an error is leaving all collector calls being timed */
+static void statsabort (global_State *g) {
+  while (g->gcstats != NULL && g->gcstats->depth > 0)
+    statsleave(g);
+}
+
+/* }====================================================== */
+
+
+
 /*
 ** {======================================================
 ** Sweep Functions
@@ -730,24 +929,54 @@ static GCObject **sweeplist (lua_State *L, GCObject **p, lu_mem count);
 ** white; change all non-dead objects back to white, preparing for next
 ** collection cycle. Return where to continue the traversal or NULL if
 ** list is finished.
+** In generational mode, surviving objects keep their marks and become
+** old instead. New objects are always added to the front of a list
+** (see the MOVE OLD rule), so all young objects come before the first
+** old one, and the sweep of a minor collection stops there.
 */
 static GCObject **sweeplist (lua_State *L, GCObject **p, lu_mem count) {
   global_State *g = G(L);
   int ow = otherwhite(g);
-  int white = luaC_white(g);  /* current white */
+  int toclear, toset;  /* bits to clear and to set in all live objects */
+  int tostop;  /* stop sweep when this is true */
+  lu_mem swept = 0, freed = 0;  /* (for the telemetry) */
+  if (isgenerational(g)) {  /* generational mode? */
+    toclear = ~0;  /* clear nothing */
+    toset = bitmask(OLDBIT);  /* set the old bit of all surviving objects */
+    tostop = bitmask(OLDBIT);  /* do not sweep old generation */
+  }
+  else {  /* normal mode */
+    toclear = maskcolors;  /* clear all color bits + old bit */
+    toset = luaC_white(g);  /* make object white */
+    tostop = 0;  /* do not stop */
+  }
   while (*p != NULL && count-- > 0) {
     GCObject *curr = *p;
     int marked = curr->marked;
     if (isdeadm(ow, marked)) {  /* is 'curr' dead? */
       *p = curr->next;  /* remove 'curr' from list */
       freeobj(L, curr);  /* erase 'curr' */
+      freed++;
     }
-    else {  /* change mark to 'white' */
-      curr->marked = cast_byte((marked & maskcolors) | white);
+    else {
+      if (testbits(marked, tostop)) {
+        p = NULL;  /* stop sweeping this list */
+        break;
+      }
+      curr->marked = cast_byte((marked & toclear) | toset);  /* update marks */
       p = &curr->next;  /* go to next element */
     }
+    swept++;
   }
-  return (*p == NULL) ? NULL : p;
+  g->GCnumobjs -= freed;
+  g->GCswept += swept;
+  g->GCtosweep = (g->GCtosweep > swept) ? g->GCtosweep - swept : 0;
+  if (g->gcstats != NULL) {
+    lua_GCStateStats *st = &currcycle(g->gcstats)->states[g->gcstate];
+    st->swept += cast(lua_Integer, swept);
+    st->freed += cast(lua_Integer, freed);
+  }
+  return (p == NULL || *p == NULL) ? NULL : p;
 }
 
 
@@ -777,8 +1006,18 @@ static GCObject **sweeptolive (lua_State *L, GCObject **p) {
 static void checkSizes (lua_State *L, global_State *g) {
   if (g->gckind != KGC_EMERGENCY) {
     l_mem olddebt = g->GCdebt;
+#if defined(LUA_USE_FASTINTERN)
+    /* the open-addressing table is only shrunk if it was too big for the
+       whole cycle, because growing it again rehashes it into a new array
+       (and so shrinking it after every cycle that creates and collects
+       many strings would cost two rehashes per cycle) */
+    if (g->strt.peakuse < g->strt.size / 4)  /* string table too big? */
+      luaS_resize(L, g->strt.size / 2);  /* shrink it a little */
+    g->strt.peakuse = g->strt.nuse;
+#else
     if (g->strt.nuse < g->strt.size / 4)  /* string table too big? */
       luaS_resize(L, g->strt.size / 2);  /* shrink it a little */
+#endif
     g->GCestimate += g->GCdebt - olddebt;  /* update estimate */
   }
 }
@@ -790,6 +1029,7 @@ static GCObject *udata2finalize (global_State *g) {
   g->tobefnz = o->next;  /* remove it from 'tobefnz' list */
   o->next = g->allgc;  /* return it to 'allgc' list */
   g->allgc = o;
+  resetoldbit(o);  /* see MOVE OLD rule */
   resetbit(o->marked, FINALIZEDBIT);  /* object is "normal" again */
   if (issweepphase(g))
     makewhite(g, o);  /* "sweep" object */
@@ -813,6 +1053,7 @@ static void GCTM (lua_State *L, int propagateerrors) {
     int status;
     lu_byte oldah = L->allowhook;
     int running  = g->gcrunning;
+    int statsdepth = (g->gcstats != NULL) ? g->gcstats->depth : 0;
     L->allowhook = 0;  /* stop debug hooks during GC metamethod */
     g->gcrunning = 0;  /* avoid GC steps */
     setobj2s(L, L->top, tm);  /* push finalizer... */
@@ -823,6 +1064,11 @@ static void GCTM (lua_State *L, int propagateerrors) {
     L->ci->callstatus &= ~CIST_FIN;  /* not running a finalizer anymore */
     L->allowhook = oldah;  /* restore hooks */
     g->gcrunning = running;  /* restore state */
+    if (g->gcstats != NULL) {
+      /* an error in the finalizer may have skipped some 'statsleave' */
+      g->gcstats->depth = statsdepth;
+      currcycle(g->gcstats)->states[g->gcstate].finalized++;
+    }
     if (status != LUA_OK && propagateerrors) {  /* error while running __gc? */
       if (status == LUA_ERRRUN) {  /* is there an error object? */
         const char *msg = (ttisstring(L->top - 1))
@@ -831,6 +1077,7 @@ static void GCTM (lua_State *L, int propagateerrors) {
         luaO_pushfstring(L, "error in __gc metamethod (%s)", msg);
         status = LUA_ERRGCMM;  /* error in __gc metamethod */
       }
+      statsabort(g);
       luaD_throw(L, status);  /* re-throw error */
     }
   }
@@ -915,6 +1162,7 @@ void luaC_checkfinalizer (lua_State *L, GCObject *o, Table *mt) {
     *p = o->next;  /* remove 'o' from 'allgc' list */
     o->next = g->finobj;  /* link it in 'finobj' list */
     g->finobj = o;
+    resetoldbit(o);  /* see MOVE OLD rule */
     l_setbit(o->marked, FINALIZEDBIT);  /* mark it as such */
   }
 }
@@ -959,6 +1207,7 @@ static void entersweep (lua_State *L) {
   global_State *g = G(L);
   g->gcstate = GCSswpallgc;
   lua_assert(g->sweepgc == NULL);
+  g->GCtosweep = g->GCnumobjs;
   g->sweepgc = sweeplist(L, &g->allgc, 1);
 }
 
@@ -973,11 +1222,35 @@ void luaC_freeallobjects (lua_State *L) {
   g->gckind = KGC_NORMAL;
   sweepwholelist(L, &g->finobj);
   sweepwholelist(L, &g->allgc);
+  /* fixed objects aren't counted in 'GCnumobjs', and so it wraps around
+     here; nothing uses it after this, though */
   sweepwholelist(L, &g->fixedgc);  /* collect fixed objects */
   lua_assert(g->strt.nuse == 0);
 }
 
 
+/*
+** In generational mode, objects that stay gray after the atomic phase
+** (threads and weak tables) survive the sweep without becoming white, so
+** they would never be marked (and traversed) again. Keep all of them in
+** 'grayagain' so that the next minor collection traverses them again.
+*/
+static void keepgraylists (global_State *g) {
+  GCObject **lists[3];
+  int i;
+  lists[0] = &g->weak; lists[1] = &g->allweak; lists[2] = &g->ephemeron;
+  for (i = 0; i < 3; i++) {
+    GCObject *l = *lists[i];
+    while (l != NULL) {
+      Table *h = gco2t(l);
+      l = h->gclist;
+      linkgclist(h, g->grayagain);
+    }
+    *lists[i] = NULL;
+  }
+}
+
+
 static l_mem atomic (lua_State *L) {
   global_State *g = G(L);
   l_mem work;
@@ -985,6 +1258,7 @@ static l_mem atomic (lua_State *L) {
   GCObject *grayagain = g->grayagain;  /* save original list */
   lua_assert(g->ephemeron == NULL && g->weak == NULL);
   lua_assert(!iswhite(g->mainthread));
+  g->grayagain = NULL;  /* threads traversed below are linked here again */
   g->gcstate = GCSinsideatomic;
   g->GCmemtrav = 0;  /* start counting work */
   markobject(g, L);  /* mark running thread */
@@ -1019,6 +1293,8 @@ static l_mem atomic (lua_State *L) {
   clearvalues(g, g->weak, origweak);
   clearvalues(g, g->allweak, origall);
   luaS_clearcache(g);
+  if (isgenerational(g))
+    keepgraylists(g);
   g->currentwhite = cast_byte(otherwhite(g));  /* flip current white */
   work += g->GCmemtrav;  /* complete counting */
   return work;  /* estimate of memory marked by 'atomic' */
@@ -1041,20 +1317,22 @@ static lu_mem sweepstep (lua_State *L, global_State *g,
 }
 
 
-static lu_mem singlestep (lua_State *L) {
-  global_State *g = G(L);
+static lu_mem dostep (lua_State *L, global_State *g) {
   switch (g->gcstate) {
     case GCSpause: {
       g->GCmemtrav = g->strt.size * sizeof(GCObject*);
+      g->GCmarked = g->GCswept = 0;  /* a new cycle starts */
       restartcollection(g);
       g->gcstate = GCSpropagate;
       return g->GCmemtrav;
     }
     case GCSpropagate: {
       g->GCmemtrav = 0;
-      lua_assert(g->gray);
-      propagatemark(g);
-       if (g->gray == NULL)  /* no more gray objects? */
+      /* a minor collection may start with nothing to propagate */
+      lua_assert(g->gray || isgenerational(g));
+      if (g->gray)
+        propagatemark(g);
+      if (g->gray == NULL)  /* no more gray objects? */
         g->gcstate = GCSatomic;  /* finish propagate phase */
       return g->GCmemtrav;  /* memory traversed in this step */
     }
@@ -1076,7 +1354,8 @@ static lu_mem singlestep (lua_State *L) {
       return sweepstep(L, g, GCSswpend, NULL);
     }
     case GCSswpend: {  /* finish sweeps */
-      makewhite(g, g->mainthread);  /* sweep main thread */
+      if (!isgenerational(g))  /* (in generational mode it stays gray) */
+        makewhite(g, g->mainthread);  /* sweep main thread */
       checkSizes(L, g);
       g->gcstate = GCScallfin;
       return 0;
@@ -1096,14 +1375,28 @@ static lu_mem singlestep (lua_State *L) {
 }
 
 
+static lu_mem singlestep (lua_State *L) {
+  global_State *g = G(L);
+  int oldstate = g->gcstate;
+  lu_mem work = dostep(L, g);
+  if (ismarkstate(oldstate))
+    g->GCmarked += work;  /* 'work' is the memory traversed */
+  if (g->gcstats != NULL)
+    statsstep(g, oldstate, work);
+  return work;
+}
+
+
 /*
 ** advances the garbage collector until it reaches a state allowed
 ** by 'statemask'
 */
 void luaC_runtilstate (lua_State *L, int statesmask) {
   global_State *g = G(L);
+  statsenter(g);
   while (!testbit(statesmask, g->gcstate))
     singlestep(L);
+  statsleave(g);
 }
 
 
@@ -1122,6 +1415,35 @@ static l_mem getdebt (global_State *g) {
   }
 }
 
+/*
+** In generational mode the next minor collection happens after the
+** program allocates 'genminormul'% of the memory currently in use
+*/
+static void setminordebt (global_State *g) {
+  luaE_setdebt(g, -(cast(l_mem, gettotalbytes(g) / 100) * g->genminormul));
+}
+
+
+/*
+** In generational mode the collector is kept in the propagate phase
+** between collections. A step is a complete minor collection, which only
+** sweeps young objects and only traverses old objects that were changed
+** (and caught by a barrier) or that are always gray (threads and weak
+** tables). When memory use has grown more than 'genmajormul'% since the
+** last major collection, a step is a full (major) collection instead.
+*/
+static void genstep (lua_State *L, global_State *g) {
+  lu_mem majorlimit = g->GCmajorbase + (g->GCmajorbase / 100) * g->genmajormul;
+  if (gettotalbytes(g) > majorlimit)
+    luaC_fullgc(L, 0);  /* (also resets the base and the debt) */
+  else {
+    luaC_runtilstate(L, bitmask(GCSpause));  /* run a complete minor cycle */
+    g->gcstate = GCSpropagate;  /* skip restart */
+    setminordebt(g);
+  }
+}
+
+
 /*
 ** performs a basic GC step when collector is running
 */
@@ -1132,17 +1454,103 @@ void luaC_step (lua_State *L) {
     luaE_setdebt(g, -GCSTEPSIZE * 10);  /* avoid being called too often */
     return;
   }
-  do {  /* repeat until pause or enough "credit" (negative debt) */
-    lu_mem work = singlestep(L);  /* perform one single step */
-    debt -= work;
-  } while (debt > -GCSTEPSIZE && g->gcstate != GCSpause);
-  if (g->gcstate == GCSpause)
-    setpause(g);  /* pause until next cycle */
+  statsenter(g);
+  if (isgenerational(g))
+    genstep(L, g);
   else {
-    debt = (debt / g->gcstepmul) * STEPMULADJ;  /* convert 'work units' to Kb */
-    luaE_setdebt(g, debt);
-    runafewfinalizers(L);
+    do {  /* repeat until pause or enough "credit" (negative debt) */
+      lu_mem work = singlestep(L);  /* perform one single step */
+      debt -= work;
+    } while (debt > -GCSTEPSIZE && g->gcstate != GCSpause);
+    if (g->gcstate == GCSpause)
+      setpause(g);  /* pause until next cycle */
+    else {
+      debt = (debt / g->gcstepmul) * STEPMULADJ;  /* convert 'work units' to Kb */
+      luaE_setdebt(g, debt);
+      runafewfinalizers(L);
+    }
   }
+  statsleave(g);
+}
+
+
+/*
+** Estimates the percentage of the current cycle that is still to be done,
+** measuring work the same way as the steps do: bytes traversed while
+** marking, and GCSWEEPCOST for each object swept. Marking is expected to
+** traverse as much memory as was left after the last cycle ('GCestimate'),
+** and every object that exists now will be swept.
+*/
+static int cycleleft (global_State *g) {
+  lu_mem left, done;
+  switch (g->gcstate) {
+    case GCSpause: return 100;
+    case GCSpropagate: case GCSatomic: {
+      left = (g->GCestimate > g->GCmarked) ? g->GCestimate - g->GCmarked : 0;
+      left += g->GCnumobjs * GCSWEEPCOST;
+      break;
+    }
+    case GCSswpallgc: case GCSswpfinobj: case GCSswptobefnz: {
+      left = g->GCtosweep * GCSWEEPCOST;
+      break;
+    }
+    default: return 1;  /* only finishing the cycle (and finalizers) left */
+  }
+  done = g->GCmarked + g->GCswept * GCSWEEPCOST;
+  if (left + done == 0) return 1;
+  else {
+    int percent = cast_int((left * 100) / (left + done));
+    return (percent < 1) ? 1 : (percent > 100) ? 100 : percent;
+  }
+}
+
+
+/*
+** Performs single steps until 'budget' nanoseconds have passed or the
+** cycle finishes (starting a new cycle if the collector is in its
+** pause). Returns 0 if the cycle finished, or else an estimate of the
+** percentage of the cycle that is left. The clock is checked after
+** each GCSTEPSIZE units of work, so the budget can be exceeded by
+** about one small step (or by the traversal of one huge object).
+** A minor collection cannot be split, so in generational mode this
+** does a whole minor collection.
+*/
+int luaC_steptime (lua_State *L, lua_Integer budget) {
+  global_State *g = G(L);
+  lua_Integer start;
+  lu_mem work = 0, unchecked = 0;
+  int left;
+  statsenter(g);
+  if (isgenerational(g)) {
+    genstep(L, g);
+    left = 0;
+  }
+  else {
+    start = l_gcclock();
+    for (;;) {
+      lu_mem stepwork = singlestep(L);
+      work += stepwork;
+      unchecked += stepwork;
+      if (g->gcstate == GCSpause)  /* cycle finished? */
+        break;
+      if (unchecked >= GCSTEPSIZE) {  /* time to check the clock? */
+        unchecked = 0;
+        if (elapsed(start, l_gcclock()) >= budget)
+          break;
+      }
+    }
+    if (g->gcstate == GCSpause) {
+      setpause(g);  /* pause until next cycle */
+      left = 0;
+    }
+    else {  /* pay back the debt with the work done */
+      l_mem paid = cast(l_mem, work / g->gcstepmul) * STEPMULADJ;
+      luaE_setdebt(g, g->GCdebt - paid);
+      left = cycleleft(g);
+    }
+  }
+  statsleave(g);
+  return left;
 }
 
 
@@ -1154,12 +1562,18 @@ void luaC_step (lua_State *L) {
 ** there may be some objects marked as black, so the collector has
 ** to sweep all objects to turn them back to white (as white has not
 ** changed, nothing will be collected).
+** In generational mode this is a major collection: it runs as a normal
+** cycle, and then the collector goes back to the propagate phase with
+** all objects young.
 */
 void luaC_fullgc (lua_State *L, int isemergency) {
   global_State *g = G(L);
-  lua_assert(g->gckind == KGC_NORMAL);
-  if (isemergency) g->gckind = KGC_EMERGENCY;  /* set flag */
-  if (keepinvariant(g)) {  /* black objects? */
+  int origkind = g->gckind;
+  int hasblack = keepinvariant(g);  /* (always true in generational mode) */
+  lua_assert(origkind != KGC_EMERGENCY);
+  statsenter(g);
+  g->gckind = (isemergency) ? KGC_EMERGENCY : KGC_NORMAL;  /* set flag */
+  if (hasblack) {  /* black objects? */
     entersweep(L); /* sweep everything to turn them back to white */
   }
   /* finish any pending sweep phase to start a new cycle */
@@ -1169,8 +1583,41 @@ void luaC_fullgc (lua_State *L, int isemergency) {
   /* estimate must be correct after a full GC cycle */
   lua_assert(g->GCestimate == gettotalbytes(g));
   luaC_runtilstate(L, bitmask(GCSpause));  /* finish collection */
-  g->gckind = KGC_NORMAL;
-  setpause(g);
+  g->gckind = origkind;
+  if (isgenerational(g)) {
+    /* generational mode must be kept in propagate phase */
+    luaC_runtilstate(L, bitmask(GCSpropagate));
+    g->GCmajorbase = gettotalbytes(g);
+    setminordebt(g);
+  }
+  else
+    setpause(g);
+  statsleave(g);
+}
+
+
+/*
+** Changes the collector between incremental ('KGC_NORMAL') and
+** generational ('KGC_GEN') modes
+*/
+void luaC_changemode (lua_State *L, int mode) {
+  global_State *g = G(L);
+  if (mode == g->gckind) return;  /* nothing to change */
+  if (mode == KGC_GEN) {  /* change to generational mode */
+    /* make sure gray lists are consistent */
+    luaC_runtilstate(L, bitmask(GCSpropagate));
+    g->GCmajorbase = gettotalbytes(g);
+    g->gckind = KGC_GEN;
+    setminordebt(g);
+  }
+  else {  /* change to incremental mode */
+    /* sweep all objects to turn them back to white
+       (as white has not changed, nothing extra will be collected) */
+    g->gckind = KGC_NORMAL;
+    entersweep(L);
+    luaC_runtilstate(L, ~(bitmask(GCSswpallgc) | bitmask(GCSswpfinobj) |
+                          bitmask(GCSswptobefnz) | bitmask(GCSswpend)));
+  }
 }
 
 /* }====================================================== */
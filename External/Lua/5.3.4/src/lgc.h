@@ -50,15 +50,18 @@
 	(GCSswpallgc <= (g)->gcstate && (g)->gcstate <= GCSswpend)
 
 
+#define isgenerational(g)	((g)->gckind == KGC_GEN)
+
 /*
 ** macro to tell when main invariant (white objects cannot point to black
 ** ones) must be kept. During a collection, the sweep
 ** phase may break the invariant, as objects turned white may point to
 ** still-black objects. The invariant is restored when sweep ends and
-** all objects are white again.
+** all objects are white again. In generational mode, the sweep does
+** not turn surviving objects white, so the invariant is always kept.
 */
 
-#define keepinvariant(g)	((g)->gcstate <= GCSatomic)
+#define keepinvariant(g)	(isgenerational(g) || (g)->gcstate <= GCSatomic)
 
 
 /*
@@ -79,8 +82,17 @@
 #define WHITE1BIT	1  /* object is white (type 1) */
 #define BLACKBIT	2  /* object is black */
 #define FINALIZEDBIT	3  /* object has been marked for finalization */
+#define OLDBIT		6  /* object is old (only in generational mode) */
+#if defined(LUA_USE_SHAREDSTRINGS)
+#define SHAREDBIT	4  /* string belongs to a shared string pool */
+#endif
 /* bit 7 is currently used by tests (luaL_checkmemory) */
 
+/*
+** MOVE OLD rule: whenever an object is moved to the beginning of
+** a GC list, its old bit must be cleared
+*/
+
 #define WHITEBITS	bit2mask(WHITE0BIT, WHITE1BIT)
 
 
@@ -91,6 +103,12 @@
 
 #define tofinalize(x)	testbit((x)->marked, FINALIZEDBIT)
 
+#define isold(x)	testbit((x)->marked, OLDBIT)
+#if defined(LUA_USE_SHAREDSTRINGS)
+#define isshared(x)	testbit((x)->marked, SHAREDBIT)
+#endif
+#define resetoldbit(x)	resetbit((x)->marked, OLDBIT)
+
 #define otherwhite(g)	((g)->currentwhite ^ WHITEBITS)
 #define isdeadm(ow,m)	(!(((m) ^ WHITEBITS) & (ow)))
 #define isdead(g,v)	isdeadm(otherwhite(g), (v)->marked)
@@ -131,9 +149,27 @@
 	(iscollectable((uv)->v) && !upisopen(uv)) ? \
          luaC_upvalbarrier_(L,uv) : cast_void(0))
 
+/*
+** GC telemetry (see LUA_GCSTATS in 'lua.h'): a ring buffer with the
+** statistics of the most recent cycles. The time spent in a state is
+** measured once per run of consecutive steps in that state (a "segment"),
+** not once per step, to keep the overhead of the clock low.
+*/
+typedef struct GCStats {
+  lua_GCCycleStats cycles[LUA_GCSTATSCYCLES];
+  int current;  /* index of the cycle in progress */
+  int depth;  /* nesting of collector calls being timed */
+  int pausecycle;  /* cycle in progress when the outermost call started */
+  int segstate;  /* state of the steps in the current segment (or -1) */
+  lua_Integer pausestart;  /* when the outermost call started */
+  lua_Integer segstart;  /* when the current segment started */
+} GCStats;
+
+
 LUAI_FUNC void luaC_fix (lua_State *L, GCObject *o);
 LUAI_FUNC void luaC_freeallobjects (lua_State *L);
 LUAI_FUNC void luaC_step (lua_State *L);
+LUAI_FUNC int luaC_steptime (lua_State *L, lua_Integer budget);
 LUAI_FUNC void luaC_runtilstate (lua_State *L, int statesmask);
 LUAI_FUNC void luaC_fullgc (lua_State *L, int isemergency);
 LUAI_FUNC GCObject *luaC_newobj (lua_State *L, int tt, size_t sz);
@@ -142,6 +178,8 @@ LUAI_FUNC void luaC_barrierback_ (lua_State *L, Table *o);
 LUAI_FUNC void luaC_upvalbarrier_ (lua_State *L, UpVal *uv);
 LUAI_FUNC void luaC_checkfinalizer (lua_State *L, GCObject *o, Table *mt);
 LUAI_FUNC void luaC_upvdeccount (lua_State *L, UpVal *uv);
+LUAI_FUNC void luaC_changemode (lua_State *L, int mode);
+LUAI_FUNC void luaC_enablestats (lua_State *L, int enable);
 
 
 #endif
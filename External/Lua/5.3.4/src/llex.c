@@ -74,6 +74,10 @@ void luaX_init (lua_State *L) {
   for (i=0; i<NUM_RESERVED; i++) {
     TString *ts = luaS_new(L, luaX_tokens[i]);
     luaC_fix(L, obj2gco(ts));  /* reserved words are never collected */
+#if defined(LUA_USE_SHAREDSTRINGS)
+    if (isshared(ts))  /* other threads can be reading it */
+      continue;  /* (and the state that owns its pool already set it) */
+#endif
     ts->extra = cast_byte(i+1);  /* reserved word */
   }
 }
@@ -501,7 +501,12 @@ typedef struct Table {
   unsigned int sizearray;  /* size of 'array' array */
   TValue *array;  /* array part */
   Node *node;
+#if defined(LUA_USE_HASHGROUPS)
+  lu_byte *ctrl;  /* control byte of each node (see ltable.c) */
+  unsigned int growthleft;  /* free nodes that new keys can still use */
+#else
   Node *lastfree;  /* any free position is before this position */
+#endif
   struct Table *metatable;
   GCObject *gclist;
 } Table;
@@ -0,0 +1,371 @@
+/*
+** $Id: lprofiler.c $
+** Sampling profiler
+** See Copyright Notice in lua.h
+*/
+
+#define lprofiler_c
+#define LUA_LIB
+
+#include "lprefix.h"
+
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lua.h"
+
+#include "lauxlib.h"
+#include "lualib.h"
+
+
+/*
+** The profiler samples the stack of the running Lua thread at a fixed
+** frequency and counts how many times each stack was seen. Like the
+** interpreter's handling of SIGINT (see 'laction' in lua.c), the timer
+** only sets a hook, which is safe to do asynchronously; the hook takes
+** the sample at the next instruction and removes itself, so nothing is
+** done between samples. (Time spent inside a C function is sampled when
+** it returns to Lua.)
+**
+** The samples are reported in the "folded stacks" format used by
+** flame graph tools: one line per distinct stack, with the frames from
+** the outermost to the innermost separated by ';', followed by a space
+** and the number of samples.
+**
+** The hook is set in the thread that started the profiler, so time
+** spent in a coroutine is sampled when the coroutine yields or returns,
+** in the function that resumed it. (Each sample counts all the timer
+** ticks since the previous one, so such time is not lost.) Sampling replaces any hook set with
+** 'debug.sethook'. Only one state can be profiled at a time.
+*/
+
+
+/* maximum number of frames in a sample */
+#if !defined(LUAI_PROFDEPTH)
+#define LUAI_PROFDEPTH		64
+#endif
+
+
+/* key, in the registry, for the table with the samples */
+static const char *const SAMPLES = "_PROFILER";
+
+/*
+** key, in the registry, for a userdata that exists while the profiler
+** runs: its user value anchors the profiled thread, and its finalizer
+** stops the profiler if the state is closed without stopping it
+*/
+static const char *const RUNNING = "_PROFILERRUNNING";
+
+
+/* thread being profiled (NULL if the profiler is not running) */
+static lua_State *volatile profiledL = NULL;
+
+
+/* number of timer ticks since the last sample */
+static volatile sig_atomic_t pendingticks = 0;
+
+
+static void profhook (lua_State *L, lua_Debug *ar);
+
+
+/* called by the timer when a sample is due */
+static void requestsample (void) {
+  lua_State *L = profiledL;
+  pendingticks++;
+  if (L != NULL)
+    lua_sethook(L, profhook, LUA_MASKCALL | LUA_MASKRET | LUA_MASKCOUNT, 1);
+}
+
+
+/*
+** {======================================================
+** Timer: 'l_starttimer' starts calling 'requestsample' about
+** 'frequency' times per second
+** =======================================================
+*/
+
+#if defined(LUA_USE_POSIX)	/* { */
+
+#include <sys/time.h>
+
+/* (the timer counts processor time, so an idle program is not sampled) */
+
+static struct sigaction oldaction;
+
+static void onprofsignal (int i) {
+  (void)i;
+  requestsample();
+}
+
+static int l_starttimer (int frequency) {
+  struct sigaction action;
+  struct itimerval timer;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onprofsignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;  /* do not interrupt I/O */
+  if (sigaction(SIGPROF, &action, &oldaction) != 0)
+    return 0;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = 1000000 / frequency;
+  timer.it_value = timer.it_interval;
+  if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+    sigaction(SIGPROF, &oldaction, NULL);
+    return 0;
+  }
+  return 1;
+}
+
+static void l_stoptimer (void) {
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, NULL);
+  sigaction(SIGPROF, &oldaction, NULL);
+}
+
+#elif defined(LUA_USE_WINDOWS)	/* }{ */
+
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+/* (a timer-queue thread plays the role of the signal) */
+
+static HANDLE timer = NULL;
+
+static VOID CALLBACK ontimer (PVOID param, BOOLEAN fired) {
+  (void)param; (void)fired;
+  requestsample();
+}
+
+static int l_starttimer (int frequency) {
+  DWORD period = 1000 / frequency;  /* in milliseconds */
+  if (period == 0) period = 1;
+  return CreateTimerQueueTimer(&timer, NULL, ontimer, NULL, period, period,
+                               WT_EXECUTEINTIMERTHREAD) != 0;
+}
+
+static void l_stoptimer (void) {
+  /* (waits for a callback that is running) */
+  DeleteTimerQueueTimer(NULL, timer, INVALID_HANDLE_VALUE);
+  timer = NULL;
+}
+
+#else				/* }{ */
+
+/* ISO C: no way to sample asynchronously */
+
+static int l_starttimer (int frequency) {
+  (void)frequency; (void)requestsample;  /* not used */
+  return 0;
+}
+
+static void l_stoptimer (void) {
+}
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
+/*
+** Adds the name of a frame: 'name (source:line)' for Lua functions,
+** 'main chunk (source)' for main chunks, and 'name [C]' for C functions
+*/
+static void addframe (luaL_Buffer *b, lua_Debug *ar) {
+  const char *name = (ar->name != NULL) ? ar->name : "?";
+  if (*ar->what == 'm')  /* main? */
+    lua_pushfstring(b->L, "main chunk (%s)", ar->short_src);
+  else if (*ar->what == 'C')
+    lua_pushfstring(b->L, "%s [C]", name);
+  else
+    lua_pushfstring(b->L, "%s (%s:%d)", name, ar->short_src,
+                                        ar->linedefined);
+  luaL_addvalue(b);
+}
+
+
+static void takesample (lua_State *L, lua_Integer weight) {
+  lua_Debug frames[LUAI_PROFDEPTH];
+  int n = 0;
+  int i;
+  luaL_Buffer b;
+  while (n < LUAI_PROFDEPTH && lua_getstack(L, n, &frames[n])) {
+    lua_getinfo(L, "Sn", &frames[n]);
+    n++;
+  }
+  if (n == 0) return;  /* no Lua function running */
+  luaL_buffinit(L, &b);
+  if (n == LUAI_PROFDEPTH && lua_getstack(L, n, &frames[0]))
+    luaL_addstring(&b, "(truncated);");  /* outermost frames are missing */
+  for (i = n - 1; i >= 0; i--) {  /* from the outermost to the innermost */
+    addframe(&b, &frames[i]);
+    if (i > 0) luaL_addchar(&b, ';');
+  }
+  luaL_pushresult(&b);
+  lua_getfield(L, LUA_REGISTRYINDEX, SAMPLES);
+  lua_pushvalue(L, -2);  /* stack */
+  lua_pushvalue(L, -1);
+  lua_rawget(L, -3);  /* samples[stack] */
+  lua_pushinteger(L, lua_tointeger(L, -1) + weight);
+  lua_remove(L, -2);
+  lua_rawset(L, -3);  /* samples[stack] = samples[stack] + weight */
+  lua_pop(L, 2);  /* samples table, stack */
+}
+
+
+static void profhook (lua_State *L, lua_Debug *ar) {
+  lua_Integer ticks = pendingticks;
+  pendingticks = 0;
+  (void)ar;
+  lua_sethook(L, NULL, 0, 0);  /* one sample per request */
+  if (profiledL != NULL && ticks > 0)
+    takesample(L, ticks);
+}
+
+
+static int prof_stop (lua_State *L) {
+  if (lua_getfield(L, LUA_REGISTRYINDEX, RUNNING) != LUA_TNIL) {
+    /* (a state can only stop its own profiler) */
+    lua_State *pL = profiledL;
+    lua_assert(pL != NULL);
+    l_stoptimer();
+    profiledL = NULL;
+    lua_sethook(pL, NULL, 0, 0);  /* remove a pending request */
+    lua_pushnil(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, RUNNING);
+  }
+  return 0;
+}
+
+
+static int prof_gc (lua_State *L) {
+  lua_getfield(L, LUA_REGISTRYINDEX, RUNNING);
+  if (lua_rawequal(L, 1, -1))  /* still running? (state is being closed) */
+    prof_stop(L);
+  return 0;
+}
+
+
+static int prof_start (lua_State *L) {
+  int frequency = (int)luaL_optinteger(L, 1, 1000);
+  luaL_argcheck(L, 0 < frequency && frequency <= 100000, 1,
+                   "frequency out of range");
+  if (profiledL != NULL)
+    return luaL_error(L, "profiler is already running");
+  if (lua_getfield(L, LUA_REGISTRYINDEX, SAMPLES) != LUA_TTABLE) {
+    lua_newtable(L);
+    lua_setfield(L, LUA_REGISTRYINDEX, SAMPLES);
+  }
+  lua_pop(L, 1);
+  lua_newuserdata(L, 1);
+  lua_pushthread(L);
+  lua_setuservalue(L, -2);  /* anchor the thread */
+  lua_createtable(L, 0, 1);
+  lua_pushcfunction(L, prof_gc);
+  lua_setfield(L, -2, "__gc");
+  lua_setmetatable(L, -2);
+  pendingticks = 0;
+  profiledL = L;
+  if (!l_starttimer(frequency)) {
+    profiledL = NULL;
+    return luaL_error(L, "cannot start the profiler timer");
+  }
+  lua_setfield(L, LUA_REGISTRYINDEX, RUNNING);
+  return 0;
+}
+
+
+static int prof_reset (lua_State *L) {
+  lua_newtable(L);
+  lua_setfield(L, LUA_REGISTRYINDEX, SAMPLES);
+  return 0;
+}
+
+
+/*
+** Pushes the folded stacks (sorted, so that reports can be compared)
+** and returns the number of samples
+*/
+static lua_Integer pushfolded (lua_State *L) {
+  lua_Integer total = 0;
+  int n = 0;
+  int i, lines;
+  luaL_Buffer b;
+  lua_newtable(L);  /* list of lines */
+  lines = lua_gettop(L);
+  if (lua_getfield(L, LUA_REGISTRYINDEX, SAMPLES) == LUA_TTABLE) {
+    lua_pushnil(L);
+    while (lua_next(L, -2)) {
+      lua_Integer count = lua_tointeger(L, -1);
+      total += count;
+      lua_pushfstring(L, "%s %I\n", lua_tostring(L, -2), (LUAI_UACINT)count);
+      lua_rawseti(L, lines, ++n);
+      lua_pop(L, 1);  /* count */
+    }
+  }
+  lua_pop(L, 1);  /* samples table */
+  lua_getglobal(L, LUA_TABLIBNAME);
+  if (lua_istable(L, -1) && lua_getfield(L, -1, "sort") == LUA_TFUNCTION) {
+    lua_pushvalue(L, lines);
+    lua_call(L, 1, 0);
+  }
+  else lua_pop(L, 1);
+  lua_pop(L, 1);  /* table library */
+  luaL_buffinit(L, &b);
+  for (i = 1; i <= n; i++) {
+    lua_rawgeti(L, lines, i);
+    luaL_addvalue(&b);
+  }
+  luaL_pushresult(&b);
+  lua_remove(L, lines);
+  return total;
+}
+
+
+/* returns the folded stacks and the number of samples */
+static int prof_report (lua_State *L) {
+  lua_Integer total = pushfolded(L);
+  lua_pushinteger(L, total);
+  return 2;
+}
+
+
+/* writes the folded stacks to a file and returns the number of samples */
+static int prof_dump (lua_State *L) {
+  const char *filename = luaL_checkstring(L, 1);
+  lua_Integer total = pushfolded(L);
+  size_t size;
+  const char *folded = lua_tolstring(L, -1, &size);
+  FILE *f = fopen(filename, "w");
+  if (f == NULL)
+    return luaL_fileresult(L, 0, filename);
+  if (fwrite(folded, 1, size, f) != size) {
+    fclose(f);
+    return luaL_fileresult(L, 0, filename);
+  }
+  if (fclose(f) != 0)
+    return luaL_fileresult(L, 0, filename);
+  lua_pushinteger(L, total);
+  return 1;
+}
+
+
+static const luaL_Reg prof_funcs[] = {
+  {"start", prof_start},
+  {"stop", prof_stop},
+  {"reset", prof_reset},
+  {"report", prof_report},
+  {"dump", prof_dump},
+  {NULL, NULL}
+};
+
+
+LUAMOD_API int luaopen_profiler (lua_State *L) {
+  luaL_newlib(L, prof_funcs);
+  return 1;
+}
+
@@ -36,6 +36,14 @@
 #define LUAI_GCMUL	200 /* GC runs 'twice the speed' of memory allocation */
 #endif
 
+#if !defined(LUAI_GENMINORMUL)
+#define LUAI_GENMINORMUL	20  /* minor collection after 20% new memory */
+#endif
+
+#if !defined(LUAI_GENMAJORMUL)
+#define LUAI_GENMAJORMUL	100  /* major collection after 100% growth */
+#endif
+
 
 /*
 ** a macro to help the creation of a unique random seed when a state is
@@ -239,16 +247,53 @@ static void preinit_thread (lua_State *L, global_State *g) {
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+
+/*
+** {======================================================
+** Shared string pools: 'lua_newstringpool' freezes a state, and the
+** states created with 'lua_newstatewithpool' look up short strings in
+** the frozen state's string table before their own. The shared strings
+** are gray and marked with SHAREDBIT, like fixed objects that no state
+** ever marks, sweeps, or writes to, and so states on different threads
+** can use them without locks. Each state that uses a pool holds a
+** reference to it; the frozen state is closed (freeing the strings)
+** when the last reference is released.
+** =======================================================
+*/
+
+static void releasepool (lua_StringPool *pool) {
+  if (l_atomicdec(&pool->refcount) == 0) {  /* last reference? */
+    lua_State *owner = pool->owner;
+    global_State *g = G(owner);
+    (*g->frealloc)(g->ud, pool, sizeof(lua_StringPool), 0);
+    lua_close(owner);
+  }
+}
+
+/* }====================================================== */
+
+#endif
+
+
 static void close_state (lua_State *L) {
   global_State *g = G(L);
+#if defined(LUA_USE_SHAREDSTRINGS)
+  lua_StringPool *pool = g->stringpool;
+#endif
   luaF_close(L, L->stack);  /* close all upvalues for this thread */
   luaC_freeallobjects(L);  /* collect all objects */
   if (g->version)  /* closing a fully built state? */
     luai_userstateclose(L);
   luaM_freearray(L, G(L)->strt.hash, G(L)->strt.size);
+  luaC_enablestats(L, 0);  /* free the GC telemetry */
   freestack(L);
   lua_assert(gettotalbytes(g) == sizeof(LG));
   (*g->frealloc)(g->ud, fromstate(L), sizeof(LG), 0);  /* free main block */
+#if defined(LUA_USE_SHAREDSTRINGS)
+  if (pool != NULL)  /* after this state no longer uses its strings */
+    releasepool(pool);
+#endif
 }
 
 
@@ -264,6 +309,7 @@ LUA_API lua_State *lua_newthread (lua_State *L) {
   /* link it on list 'allgc' */
   L1->next = g->allgc;
   g->allgc = obj2gco(L1);
+  g->GCnumobjs++;
   /* anchor it on L stack */
   setthvalue(L, L->top, L1);
   api_incr_top(L);
@@ -292,7 +338,11 @@ void luaE_freethread (lua_State *L, lua_State *L1) {
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+static lua_State *newstate (lua_Alloc f, void *ud, lua_StringPool *pool) {
+#else
 LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
+#endif
   int i;
   lua_State *L;
   global_State *g;
@@ -309,10 +359,20 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->ud = ud;
   g->mainthread = L;
   g->seed = makeseed(L);
+#if defined(LUA_USE_SHAREDSTRINGS)
+  g->stringpool = pool;
+  if (pool != NULL) {
+    g->seed = G(pool->owner)->seed;  /* the shared strings' hashes use it */
+    l_atomicinc(&pool->refcount);  /* released by 'close_state' */
+  }
+#endif
   g->gcrunning = 0;  /* no GC while building state */
   g->GCestimate = 0;
   g->strt.size = g->strt.nuse = 0;
   g->strt.hash = NULL;
+#if defined(LUA_USE_FASTINTERN)
+  g->strt.peakuse = 0;
+#endif
   setnilvalue(&g->l_registry);
   g->panic = NULL;
   g->version = NULL;
@@ -328,6 +388,11 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->gcfinnum = 0;
   g->gcpause = LUAI_GCPAUSE;
   g->gcstepmul = LUAI_GCMUL;
+  g->genminormul = LUAI_GENMINORMUL;
+  g->genmajormul = LUAI_GENMAJORMUL;
+  g->GCmajorbase = 0;
+  g->gcstats = NULL;
+  g->GCnumobjs = g->GCmarked = g->GCswept = g->GCtosweep = 0;
   for (i=0; i < LUA_NUMTAGS; i++) g->mt[i] = NULL;
   if (luaD_rawrunprotected(L, f_luaopen, NULL) != LUA_OK) {
     /* memory allocation error: free partial state */
@@ -338,6 +403,57 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+
+LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
+  return newstate(f, ud, NULL);
+}
+
+
+/*
+** Creates a state that shares the strings of a pool. The pool is kept
+** alive until the state is closed.
+*/
+LUA_API lua_State *lua_newstatewithpool (lua_Alloc f, void *ud,
+                                         lua_StringPool *pool) {
+  return newstate(f, ud, pool);
+}
+
+
+/*
+** Freezes a state and makes a pool of every short string that it has
+** (e.g. the names and keys that compiling and running typical scripts
+** created). The pool owns the state, which must not be used again
+** (not even closed), and the caller owns one reference to the pool,
+** which 'lua_closestringpool' releases. Returns NULL if there is not
+** enough memory (and then the state is unchanged).
+*/
+LUA_API lua_StringPool *lua_newstringpool (lua_State *L) {
+  global_State *g;
+  lua_StringPool *pool;
+  lua_lock(L);
+  g = G(L);
+  api_check(L, g->stringpool == NULL, "state uses a string pool itself");
+  pool = cast(lua_StringPool *,
+              (*g->frealloc)(g->ud, NULL, 0, sizeof(lua_StringPool)));
+  if (pool != NULL) {
+    g->gcrunning = 0;  /* the shared strings must never be collected */
+    luaS_share(L);
+    pool->owner = g->mainthread;
+    pool->refcount = 1;
+  }
+  lua_unlock(L);
+  return pool;
+}
+
+
+LUA_API void lua_closestringpool (lua_StringPool *pool) {
+  releasepool(pool);
+}
+
+#endif
+
+
 LUA_API void lua_close (lua_State *L) {
   L = G(L)->mainthread;  /* only the main thread can be closed */
   lua_lock(L);
@@ -53,15 +53,60 @@ struct lua_longjmp;  /* defined in ldo.c */
 /* kinds of Garbage Collection */
 #define KGC_NORMAL	0
 #define KGC_EMERGENCY	1	/* gc was forced by an allocation failure */
+#define KGC_GEN		2	/* generational collection */
+
+
+#if defined(LUA_USE_FASTINTERN)
+/* a slot of the open-addressing string table (see lstring.c) */
+typedef struct StringSlot {
+  unsigned int hash;  /* hash of 'ts' */
+  TString *ts;  /* NULL for an empty slot */
+} StringSlot;
+#endif
 
 
 typedef struct stringtable {
+#if defined(LUA_USE_FASTINTERN)
+  StringSlot *hash;
+  int peakuse;  /* largest 'nuse' since the last collection */
+#else
   TString **hash;
+#endif
   int nuse;  /* number of elements */
   int size;
 } stringtable;
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+
+/*
+** The reference count of a string pool is changed by states that can
+** be used by different threads
+*/
+#if !defined(l_atomicinc)
+#if defined(_MSC_VER) && !defined(__GNUC__)
+#include <intrin.h>
+#define l_atomicinc(p)	_InterlockedIncrement(p)
+#define l_atomicdec(p)	_InterlockedDecrement(p)
+#else
+#define l_atomicinc(p)	__sync_add_and_fetch(p, 1)
+#define l_atomicdec(p)	__sync_sub_and_fetch(p, 1)
+#endif
+#endif
+
+
+/*
+** A string pool is a frozen state whose short strings are shared with
+** the states that are created with the pool (see lstate.c)
+*/
+struct lua_StringPool {
+  lua_State *owner;  /* the frozen state (which frees the strings) */
+  volatile long refcount;  /* 'lua_closestringpool' and each user */
+};
+
+#endif
+
+
 /*
 ** Information about a call.
 ** When a thread yields, 'func' is adjusted to pretend that the
@@ -126,6 +171,9 @@ typedef struct global_State {
   stringtable strt;  /* hash table for strings */
   TValue l_registry;
   unsigned int seed;  /* randomized seed for hashes */
+#if defined(LUA_USE_SHAREDSTRINGS)
+  struct lua_StringPool *stringpool;  /* strings shared with this state */
+#endif
   lu_byte currentwhite;
   lu_byte gcstate;  /* state of garbage collector */
   lu_byte gckind;  /* kind of GC running */
@@ -144,6 +192,14 @@ typedef struct global_State {
   unsigned int gcfinnum;  /* number of finalizers to call in each GC step */
   int gcpause;  /* size of pause between successive GCs */
   int gcstepmul;  /* GC 'granularity' */
+  int genminormul;  /* control for minor generational collections */
+  int genmajormul;  /* control for major generational collections */
+  lu_mem GCmajorbase;  /* memory in use after last major collection */
+  struct GCStats *gcstats;  /* GC telemetry (NULL when it is off) */
+  lu_mem GCnumobjs;  /* number of collectable objects (except fixed ones) */
+  lu_mem GCmarked;  /* memory traversed in the current cycle */
+  lu_mem GCswept;  /* objects swept in the current cycle */
+  lu_mem GCtosweep;  /* objects still to be swept in the current cycle */
   lua_CFunction panic;  /* to be called in unprotected errors */
   struct lua_State *mainthread;
   const lua_Number *version;  /* pointer to version number */
@@ -4,6 +4,18 @@
 ** See Copyright Notice in lua.h
 */
 
+/*
+** When Lua is built with LUA_USE_FASTINTERN short strings are hashed
+** and compared a machine word at a time, and the string table uses open
+** addressing (linear probing) instead of chaining. Each slot keeps the
+** hash of its string next to the pointer, so a lookup only reads the
+** strings whose hash matches instead of following a chain of them.
+**
+** When Lua is built with LUA_USE_SHAREDSTRINGS a state can also look up
+** short strings in the frozen string table of a string pool (see
+** lstate.c) before its own table.
+*/
+
 #define lstring_c
 #define LUA_CORE
 
@@ -12,6 +24,10 @@
 
 #include <string.h>
 
+#if defined(LUA_USE_FASTINTERN)
+#include <limits.h>
+#endif
+
 #include "lua.h"
 
 #include "ldebug.h"
@@ -46,9 +62,102 @@ int luaS_eqlngstr (TString *a, TString *b) {
 }
 
 
+#if defined(LUA_USE_FASTINTERN)
+
+/*
+** {==================================================================
+** Word-at-a-time hashing and comparison of short strings
+** ===================================================================
+*/
+
+#define WORDBITS	(sizeof(size_t) * CHAR_BIT)
+
+/*
+** An odd multiplier (from the golden ratio). Machines with 32-bit
+** words only get its low half.
+*/
+#define HASHMUL		((cast(size_t, 0x9E3779B9u) << 16 << 16) | 0x7F4A7C15u)
+
+/*
+** A multiplication only carries bits upwards, and the shift brings the
+** high half back down (tables only use the low bits of a hash).
+*/
+#define mix(h)		((h) *= HASHMUL, (h) ^= (h) >> (WORDBITS / 2))
+
+/* mixes word 'w' into 'h' */
+#define mixword(h,w)	((h) ^= (w), mix(h))
+
+
+/* reads a (possibly unaligned) word; compilers turn this into a load */
+static size_t loadword (const char *p) {
+  size_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+
+/*
+** Short strings are never longer than LUAI_MAXSHORTLEN, and so every
+** byte is hashed (without the stride that long strings use). The last
+** word overlaps the one before it when the length isn't a multiple of
+** the word size, and shorter strings are read in two overlapping
+** halves or as three bytes, so there is never a loop over single bytes.
+*/
+static unsigned int hashshort (const char *str, size_t l,
+                               unsigned int seed) {
+  size_t h = cast(size_t, seed ^ cast(unsigned int, l)) * HASHMUL;
+  if (l >= sizeof(size_t)) {
+    const char *last = str + l - sizeof(size_t);
+    for (; str < last; str += sizeof(size_t))
+      mixword(h, loadword(str));
+    mixword(h, loadword(last));
+  }
+  else if (l >= 4) {  /* (only when words are longer than 4 bytes) */
+    unsigned int first = 0, second = 0;
+    memcpy(&first, str, 4);
+    memcpy(&second, str + l - 4, 4);
+    mixword(h, (cast(size_t, first) << 16 << 16) ^ second);
+  }
+  else if (l > 0)
+    mixword(h, (cast(size_t, cast_byte(str[0])) << 16) |
+               (cast(size_t, cast_byte(str[l >> 1])) << 8) |
+               cast_byte(str[l - 1]));
+  /* mix once more, so that the high bytes of the last word (which only
+     reached the middle of 'h') also reach its low bits */
+  mix(h);
+  return cast(unsigned int, h);
+}
+
+
+/* equality of the contents of two short strings with length 'l' */
+static int eqshortbytes (const char *a, const char *b, size_t l) {
+  if (l >= sizeof(size_t)) {
+    const char *lasta = a + l - sizeof(size_t);
+    const char *lastb = b + l - sizeof(size_t);
+    for (; a < lasta; a += sizeof(size_t), b += sizeof(size_t)) {
+      if (loadword(a) != loadword(b))
+        return 0;
+    }
+    return (loadword(lasta) == loadword(lastb));
+  }
+  else
+    return (memcmp(a, b, l * sizeof(char)) == 0);
+}
+
+/* }================================================================== */
+
+#endif
+
+
 unsigned int luaS_hash (const char *str, size_t l, unsigned int seed) {
-  unsigned int h = seed ^ cast(unsigned int, l);
-  size_t step = (l >> LUAI_HASHLIMIT) + 1;
+  unsigned int h;
+  size_t step;
+#if defined(LUA_USE_FASTINTERN)
+  if (l <= LUAI_MAXSHORTLEN)
+    return hashshort(str, l, seed);
+#endif
+  h = seed ^ cast(unsigned int, l);
+  step = (l >> LUAI_HASHLIMIT) + 1;
   for (; l >= step; l -= step)
     h ^= ((h<<5) + (h>>2) + cast_byte(str[l - 1]));
   return h;
@@ -65,6 +174,59 @@ unsigned int luaS_hashlongstr (TString *ts) {
 }
 
 
+#if defined(LUA_USE_FASTINTERN)
+
+/*
+** {==================================================================
+** Open-addressing string table
+** ===================================================================
+*/
+
+/*
+** A string is at or after its main position (its hash modulo the size)
+** with no empty slot in between, and so a probe sequence ends at the
+** first empty slot. Removing a string moves the strings after it back
+** (see 'luaS_remove') instead of leaving a "removed" marker, so strings
+** that were collected never make probe sequences longer.
+*/
+
+#define nextslot(i,size)	lmod((i) + 1, (size))
+
+/* at most 3/4 of the slots are used */
+#define maxused(size)	((size) - (size) / 4)
+
+
+/*
+** resizes the string table
+*/
+void luaS_resize (lua_State *L, int newsize) {
+  int i;
+  stringtable *tb = &G(L)->strt;
+  StringSlot *newhash = luaM_newvector(L, newsize, StringSlot);
+  lua_assert(tb->nuse < maxused(newsize));
+  for (i = 0; i < newsize; i++) {
+    newhash[i].hash = 0;
+    newhash[i].ts = NULL;
+  }
+  for (i = 0; i < tb->size; i++) {
+    TString *ts = tb->hash[i].ts;
+    if (ts != NULL) {
+      int j = lmod(ts->hash, newsize);
+      while (newhash[j].ts != NULL)
+        j = nextslot(j, newsize);
+      newhash[j].hash = ts->hash;
+      newhash[j].ts = ts;
+    }
+  }
+  luaM_freearray(L, tb->hash, tb->size);
+  tb->hash = newhash;
+  tb->size = newsize;
+}
+
+/* }================================================================== */
+
+#else
+
 /*
 ** resizes the string table
 */
@@ -95,6 +257,8 @@ void luaS_resize (lua_State *L, int newsize) {
   tb->size = newsize;
 }
 
+#endif
+
 
 /*
 ** Clear API string cache. (Entries cannot be empty, so fill them with
@@ -110,6 +274,30 @@ void luaS_clearcache (global_State *g) {
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+/*
+** Makes every short string shared: gray, like a fixed object (so that
+** no collector marks or sweeps it), and with SHAREDBIT set
+*/
+void luaS_share (lua_State *L) {
+  stringtable *tb = &G(L)->strt;
+  int i;
+  for (i = 0; i < tb->size; i++) {
+#if defined(LUA_USE_FASTINTERN)
+    TString *ts = tb->hash[i].ts;
+    if (ts != NULL) {
+#else
+    TString *ts;
+    for (ts = tb->hash[i]; ts != NULL; ts = ts->u.hnext) {
+#endif
+      resetbits(ts->marked, WHITEBITS | bitmask(BLACKBIT));
+      l_setbit(ts->marked, SHAREDBIT);
+    }
+  }
+}
+#endif
+
+
 /*
 ** Initialize the string table and the string cache
 */
@@ -151,6 +339,95 @@ TString *luaS_createlngstrobj (lua_State *L, size_t l) {
 }
 
 
+#if defined(LUA_USE_FASTINTERN)
+
+void luaS_remove (lua_State *L, TString *ts) {
+  stringtable *tb = &G(L)->strt;
+  int i = lmod(ts->hash, tb->size);
+  int j;
+  while (tb->hash[i].ts != ts)  /* find its slot */
+    i = nextslot(i, tb->size);
+  tb->nuse--;
+  /* fill the hole with the next string whose probe sequence goes through
+     it (i.e. whose main position isn't between the hole and the string),
+     which leaves a new hole, until there is an empty slot */
+  for (j = nextslot(i, tb->size); tb->hash[j].ts != NULL;
+       j = nextslot(j, tb->size)) {
+    int mainposition = lmod(tb->hash[j].hash, tb->size);
+    if (i <= j ? (i < mainposition && mainposition <= j)
+               : (i < mainposition || mainposition <= j))
+      continue;  /* string can't move to the hole */
+    tb->hash[i] = tb->hash[j];
+    i = j;
+  }
+  tb->hash[i].ts = NULL;
+}
+
+
+#if defined(LUA_USE_SHAREDSTRINGS)
+/*
+** looks a short string up in the (frozen) string table of a pool
+*/
+static TString *findshared (lua_StringPool *pool, const char *str, size_t l,
+                            unsigned int h) {
+  stringtable *tb = &G(pool->owner)->strt;
+  TString *ts;
+  int i;
+  for (i = lmod(h, tb->size); (ts = tb->hash[i].ts) != NULL;
+       i = nextslot(i, tb->size)) {
+    if (tb->hash[i].hash == h && l == ts->shrlen &&
+        eqshortbytes(str, getstr(ts), l))
+      return ts;
+  }
+  return NULL;
+}
+#endif
+
+
+/*
+** checks whether short string exists and reuses it or creates a new one
+*/
+static TString *internshrstr (lua_State *L, const char *str, size_t l) {
+  TString *ts;
+  global_State *g = G(L);
+  stringtable *tb = &g->strt;
+  unsigned int h = luaS_hash(str, l, g->seed);
+  int i;
+  StringSlot *slot;
+  lua_assert(str != NULL);  /* otherwise 'memcmp'/'memcpy' are undefined */
+#if defined(LUA_USE_SHAREDSTRINGS)
+  if (g->stringpool != NULL &&
+      (ts = findshared(g->stringpool, str, l, h)) != NULL)
+    return ts;
+#endif
+  for (i = lmod(h, tb->size); (ts = (slot = &tb->hash[i])->ts) != NULL;
+       i = nextslot(i, tb->size)) {
+    if (slot->hash == h && l == ts->shrlen &&
+        eqshortbytes(str, getstr(ts), l)) {
+      /* found! */
+      if (isdead(g, ts))  /* dead (but not collected yet)? */
+        changewhite(ts);  /* resurrect it */
+      return ts;
+    }
+  }
+  if (tb->nuse >= maxused(tb->size) && tb->size <= MAX_INT/2)
+    luaS_resize(L, tb->size * 2);
+  ts = createstrobj(L, l, LUA_TSHRSTR, h);
+  memcpy(getstr(ts), str, l * sizeof(char));
+  ts->shrlen = cast_byte(l);
+  /* find the empty slot only now, because creating the string could
+     have run an emergency collection that moved strings */
+  for (i = lmod(h, tb->size); tb->hash[i].ts != NULL;
+       i = nextslot(i, tb->size)) {}
+  tb->hash[i].hash = h;
+  tb->hash[i].ts = ts;
+  if (++tb->nuse > tb->peakuse)
+    tb->peakuse = tb->nuse;
+  return ts;
+}
+
+#else
+
 void luaS_remove (lua_State *L, TString *ts) {
   stringtable *tb = &G(L)->strt;
   TString **p = &tb->hash[lmod(ts->hash, tb->size)];
@@ -161,6 +438,24 @@ void luaS_remove (lua_State *L, TString *ts) {
 }
 
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+/*
+** looks a short string up in the (frozen) string table of a pool
+*/
+static TString *findshared (lua_StringPool *pool, const char *str, size_t l,
+                            unsigned int h) {
+  stringtable *tb = &G(pool->owner)->strt;
+  TString *ts;
+  for (ts = tb->hash[lmod(h, tb->size)]; ts != NULL; ts = ts->u.hnext) {
+    if (l == ts->shrlen &&
+        (memcmp(str, getstr(ts), l * sizeof(char)) == 0))
+      return ts;
+  }
+  return NULL;
+}
+#endif
+
+
 /*
 ** checks whether short string exists and reuses it or creates a new one
 */
@@ -170,6 +465,11 @@ static TString *internshrstr (lua_State *L, const char *str, size_t l) {
   unsigned int h = luaS_hash(str, l, g->seed);
   TString **list = &g->strt.hash[lmod(h, g->strt.size)];
   lua_assert(str != NULL);  /* otherwise 'memcmp'/'memcpy' are undefined */
+#if defined(LUA_USE_SHAREDSTRINGS)
+  if (g->stringpool != NULL &&
+      (ts = findshared(g->stringpool, str, l, h)) != NULL)
+    return ts;
+#endif
   for (ts = *list; ts != NULL; ts = ts->u.hnext) {
     if (l == ts->shrlen &&
         (memcmp(str, getstr(ts), l * sizeof(char)) == 0)) {
@@ -192,6 +492,8 @@ static TString *internshrstr (lua_State *L, const char *str, size_t l) {
   return ts;
 }
 
+#endif
+
 
 /*
 ** new string (with explicit length)
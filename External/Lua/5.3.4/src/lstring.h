@@ -44,6 +44,9 @@ LUAI_FUNC Udata *luaS_newudata (lua_State *L, size_t s);
 LUAI_FUNC TString *luaS_newlstr (lua_State *L, const char *str, size_t l);
 LUAI_FUNC TString *luaS_new (lua_State *L, const char *str);
 LUAI_FUNC TString *luaS_createlngstrobj (lua_State *L, size_t l);
+#if defined(LUA_USE_SHAREDSTRINGS)
+LUAI_FUNC void luaS_share (lua_State *L);
+#endif
 
 
 #endif
@@ -21,11 +21,27 @@
 ** in its main position (i.e. the 'original' position that its hash gives
 ** to it), then the colliding element is in its own main position.
 ** Hence even when the load factor reaches 100%, performance remains good.
+**
+** When Lua is built with LUA_USE_HASHGROUPS the hash part uses open
+** addressing instead (see "Hash groups" below), with one control byte
+** per node kept in a separate compact array.
 */
 
 #include <math.h>
 #include <limits.h>
 
+#if defined(LUA_USE_HASHGROUPS)
+#include <string.h>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LUAI_HASHGROUPS_SSE2
+#endif
+#if defined(_MSC_VER) && !defined(__GNUC__)
+#include <intrin.h>
+#endif
+#endif
+
 #include "lua.h"
 
 #include "ldebug.h"
@@ -55,6 +71,8 @@
 #define MAXHBITS	(MAXABITS - 1)
 
 
+#if !defined(LUA_USE_HASHGROUPS)
+
 #define hashpow2(t,n)		(gnode(t, lmod((n), sizenode(t))))
 
 #define hashstr(t,str)		hashpow2(t, (str)->hash)
@@ -72,6 +90,9 @@
 #define hashpointer(t,p)	hashmod(t, point2uint(p))
 
 
+#endif
+
+
 #define dummynode		(&dummynode_)
 
 static const Node dummynode_ = {
@@ -110,6 +131,8 @@ static int l_hashfloat (lua_Number n) {
 #endif
 
 
+#if !defined(LUA_USE_HASHGROUPS)
+
 /*
 ** returns the 'main' position of an element in a table (that is, the index
 ** of its hash value)
@@ -136,6 +159,244 @@ static Node *mainposition (const Table *t, const TValue *key) {
   }
 }
 
+#else
+
+/*
+** {=============================================================
+** Hash groups
+** ==============================================================
+*/
+
+/*
+** With LUA_USE_HASHGROUPS the hash part is an open-addressing table
+** in the style of "SwissTable". Besides the nodes, each table has an
+** array 'ctrl' with one control byte per node: either CTRL_EMPTY (the
+** node has never held a key) or the top 7 bits of the hash of the
+** node's key (its 'tag'). The nodes are split in groups of GROUPWIDTH
+** consecutive nodes, and a lookup compares the key's tag with the
+** whole group of control bytes at once (with SSE2 when it is available).
+** Only the nodes whose tags match are read, and so most misses and
+** collisions don't touch the nodes at all. A key is searched for in
+** its first group (chosen by its hash) and then in the following
+** groups of a triangular probe sequence (which visits every group),
+** until a group that has an empty node.
+**
+** Keys are never removed from the hash part (as with chaining, a key
+** whose value becomes nil stays until the next rehash), and so there
+** is no need for tombstones. To keep the probe sequences short, at
+** most 7/8 of the nodes of a table with more than one group can be
+** used ('growthleft' counts how many more keys fit). A table smaller
+** than a group has a single group that is padded with empty control
+** bytes, which can't be used but end every probe.
+*/
+
+#define CTRL_EMPTY	0x80
+
+#if defined(LUAI_HASHGROUPS_SSE2)
+#define GROUPWIDTH	16
+#else
+#define GROUPWIDTH	8
+#endif
+
+/* a bit mask of nodes in a group (bit 'i' is node 'i' in the group) */
+typedef unsigned int GroupMask;
+
+
+/* number of control bytes; a small table still has a whole group */
+#define sizectrl(size)	((size) < GROUPWIDTH ? GROUPWIDTH : (size))
+
+/* mask to choose a group of 't' */
+#define lastgroup(t)	(cast(unsigned int, sizenode(t) - 1) / GROUPWIDTH)
+
+/* how many keys a hash part with 'size' nodes can hold */
+#define maxgrowth(size)	((size) < GROUPWIDTH ? (size) : (size) - (size) / 8)
+
+
+/*
+** Every hash is mixed with a multiplication (Fibonacci hashing) so that
+** keys like consecutive integers or aligned pointers still spread over
+** all of the groups and get different tags. The tag comes from the top
+** 7 bits of the mixed hash, and the group from the bits below them
+** (rotated, so that the largest tables can use every bit).
+*/
+#define mixhash(h)	((cast(unsigned int, h) * 0x9E3779B1u) & 0xFFFFFFFFu)
+#define hashtag(h)	cast_byte(((h) >> 25) & 0x7F)
+#define hashgroup(h)	((h) >> 7 | (h) << 25)
+
+/* the hash of an integer uses all of its bits */
+#define hashint(i)	mixhash(l_castS2U(i) ^ (l_castS2U(i) >> 16 >> 16))
+#define hashpointer(p)	mixhash(point2uint(p))
+
+
+#if defined(__GNUC__)
+#define lowestbit(m)	__builtin_ctz(m)
+#elif defined(_MSC_VER)
+static int lowestbit (GroupMask m) {
+  unsigned long i;
+  _BitScanForward(&i, m);
+  return cast_int(i);
+}
+#else
+static int lowestbit (GroupMask m) {
+  int i = 0;
+  for (; (m & 1) == 0; m >>= 1) i++;
+  return i;
+}
+#endif
+
+
+#if defined(LUAI_HASHGROUPS_SSE2)
+
+static GroupMask matchtag (const lu_byte *ctrl, lu_byte tag) {
+  __m128i group = _mm_loadu_si128(cast(const __m128i *, ctrl));
+  __m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8(cast(char, tag)));
+  return cast(GroupMask, _mm_movemask_epi8(match));
+}
+
+/* CTRL_EMPTY is the only control byte with its top bit set */
+static GroupMask matchempty (const lu_byte *ctrl) {
+  __m128i group = _mm_loadu_si128(cast(const __m128i *, ctrl));
+  return cast(GroupMask, _mm_movemask_epi8(group));
+}
+
+#else
+
+static GroupMask matchtag (const lu_byte *ctrl, lu_byte tag) {
+  GroupMask m = 0;
+  int i;
+  for (i = 0; i < GROUPWIDTH; i++)
+    m |= cast(GroupMask, ctrl[i] == tag) << i;
+  return m;
+}
+
+static GroupMask matchempty (const lu_byte *ctrl) {
+  GroupMask m = 0;
+  int i;
+  for (i = 0; i < GROUPWIDTH; i++)
+    m |= cast(GroupMask, ctrl[i] >> 7) << i;
+  return m;
+}
+
+#endif
+
+
+/* the control bytes of the dummy node: a lookup ends right away */
+LUAI_DDEF const lu_byte luaH_dummyctrl[GROUPWIDTH] = {
+  CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+  CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY
+#if GROUPWIDTH > 8
+  , CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+  CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY
+#endif
+};
+
+
+/*
+** returns the mixed hash of a key (which is not a dead key)
+*/
+static unsigned int hashkey (const TValue *key) {
+  switch (ttype(key)) {
+    case LUA_TNUMINT:
+      return hashint(ivalue(key));
+    case LUA_TNUMFLT:
+      return mixhash(l_hashfloat(fltvalue(key)));
+    case LUA_TSHRSTR:
+      return mixhash(tsvalue(key)->hash);
+    case LUA_TLNGSTR:
+      return mixhash(luaS_hashlongstr(tsvalue(key)));
+    case LUA_TBOOLEAN:
+      return mixhash(bvalue(key));
+    case LUA_TLIGHTUSERDATA:
+      return hashpointer(pvalue(key));
+    case LUA_TLCF:
+      return hashpointer(fvalue(key));
+    default:
+      lua_assert(!ttisdeadkey(key));
+      return hashpointer(gcvalue(key));
+  }
+}
+
+
+/*
+** State of a search for a key: the nodes of the current group that
+** have the key's tag and haven't been compared yet
+*/
+typedef struct Probe {
+  const lu_byte *ctrl;  /* control bytes of the current group */
+  GroupMask candidates;
+  unsigned int group;
+  unsigned int lastgroup;  /* mask to choose a group */
+  unsigned int step;
+  int found;  /* index in the group of the last candidate */
+  lu_byte tag;
+} Probe;
+
+
+static void startprobe (const Table *t, unsigned int h, Probe *p) {
+  p->tag = hashtag(h);
+  p->lastgroup = lastgroup(t);
+  p->group = hashgroup(h) & p->lastgroup;
+  p->step = 0;
+  p->ctrl = t->ctrl + p->group * GROUPWIDTH;
+  p->candidates = matchtag(p->ctrl, p->tag);
+}
+
+
+/*
+** moves a probe on to the next group that has nodes with its tag;
+** returns 0 when the key is not in the table
+*/
+static int nextgroup (const Table *t, Probe *p) {
+  do {
+    if (matchempty(p->ctrl) != 0)  /* group has an empty node? */
+      return 0;  /* key would have been inserted here */
+    p->group = (p->group + ++p->step) & p->lastgroup;
+    p->ctrl = t->ctrl + p->group * GROUPWIDTH;
+    p->candidates = matchtag(p->ctrl, p->tag);
+  } while (p->candidates == 0);
+  return 1;
+}
+
+
+/*
+** returns the next node that may hold the key being searched for, or
+** NULL when the key is not in the table (a macro, so that a key that is
+** in its first group is found without any calls)
+*/
+#define nextcandidate(t,p)  \
+	(((p)->candidates != 0 || nextgroup(t, p)) \
+	  ? ((p)->found = lowestbit((p)->candidates), \
+	     (p)->candidates &= (p)->candidates - 1, \
+	     gnode(t, (p)->group * GROUPWIDTH + (p)->found)) \
+	  : NULL)
+
+
+/*
+** returns the first empty node in the probe sequence of hash 'h' and
+** marks it as used (the table must still have room for a new key)
+*/
+static Node *useemptynode (Table *t, unsigned int h) {
+  unsigned int mask = lastgroup(t);
+  unsigned int group = hashgroup(h) & mask;
+  unsigned int step = 0;
+  /* the padding of a small table can't be used */
+  GroupMask usable = (sizenode(t) < GROUPWIDTH)
+                   ? (cast(GroupMask, 1) << sizenode(t)) - 1 : ~cast(GroupMask, 0);
+  GroupMask empty;
+  int i;
+  lua_assert(t->growthleft > 0);
+  while ((empty = matchempty(t->ctrl + group * GROUPWIDTH) & usable) == 0)
+    group = (group + ++step) & mask;
+  i = cast_int(group * GROUPWIDTH) + lowestbit(empty);
+  t->ctrl[i] = hashtag(h);
+  t->growthleft--;
+  return gnode(t, i);
+}
+
+/* }============================================================= */
+
+#endif
+
 
 /*
 ** returns the index for 'key' if 'key' is an appropriate key to live in
@@ -163,6 +424,22 @@ static unsigned int findindex (lua_State *L, Table *t, StkId key) {
   if (i != 0 && i <= t->sizearray)  /* is 'key' inside array part? */
     return i;  /* yes; that's the index */
   else {
+#if defined(LUA_USE_HASHGROUPS)
+    Probe p;
+    Node *n;
+    startprobe(t, hashkey(key), &p);
+    while ((n = nextcandidate(t, &p)) != NULL) {
+      /* key may be dead already, but it is ok to use it in 'next' */
+      if (luaV_rawequalobj(gkey(n), key) ||
+            (ttisdeadkey(gkey(n)) && iscollectable(key) &&
+             deadvalue(gkey(n)) == gcvalue(key))) {
+        i = cast_int(n - gnode(t, 0));  /* key index in hash table */
+        /* hash elements are numbered after array ones */
+        return (i + 1) + t->sizearray;
+      }
+    }
+    luaG_runerror(L, "invalid key to 'next'");  /* key not found */
+#else
     int nx;
     Node *n = mainposition(t, key);
     for (;;) {  /* check whether 'key' is somewhere in the chain */
@@ -179,6 +456,7 @@ static unsigned int findindex (lua_State *L, Table *t, StkId key) {
         luaG_runerror(L, "invalid key to 'next'");  /* key not found */
       else n += nx;
     }
+#endif
   }
 }
 
@@ -305,6 +583,54 @@ static void setarrayvector (lua_State *L, Table *t, unsigned int size) {
 }
 
 
+#if defined(LUA_USE_HASHGROUPS)
+
+/* size of the block with the nodes and the control bytes of a hash part */
+#define sizehashpart(size)  \
+	((size) * sizeof(Node) + cast(size_t, sizectrl(size)) * sizeof(lu_byte))
+
+/*
+** The nodes and their control bytes are allocated together. 'size' is
+** the number of keys that the hash part must hold.
+*/
+static void setnodevector (lua_State *L, Table *t, unsigned int size) {
+  if (size == 0) {  /* no elements to hash part? */
+    t->node = cast(Node *, dummynode);  /* use common 'dummynode' */
+    t->lsizenode = 0;
+    t->ctrl = cast(lu_byte *, luaH_dummyctrl);  /* signal dummy node */
+    t->growthleft = 0;
+  }
+  else {
+    int i;
+    int lsize = luaO_ceillog2(size);
+    if (lsize <= MAXHBITS && cast(unsigned int, maxgrowth(twoto(lsize))) < size)
+      lsize++;  /* keep some nodes empty */
+    if (lsize > MAXHBITS)
+      luaG_runerror(L, "table overflow");
+    size = twoto(lsize);
+    if (size > (MAX_SIZET - sizectrl(size)) / sizeof(Node))
+      luaM_toobig(L);
+    t->node = cast(Node *, luaM_malloc(L, sizehashpart(size)));
+    t->ctrl = cast(lu_byte *, t->node + size);
+    for (i = 0; i < (int)size; i++) {
+      Node *n = gnode(t, i);
+      gnext(n) = 0;
+      setnilvalue(wgkey(n));
+      setnilvalue(gval(n));
+    }
+    memset(t->ctrl, CTRL_EMPTY, sizectrl(size));
+    t->lsizenode = cast_byte(lsize);
+    t->growthleft = maxgrowth(size);
+  }
+}
+
+
+static void freenodevector (lua_State *L, Node *node, int size) {
+  luaM_freemem(L, node, sizehashpart(cast(size_t, size)));
+}
+
+#else
+
 static void setnodevector (lua_State *L, Table *t, unsigned int size) {
   if (size == 0) {  /* no elements to hash part? */
     t->node = cast(Node *, dummynode);  /* use common 'dummynode' */
@@ -330,6 +656,11 @@ static void setnodevector (lua_State *L, Table *t, unsigned int size) {
 }
 
 
+#define freenodevector(L,node,size)	luaM_freearray(L, node, cast(size_t, size))
+
+#endif
+
+
 void luaH_resize (lua_State *L, Table *t, unsigned int nasize,
                                           unsigned int nhsize) {
   unsigned int i;
@@ -361,12 +692,17 @@ void luaH_resize (lua_State *L, Table *t, unsigned int nasize,
     }
   }
   if (oldhsize > 0)  /* not the dummy node? */
-    luaM_freearray(L, nold, cast(size_t, oldhsize)); /* free old hash */
+    freenodevector(L, nold, oldhsize); /* free old hash */
 }
 
 
 void luaH_resizearray (lua_State *L, Table *t, unsigned int nasize) {
+#if defined(LUA_USE_HASHGROUPS)
+  /* keep the same number of nodes (not all of them can hold keys) */
+  int nsize = isdummy(t) ? 0 : maxgrowth(sizenode(t));
+#else
   int nsize = allocsizenode(t);
+#endif
   luaH_resize(L, t, nasize, nsize);
 }
 
@@ -413,12 +749,45 @@ Table *luaH_new (lua_State *L) {
 
 void luaH_free (lua_State *L, Table *t) {
   if (!isdummy(t))
-    luaM_freearray(L, t->node, cast(size_t, sizenode(t)));
+    freenodevector(L, t->node, sizenode(t));
   luaM_freearray(L, t->array, t->sizearray);
   luaM_free(L, t);
 }
 
 
+#if defined(LUA_USE_HASHGROUPS)
+
+/*
+** inserts a new key into a hash table; the key goes into the first empty
+** node of its probe sequence. When the table is full, it is rehashed.
+*/
+TValue *luaH_newkey (lua_State *L, Table *t, const TValue *key) {
+  Node *f;
+  TValue aux;
+  if (ttisnil(key)) luaG_runerror(L, "table index is nil");
+  else if (ttisfloat(key)) {
+    lua_Integer k;
+    if (luaV_tointeger(key, &k, 0)) {  /* does index fit in an integer? */
+      setivalue(&aux, k);
+      key = &aux;  /* insert it as an integer */
+    }
+    else if (luai_numisnan(fltvalue(key)))
+      luaG_runerror(L, "table index is NaN");
+  }
+  if (t->growthleft == 0) {  /* cannot find a free place? */
+    rehash(L, t, key);  /* grow table */
+    /* whatever called 'newkey' takes care of TM cache */
+    return luaH_set(L, t, key);  /* insert key into grown table */
+  }
+  f = useemptynode(t, hashkey(key));
+  setnodekey(L, &f->i_key, key);
+  luaC_barrierback(L, t, key);
+  lua_assert(ttisnil(gval(f)));
+  return gval(f);
+}
+
+#else
+
 static Node *getfreepos (Table *t) {
   if (!isdummy(t)) {
     while (t->lastfree > t->node) {
@@ -490,6 +859,8 @@ TValue *luaH_newkey (lua_State *L, Table *t, const TValue *key) {
   return gval(mp);
 }
 
+#endif
+
 
 /*
 ** search function for integers
@@ -499,6 +870,15 @@ const TValue *luaH_getint (Table *t, lua_Integer key) {
   if (l_castS2U(key) - 1 < t->sizearray)
     return &t->array[key - 1];
   else {
+#if defined(LUA_USE_HASHGROUPS)
+    Probe p;
+    Node *n;
+    startprobe(t, hashint(key), &p);
+    while ((n = nextcandidate(t, &p)) != NULL) {
+      if (ttisinteger(gkey(n)) && ivalue(gkey(n)) == key)
+        return gval(n);  /* that's it */
+    }
+#else
     Node *n = hashint(t, key);
     for (;;) {  /* check whether 'key' is somewhere in the chain */
       if (ttisinteger(gkey(n)) && ivalue(gkey(n)) == key)
@@ -509,6 +889,7 @@ const TValue *luaH_getint (Table *t, lua_Integer key) {
         n += nx;
       }
     }
+#endif
     return luaO_nilobject;
   }
 }
@@ -517,6 +898,39 @@ const TValue *luaH_getint (Table *t, lua_Integer key) {
 /*
 ** search function for short strings
 */
+#if defined(LUA_USE_HASHGROUPS)
+
+const TValue *luaH_getshortstr (Table *t, TString *key) {
+  Probe p;
+  Node *n;
+  lua_assert(key->tt == LUA_TSHRSTR);
+  startprobe(t, mixhash(key->hash), &p);
+  while ((n = nextcandidate(t, &p)) != NULL) {
+    const TValue *k = gkey(n);
+    if (ttisshrstring(k) && eqshrstr(tsvalue(k), key))
+      return gval(n);  /* that's it */
+  }
+  return luaO_nilobject;  /* not found */
+}
+
+
+/*
+** "Generic" get version. (Not that generic: not valid for integers,
+** which may be in array part, nor for floats with integral values.)
+*/
+static const TValue *getgeneric (Table *t, const TValue *key) {
+  Probe p;
+  Node *n;
+  startprobe(t, hashkey(key), &p);
+  while ((n = nextcandidate(t, &p)) != NULL) {
+    if (luaV_rawequalobj(gkey(n), key))
+      return gval(n);  /* that's it */
+  }
+  return luaO_nilobject;  /* not found */
+}
+
+#else
+
 const TValue *luaH_getshortstr (Table *t, TString *key) {
   Node *n = hashstr(t, key);
   lua_assert(key->tt == LUA_TSHRSTR);
@@ -552,6 +966,8 @@ static const TValue *getgeneric (Table *t, const TValue *key) {
   }
 }
 
+#endif
+
 
 const TValue *luaH_getstr (Table *t, TString *key) {
   if (key->tt == LUA_TSHRSTR)
@@ -660,10 +1076,21 @@ int luaH_getn (Table *t) {
 
 #if defined(LUA_DEBUG)
 
+#if defined(LUA_USE_HASHGROUPS)
+
+/* (with hash groups this is the first node of the key's first group) */
+Node *luaH_mainposition (const Table *t, const TValue *key) {
+  return gnode(t, (hashgroup(hashkey(key)) & lastgroup(t)) * GROUPWIDTH);
+}
+
+#else
+
 Node *luaH_mainposition (const Table *t, const TValue *key) {
   return mainposition(t, key);
 }
 
+#endif
+
 int luaH_isdummy (const Table *t) { return isdummy(t); }
 
 #endif
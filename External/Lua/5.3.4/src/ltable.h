@@ -28,7 +28,12 @@
 
 
 /* true when 't' is using 'dummynode' as its hash part */
+#if defined(LUA_USE_HASHGROUPS)
+#define isdummy(t)		((t)->ctrl == luaH_dummyctrl)
+LUAI_DDEC const lu_byte luaH_dummyctrl[];
+#else
 #define isdummy(t)		((t)->lastfree == NULL)
+#endif
 
 
 /* allocated size for hash nodes */
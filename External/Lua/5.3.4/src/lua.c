@@ -129,7 +129,7 @@ static void laction (int i) {
 
 static void print_usage (const char *badoption) {
   lua_writestringerror("%s: ", progname);
-  if (badoption[1] == 'e' || badoption[1] == 'l')
+  if (badoption[1] == 'e' || badoption[1] == 'l' || badoption[1] == 'p')
     lua_writestringerror("'%s' needs argument\n", badoption);
   else
     lua_writestringerror("unrecognized option '%s'\n", badoption);
@@ -139,6 +139,7 @@ static void print_usage (const char *badoption) {
   "  -e stat  execute string 'stat'\n"
   "  -i       enter interactive mode after executing 'script'\n"
   "  -l name  require library 'name'\n"
+  "  -p file  profile 'script', writing folded stacks to 'file'\n"
   "  -v       show version information\n"
   "  -E       ignore environment variables\n"
   "  --       stop handling options\n"
@@ -267,6 +268,33 @@ static int dolibrary (lua_State *L, const char *name) {
 }
 
 
+/*
+** Calls 'require(LUA_PROFILERLIBNAME)[fname](filename)' (without
+** 'filename' if it is NULL). A function that fails returning nil plus
+** a message (like 'dump') also counts as an error.
+*/
+static int doprofiler (lua_State *L, const char *fname, const char *filename) {
+  int status;
+  lua_getglobal(L, "require");
+  lua_pushliteral(L, LUA_PROFILERLIBNAME);
+  status = docall(L, 1, 1);  /* call 'require(LUA_PROFILERLIBNAME)' */
+  if (status == LUA_OK) {
+    lua_getfield(L, -1, fname);
+    lua_remove(L, -2);  /* remove library */
+    if (filename != NULL) lua_pushstring(L, filename);
+    status = docall(L, (filename != NULL), 2);
+    if (status == LUA_OK) {
+      if (lua_isnil(L, -2) && lua_isstring(L, -1)) {  /* failed? */
+        lua_remove(L, -2);  /* leave only the message */
+        status = LUA_ERRRUN;
+      }
+      else lua_pop(L, 2);  /* remove results */
+    }
+  }
+  return report(L, status);
+}
+
+
 /*
 ** Returns the string to be used as a prompt by the interpreter.
 */
@@ -491,7 +519,7 @@ static int collectargs (char **argv, int *first) {
         break;
       case 'e':
         args |= has_e;  /* FALLTHROUGH */
-      case 'l':  /* both options need an argument */
+      case 'l': case 'p':  /* these options need an argument */
         if (argv[i][2] == '\0') {  /* no concatenated argument? */
           i++;  /* try next 'argv' */
           if (argv[i] == NULL || argv[i][0] == '-')
@@ -526,11 +554,32 @@ static int runargs (lua_State *L, char **argv, int n) {
                : dolibrary(L, extra);
       if (status != LUA_OK) return 0;
     }
+    else if (option == 'p' && argv[i][2] == '\0')
+      i++;  /* skip its argument */
   }
   return 1;
 }
 
 
+/*
+** Returns the file given with option 'p' (the last one, if there are
+** several), or NULL if there is none
+*/
+static const char *profilefile (char **argv, int n) {
+  const char *filename = NULL;
+  int i;
+  for (i = 1; i < n; i++) {
+    int option = argv[i][1];
+    const char *extra = argv[i] + 2;
+    if (option == 'e' || option == 'l' || option == 'p') {
+      if (*extra == '\0') extra = argv[++i];
+      if (option == 'p') filename = extra;
+    }
+  }
+  return filename;
+}
+
+
 
 static int handle_luainit (lua_State *L) {
   const char *name = "=" LUA_INITVARVERSION;
@@ -556,6 +605,7 @@ static int pmain (lua_State *L) {
   char **argv = (char **)lua_touserdata(L, 2);
   int script;
   int args = collectargs(argv, &script);
+  const char *profile;
   luaL_checkversion(L);  /* check that interpreter has correct version */
   if (argv[0] && argv[0][0]) progname = argv[0];
   if (args == has_error) {  /* bad arg? */
@@ -576,7 +626,18 @@ static int pmain (lua_State *L) {
   }
   if (!runargs(L, argv, script))  /* execute arguments -e and -l */
     return 0;  /* something failed */
-  if (script < argc &&  /* execute main script (if there is one) */
+  profile = profilefile(argv, script);
+  if (profile != NULL) {  /* option '-p'? */
+    int status;
+    if (doprofiler(L, "start", NULL) != LUA_OK)
+      return 0;
+    status = (script < argc) ? handle_script(L, argv + script) : LUA_OK;
+    /* write the samples even if the script failed */
+    if (doprofiler(L, "stop", NULL) != LUA_OK ||
+        doprofiler(L, "dump", profile) != LUA_OK || status != LUA_OK)
+      return 0;
+  }
+  else if (script < argc &&  /* execute main script (if there is one) */
       handle_script(L, argv + script) != LUA_OK)
     return 0;
   if (args & has_i)  /* -i option? */
@@ -146,6 +146,18 @@ LUA_API lua_State *(lua_newstate) (lua_Alloc f, void *ud);
 LUA_API void       (lua_close) (lua_State *L);
 LUA_API lua_State *(lua_newthread) (lua_State *L);
 
+#if defined(LUA_USE_SHAREDSTRINGS)
+/*
+** shared string pools (see lstate.c)
+*/
+typedef struct lua_StringPool lua_StringPool;
+
+LUA_API lua_StringPool *(lua_newstringpool) (lua_State *L);
+LUA_API void (lua_closestringpool) (lua_StringPool *pool);
+LUA_API lua_State *(lua_newstatewithpool) (lua_Alloc f, void *ud,
+                                           lua_StringPool *pool);
+#endif
+
 LUA_API lua_CFunction (lua_atpanic) (lua_State *L, lua_CFunction panicf);
 
 
@@ -307,11 +319,51 @@ LUA_API int (lua_isyieldable) (lua_State *L);
 #define LUA_GCSTEP		5
 #define LUA_GCSETPAUSE		6
 #define LUA_GCSETSTEPMUL	7
+#define LUA_GCSETMAJORINC	8
 #define LUA_GCISRUNNING		9
+#define LUA_GCGEN		10
+#define LUA_GCINC		11
+#define LUA_GCSTATS		12
+#define LUA_GCSTEPTIME		13
 
 LUA_API int (lua_gc) (lua_State *L, int what, int data);
 
 
+/*
+** GC telemetry: while LUA_GCSTATS is on, the collector records what it
+** did in each of its states during the last LUA_GCSTATSCYCLES cycles.
+** Times are wall-clock times in nanoseconds. A "pause" is one call into
+** the collector (a step, a full collection, etc.); the histogram counts
+** pauses shorter than 1us in bucket 0, between 2^(i-1) and 2^i us in
+** bucket i, and the longest ones in the last bucket.
+*/
+#define LUA_GCSTATSCYCLES	16
+#define LUA_NUMGCSTATES		8	/* one for each state in 'lgc.h' */
+#define LUA_GCSTATSBUCKETS	16
+
+typedef struct lua_GCStateStats {
+  lua_Integer steps;  /* number of single steps done in this state */
+  lua_Integer time;  /* total time spent in this state */
+  lua_Integer maxtime;  /* longest time in this state during one pause */
+  lua_Integer traversed;  /* bytes traversed (marking states only) */
+  lua_Integer swept;  /* objects visited by the sweep */
+  lua_Integer freed;  /* objects freed by the sweep */
+  lua_Integer finalized;  /* finalizers run */
+} lua_GCStateStats;
+
+typedef struct lua_GCCycleStats {
+  lua_Integer cycle;  /* number of the cycle (the first one is 1) */
+  lua_Integer memory;  /* bytes in use when the cycle finished */
+  lua_Integer pauses;  /* number of pauses that started in this cycle */
+  lua_Integer pausetime;  /* total time of those pauses */
+  lua_Integer maxpause;  /* longest of those pauses */
+  lua_Integer histogram[LUA_GCSTATSBUCKETS];  /* pause durations */
+  lua_GCStateStats states[LUA_NUMGCSTATES];
+} lua_GCCycleStats;
+
+LUA_API int (lua_getgcstats) (lua_State *L, int n, lua_GCCycleStats *stats);
+
+
 /*
 ** miscellaneous functions
 */
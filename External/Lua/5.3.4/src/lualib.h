@@ -47,6 +47,12 @@ LUAMOD_API int (luaopen_debug) (lua_State *L);
 #define LUA_LOADLIBNAME	"package"
 LUAMOD_API int (luaopen_package) (lua_State *L);
 
+#define LUA_PROFILERLIBNAME	"profiler"
+LUAMOD_API int (luaopen_profiler) (lua_State *L);
+
+#define LUA_CHANNELLIBNAME	"channel"
+LUAMOD_API int (luaopen_channel) (lua_State *L);
+
 
 /* open all previous libraries */
 LUALIB_API void (luaL_openlibs) (lua_State *L);
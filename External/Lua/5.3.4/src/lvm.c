@@ -762,10 +762,31 @@ void luaV_finishOp (lua_State *L) {
   lua_assert(base <= L->top && L->top < L->stack + L->stacksize); \
 }
 
+/*
+** LUA_USE_JUMPTABLE (GCC and Clang only) replaces the 'switch' with
+** "labels as values": each opcode's code ends with its own indirect
+** jump through 'disptab' to the next opcode's code. Each jump then has
+** its own entry in the branch predictor, instead of every opcode
+** sharing the single jump of the 'switch'.
+*/
+#if defined(LUA_USE_JUMPTABLE)
+
+#if !defined(__GNUC__)
+#error "LUA_USE_JUMPTABLE needs a compiler with labels as values (GCC or Clang)"
+#endif
+
+#define vmdispatch(o)	goto *disptab[o];
+#define vmcase(l)	L_##l:
+#define vmbreak		vmfetch(); vmdispatch(GET_OPCODE(i))
+
+#else
+
 #define vmdispatch(o)	switch(o)
 #define vmcase(l)	case l:
 #define vmbreak		break
 
+#endif
+
 
 /*
 ** copy of 'luaV_gettable', but protecting the call to potential
@@ -788,6 +809,22 @@ void luaV_execute (lua_State *L) {
   LClosure *cl;
   TValue *k;
   StkId base;
+#if defined(LUA_USE_JUMPTABLE)
+  /* one label for each opcode, in the same order as 'OpCode' */
+  static const void *const disptab[NUM_OPCODES] = {
+    &&L_OP_MOVE, &&L_OP_LOADK, &&L_OP_LOADKX, &&L_OP_LOADBOOL,
+    &&L_OP_LOADNIL, &&L_OP_GETUPVAL, &&L_OP_GETTABUP, &&L_OP_GETTABLE,
+    &&L_OP_SETTABUP, &&L_OP_SETUPVAL, &&L_OP_SETTABLE, &&L_OP_NEWTABLE,
+    &&L_OP_SELF, &&L_OP_ADD, &&L_OP_SUB, &&L_OP_MUL, &&L_OP_MOD,
+    &&L_OP_POW, &&L_OP_DIV, &&L_OP_IDIV, &&L_OP_BAND, &&L_OP_BOR,
+    &&L_OP_BXOR, &&L_OP_SHL, &&L_OP_SHR, &&L_OP_UNM, &&L_OP_BNOT,
+    &&L_OP_NOT, &&L_OP_LEN, &&L_OP_CONCAT, &&L_OP_JMP, &&L_OP_EQ,
+    &&L_OP_LT, &&L_OP_LE, &&L_OP_TEST, &&L_OP_TESTSET, &&L_OP_CALL,
+    &&L_OP_TAILCALL, &&L_OP_RETURN, &&L_OP_FORLOOP, &&L_OP_FORPREP,
+    &&L_OP_TFORCALL, &&L_OP_TFORLOOP, &&L_OP_SETLIST, &&L_OP_CLOSURE,
+    &&L_OP_VARARG, &&L_OP_EXTRAARG
+  };
+#endif
   ci->callstatus |= CIST_FRESH;  /* fresh invocation of 'luaV_execute" */
  newframe:  /* reentry point when frame changes (call/return) */
   lua_assert(ci == L->ci);
@@ -0,0 +1,295 @@
+// Include Files
+//==============
+
+#include "BuildBinaryAsset.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/BinaryAssets/Format.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	namespace Format = eae6320::BinaryAssets::Format;
+
+	class cBuilder
+	{
+		// Interface
+		//==========
+
+	public:
+
+		eae6320::cResult BuildValue( lua_State& io_luaState, const int i_index, const uint32_t i_depth, Format::sValue& o_value );
+
+		cBuilder( std::vector<uint8_t>& io_data ) : m_data( io_data ) {}
+
+		// Implementation
+		//===============
+
+	private:
+
+		eae6320::cResult BuildTable( lua_State& io_luaState, const int i_index, const uint32_t i_depth, Format::sValue& o_value );
+		// Every string is only stored once
+		eae6320::cResult WriteString( const char* const i_string, const size_t i_length, uint32_t& o_offset );
+		// Adds zeroed space to the end of the data and returns its offset
+		eae6320::cResult Allocate( const uint64_t i_size, const uint32_t i_alignment, uint32_t& o_offset );
+
+		// Data
+		//=====
+
+	private:
+
+		std::vector<uint8_t>& m_data;
+		std::unordered_map<std::string, uint32_t> m_stringOffsets;
+	};
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::BinaryAssetCompiler::BuildBinaryAsset( lua_State& io_luaState, const int i_tableIndex, std::vector<uint8_t>& o_data )
+{
+	auto result = Results::Success;
+
+	o_data.clear();
+	cBuilder builder( o_data );
+
+	// The header is at the start of the file, but its root value can't be filled in until the table has been built
+	Format::sHeader header{};
+	std::memcpy( header.magic, Format::s_magic, sizeof( header.magic ) );
+	header.version = Format::s_version;
+	o_data.resize( sizeof( header ), 0 );
+	if ( !( result = builder.BuildValue( io_luaState, lua_absindex( &io_luaState, i_tableIndex ), 0, header.root ) ) )
+	{
+		o_data.clear();
+		return result;
+	}
+	header.size = static_cast<uint32_t>( o_data.size() );
+	std::memcpy( o_data.data(), &header, sizeof( header ) );
+
+	return result;
+}
+
+// Helper Class Definition
+//========================
+
+namespace
+{
+	// Interface
+	//==========
+
+	eae6320::cResult cBuilder::BuildValue( lua_State& io_luaState, const int i_index, const uint32_t i_depth, Format::sValue& o_value )
+	{
+		auto result = eae6320::Results::Success;
+
+		std::memset( &o_value, 0, sizeof( o_value ) );
+		switch ( lua_type( &io_luaState, i_index ) )
+		{
+		case LUA_TNIL:
+			o_value.type = Format::eType::Nil;
+			break;
+		case LUA_TBOOLEAN:
+			o_value.type = Format::eType::Boolean;
+			o_value.boolean = ( lua_toboolean( &io_luaState, i_index ) != 0 ) ? 1 : 0;
+			break;
+		case LUA_TNUMBER:
+			// Integers and floats are kept separate so that the value doesn't change
+			if ( lua_isinteger( &io_luaState, i_index ) )
+			{
+				o_value.type = Format::eType::Integer;
+				o_value.integer = static_cast<int64_t>( lua_tointeger( &io_luaState, i_index ) );
+			}
+			else
+			{
+				o_value.type = Format::eType::Number;
+				o_value.number = static_cast<double>( lua_tonumber( &io_luaState, i_index ) );
+			}
+			break;
+		case LUA_TSTRING:
+			{
+				o_value.type = Format::eType::String;
+				size_t length;
+				const auto* const value = lua_tolstring( &io_luaState, i_index, &length );
+				o_value.length = static_cast<uint32_t>( length );
+				result = WriteString( value, length, o_value.offset );
+			}
+			break;
+		case LUA_TTABLE:
+			result = BuildTable( io_luaState, i_index, i_depth, o_value );
+			break;
+		default:
+			result = eae6320::Results::InvalidFile;
+			std::cerr << "Asset values can't be a " << luaL_typename( &io_luaState, i_index ) << std::endl;
+		}
+
+		return result;
+	}
+
+	// Implementation
+	//===============
+
+	eae6320::cResult cBuilder::BuildTable( lua_State& io_luaState, const int i_index, const uint32_t i_depth, Format::sValue& o_value )
+	{
+		auto result = eae6320::Results::Success;
+
+		if ( i_depth >= Format::s_maxTableDepth )
+		{
+			result = eae6320::Results::InvalidFile;
+			std::cerr << "Asset tables can't be nested more than " << Format::s_maxTableDepth << " levels deep" << std::endl;
+			return result;
+		}
+		// Every level of nesting needs a few stack slots (a key, a value, and the nested table's key and value)
+		if ( !lua_checkstack( &io_luaState, 4 ) )
+		{
+			result = eae6320::Results::OutOfMemory;
+			std::cerr << "The Lua stack couldn't grow to read a nested asset table" << std::endl;
+			return result;
+		}
+
+		// Find the keys of the dictionary part
+		// (lua_rawlen() and lua_rawget() are used because asset tables shouldn't have metatables)
+		const auto arrayLength = static_cast<lua_Integer>( lua_rawlen( &io_luaState, i_index ) );
+		std::vector<std::string> keys;
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, i_index ) )
+		{
+			// The key is at -2 and the value is at -1
+			const auto keyType = lua_type( &io_luaState, -2 );
+			if ( keyType == LUA_TSTRING )
+			{
+				size_t keyLength;
+				const auto* const key = lua_tolstring( &io_luaState, -2, &keyLength );
+				keys.emplace_back( key, keyLength );
+			}
+			else if ( ( keyType == LUA_TNUMBER ) && lua_isinteger( &io_luaState, -2 ) )
+			{
+				const auto key = lua_tointeger( &io_luaState, -2 );
+				if ( ( key < 1 ) || ( key > arrayLength ) )
+				{
+					result = eae6320::Results::InvalidFile;
+					std::cerr << "The integer key " << key << " isn't part of the asset table's array"
+						" (which has " << arrayLength << " values)" << std::endl;
+					lua_pop( &io_luaState, 2 );
+					return result;
+				}
+			}
+			else
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << "Asset table keys can't be a " << luaL_typename( &io_luaState, -2 ) << std::endl;
+				lua_pop( &io_luaState, 2 );
+				return result;
+			}
+			// Pop the value, but leave the key for lua_next()
+			lua_pop( &io_luaState, 1 );
+		}
+		// The runtime finds keys with a binary search
+		// (std::string compares bytes as unsigned chars, the same as memcmp())
+		std::sort( keys.begin(), keys.end() );
+
+		// The table and its values are allocated before any nested tables or strings
+		// so that a table's values are next to each other
+		Format::sTable table{};
+		table.arrayLength = static_cast<uint32_t>( arrayLength );
+		table.dictionaryLength = static_cast<uint32_t>( keys.size() );
+		uint32_t tableOffset;
+		if ( !( result = Allocate( sizeof( Format::sTable ), Format::s_alignment, tableOffset ) ) )
+		{
+			return result;
+		}
+		if ( !( result = Allocate( static_cast<uint64_t>( table.arrayLength ) * sizeof( Format::sValue ), Format::s_alignment, table.arrayOffset ) ) )
+		{
+			return result;
+		}
+		if ( !( result = Allocate( static_cast<uint64_t>( table.dictionaryLength ) * sizeof( Format::sDictionaryEntry ),
+			Format::s_alignment, table.dictionaryOffset ) ) )
+		{
+			return result;
+		}
+		std::memcpy( m_data.data() + tableOffset, &table, sizeof( table ) );
+
+		// Values are built into a local first and then copied
+		// because building a nested value can reallocate the data
+		for ( uint32_t i = 0; i < table.arrayLength; ++i )
+		{
+			lua_rawgeti( &io_luaState, i_index, static_cast<lua_Integer>( i + 1 ) );
+			Format::sValue value;
+			result = BuildValue( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, value );
+			lua_pop( &io_luaState, 1 );
+			if ( !result )
+			{
+				return result;
+			}
+			std::memcpy( m_data.data() + table.arrayOffset + ( i * sizeof( Format::sValue ) ), &value, sizeof( value ) );
+		}
+		for ( uint32_t i = 0; i < table.dictionaryLength; ++i )
+		{
+			const auto& key = keys[i];
+			Format::sDictionaryEntry entry;
+			entry.keyLength = static_cast<uint32_t>( key.size() );
+			if ( !( result = WriteString( key.data(), key.size(), entry.keyOffset ) ) )
+			{
+				return result;
+			}
+			lua_pushlstring( &io_luaState, key.data(), key.size() );
+			lua_rawget( &io_luaState, i_index );
+			result = BuildValue( io_luaState, lua_gettop( &io_luaState ), i_depth + 1, entry.value );
+			lua_pop( &io_luaState, 1 );
+			if ( !result )
+			{
+				return result;
+			}
+			std::memcpy( m_data.data() + table.dictionaryOffset + ( i * sizeof( Format::sDictionaryEntry ) ), &entry, sizeof( entry ) );
+		}
+
+		o_value.type = Format::eType::Table;
+		o_value.offset = tableOffset;
+
+		return result;
+	}
+
+	eae6320::cResult cBuilder::WriteString( const char* const i_string, const size_t i_length, uint32_t& o_offset )
+	{
+		auto result = eae6320::Results::Success;
+
+		std::string string( i_string, i_length );
+		const auto existingString = m_stringOffsets.find( string );
+		if ( existingString != m_stringOffsets.end() )
+		{
+			o_offset = existingString->second;
+			return result;
+		}
+		// The allocated space is already zeroed, and so the terminating NULL doesn't have to be written
+		constexpr uint32_t noAlignment = 1;
+		if ( !( result = Allocate( static_cast<uint64_t>( i_length ) + 1, noAlignment, o_offset ) ) )
+		{
+			return result;
+		}
+		std::memcpy( m_data.data() + o_offset, i_string, i_length );
+		m_stringOffsets.emplace( std::move( string ), o_offset );
+
+		return result;
+	}
+
+	eae6320::cResult cBuilder::Allocate( const uint64_t i_size, const uint32_t i_alignment, uint32_t& o_offset )
+	{
+		const auto offset = ( ( static_cast<uint64_t>( m_data.size() ) + i_alignment - 1 ) / i_alignment ) * i_alignment;
+		const auto newSize = offset + i_size;
+		// Offsets are 32 bits
+		if ( newSize > 0xffffffff )
+		{
+			std::cerr << "Binary assets can't be bigger than 4 GB" << std::endl;
+			return eae6320::Results::OutOfMemory;
+		}
+		m_data.resize( static_cast<size_t>( newSize ), 0 );
+		o_offset = static_cast<uint32_t>( offset );
+		return eae6320::Results::Success;
+	}
+}
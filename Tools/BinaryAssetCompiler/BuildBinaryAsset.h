@@ -0,0 +1,39 @@
+/*
+	These functions convert an asset table into a binary asset
+*/
+
+#ifndef EAE6320_BINARYASSETCOMPILER_BUILDBINARYASSET_H
+#define EAE6320_BINARYASSETCOMPILER_BUILDBINARYASSET_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace BinaryAssetCompiler
+	{
+		// Converts the table at the given index of the stack (which is left unchanged)
+		// into the contents of a binary asset file.
+		// Asset tables can only have string keys and array keys (1, 2, ..., n),
+		// and functions, userdata, and threads aren't allowed anywhere.
+		cResult BuildBinaryAsset( lua_State& io_luaState, const int i_tableIndex, std::vector<uint8_t>& o_data );
+	}
+}
+
+#endif	// EAE6320_BINARYASSETCOMPILER_BUILDBINARYASSET_H
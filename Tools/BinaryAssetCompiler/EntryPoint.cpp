@@ -0,0 +1,196 @@
+/*
+	The main() function is where the program starts execution
+
+	This tool converts a Lua asset file into a binary asset file:
+		BinaryAssetCompiler source.lua target.binasset
+	The Lua file is run once (in the same way that an asset loader would run it)
+	and the table that it returns is written to the target file.
+	The written file is then loaded back and compared against the table
+	to make sure that nothing was lost.
+
+	An existing binary asset can be checked against its Lua source without writing anything:
+		BinaryAssetCompiler -verify source.lua target.binasset
+*/
+
+// Include Files
+//==============
+
+#include "BuildBinaryAsset.h"
+#include "VerifyBinaryAsset.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/BinaryAssets/cAsset.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Pushes the table that the asset file returns
+	eae6320::cResult LoadAssetTable( lua_State& io_luaState, const char* const i_path );
+	eae6320::cResult WriteFile( const char* const i_path, const std::vector<uint8_t>& i_data );
+}
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	int exitCode = EXIT_SUCCESS;
+
+	bool shouldOnlyVerify = false;
+	const char* sourcePath = nullptr;
+	const char* targetPath = nullptr;
+	lua_State* luaState = nullptr;
+	eae6320::BinaryAssets::cAsset binaryAsset;
+
+	// Parse the command line
+	{
+		int argumentIndex = 1;
+		if ( ( argumentIndex < i_argumentCount ) && ( std::strcmp( i_arguments[argumentIndex], "-verify" ) == 0 ) )
+		{
+			shouldOnlyVerify = true;
+			++argumentIndex;
+		}
+		if ( ( i_argumentCount - argumentIndex ) != 2 )
+		{
+			std::cerr << "Usage: BinaryAssetCompiler [-verify] source.lua target.binasset" << std::endl;
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+		sourcePath = i_arguments[argumentIndex];
+		targetPath = i_arguments[argumentIndex + 1];
+	}
+
+	// Create a new Lua state
+	{
+		luaState = luaL_newstate();
+		if ( !luaState )
+		{
+			std::cerr << "Failed to create a new Lua state" << std::endl;
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+	}
+	// The standard libraries aren't opened
+	// because asset files are loaded without them
+
+	if ( !LoadAssetTable( *luaState, sourcePath ) )
+	{
+		exitCode = EXIT_FAILURE;
+		goto OnExit;
+	}
+	if ( !shouldOnlyVerify )
+	{
+		std::vector<uint8_t> data;
+		const auto isWritten = eae6320::BinaryAssetCompiler::BuildBinaryAsset( *luaState, -1, data )
+			&& WriteFile( targetPath, data );
+		if ( !isWritten )
+		{
+			std::cerr << "(The asset that couldn't be built was " << sourcePath << ")" << std::endl;
+			lua_pop( luaState, 1 );
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+	}
+	// The binary asset is always read back the same way that the runtime will read it
+	{
+		const auto isVerified = binaryAsset.Load( targetPath )
+			&& eae6320::BinaryAssetCompiler::VerifyBinaryAsset( *luaState, -1, binaryAsset.GetRoot() );
+		// Pop the asset table
+		lua_pop( luaState, 1 );
+		if ( !isVerified )
+		{
+			std::cerr << "The binary asset " << targetPath << " doesn't match " << sourcePath << std::endl;
+			exitCode = EXIT_FAILURE;
+			goto OnExit;
+		}
+		std::cout << ( shouldOnlyVerify ? "Verified " : "Built " ) << targetPath
+			<< " (" << binaryAsset.GetSize() << " bytes) from " << sourcePath << std::endl;
+	}
+
+OnExit:
+
+	binaryAsset.Unload();
+	if ( luaState )
+	{
+		// If I haven't made any mistakes
+		// there shouldn't be anything on the stack
+		// regardless of any errors
+		EAE6320_ASSERT( lua_gettop( luaState ) == 0 );
+
+		lua_close( luaState );
+		luaState = nullptr;
+	}
+
+	return exitCode;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult LoadAssetTable( lua_State& io_luaState, const char* const i_path )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Load the asset file as a "chunk"
+		{
+			const auto luaResult = luaL_loadfile( &io_luaState, i_path );
+			if ( luaResult != LUA_OK )
+			{
+				result = ( luaResult == LUA_ERRFILE ) ? eae6320::Results::FileDoesntExist : eae6320::Results::InvalidFile;
+				std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+		}
+		// Execute the chunk, which should return the asset table
+		{
+			constexpr int argumentCount = 0;
+			constexpr int returnValueCount = 1;
+			constexpr int noMessageHandler = 0;
+			const auto luaResult = lua_pcall( &io_luaState, argumentCount, returnValueCount, noMessageHandler );
+			if ( luaResult != LUA_OK )
+			{
+				result = eae6320::Results::InvalidFile;
+				std::cerr << lua_tostring( &io_luaState, -1 ) << std::endl;
+				lua_pop( &io_luaState, 1 );
+				return result;
+			}
+		}
+		if ( !lua_istable( &io_luaState, -1 ) )
+		{
+			result = eae6320::Results::InvalidFile;
+			std::cerr << "Asset files must return a table (instead of a "
+				<< luaL_typename( &io_luaState, -1 ) << "): " << i_path << std::endl;
+			lua_pop( &io_luaState, 1 );
+			return result;
+		}
+
+		return result;
+	}
+
+	eae6320::cResult WriteFile( const char* const i_path, const std::vector<uint8_t>& i_data )
+	{
+		std::ofstream file( i_path, std::ios::binary | std::ios::trunc );
+		if ( file.is_open() )
+		{
+			file.write( reinterpret_cast<const char*>( i_data.data() ), static_cast<std::streamsize>( i_data.size() ) );
+			if ( file.good() )
+			{
+				return eae6320::Results::Success;
+			}
+		}
+		std::cerr << "The binary asset couldn't be written to " << i_path << std::endl;
+		return eae6320::Results::Failure;
+	}
+}
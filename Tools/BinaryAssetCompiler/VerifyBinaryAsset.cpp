@@ -0,0 +1,173 @@
+// Include Files
+//==============
+
+#include "VerifyBinaryAsset.h"
+
+#include <cstring>
+#include <Engine/BinaryAssets/cValue.h>
+#include <Engine/Results/Results.h>
+#include <External/Lua/Includes.h>
+#include <iostream>
+#include <string>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The path is only used for the error message (e.g. "parameters.g_speed" or "textures[2]")
+	bool IsValueEqual( lua_State& io_luaState, const int i_index, const eae6320::BinaryAssets::cValue& i_value,
+		const std::string& i_path );
+	bool IsTableEqual( lua_State& io_luaState, const int i_index, const eae6320::BinaryAssets::cValue& i_value,
+		const std::string& i_path );
+	void PrintDifference( const std::string& i_path, const char* const i_description );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::BinaryAssetCompiler::VerifyBinaryAsset( lua_State& io_luaState, const int i_tableIndex,
+	const BinaryAssets::cValue& i_root )
+{
+	return IsValueEqual( io_luaState, lua_absindex( &io_luaState, i_tableIndex ), i_root, "(root)" )
+		? Results::Success : Results::InvalidFile;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool IsValueEqual( lua_State& io_luaState, const int i_index, const eae6320::BinaryAssets::cValue& i_value,
+		const std::string& i_path )
+	{
+		using eType = eae6320::BinaryAssets::cValue::eType;
+
+		switch ( lua_type( &io_luaState, i_index ) )
+		{
+		case LUA_TNIL:
+			if ( !i_value.IsNil() )
+			{
+				PrintDifference( i_path, "the binary value should be nil" );
+				return false;
+			}
+			return true;
+		case LUA_TBOOLEAN:
+			if ( ( i_value.GetType() != eType::Boolean )
+				|| ( i_value.GetBoolean() != ( lua_toboolean( &io_luaState, i_index ) != 0 ) ) )
+			{
+				PrintDifference( i_path, "the boolean values are different" );
+				return false;
+			}
+			return true;
+		case LUA_TNUMBER:
+			if ( lua_isinteger( &io_luaState, i_index ) )
+			{
+				if ( ( i_value.GetType() != eType::Integer )
+					|| ( i_value.GetInteger() != static_cast<int64_t>( lua_tointeger( &io_luaState, i_index ) ) ) )
+				{
+					PrintDifference( i_path, "the integer values are different" );
+					return false;
+				}
+			}
+			else
+			{
+				// The bits are compared so that NaNs (which aren't equal to anything) are handled
+				const auto expectedValue = static_cast<double>( lua_tonumber( &io_luaState, i_index ) );
+				const auto value = i_value.GetNumber();
+				if ( ( i_value.GetType() != eType::Number ) || ( std::memcmp( &expectedValue, &value, sizeof( value ) ) != 0 ) )
+				{
+					PrintDifference( i_path, "the number values are different" );
+					return false;
+				}
+			}
+			return true;
+		case LUA_TSTRING:
+			{
+				size_t expectedLength;
+				const auto* const expectedString = lua_tolstring( &io_luaState, i_index, &expectedLength );
+				size_t length;
+				const auto* const string = i_value.GetString( &length );
+				if ( ( i_value.GetType() != eType::String ) || ( length != expectedLength )
+					|| ( std::memcmp( string, expectedString, length ) != 0 ) )
+				{
+					PrintDifference( i_path, "the string values are different" );
+					return false;
+				}
+			}
+			return true;
+		case LUA_TTABLE:
+			return IsTableEqual( io_luaState, i_index, i_value, i_path );
+		default:
+			PrintDifference( i_path, "the Lua value can't be stored in a binary asset" );
+			return false;
+		}
+	}
+
+	bool IsTableEqual( lua_State& io_luaState, const int i_index, const eae6320::BinaryAssets::cValue& i_value,
+		const std::string& i_path )
+	{
+		if ( i_value.GetType() != eae6320::BinaryAssets::cValue::eType::Table )
+		{
+			PrintDifference( i_path, "the binary value should be a table" );
+			return false;
+		}
+		if ( !lua_checkstack( &io_luaState, 4 ) )
+		{
+			PrintDifference( i_path, "the Lua stack couldn't grow to read the nested table" );
+			return false;
+		}
+
+		// Every Lua value must have a corresponding binary value
+		const auto arrayLength = lua_rawlen( &io_luaState, i_index );
+		if ( i_value.GetArrayLength() != arrayLength )
+		{
+			PrintDifference( i_path, "the array lengths are different" );
+			return false;
+		}
+		for ( size_t i = 0; i < arrayLength; ++i )
+		{
+			lua_rawgeti( &io_luaState, i_index, static_cast<lua_Integer>( i + 1 ) );
+			const auto isEqual = IsValueEqual( io_luaState, lua_gettop( &io_luaState ), i_value.GetArrayValue( i ),
+				i_path + "[" + std::to_string( i + 1 ) + "]" );
+			lua_pop( &io_luaState, 1 );
+			if ( !isEqual )
+			{
+				return false;
+			}
+		}
+		size_t dictionaryLength = 0;
+		lua_pushnil( &io_luaState );
+		while ( lua_next( &io_luaState, i_index ) )
+		{
+			// The key is at -2 and the value is at -1
+			if ( lua_type( &io_luaState, -2 ) == LUA_TSTRING )
+			{
+				size_t keyLength;
+				const auto* const key = lua_tolstring( &io_luaState, -2, &keyLength );
+				if ( !IsValueEqual( io_luaState, lua_gettop( &io_luaState ), i_value.Find( key, keyLength ),
+					i_path + "." + std::string( key, keyLength ) ) )
+				{
+					lua_pop( &io_luaState, 2 );
+					return false;
+				}
+				++dictionaryLength;
+			}
+			// Pop the value, but leave the key for lua_next()
+			lua_pop( &io_luaState, 1 );
+		}
+		// ...and there must not be any extra binary values
+		if ( i_value.GetDictionaryLength() != dictionaryLength )
+		{
+			PrintDifference( i_path, "the binary table has extra keys" );
+			return false;
+		}
+
+		return true;
+	}
+
+	void PrintDifference( const std::string& i_path, const char* const i_description )
+	{
+		std::cerr << "The binary asset doesn't match the Lua asset at " << i_path << ": " << i_description << std::endl;
+	}
+}
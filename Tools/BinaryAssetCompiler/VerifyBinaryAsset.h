@@ -0,0 +1,37 @@
+/*
+	These functions check that a binary asset matches the Lua table it was built from
+*/
+
+#ifndef EAE6320_BINARYASSETCOMPILER_VERIFYBINARYASSET_H
+#define EAE6320_BINARYASSETCOMPILER_VERIFYBINARYASSET_H
+
+// Forward Declarations
+//=====================
+
+struct lua_State;
+
+namespace eae6320
+{
+	class cResult;
+
+	namespace BinaryAssets
+	{
+		class cValue;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace BinaryAssetCompiler
+	{
+		// Compares every value of the table at the given index of the stack (which is left unchanged)
+		// with the corresponding value of the binary asset.
+		// The first difference that is found is printed.
+		cResult VerifyBinaryAsset( lua_State& io_luaState, const int i_tableIndex, const BinaryAssets::cValue& i_root );
+	}
+}
+
+#endif	// EAE6320_BINARYASSETCOMPILER_VERIFYBINARYASSET_H